@@ -0,0 +1,143 @@
+/* USER CODE BEGIN Header */
+/**
+ ******************************************************************************
+ * @file           : Benchmark_UART.c
+ * @brief          : USART driver benchmark application (TASKS/USART_Bench.c)
+ ******************************************************************************
+ * @attention
+ *
+ * Alternative main, excluded from the Debug build like the other *_UART.c
+ * mains: swap the exclusion with Transmit_UART.c to flash it.
+ *
+ * Wiring : USART2 TX (PA2) jumpered to USART2 RX (PA3).
+ * Output : BENCH,... lines over ITM/SWO (printf), see TASKS/USART_Bench.h.
+ * Sweeps : rebuild with other USART_Cfg.h modes / USART2_BAUDRATE /
+ *          USART2_TX_BUFF_SIZE / USART2_RX_BUFF_SIZE (-D or edit) per run.
+ *
+ ******************************************************************************
+ */
+/* USER CODE END Header */
+/* Includes ------------------------------------------------------------------*/
+#include "main.h"
+#include "USART_Prv.h"
+#include "Sys.h"
+#include "USART.h"
+#include "USART_Cfg.h"
+#include "TASKS.h"
+#include "USART_Bench.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Two CYCCNT reads further apart than this were split by an interrupt. */
+#define BENCH_GAP_CYCLES    40U
+
+static void Bench_Cycles_Init(void)
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT       = 0U;
+	DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t USART_Bench_Cycles(void)
+{
+	return DWT->CYCCNT;
+}
+
+uint32_t USART_Bench_CyclesHz(void)
+{
+	return SystemCoreClock;
+}
+
+/* CYCCNT extended to 64 bits; called far more often than its 25 s wrap at 168 MHz. */
+uint64_t USART_Bench_NowNs(void)
+{
+	static uint64_t Total = 0;
+	static uint32_t Last  = 0;
+	uint32_t        Now;
+	uint64_t        Ns;
+
+	taskENTER_CRITICAL();
+	Now    = DWT->CYCCNT;
+	Total += (uint32_t)(Now - Last);
+	Last   = Now;
+	Ns     = ((Total / SystemCoreClock) * 1000000000ULL) +
+	         (((Total % SystemCoreClock) * 1000000000ULL) / SystemCoreClock);
+	taskEXIT_CRITICAL();
+
+	return Ns;
+}
+
+/*
+ * Busy-wait Window_Ms reading CYCCNT back to back: every gap longer than
+ * BENCH_GAP_CYCLES is time spent in an interrupt (USART, DMA, SysTick, ...).
+ * The isr_idle record is the baseline to subtract. Holds the CPU for the whole
+ * window, so polled directions make no progress while it runs.
+ */
+void USART_Bench_IsrProbe(USART_Num_t USART_Num, uint32_t Window_Ms, USART_Bench_Isr_t *Isr)
+{
+	uint32_t Window = (SystemCoreClock / 1000U) * Window_Ms;
+	uint32_t Start  = DWT->CYCCNT;
+	uint32_t Prev   = Start;
+	uint32_t Now;
+	uint32_t Gap;
+
+	(void)USART_Num;
+	Isr->Count = 0;
+	Isr->Min   = 0xFFFFFFFFU;
+	Isr->Max   = 0;
+	Isr->Total = 0;
+
+	while(((Now = DWT->CYCCNT) - Start) < Window)
+	{
+		Gap = Now - Prev;
+		if(Gap > BENCH_GAP_CYCLES)
+		{
+			Isr->Count++;
+			Isr->Total += Gap;
+			Isr->Min    = (Gap < Isr->Min) ? Gap : Isr->Min;
+			Isr->Max    = (Gap > Isr->Max) ? Gap : Isr->Max;
+		}
+		Prev = Now;
+	}
+}
+
+static void Bench_Task(void *pram)
+{
+	(void)USART_Bench_Run(USART_NUM_2);
+
+	while(1)
+	{
+		vTaskDelay(pdMS_TO_TICKS(1000));
+	}
+}
+
+int main(void)
+{
+	Sys_Init();
+	Bench_Cycles_Init();
+	TASKS_Init();
+
+	BaseType_t ret_st;
+
+	ret_st = xTaskCreate(Bench_Task, "Bench", 512, NULL, 2, NULL);
+	configASSERT(ret_st == pdPASS);
+
+	/* Service tasks for polled directions (no-ops for interrupt / DMA driven ones). */
+	ret_st = xTaskCreate(TASKS_USART_30ms, "Rx cyclic", 200, NULL, 1, NULL);
+	configASSERT(ret_st == pdPASS);
+
+	ret_st = xTaskCreate(TASKS_USART_Tx_Cyclic, "Tx cyclic", 200, NULL, 1, NULL);
+	configASSERT(ret_st == pdPASS);
+
+	vTaskStartScheduler();
+
+  /* USER CODE BEGIN WHILE */
+  /* Not reached: the scheduler only returns if it could not start. */
+  while (1)
+  {
+    /* USER CODE END WHILE */
+
+    /* USER CODE BEGIN 3 */
+  }
+  /* USER CODE END 3 */
+}
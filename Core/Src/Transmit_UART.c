@@ -39,6 +39,14 @@ int main(void)
 	ret_st = xTaskCreate(TASKS_Send_Data, "Tx data", 200, NULL, 2, NULL);
 	configASSERT(ret_st == pdPASS);
 
+	/* USB host stack (and the CDC bridge when enabled), event driven. */
+	ret_st = xTaskCreate(TASKS_Usb_Host, "USB host", 512, NULL, 2, NULL);
+	configASSERT(ret_st == pdPASS);
+
+	/* Ships the deferred USART_LOG() records (USART_Log.h), lowest priority. */
+	ret_st = xTaskCreate(TASKS_Log_Flush, "Log flush", 200, NULL, 1, NULL);
+	configASSERT(ret_st == pdPASS);
+
 /*	ret_st = xTaskCreate(TASKS_USART_Tx_Cyclic, "Tx cyclic", 200, NULL, 1, NULL);
 	configASSERT(ret_st == pdPASS);*/
 
@@ -46,10 +54,11 @@ int main(void)
 	vTaskStartScheduler();
 
   /* USER CODE BEGIN WHILE */
+  /* Not reached: the scheduler only returns if it could not start. The USB host
+     runs in TASKS_Usb_Host. */
   while (1)
   {
     /* USER CODE END WHILE */
-    MX_USB_HOST_Process();
 
     /* USER CODE BEGIN 3 */
   }
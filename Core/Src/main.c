@@ -24,6 +24,7 @@
 #include "USART.h"
 #include "USART_Cfg.h"
 #include "TASKS.h"
+#include "USART_UsbBridge.h"
 #include "FreeRTOS.h"
 #include "task.h"
 
@@ -34,23 +35,38 @@ int main(void)
 	Sys_Init();
 
 	TASKS_Init();
-	BaseType_t ret_st = xTaskCreate(TASKS_USART_30ms, "USART Cyclic", 200, NULL, 1, NULL);
+	BaseType_t ret_st;
+
+	/* RX cyclic service is only needed in polling mode; IT/DMA modes signal events. */
+#if (USART_RX_INT == DISABLE)
+	ret_st = xTaskCreate(TASKS_USART_30ms, "USART Cyclic", 200, NULL, 1, NULL);
+	configASSERT(ret_st == pdPASS);
+#endif
+
+	/* USB host stack (and the CDC bridge when enabled), event driven. */
+	ret_st = xTaskCreate(TASKS_Usb_Host, "USB host", 512, NULL, 2, NULL);
 	configASSERT(ret_st == pdPASS);
 
+	/* Ships the deferred USART_LOG() records (USART_Log.h), lowest priority. */
+	ret_st = xTaskCreate(TASKS_Log_Flush, "Log flush", 200, NULL, 1, NULL);
+	configASSERT(ret_st == pdPASS);
+
+	/* The bridge owns the port's RX stream. */
+#if (USART_USB_BRIDGE != ENABLE)
 	 ret_st = xTaskCreate(TASKS_Print_Usart_Rx_Msg, "Rx data", 200, NULL, 2, NULL);
 	configASSERT(ret_st == pdPASS);
+#endif
 
 	vTaskStartScheduler();
 
   /* USER CODE BEGIN WHILE */
+  /* Not reached: the scheduler only returns if it could not start. The USB host
+     runs in TASKS_Usb_Host. */
   while (1)
   {
     /* USER CODE END WHILE */
-    MX_USB_HOST_Process();
 
     /* USER CODE BEGIN 3 */
   }
   /* USER CODE END 3 */
 }
-
-
@@ -106,6 +106,7 @@ __attribute__((weak)) int _read(int file, char *ptr, int len)
   return len;
 }
 
+/* Overridden by MCAL/USART/USART_Stdio.c when USART_STDIO == ENABLE (USART_Cfg.h). */
 __attribute__((weak)) int _write(int file, char *ptr, int len)
 {
   (void)file;
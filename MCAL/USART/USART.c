@@ -10,7 +10,7 @@
  *
  *  This module supports two operation styles (compile-time selectable):
  *    1) Polling mode (USART_TX_INT / USART_RX_INT = DISABLE)
- *       - Application pushes TX bytes into a queue (or direct-send when possible)
+ *       - Application pushes TX bytes into a queue, the caller drains what TXE allows
  *       - Cyclic functions (USART_TxCyclic / USART_RxCyclic) poll HW flags (TXE / RXNE)
  *         and move data between HW registers and RTOS queues.
  *
@@ -19,9 +19,27 @@
  *       - TX uses HAL_UART_Transmit_IT() and HAL_UART_TxCpltCallback()
  *       - Queues are used as async buffers between tasks and ISR context
  *
+ *    3) DMA RX mode (USART_RX_DMA = ENABLE, on top of USART_RX_INT = ENABLE)
+ *       - RX uses a circular DMA stream + HAL_UARTEx_ReceiveToIdle_DMA()
+ *       - HAL_UARTEx_RxEventCallback() (half/complete/IDLE) copies whole chunks
+ *         from the DMA landing buffer into the RX buffer
+ *
+ *       - With USART_FAST_ISR = ENABLE the HAL path is bypassed: the driver ISR
+ *         reads SR/DR directly and TX is driven by the TXE interrupt
+ *
+ *    4) DMA TX mode (USART_TX_DMA = ENABLE)
+ *       - USART_SendBuffer() starts HAL_UART_Transmit_DMA() on the caller's buffer
+ *       - HAL_UART_TxCpltCallback() reports completion through the caller's callback
+ *
  *  Notes:
  *  ------
- *  - Queues are created per USART instance using USART_MAX_BUFF length.
+ *  - TX/RX buffers are either FreeRTOS queues or lock-free SPSC rings, selected by
+ *    USART_BUFF_BACKEND in USART_Cfg.h. Capacity and storage come per port from
+ *    USART_Config[] (Tx_Buff/Tx_Buff_Size, Rx_Buff/Rx_Buff_Size).
+ *    All buffer accesses go through the usart_buff_* helpers below.
+ *  - Several tasks may send on one port. With the ring backend every TX write is an
+ *    atomic reservation (USART_Ring_Reserve), so each USART_SendByte() / USART_Send()
+ *    (up to Tx_Buff_Size) / USART_TxReserve() message lands contiguously.
  *  - This file mixes HAL init/IT services with LL flag checks for polling loops.
  *  - For ISR usage with FreeRTOS, prefer passing pxHigherPriorityTaskWoken to
  *    xQueueSendFromISR/xQueueReceiveFromISR if you want immediate task switch.
@@ -31,6 +49,7 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "stm32f4xx.h"
 #include "stm32f407xx.h"
@@ -43,10 +62,21 @@
 #include "stm32f4xx_ll_usart.h"
 #include "FreeRTOS.h"
 #include "queue.h"
+#include "task.h"
 
 #include "USART.h"
 #include "USART_Prv.h"
 #include "USART_Cfg.h"
+#include "USART_Ring.h"
+#include "USART_Atomic.h"
+
+#if (USART_RX_DMA == ENABLE) && (USART_RX_INT != ENABLE)
+#error "USART_RX_DMA requires USART_RX_INT == ENABLE (IDLE-line event uses the USART IRQ)"
+#endif
+
+#if (USART_FAST_ISR == ENABLE) && ((USART_RX_DMA == ENABLE) || (USART_TX_DMA == ENABLE))
+#error "USART_FAST_ISR cannot be combined with USART_RX_DMA / USART_TX_DMA"
+#endif
 
 /* =========================================================================================
  *                                  Global Driver Objects
@@ -70,24 +100,85 @@ UART_HandleTypeDef USART_Handler[USART_MAX_NUM] = {NULL};
 USART_TypeDef *USART_Base_Num[USART_MAX_NUM] = {USART1 , USART2 , USART3 , UART4, UART5, USART6};
 IRQn_Type USART_IRQ[USART_MAX_NUM] = {USART1_IRQn , USART2_IRQn , USART3_IRQn , UART4_IRQn , UART5_IRQn , USART6_IRQn} ;
 
+#if (USART_RX_DMA == ENABLE)
+/* =========================================================================================
+ *                                  RX DMA Objects
+ * =========================================================================================
+ *
+ * USART_Rx_DMA_Handler:
+ *  - HAL DMA handle per USART, linked to USART_Handler[].hdmarx in USART_Init().
+ *
+ * USART_Rx_DMA_Stream / USART_Rx_DMA_Channel / USART_Rx_DMA_IRQ:
+ *  - Fixed STM32F407 request mapping for each USART RX (see USART_Cfg.h).
+ *
+ * USART_Rx_DMA_Buff:
+ *  - Circular landing buffer written by the DMA stream.
+ *
+ * USART_Rx_DMA_Pos:
+ *  - Offset in USART_Rx_DMA_Buff up to which data was already moved to the RX buffer.
+ */
+DMA_HandleTypeDef   USART_Rx_DMA_Handler[USART_MAX_NUM];
+DMA_Stream_TypeDef *USART_Rx_DMA_Stream[USART_MAX_NUM]  = {DMA2_Stream2 , DMA1_Stream5 , DMA1_Stream1 , DMA1_Stream2 , DMA1_Stream0 , DMA2_Stream1};
+uint32_t            USART_Rx_DMA_Channel[USART_MAX_NUM] = {DMA_CHANNEL_4, DMA_CHANNEL_4, DMA_CHANNEL_4, DMA_CHANNEL_4, DMA_CHANNEL_4, DMA_CHANNEL_5};
+IRQn_Type           USART_Rx_DMA_IRQ[USART_MAX_NUM]     = {DMA2_Stream2_IRQn , DMA1_Stream5_IRQn , DMA1_Stream1_IRQn , DMA1_Stream2_IRQn , DMA1_Stream0_IRQn , DMA2_Stream1_IRQn};
+
+static uint8_t  USART_Rx_DMA_Buff[USART_MAX_NUM][USART_RX_DMA_SIZE];
+static uint16_t USART_Rx_DMA_Pos[USART_MAX_NUM];
+#endif
+
+#if (USART_TX_DMA == ENABLE)
+/* =========================================================================================
+ *                                  TX DMA Objects
+ * =========================================================================================
+ *
+ * USART_Tx_DMA_Handler:
+ *  - HAL DMA handle per USART, linked to USART_Handler[].hdmatx in USART_Init().
+ *
+ * USART_Tx_DMA_Stream / USART_Tx_DMA_Channel / USART_Tx_DMA_IRQ:
+ *  - Fixed STM32F407 request mapping for each USART TX (see USART_Cfg.h).
+ *
+ * USART_Tx_DMA_Busy / USART_Tx_DMA_Cb:
+ *  - Set by USART_SendBuffer() while a caller buffer is in flight, cleared in
+ *    HAL_UART_TxCpltCallback() right before the completion callback runs.
+ */
+DMA_HandleTypeDef   USART_Tx_DMA_Handler[USART_MAX_NUM];
+DMA_Stream_TypeDef *USART_Tx_DMA_Stream[USART_MAX_NUM]  = {DMA2_Stream7 , DMA1_Stream6 , DMA1_Stream3 , DMA1_Stream4 , DMA1_Stream7 , DMA2_Stream6};
+uint32_t            USART_Tx_DMA_Channel[USART_MAX_NUM] = {DMA_CHANNEL_4, DMA_CHANNEL_4, DMA_CHANNEL_4, DMA_CHANNEL_4, DMA_CHANNEL_4, DMA_CHANNEL_5};
+IRQn_Type           USART_Tx_DMA_IRQ[USART_MAX_NUM]     = {DMA2_Stream7_IRQn , DMA1_Stream6_IRQn , DMA1_Stream3_IRQn , DMA1_Stream4_IRQn , DMA1_Stream7_IRQn , DMA2_Stream6_IRQn};
+
+static volatile uint8_t  USART_Tx_DMA_Busy[USART_MAX_NUM];
+static USART_TxDoneCb_t  USART_Tx_DMA_Cb[USART_MAX_NUM];
+#endif
+
 /* =========================================================================================
- *                              FreeRTOS Queue Buffers (TX/RX)
+ *                                TX/RX Buffers (Queue or Ring)
  * =========================================================================================
  *
  * USART_Tx_Buffer / USART_Rx_Buffer:
- *  - Each USART instance owns a TX and RX queue.
+ *  - Each USART instance owns a TX and RX buffer (queue or ring, see USART_BUFF_BACKEND).
  *  - Tasks send TX bytes to USART_Tx_Buffer[], and cyclic/ISR code drains to hardware.
  *  - Cyclic/ISR code pushes RX bytes into USART_Rx_Buffer[], and tasks read from it.
  *
- * usart_active_flag:
- *  - Used in TX interrupt mode to indicate that a TX "chain" is active.
- *  - When set to 0, the first queued byte triggers HAL_UART_Transmit_IT().
- *  - When queue becomes empty, callback clears the flag back to 0.
+ * USART_Tx_State:
+ *  - USART_Tx_State_t per port: whether a TX IT chain / DMA transfer owns the
+ *    transmitter (see "TX State Machine"). 32-bit for LDREX / STREX.
  */
+#if (USART_BUFF_BACKEND == USART_BUFF_QUEUE)
 QueueHandle_t USART_Tx_Buffer[USART_MAX_NUM];
 QueueHandle_t USART_Rx_Buffer[USART_MAX_NUM];
 
-volatile uint8_t usart_active_flag[USART_MAX_NUM] = {0};
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+/* Queue control blocks; the item storage is USART_Config[].Tx_Buff / Rx_Buff. */
+static StaticQueue_t USART_Tx_Queue_Cb[USART_MAX_NUM];
+static StaticQueue_t USART_Rx_Queue_Cb[USART_MAX_NUM];
+#endif
+#else
+/* Ring storage is the static per-port array from USART_Config[] (no heap usage). */
+USART_Ring_t  USART_Tx_Buffer[USART_MAX_NUM];
+USART_Ring_t  USART_Rx_Buffer[USART_MAX_NUM];
+#endif
+
+static volatile uint32_t USART_Tx_State[USART_MAX_NUM] = {USART_TX_IDLE};
 
 /* Per-instance single-byte staging variables (shared between cyclic/ISR code). */
 uint8_t USART_Rx_Byte[USART_MAX_NUM];
@@ -96,278 +187,2455 @@ uint8_t USART_Tx_Byte[USART_MAX_NUM];
 /* Tracks init state per USART instance (prevents using non-initialized peripheral). */
 static USART_Err_St_t  USART_Init_St[USART_MAX_NUM] = {USART_Not_Init};
 
+/*
+ * Blocked-task bookkeeping (USART_Send / USART_Receive):
+ *
+ * USART_Tx_Waiter / USART_Rx_Waiter:
+ *  - Task currently sleeping for TX space / RX data, NULL if none.
+ *  - The side that frees space / adds data notifies it (index USART_NOTIFY_INDEX)
+ *    and clears the slot, so each wait costs exactly one notification.
+ *
+ * USART_Tx_Wait_Need:
+ *  - Free TX space the waiter needs before waking is worthwhile (avoids one
+ *    wake-up per transmitted byte).
+ */
+static TaskHandle_t volatile USART_Tx_Waiter[USART_MAX_NUM];
+static TaskHandle_t volatile USART_Rx_Waiter[USART_MAX_NUM];
+static volatile uint32_t     USART_Tx_Wait_Need[USART_MAX_NUM];
+
+/*
+ * USART_Event_Task:
+ *  - Consumer task registered with USART_SetEventTask(), NULL if none.
+ *  - Receives USART_EVT_RX(num) / USART_EVT_TX(num) bits on USART_EVENT_NOTIFY_INDEX.
+ */
+static TaskHandle_t volatile USART_Event_Task[USART_MAX_NUM];
+
+/*
+ * USART_Rx_Hook:
+ *  - Stream consumer registered with USART_SetRxHook(), NULL if none. When set,
+ *    received data bytes go to the hook instead of the RX buffer.
+ */
+static USART_RxHook_t volatile USART_Rx_Hook[USART_MAX_NUM];
+
+#if (USART_SW_RTS == ENABLE)
+/*
+ * USART_Rts_Throttled:
+ *  - 1 while the software watermark holds RTS deasserted (RX buffer above the high mark).
+ *  - Set by the RX producer (ISR / USART_RxCyclic), cleared by the reading task.
+ */
+static volatile uint8_t USART_Rts_Throttled[USART_MAX_NUM];
+#endif
+
+#if (USART_XON_XOFF == ENABLE)
+/*
+ * XON/XOFF state (ports with a non-zero Xoff_High_Water only):
+ *
+ * USART_Xoff_Rcvd:
+ *  - 1 after the peer sent XOFF: TX holds buffered data until the peer sends XON.
+ *
+ * USART_Xoff_Sent:
+ *  - 1 after we asked the peer to pause (RX buffer above Xoff_High_Water).
+ *
+ * USART_Flow_Char:
+ *  - XON/XOFF waiting to be transmitted ahead of the TX buffer, 0 if none.
+ */
+static volatile uint8_t USART_Xoff_Rcvd[USART_MAX_NUM];
+static volatile uint8_t USART_Xoff_Sent[USART_MAX_NUM];
+static volatile uint8_t USART_Flow_Char[USART_MAX_NUM];
+#endif
+
+#if (USART_STATS == ENABLE)
+/*
+ * USART_Stats:
+ *  - Per-port counters returned by USART_GetStats(). Each field has one writer context
+ *    (RX producer or TX consumer), so plain increments are enough, except
+ *    Tx_High_Water: every sending task updates it, with a CAS (usart_stat_tx_level).
+ */
+static USART_Stats_t USART_Stats[USART_MAX_NUM];
+#endif
+
+#if (USART_PROFILE == ENABLE)
+/*
+ * USART_Prof:
+ *  - Per-port, per-probe-point cycle profiles returned by USART_GetProfile(). Each
+ *    probe point has one writer context (task, cyclic task or ISR), like USART_Stats.
+ */
+static USART_Prof_t USART_Prof[USART_MAX_NUM][USART_PROF_POINTS];
+#endif
+
 /* =========================================================================================
- *                                  USART_Init()
+ *                              Buffer Backend Helpers
  * =========================================================================================
  *
- * General peripheral init pattern used here:
- *   1) Validate arguments
- *   2) Enable peripheral clock
- *   3) Enable GPIO clocks
- *   4) Configure GPIO pins for Alternate Function (TX/RX)
- *   5) Configure USART parameters via HAL handle
- *   6) Initialize USART with HAL_UART_Init()
- *   7) Create RTOS resources (TX/RX queues)
- *   8) Configure NVIC + enable interrupts (optional)
- *   9) Start RX interrupt reception (optional)
+ * Thin wrappers that hide the selected backend from the rest of the driver.
+ * All return 1 on success and 0 on full/empty buffer.
  *
- * Returns:
- *   - USART_InitSuccess on success
- *   - Error codes on invalid args, HAL init failure, queue creation failure, etc.
+ * *_isr variants must be used from interrupt context (FromISR queue APIs).
+ * With the ring backend task and ISR variants are identical (no RTOS calls).
  */
-USART_Err_St_t USART_Init(USART_Num_t USART_Num)
+#if (USART_BUFF_BACKEND == USART_BUFF_QUEUE)
+
+static inline uint8_t usart_buff_create(USART_Num_t USART_Num)
 {
-	USART_Err_St_t USART_Err_Ret = USART_InitSuccess;
-	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	const USART_Config_t *Cfg = &USART_Config[USART_Num];
 
-	/* 1) Validate argument: USART_Num must be within configured range. */
-	if(USART_Num >= USART_MAX_NUM)
+	if((Cfg->Tx_Buff_Size == 0U) || (Cfg->Rx_Buff_Size == 0U))
 	{
-		USART_Err_Ret = USART_Invalid_Arg;
+		return 0;
 	}
-	else
-	{
-		/* 2) Enable USART peripheral clock. */
-		usart_clk_enable(USART_Num);
 
-		/* 3) Enable GPIO clocks for configured TX/RX ports. */
-		usart_gpio_clk_enable(USART_Pin_Config[USART_Num].Tx_Port);
-		usart_gpio_clk_enable(USART_Pin_Config[USART_Num].Rx_Port);
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+	USART_Tx_Buffer[USART_Num] =  xQueueCreateStatic(Cfg->Tx_Buff_Size, sizeof(uint8_t), Cfg->Tx_Buff, &USART_Tx_Queue_Cb[USART_Num]);
+	USART_Rx_Buffer[USART_Num] =  xQueueCreateStatic(Cfg->Rx_Buff_Size, sizeof(uint8_t), Cfg->Rx_Buff, &USART_Rx_Queue_Cb[USART_Num]);
+#else
+	/* Static allocation disabled in FreeRTOSConfig.h: fall back to the heap. */
+	USART_Tx_Buffer[USART_Num] =  xQueueCreate(Cfg->Tx_Buff_Size, sizeof(uint8_t));
+	USART_Rx_Buffer[USART_Num] =  xQueueCreate(Cfg->Rx_Buff_Size, sizeof(uint8_t));
+#endif
 
-		/* 4) Configure TX pin as Alternate Function Push-Pull. */
-		GPIO_InitStruct.Pin = USART_Pin_Config[USART_Num].Tx_Pin;
-		GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
-		GPIO_InitStruct.Pull = GPIO_NOPULL;
-		GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+	return ((USART_Tx_Buffer[USART_Num] != NULL) && (USART_Rx_Buffer[USART_Num] != NULL));
+}
 
-		/* Select AF mapping: USART1/2/3 use AF7, UART4/5/USART6 often AF8 on STM32F4. */
-		if((USART_Num == USART_NUM_1) || (USART_Num == USART_NUM_2) || (USART_Num == USART_NUM_3))
-		{
-			GPIO_InitStruct.Alternate = USART_GPIO_AF7;
-		}
-		else
-		{
-			GPIO_InitStruct.Alternate = USART_GPIO_AF8;
-		}
+static inline uint8_t usart_buff_tx_put(USART_Num_t USART_Num, uint8_t Data)
+{
+	return (xQueueSend(USART_Tx_Buffer[USART_Num], &Data, 0) == pdPASS);
+}
 
-		HAL_GPIO_Init(USART_Pin_Config[USART_Num].Tx_Port, &GPIO_InitStruct);
+static inline uint8_t usart_buff_tx_get(USART_Num_t USART_Num, uint8_t *Data)
+{
+	return (xQueueReceive(USART_Tx_Buffer[USART_Num], Data, 0) == pdPASS);
+}
 
-		/* Configure RX pin with the same AF parameters (Pin field changed only). */
-		GPIO_InitStruct.Pin = USART_Pin_Config[USART_Num].Rx_Pin;
-		HAL_GPIO_Init(USART_Pin_Config[USART_Num].Rx_Port, &GPIO_InitStruct);
+static inline uint8_t usart_buff_tx_get_isr(USART_Num_t USART_Num, uint8_t *Data)
+{
+	return (xQueueReceiveFromISR(USART_Tx_Buffer[USART_Num], Data, NULL) == pdPASS);
+}
 
-		/* 5) Fill HAL handle init parameters from configuration tables. */
-		USART_Handler[USART_Num].Instance          = USART_Base_Num[USART_Num];
-		USART_Handler[USART_Num].Init.BaudRate     = USART_Config[USART_Num].BaudRate;
-		USART_Handler[USART_Num].Init.WordLength   = USART_Config[USART_Num].WordLength;
-		USART_Handler[USART_Num].Init.StopBits     = USART_Config[USART_Num].stop_bit;
-		USART_Handler[USART_Num].Init.Parity       = USART_Config[USART_Num].Parity;
-		USART_Handler[USART_Num].Init.Mode         = UART_MODE_TX_RX;
-		USART_Handler[USART_Num].Init.HwFlowCtl    = UART_HWCONTROL_NONE;
-		USART_Handler[USART_Num].Init.OverSampling = USART_Config[USART_Num].OverSampling;
+static inline uint32_t usart_buff_tx_count(USART_Num_t USART_Num)
+{
+	return (uint32_t)uxQueueMessagesWaiting(USART_Tx_Buffer[USART_Num]);
+}
 
-		/* 6) Initialize hardware via HAL. */
-		if(HAL_UART_Init(&USART_Handler[USART_Num]) != HAL_OK)
-		{
-			USART_Err_Ret = USART_InitFailed;
-		}
+static inline uint8_t usart_buff_rx_put(USART_Num_t USART_Num, uint8_t Data)
+{
+	return (xQueueSend(USART_Rx_Buffer[USART_Num], &Data, 0) == pdPASS);
+}
 
-		if( USART_Err_Ret == USART_InitSuccess)
-		{
-			/* 7) Create TX/RX queues (byte-sized elements). */
-			USART_Tx_Buffer[USART_Num] =  xQueueCreate(USART_MAX_BUFF, sizeof(uint8_t));
-			USART_Rx_Buffer[USART_Num] =  xQueueCreate(USART_MAX_BUFF, sizeof(uint8_t));
+static inline uint8_t usart_buff_rx_put_isr(USART_Num_t USART_Num, uint8_t Data)
+{
+	return (xQueueSendFromISR(USART_Rx_Buffer[USART_Num], &Data, NULL) == pdPASS);
+}
 
-			if( USART_Tx_Buffer[USART_Num] == NULL ||  USART_Rx_Buffer[USART_Num] == NULL)
-			{
-				USART_Err_Ret = USART_CreateBuff_Failed;
-			}
+static inline uint8_t usart_buff_rx_get(USART_Num_t USART_Num, uint8_t *Data)
+{
+	return (xQueueReceive(USART_Rx_Buffer[USART_Num], Data, 0) == pdPASS);
+}
 
-			/* 8) Configure NVIC only if at least one direction uses interrupts. */
-#if  ((USART_RX_INT ==  ENABLE) || (USART_TX_INT ==  ENABLE))
-			HAL_NVIC_SetPriority(USART_IRQ[USART_Num], USART_NVIC_GROUP_PRIORITY, USART_NVIC_SUB_PRIORITY);
-			HAL_NVIC_EnableIRQ(USART_IRQ[USART_Num]);
-#endif
+static inline uint32_t usart_buff_rx_write_isr(USART_Num_t USART_Num, const uint8_t *Data, uint32_t Len)
+{
+	uint32_t count = 0;
 
-			/* 9) Start RX interrupt reception (one byte at a time) if enabled. */
-#if (USART_RX_INT ==  ENABLE)
-			HAL_UART_Receive_IT(&USART_Handler[USART_Num] , &USART_Rx_Byte[USART_Num], 1);
-#endif
+	while((count < Len) && (xQueueSendFromISR(USART_Rx_Buffer[USART_Num], &Data[count], NULL) == pdPASS))
+	{
+		count++;
+	}
+	return count;
+}
 
-			USART_Init_St[USART_Num] = USART_InitSuccess;
-		}
+/* Bulk helpers: the queue backend has no span copy, so these loop per byte. */
+
+static inline uint32_t usart_buff_tx_write(USART_Num_t USART_Num, const uint8_t *Data, uint32_t Len)
+{
+	uint32_t count = 0;
+
+	while((count < Len) && (xQueueSend(USART_Tx_Buffer[USART_Num], &Data[count], 0) == pdPASS))
+	{
+		count++;
 	}
-	return USART_Err_Ret;
+	return count;
 }
 
-/* =========================================================================================
- *                                  USART_RxCyclic()
- * =========================================================================================
- *
- * Polling-based receive "service routine" (used when RX interrupts are disabled).
- *
- * What it does:
- *  - Iterates over all configured USART instances
- *  - For each initialized instance, polls RXNE flag
- *  - While RXNE is set, reads DR (which clears RXNE) and pushes byte to RX queue
- *
- * Why this exists:
- *  - In polling mode, application tasks should NOT touch hardware registers directly.
- *    Instead they read from an RTOS queue; this function performs the HW draining.
- *
- * Call frequency:
- *  - Should be called periodically from a dedicated task or main loop.
- *  - The faster you call it, the less chance of RX overrun if incoming data is fast.
+static inline uint32_t usart_buff_tx_free(USART_Num_t USART_Num)
+{
+	/* FromISR variant: plain read, safe from both task and ISR context. */
+	return (USART_Config[USART_Num].Tx_Buff_Size - (uint32_t)uxQueueMessagesWaitingFromISR(USART_Tx_Buffer[USART_Num]));
+}
+
+static inline uint32_t usart_buff_rx_read(USART_Num_t USART_Num, uint8_t *Data, uint32_t Len)
+{
+	uint32_t count = 0;
+
+	while((count < Len) && (xQueueReceive(USART_Rx_Buffer[USART_Num], &Data[count], 0) == pdPASS))
+	{
+		count++;
+	}
+	return count;
+}
+
+static inline uint32_t usart_buff_rx_count(USART_Num_t USART_Num)
+{
+	return (uint32_t)uxQueueMessagesWaitingFromISR(USART_Rx_Buffer[USART_Num]);
+}
+
+#else /* USART_BUFF_RING */
+
+static inline uint8_t usart_buff_create(USART_Num_t USART_Num)
+{
+	const USART_Config_t *Cfg = &USART_Config[USART_Num];
+
+	/* Ring_Init rejects NULL storage and size 0, so unused ports fail here. */
+	return (USART_Ring_InitMp(&USART_Tx_Buffer[USART_Num], Cfg->Tx_Buff, Cfg->Tx_Buff_Size, Cfg->Tx_Marks) &&
+			USART_Ring_Init(&USART_Rx_Buffer[USART_Num], Cfg->Rx_Buff, Cfg->Rx_Buff_Size));
+}
+
+/*
+ * TX producers are tasks (USART_SendByte / USART_Send / USART_TxCommit), possibly
+ * several on one port: every write reserves its slots atomically and publishes
+ * them in reservation order, so one call's bytes stay contiguous on the wire.
+ * usart_ring_tx_commit() never waits: a range committed while an earlier
+ * reservation is still being filled goes out right after it, once that one is
+ * committed (see USART_Ring.h). Used < Len leaves the rest of the range unsent.
  */
-void USART_RxCyclic(void)
+static inline void usart_ring_tx_commit(USART_Num_t USART_Num, uint32_t Pos, uint32_t Len, uint32_t Used)
 {
-	USART_TypeDef *USART_Instance = NULL ;
+	USART_Ring_Commit(&USART_Tx_Buffer[USART_Num], Pos, Len, Used);
+}
 
-	for(uint8_t usart_num = 0 ; usart_num < USART_MAX_NUM ; usart_num++)
+static inline uint8_t usart_buff_tx_put(USART_Num_t USART_Num, uint8_t Data)
+{
+	uint32_t Pos;
+	uint8_t  ret = USART_Ring_Reserve(&USART_Tx_Buffer[USART_Num], 1U, &Pos);
+
+	if(ret != 0U)
 	{
-		USART_Instance = USART_Handler[usart_num].Instance;
+		USART_Ring_Fill(&USART_Tx_Buffer[USART_Num], Pos, &Data, 1U);
+		usart_ring_tx_commit(USART_Num, Pos, 1U, 1U);
+	}
+	return ret;
+}
 
-		if(USART_Instance != NULL)
-		{
-#if USART_RX_INT == DISABLE
-			/* RXNE = 1 means there is unread data in the receive data register. */
-			while(LL_USART_IsActiveFlag_RXNE(USART_Instance) != RESET)
-			{
-				/* Reading DR returns the received byte and clears RXNE. */
-				USART_Rx_Byte[usart_num] = LL_USART_ReceiveData8(USART_Instance);
+static inline uint8_t usart_buff_tx_get(USART_Num_t USART_Num, uint8_t *Data)
+{
+	return USART_Ring_Get(&USART_Tx_Buffer[USART_Num], Data);
+}
 
-				/* Push received byte into the RTOS queue (non-blocking). */
-				xQueueSend(USART_Rx_Buffer[usart_num] , &USART_Rx_Byte[usart_num] , 0);
-			}
-#endif
-		}
+static inline uint8_t usart_buff_tx_get_isr(USART_Num_t USART_Num, uint8_t *Data)
+{
+	return USART_Ring_Get(&USART_Tx_Buffer[USART_Num], Data);
+}
+
+static inline uint32_t usart_buff_tx_count(USART_Num_t USART_Num)
+{
+	return USART_Ring_Count(&USART_Tx_Buffer[USART_Num]);
+}
+
+static inline uint8_t usart_buff_rx_put(USART_Num_t USART_Num, uint8_t Data)
+{
+	return USART_Ring_Put(&USART_Rx_Buffer[USART_Num], Data);
+}
+
+static inline uint8_t usart_buff_rx_put_isr(USART_Num_t USART_Num, uint8_t Data)
+{
+	return USART_Ring_Put(&USART_Rx_Buffer[USART_Num], Data);
+}
+
+static inline uint8_t usart_buff_rx_get(USART_Num_t USART_Num, uint8_t *Data)
+{
+	return USART_Ring_Get(&USART_Rx_Buffer[USART_Num], Data);
+}
+
+static inline uint32_t usart_buff_rx_write_isr(USART_Num_t USART_Num, const uint8_t *Data, uint32_t Len)
+{
+	return USART_Ring_Write(&USART_Rx_Buffer[USART_Num], Data, Len);
+}
+
+/* Bulk helpers: at most two memcpy per call (before/after the wrap point). */
+
+/* Spans that fit the buffer go in whole or not at all; longer ones stream in as room frees up. */
+static inline uint32_t usart_buff_tx_write(USART_Num_t USART_Num, const uint8_t *Data, uint32_t Len)
+{
+	USART_Ring_t *Ring = &USART_Tx_Buffer[USART_Num];
+	uint32_t      Span = Len;
+	uint32_t      Pos;
+
+	if(Span > (Ring->Mask + 1U))
+	{
+		Span = USART_Ring_Free(Ring);
+	}
+
+	if(USART_Ring_Reserve(Ring, Span, &Pos) == 0U)
+	{
+		Span = 0;
+	}
+	else
+	{
+		USART_Ring_Fill(Ring, Pos, Data, Span);
+		usart_ring_tx_commit(USART_Num, Pos, Span, Span);
 	}
+	return Span;
 }
 
-/* =========================================================================================
- *                                  USART_TxCyclic()
- * =========================================================================================
- *
- * Polling-based transmit "service routine" (used when TX interrupts are disabled).
+static inline uint32_t usart_buff_tx_free(USART_Num_t USART_Num)
+{
+	return USART_Ring_Free(&USART_Tx_Buffer[USART_Num]);
+}
+
+static inline uint32_t usart_buff_rx_read(USART_Num_t USART_Num, uint8_t *Data, uint32_t Len)
+{
+	return USART_Ring_Read(&USART_Rx_Buffer[USART_Num], Data, Len);
+}
+
+static inline uint32_t usart_buff_rx_count(USART_Num_t USART_Num)
+{
+	return USART_Ring_Count(&USART_Rx_Buffer[USART_Num]);
+}
+
+#endif /* USART_BUFF_BACKEND */
+
+/*
+ * usart_get_num():
+ *  - Maps a HAL handle instance to the driver logical USART number (ISR/callback use).
+ */
+static inline USART_Num_t usart_get_num(const UART_HandleTypeDef *huart)
+{
+	/* USART_Handler[] is indexed by logical number: pointer difference gives the index. */
+	return (USART_Num_t)(huart - USART_Handler);
+}
+
+/*
+ * Statistics helpers (no-ops with USART_STATS == DISABLE):
  *
- * What it does:
- *  - Iterates over all USART instances
+ * usart_stat_rx():        Got bytes taken from the hardware, Dropped of them lost (RX full)
+ * usart_stat_tx():        Sent bytes handed to the transmitter (DR or DMA)
+ * usart_stat_sr():        line errors flagged in a USART SR snapshot (read before DR)
+ * usart_stat_hal_err():   line errors reported by HAL in huart->ErrorCode
+ * usart_stat_rx_level():  track the RX buffer high-water mark
+ * usart_stat_tx_level():  track the TX buffer high-water mark
+ */
+static inline void usart_stat_rx(USART_Num_t USART_Num, uint32_t Got, uint32_t Dropped)
+{
+#if (USART_STATS == ENABLE)
+	USART_Stats[USART_Num].Rx_Bytes += Got;
+	USART_Stats[USART_Num].Rx_Drops += Dropped;
+#else
+	(void)USART_Num;
+	(void)Got;
+	(void)Dropped;
+#endif
+}
+
+static inline void usart_stat_tx(USART_Num_t USART_Num, uint32_t Sent)
+{
+#if (USART_STATS == ENABLE)
+	USART_Stats[USART_Num].Tx_Bytes += Sent;
+#else
+	(void)USART_Num;
+	(void)Sent;
+#endif
+}
+
+static inline void usart_stat_sr(USART_Num_t USART_Num, uint32_t Sr)
+{
+#if (USART_STATS == ENABLE)
+	if((Sr & (USART_SR_ORE | USART_SR_FE | USART_SR_NE | USART_SR_PE)) != 0U)
+	{
+		USART_Stats[USART_Num].Overrun += ((Sr & USART_SR_ORE) != 0U);
+		USART_Stats[USART_Num].Framing += ((Sr & USART_SR_FE) != 0U);
+		USART_Stats[USART_Num].Noise   += ((Sr & USART_SR_NE) != 0U);
+		USART_Stats[USART_Num].Parity  += ((Sr & USART_SR_PE) != 0U);
+	}
+#else
+	(void)USART_Num;
+	(void)Sr;
+#endif
+}
+
+static inline void usart_stat_hal_err(USART_Num_t USART_Num, uint32_t Error_Code)
+{
+#if (USART_STATS == ENABLE)
+	USART_Stats[USART_Num].Overrun += ((Error_Code & HAL_UART_ERROR_ORE) != 0U);
+	USART_Stats[USART_Num].Framing += ((Error_Code & HAL_UART_ERROR_FE) != 0U);
+	USART_Stats[USART_Num].Noise   += ((Error_Code & HAL_UART_ERROR_NE) != 0U);
+	USART_Stats[USART_Num].Parity  += ((Error_Code & HAL_UART_ERROR_PE) != 0U);
+#else
+	(void)USART_Num;
+	(void)Error_Code;
+#endif
+}
+
+static inline void usart_stat_rx_level(USART_Num_t USART_Num)
+{
+#if (USART_STATS == ENABLE)
+	uint32_t Level = usart_buff_rx_count(USART_Num);
+
+	if(Level > USART_Stats[USART_Num].Rx_High_Water)
+	{
+		USART_Stats[USART_Num].Rx_High_Water = Level;
+	}
+#else
+	(void)USART_Num;
+#endif
+}
+
+static inline void usart_stat_tx_level(USART_Num_t USART_Num)
+{
+#if (USART_STATS == ENABLE)
+	uint32_t           Level = usart_buff_tx_count(USART_Num);
+	volatile uint32_t *Max   = &USART_Stats[USART_Num].Tx_High_Water;
+	uint32_t           Old;
+
+	/* Several tasks may send on the port: a plain store could lower the mark. */
+	do
+	{
+		Old = *Max;
+	} while((Level > Old) && (USART_Atomic_Cas(Max, Old, Level) == 0U));
+#else
+	(void)USART_Num;
+#endif
+}
+
+/*
+ * Profiling probes (compiled out with USART_PROFILE == DISABLE):
+ *
+ * USART_PROF_START(Var):              latch DWT->CYCCNT into a new local Var
+ * USART_PROF_STOP(Num, Point, Var):   book the cycles since Var for (port, point)
+ *
+ * Nested probes (callbacks inside an IRQ probe) use their own locals; the outer
+ * probe includes the inner sections. Out-of-range ports (rejected calls) are ignored.
+ */
+#if (USART_PROFILE == ENABLE)
+#define USART_PROF_START(Var)               uint32_t Var = DWT->CYCCNT
+#define USART_PROF_STOP(Num, Point, Var)    usart_prof_record((Num), (Point), DWT->CYCCNT - (Var))
+
+static void usart_prof_record(USART_Num_t USART_Num, USART_Prof_Point_t Point, uint32_t Cycles)
+{
+	if(USART_Num < USART_MAX_NUM)
+	{
+		USART_Prof_t *Prof = &USART_Prof[USART_Num][Point];
+		uint32_t      Bin  = (Cycles < 2U) ? 0U : (31U - (uint32_t)__builtin_clz(Cycles));
+
+		if((Prof->Count == 0U) || (Cycles < Prof->Min))
+		{
+			Prof->Min = Cycles;
+		}
+		if(Cycles > Prof->Max)
+		{
+			Prof->Max = Cycles;
+		}
+		Prof->Total += Cycles;
+		Prof->Count++;
+		Prof->Hist[(Bin < USART_PROF_BINS) ? Bin : (USART_PROF_BINS - 1U)]++;
+	}
+}
+#else
+#define USART_PROF_START(Var)
+#define USART_PROF_STOP(Num, Point, Var)
+#endif
+
+/* =========================================================================================
+ *                              Blocked-Task Wake-up Helpers
+ * =========================================================================================
+ *
+ * usart_wake() / usart_wake_isr():
+ *  - Notify and release the task parked in *Waiter (if any). The ISR variant
+ *    requests a context switch on exit when the woken task has higher priority.
+ *
+ * usart_event() / usart_event_isr():
+ *  - Set event bits in the registered consumer task (USART_SetEventTask).
+ *
+ * usart_rx_signal() / usart_rx_signal_isr():
+ *  - New RX data: wake USART_Receive() waiter and raise USART_EVT_RX.
+ *  - Software RTS: deassert RTS once the RX buffer reaches Rts_High_Water.
+ *  - XON/XOFF: queue XOFF above Xoff_High_Water, restart TX after a received XON.
+ *
+ * usart_tx_space() / usart_tx_space_isr():
+ *  - Wake the TX waiter once enough TX space is free (see USART_Tx_Wait_Need).
+ *
+ * usart_tx_idle() / usart_tx_idle_isr():
+ *  - TX buffer fully drained: raise USART_EVT_TX.
+ */
+static inline void usart_wake(TaskHandle_t volatile *Waiter)
+{
+	TaskHandle_t Task = *Waiter;
+
+	if(Task != NULL)
+	{
+		*Waiter = NULL;
+		(void)xTaskNotifyGiveIndexed(Task, USART_NOTIFY_INDEX);
+	}
+}
+
+static inline void usart_wake_isr(TaskHandle_t volatile *Waiter)
+{
+	TaskHandle_t Task = *Waiter;
+	BaseType_t   Higher_Prio_Woken = pdFALSE;
+
+	if(Task != NULL)
+	{
+		*Waiter = NULL;
+		vTaskNotifyGiveIndexedFromISR(Task, USART_NOTIFY_INDEX, &Higher_Prio_Woken);
+		portYIELD_FROM_ISR(Higher_Prio_Woken);
+	}
+}
+
+static inline void usart_event(USART_Num_t USART_Num, uint32_t Events)
+{
+	TaskHandle_t Task = USART_Event_Task[USART_Num];
+
+	if(Task != NULL)
+	{
+		(void)xTaskNotifyIndexed(Task, USART_EVENT_NOTIFY_INDEX, Events, eSetBits);
+	}
+}
+
+static inline void usart_event_isr(USART_Num_t USART_Num, uint32_t Events)
+{
+	TaskHandle_t Task = USART_Event_Task[USART_Num];
+	BaseType_t   Higher_Prio_Woken = pdFALSE;
+
+	if(Task != NULL)
+	{
+		(void)xTaskNotifyIndexedFromISR(Task, USART_EVENT_NOTIFY_INDEX, Events, eSetBits, &Higher_Prio_Woken);
+		portYIELD_FROM_ISR(Higher_Prio_Woken);
+	}
+}
+
+/*
+ * usart_rts_throttle() / usart_rts_release():
+ *  - Software RTS watermark (USART_SW_RTS). RTS is active low: SET = "stop sending".
+ *  - throttle runs on the RX producer side after new data was buffered.
+ *  - release runs on the reading side after data was taken out. It re-checks the
+ *    level inside a critical section so a producer ISR cannot throttle in between
+ *    and leave RTS asserted with a full buffer.
+ */
+static inline void usart_rts_throttle(USART_Num_t USART_Num)
+{
+#if (USART_SW_RTS == ENABLE)
+	uint32_t High_Water = USART_Config[USART_Num].Rts_High_Water;
+
+	if((High_Water != 0U) && (USART_Rts_Throttled[USART_Num] == 0U) && (usart_buff_rx_count(USART_Num) >= High_Water))
+	{
+		USART_Rts_Throttled[USART_Num] = 1U;
+		HAL_GPIO_WritePin(USART_Pin_Config[USART_Num].Rts_Port, USART_Pin_Config[USART_Num].Rts_Pin, GPIO_PIN_SET);
+	}
+#else
+	(void)USART_Num;
+#endif
+}
+
+static inline void usart_rts_release(USART_Num_t USART_Num)
+{
+#if (USART_SW_RTS == ENABLE)
+	if(USART_Rts_Throttled[USART_Num] != 0U)
+	{
+		taskENTER_CRITICAL();
+		if((USART_Rts_Throttled[USART_Num] != 0U) && (usart_buff_rx_count(USART_Num) <= USART_Config[USART_Num].Rts_Low_Water))
+		{
+			USART_Rts_Throttled[USART_Num] = 0U;
+			HAL_GPIO_WritePin(USART_Pin_Config[USART_Num].Rts_Port, USART_Pin_Config[USART_Num].Rts_Pin, GPIO_PIN_RESET);
+		}
+		taskEXIT_CRITICAL();
+	}
+#else
+	(void)USART_Num;
+#endif
+}
+
+#if (USART_XON_XOFF == ENABLE)
+/* XON/XOFF hooks, defined after usart_tx_kick() which they use. */
+static void usart_xonxoff_rx_check(USART_Num_t USART_Num);
+static void usart_xonxoff_rx_check_isr(USART_Num_t USART_Num);
+#endif
+
+static inline void usart_rx_signal(USART_Num_t USART_Num)
+{
+	/* Task-level producer (USART_RxCyclic): keep the check atomic against the reader. */
+#if (USART_SW_RTS == ENABLE)
+	taskENTER_CRITICAL();
+	usart_rts_throttle(USART_Num);
+	taskEXIT_CRITICAL();
+#endif
+#if (USART_XON_XOFF == ENABLE)
+	usart_xonxoff_rx_check(USART_Num);
+#endif
+	usart_stat_rx_level(USART_Num);
+	usart_wake(&USART_Rx_Waiter[USART_Num]);
+	usart_event(USART_Num, USART_EVT_RX(USART_Num));
+}
+
+static inline void usart_rx_signal_isr(USART_Num_t USART_Num)
+{
+	usart_rts_throttle(USART_Num);
+#if (USART_XON_XOFF == ENABLE)
+	usart_xonxoff_rx_check_isr(USART_Num);
+#endif
+	usart_stat_rx_level(USART_Num);
+	usart_wake_isr(&USART_Rx_Waiter[USART_Num]);
+	usart_event_isr(USART_Num, USART_EVT_RX(USART_Num));
+}
+
+static inline void usart_tx_idle(USART_Num_t USART_Num)
+{
+	usart_event(USART_Num, USART_EVT_TX(USART_Num));
+}
+
+static inline void usart_tx_idle_isr(USART_Num_t USART_Num)
+{
+	usart_event_isr(USART_Num, USART_EVT_TX(USART_Num));
+}
+
+static inline void usart_tx_space(USART_Num_t USART_Num)
+{
+	if((USART_Tx_Waiter[USART_Num] != NULL) && (usart_buff_tx_free(USART_Num) >= USART_Tx_Wait_Need[USART_Num]))
+	{
+		usart_wake(&USART_Tx_Waiter[USART_Num]);
+	}
+}
+
+static inline void usart_tx_space_isr(USART_Num_t USART_Num)
+{
+	if((USART_Tx_Waiter[USART_Num] != NULL) && (usart_buff_tx_free(USART_Num) >= USART_Tx_Wait_Need[USART_Num]))
+	{
+		usart_wake_isr(&USART_Tx_Waiter[USART_Num]);
+	}
+}
+
+/*
+ * usart_tx_dma_busy():
+ *  - 1 while a USART_SendBuffer() transfer owns the transmitter (always 0 without TX DMA).
+ */
+static inline uint8_t usart_tx_dma_busy(USART_Num_t USART_Num)
+{
+#if (USART_TX_DMA == ENABLE)
+	return USART_Tx_DMA_Busy[USART_Num];
+#else
+	(void)USART_Num;
+	return 0;
+#endif
+}
+
+/*
+ * usart_tx_next() / usart_tx_next_isr():
+ *  - Fetch the next byte to put on the wire. A pending XON/XOFF goes first, and
+ *    buffered data is held back while the peer has us paused with XOFF.
+ *  - Without USART_XON_XOFF these are plain TX buffer reads.
+ *  - The task variant claims USART_Flow_Char in a critical section because an RX
+ *    ISR may replace it at any time.
+ *
+ * usart_tx_pending():
+ *  - 1 if usart_tx_next() would return a byte right now.
+ *
+ * usart_tx_paused():
+ *  - 1 while a byte may not bypass the TX buffer (XOFF received, or XON/XOFF queued).
+ */
+static inline uint8_t usart_tx_next(USART_Num_t USART_Num, uint8_t *Data)
+{
+#if (USART_XON_XOFF == ENABLE)
+	uint8_t Flow_Char = 0;
+
+	if(USART_Flow_Char[USART_Num] != 0U)
+	{
+		taskENTER_CRITICAL();
+		Flow_Char = USART_Flow_Char[USART_Num];
+		USART_Flow_Char[USART_Num] = 0U;
+		taskEXIT_CRITICAL();
+	}
+
+	if(Flow_Char != 0U)
+	{
+		*Data = Flow_Char;
+		usart_stat_tx(USART_Num, 1U);
+		return 1;
+	}
+	if(USART_Xoff_Rcvd[USART_Num] != 0U)
+	{
+		return 0;
+	}
+#endif
+	if(usart_buff_tx_get(USART_Num, Data) == 0)
+	{
+		return 0;
+	}
+	usart_stat_tx(USART_Num, 1U);
+	return 1;
+}
+
+static inline uint8_t usart_tx_next_isr(USART_Num_t USART_Num, uint8_t *Data)
+{
+#if (USART_XON_XOFF == ENABLE)
+	if(USART_Flow_Char[USART_Num] != 0U)
+	{
+		*Data = USART_Flow_Char[USART_Num];
+		USART_Flow_Char[USART_Num] = 0U;
+		usart_stat_tx(USART_Num, 1U);
+		return 1;
+	}
+	if(USART_Xoff_Rcvd[USART_Num] != 0U)
+	{
+		return 0;
+	}
+#endif
+	if(usart_buff_tx_get_isr(USART_Num, Data) == 0)
+	{
+		return 0;
+	}
+	usart_stat_tx(USART_Num, 1U);
+	return 1;
+}
+
+static inline uint8_t usart_tx_pending(USART_Num_t USART_Num)
+{
+#if (USART_XON_XOFF == ENABLE)
+	if(USART_Flow_Char[USART_Num] != 0U)
+	{
+		return 1;
+	}
+	if(USART_Xoff_Rcvd[USART_Num] != 0U)
+	{
+		return 0;
+	}
+#endif
+	return (usart_buff_tx_count(USART_Num) != 0U);
+}
+
+static inline uint8_t usart_tx_paused(USART_Num_t USART_Num)
+{
+#if (USART_XON_XOFF == ENABLE)
+	return ((USART_Xoff_Rcvd[USART_Num] != 0U) || (USART_Flow_Char[USART_Num] != 0U));
+#else
+	(void)USART_Num;
+	return 0;
+#endif
+}
+
+/*
+ * usart_rx_filter():
+ *  - XON/XOFF: consume flow control characters from the peer (they never reach the
+ *    RX buffer) and update USART_Xoff_Rcvd. Returns 1 for a data byte.
+ *  - TX is restarted after XON by usart_xonxoff_rx_check*() via usart_rx_signal*().
+ *
+ * usart_rx_store() / usart_rx_store_isr() / usart_rx_store_chunk_isr():
+ *  - Deliver received data bytes to the RX hook (USART_SetRxHook) if one is
+ *    registered, else into the RX buffer. Return what was stored (0 / count short
+ *    of Len = dropped because the buffer is full); the hook takes everything.
+ *
+ * usart_rx_write_isr():
+ *  - Chunk variant for RX DMA: stores the data between flow control characters.
+ */
+static inline uint8_t usart_rx_filter(USART_Num_t USART_Num, uint8_t Data)
+{
+#if (USART_XON_XOFF == ENABLE)
+	if(USART_Config[USART_Num].Xoff_High_Water != 0U)
+	{
+		if(Data == USART_XOFF_CHAR)
+		{
+			USART_Xoff_Rcvd[USART_Num] = 1U;
+			return 0;
+		}
+		if(Data == USART_XON_CHAR)
+		{
+			USART_Xoff_Rcvd[USART_Num] = 0U;
+			return 0;
+		}
+	}
+#else
+	(void)USART_Num;
+	(void)Data;
+#endif
+	return 1;
+}
+
+static inline uint8_t usart_rx_store(USART_Num_t USART_Num, uint8_t Data)
+{
+	USART_RxHook_t Hook = USART_Rx_Hook[USART_Num];
+	uint8_t        ret  = 1;
+
+	if(Hook != NULL)
+	{
+		Hook(USART_Num, &Data, 1U);
+	}
+	else
+	{
+		ret = usart_buff_rx_put(USART_Num, Data);
+	}
+	return ret;
+}
+
+static inline uint8_t usart_rx_store_isr(USART_Num_t USART_Num, uint8_t Data)
+{
+	USART_RxHook_t Hook = USART_Rx_Hook[USART_Num];
+	uint8_t        ret  = 1;
+
+	if(Hook != NULL)
+	{
+		Hook(USART_Num, &Data, 1U);
+	}
+	else
+	{
+		ret = usart_buff_rx_put_isr(USART_Num, Data);
+	}
+	return ret;
+}
+
+#if (USART_RX_DMA == ENABLE)
+static inline uint32_t usart_rx_store_chunk_isr(USART_Num_t USART_Num, const uint8_t *Data, uint32_t Len)
+{
+	USART_RxHook_t Hook = USART_Rx_Hook[USART_Num];
+	uint32_t       ret  = Len;
+
+	if(Hook != NULL)
+	{
+		if(Len != 0U)
+		{
+			/* Whole DMA chunk in one call: the consumer parses it in place. */
+			Hook(USART_Num, Data, Len);
+		}
+	}
+	else
+	{
+		ret = usart_buff_rx_write_isr(USART_Num, Data, Len);
+	}
+	return ret;
+}
+
+static inline void usart_rx_write_isr(USART_Num_t USART_Num, const uint8_t *Data, uint32_t Len)
+{
+	uint32_t Dropped = 0;
+
+	usart_stat_rx(USART_Num, Len, 0U);
+
+#if (USART_XON_XOFF == ENABLE)
+	uint32_t Start = 0;
+
+	if(USART_Config[USART_Num].Xoff_High_Water != 0U)
+	{
+		for(uint32_t Idx = 0; Idx < Len; Idx++)
+		{
+			if(usart_rx_filter(USART_Num, Data[Idx]) == 0)
+			{
+				Dropped += (Idx - Start) - usart_rx_store_chunk_isr(USART_Num, &Data[Start], Idx - Start);
+				Start = Idx + 1U;
+			}
+		}
+		Data = &Data[Start];
+		Len -= Start;
+	}
+#endif
+	Dropped += Len - usart_rx_store_chunk_isr(USART_Num, Data, Len);
+	usart_stat_rx(USART_Num, 0U, Dropped);
+}
+#endif
+
+#if (USART_TX_INT == DISABLE)
+/*
+ * usart_tx_drain():
+ *  - Polling TX helper: moves bytes from the TX buffer into DR while TXE is set.
+ *  - Called from both USART_SendByte() and USART_TxCyclic(), i.e. possibly from two
+ *    different tasks. The SPSC ring allows only ONE consumer, so the drain runs with
+ *    the scheduler suspended (tasks only, interrupts stay enabled).
+ */
+static void usart_tx_drain(USART_Num_t USART_Num, USART_TypeDef *USART_Instance)
+{
+	uint8_t Drained = 0;
+
+#if (USART_BUFF_BACKEND == USART_BUFF_RING)
+	vTaskSuspendAll();
+#endif
+
+	while((LL_USART_IsActiveFlag_TXE(USART_Instance) != RESET) &&
+		  (usart_tx_dma_busy(USART_Num) == 0) &&
+		  usart_tx_next(USART_Num, &USART_Tx_Byte[USART_Num]))
+	{
+		/* Write byte to DR -> starts hardware transmission. */
+		LL_USART_TransmitData8(USART_Instance, USART_Tx_Byte[USART_Num]);
+		Drained = 1;
+	}
+
+#if (USART_BUFF_BACKEND == USART_BUFF_RING)
+	(void)xTaskResumeAll();
+#endif
+
+	if(Drained != 0)
+	{
+		usart_tx_space(USART_Num);
+
+		if(usart_buff_tx_count(USART_Num) == 0)
+		{
+			usart_tx_idle(USART_Num);
+		}
+	}
+}
+#endif
+
+/* =========================================================================================
+ *                                   TX State Machine
+ * =========================================================================================
+ *
+ * USART_Tx_State[] tells who owns the transmitter (interrupt TX mode, and TX DMA):
+ *
+ *   IDLE      : nothing in flight, TX interrupts disarmed.
+ *   ACTIVE    : an IT chain / armed TXE interrupt / USART_SendBuffer() DMA owns it.
+ *   DRAINING  : the owner found nothing to send and is letting go. A producer that
+ *               sees it hands the port back (DRAINING -> ACTIVE) so the owner keeps
+ *               going, instead of starting a second chain.
+ *   SUSPENDED : idle, but buffered bytes are held back by an XOFF from the peer. The
+ *               kick after XON (or for a queued XON/XOFF) restarts from here.
+ *
+ * Producers take IDLE / SUSPENDED -> ACTIVE with USART_Atomic_Cas() (LDREX / STREX),
+ * so starting TX from a task no longer needs taskENTER_CRITICAL(), which masks every
+ * interrupt up to configMAX_SYSCALL_INTERRUPT_PRIORITY. Only the owner leaves ACTIVE.
+ * Polling TX mode uses the states only to hand the transmitter to a DMA transfer.
+ *
+ * usart_tx_claim():
+ *  - Producer side, after publishing data. Returns 1 if the caller won the
+ *    transmitter and must start it, 0 if a running chain picks the data up (or the
+ *    line may not send anything right now).
+ *
+ * usart_tx_release():
+ *  - Owner side, nothing left to send: ACTIVE -> DRAINING, re-check, then IDLE or
+ *    SUSPENDED. Returns 1 if data turned up meanwhile: the caller still owns the
+ *    transmitter and must keep sending.
+ */
+#if (USART_TX_INT == ENABLE)
+static uint8_t usart_tx_claim(USART_Num_t USART_Num)
+{
+	volatile uint32_t *State = &USART_Tx_State[USART_Num];
+	uint32_t           Seen;
+	uint8_t            Start = 0;
+	uint8_t            Done  = 0;
+
+	/* Buffer publish before the state read. */
+	__DMB();
+
+	while(Done == 0U)
+	{
+		Seen = *State;
+		if((Seen == USART_TX_ACTIVE) || (usart_tx_pending(USART_Num) == 0U))
+		{
+			Done = 1;
+		}
+		else if(Seen == USART_TX_DRAINING)
+		{
+			Done = USART_Atomic_Cas(State, USART_TX_DRAINING, USART_TX_ACTIVE);
+		}
+		else if(USART_Atomic_Cas(State, Seen, USART_TX_ACTIVE))
+		{
+			Start = 1;
+			Done  = 1;
+		}
+	}
+	return Start;
+}
+
+static uint8_t usart_tx_release(USART_Num_t USART_Num)
+{
+	volatile uint32_t *State = &USART_Tx_State[USART_Num];
+	uint32_t           Rest;
+	uint8_t            Again = 1;
+
+	/* TX interrupt disarm (fast ISR) before the state change. */
+	__DMB();
+	*State = USART_TX_DRAINING;
+	__DMB();
+
+	if(usart_tx_pending(USART_Num) == 0U)
+	{
+		Rest  = (usart_buff_tx_count(USART_Num) != 0U) ? USART_TX_SUSPENDED : USART_TX_IDLE;
+
+		/* Fails only if a producer handed the port back (DRAINING -> ACTIVE). */
+		Again = (USART_Atomic_Cas(State, USART_TX_DRAINING, Rest) == 0U);
+	}
+	else
+	{
+		*State = USART_TX_ACTIVE;
+	}
+	return Again;
+}
+#endif
+
+#if (USART_TX_INT == ENABLE) && (USART_FAST_ISR == DISABLE)
+/*
+ * usart_tx_chain() / usart_tx_chain_isr():
+ *  - HAL IT path, transmitter owner only: start the next byte as a one-byte
+ *    HAL_UART_Transmit_IT(), or let go of the transmitter. Returns 1 if a byte went out.
+ *  - HAL_UART_Transmit_IT() updates the handle and CR1 with plain read-modify-writes,
+ *    as does the port's own IRQ (RX side). The task variant holds off that one IRQ
+ *    while it runs; every other interrupt keeps running.
+ */
+static uint8_t usart_tx_chain(USART_Num_t USART_Num)
+{
+	uint8_t Sending = 0;
+
+	HAL_NVIC_DisableIRQ(USART_IRQ[USART_Num]);
+	do
+	{
+		Sending = usart_tx_next(USART_Num, &USART_Tx_Byte[USART_Num]);
+		if(Sending != 0U)
+		{
+			HAL_UART_Transmit_IT(&USART_Handler[USART_Num], &USART_Tx_Byte[USART_Num], 1);
+		}
+	} while((Sending == 0U) && usart_tx_release(USART_Num));
+	HAL_NVIC_EnableIRQ(USART_IRQ[USART_Num]);
+
+	return Sending;
+}
+
+static uint8_t usart_tx_chain_isr(USART_Num_t USART_Num)
+{
+	uint8_t Sending = 0;
+
+	do
+	{
+		Sending = usart_tx_next_isr(USART_Num, &USART_Tx_Byte[USART_Num]);
+		if(Sending != 0U)
+		{
+			HAL_UART_Transmit_IT(&USART_Handler[USART_Num], &USART_Tx_Byte[USART_Num], 1);
+		}
+	} while((Sending == 0U) && usart_tx_release(USART_Num));
+
+	return Sending;
+}
+#endif
+
+/*
+ * usart_tx_kick():
+ *  - Makes sure buffered TX bytes are moving after a task added data.
+ *  - Interrupt TX mode: if the transmitter is idle, claim it (usart_tx_claim) and
+ *    start it: arm TXEIE for the fast ISR (LL does that with LDREX / STREX on CR1),
+ *    else send the first byte through the HAL. If a chain is running, nothing to do.
+ *  - Polling TX mode: drain into DR as far as TXE allows.
+ */
+static void usart_tx_kick(USART_Num_t USART_Num)
+{
+#if (USART_TX_INT == ENABLE)
+	if(usart_tx_claim(USART_Num))
+	{
+#if (USART_FAST_ISR == ENABLE)
+		/* Fast ISR: just arm TXE, the ISR pulls bytes from the buffer itself. */
+		LL_USART_EnableIT_TXE(USART_Handler[USART_Num].Instance);
+#else
+		(void)usart_tx_chain(USART_Num);
+#endif
+	}
+#else
+	usart_tx_drain(USART_Num, USART_Handler[USART_Num].Instance);
+#endif
+}
+
+#if (USART_XON_XOFF == ENABLE)
+/* =========================================================================================
+ *                              XON/XOFF Software Flow Control
+ * =========================================================================================
+ *
+ * usart_tx_kick_isr():
+ *  - ISR-side usart_tx_kick(): start the IT chain / arm TXE for a pending XON/XOFF or
+ *    for data released by XON (SUSPENDED -> ACTIVE). Polling TX needs nothing, the
+ *    next drain sends it.
+ *    USART and DMA IRQs share one priority, so no other TX ISR can run in between.
+ *
+ * usart_xonxoff_rx_check() / usart_xonxoff_rx_check_isr():
+ *  - RX producer side: queue XOFF once the RX buffer reaches Xoff_High_Water and
+ *    restart TX (covers both the queued XOFF and a received XON).
+ *
+ * usart_xon_release():
+ *  - Reader side: queue XON once the RX buffer drained to Xon_Low_Water.
+ *
+ * NOTE:
+ *  - XON (0x11) / XOFF (0x13) are removed from the RX stream, so this mode is for
+ *    text protocols only. An in-flight USART_SendBuffer() DMA transfer is not paused.
+ */
+static void usart_tx_kick_isr(USART_Num_t USART_Num)
+{
+#if (USART_TX_INT == ENABLE) && (USART_FAST_ISR == ENABLE)
+	if(usart_tx_claim(USART_Num))
+	{
+		LL_USART_EnableIT_TXE(USART_Handler[USART_Num].Instance);
+	}
+#elif (USART_TX_INT == ENABLE)
+	if(usart_tx_claim(USART_Num))
+	{
+		(void)usart_tx_chain_isr(USART_Num);
+	}
+#else
+	(void)USART_Num;
+#endif
+}
+
+/* Returns 1 if the RX buffer just crossed the high mark and XOFF was queued. */
+static inline uint8_t usart_xoff_throttle(USART_Num_t USART_Num)
+{
+	uint32_t High_Water = USART_Config[USART_Num].Xoff_High_Water;
+	uint8_t  Queued = 0;
+
+	if((USART_Xoff_Sent[USART_Num] == 0U) && (usart_buff_rx_count(USART_Num) >= High_Water))
+	{
+		USART_Xoff_Sent[USART_Num] = 1U;
+		USART_Flow_Char[USART_Num] = USART_XOFF_CHAR;
+		Queued = 1;
+	}
+	return Queued;
+}
+
+static void usart_xonxoff_rx_check(USART_Num_t USART_Num)
+{
+	if(USART_Config[USART_Num].Xoff_High_Water != 0U)
+	{
+		taskENTER_CRITICAL();
+		(void)usart_xoff_throttle(USART_Num);
+		taskEXIT_CRITICAL();
+
+		usart_tx_kick(USART_Num);
+	}
+}
+
+static void usart_xonxoff_rx_check_isr(USART_Num_t USART_Num)
+{
+	if(USART_Config[USART_Num].Xoff_High_Water != 0U)
+	{
+		(void)usart_xoff_throttle(USART_Num);
+		usart_tx_kick_isr(USART_Num);
+	}
+}
+
+static void usart_xon_release(USART_Num_t USART_Num)
+{
+	uint8_t Queued = 0;
+
+	if(USART_Xoff_Sent[USART_Num] != 0U)
+	{
+		taskENTER_CRITICAL();
+		if((USART_Xoff_Sent[USART_Num] != 0U) && (usart_buff_rx_count(USART_Num) <= USART_Config[USART_Num].Xon_Low_Water))
+		{
+			USART_Xoff_Sent[USART_Num] = 0U;
+			USART_Flow_Char[USART_Num] = USART_XON_CHAR;
+			Queued = 1;
+		}
+		taskEXIT_CRITICAL();
+
+		if(Queued != 0)
+		{
+			usart_tx_kick(USART_Num);
+		}
+	}
+}
+#endif
+
+/*
+ * usart_ms_to_ticks():
+ *  - Converts a driver timeout (ms) to ticks; USART_WAIT_FOREVER maps to portMAX_DELAY.
+ *    64-bit math so large timeouts do not overflow like pdMS_TO_TICKS() would.
+ */
+static inline TickType_t usart_ms_to_ticks(uint32_t Timeout_Ms)
+{
+	TickType_t Ticks = portMAX_DELAY;
+
+	if(Timeout_Ms != USART_WAIT_FOREVER)
+	{
+		Ticks = (TickType_t)(((uint64_t)Timeout_Ms * configTICK_RATE_HZ) / 1000U);
+	}
+	return Ticks;
+}
+
+/*
+ * usart_wait_tx() / usart_wait_rx():
+ *  - Park the calling task until TX space / RX data is available or the timeout
+ *    (tracked by Time_Out / Ticks_Left across several waits) expires.
+ *  - Sequence: drop stale notifications -> publish waiter -> re-check condition ->
+ *    sleep. The re-check closes the race with an ISR that ran before publishing.
+ *  - TX: Need is the free space the caller waits for (<= Tx_Buff_Size). There is one
+ *    waiter slot per port; when another sending task already holds it, the caller
+ *    is not published and re-checks every tick instead.
+ *  - Before the scheduler runs, or while it is suspended, a task cannot block:
+ *    both return 0 at once, so the caller reports a timeout instead of sleeping.
+ *  - Return 1 if the caller should retry, 0 on timeout.
+ */
+static uint8_t usart_wait_tx(USART_Num_t USART_Num, uint32_t Need, TimeOut_t *Time_Out, TickType_t *Ticks_Left)
+{
+	uint8_t      Retry = 1;
+	TickType_t   Ticks;
+	TaskHandle_t Self  = xTaskGetCurrentTaskHandle();
+	uint8_t      Owner = 0;
+
+	if(xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+	{
+		return 0;
+	}
+
+	(void)ulTaskNotifyTakeIndexed(USART_NOTIFY_INDEX, pdTRUE, 0);
+
+	taskENTER_CRITICAL();
+	if(USART_Tx_Waiter[USART_Num] == NULL)
+	{
+		USART_Tx_Wait_Need[USART_Num] = Need;
+		USART_Tx_Waiter[USART_Num]    = Self;
+		Owner = 1;
+	}
+	taskEXIT_CRITICAL();
+
+	if(usart_buff_tx_free(USART_Num) < Need)
+	{
+		if(xTaskCheckForTimeOut(Time_Out, Ticks_Left) != pdFALSE)
+		{
+			Retry = 0;
+		}
+		else
+		{
+			Ticks = *Ticks_Left;
+			/*
+			 * Nobody may wake us: another task holds the waiter slot, or polling TX
+			 * (nobody may be running USART_TxCyclic()). Drain / re-check after a tick.
+			 */
+			if(((Owner == 0U) || (USART_TX_INT == DISABLE)) && (Ticks > 1U))
+			{
+				Ticks = 1U;
+			}
+			(void)ulTaskNotifyTakeIndexed(USART_NOTIFY_INDEX, pdTRUE, Ticks);
+		}
+	}
+
+	/* The waker clears the slot itself; only release it if it is still ours. */
+	taskENTER_CRITICAL();
+	if(USART_Tx_Waiter[USART_Num] == Self)
+	{
+		USART_Tx_Waiter[USART_Num] = NULL;
+	}
+	taskEXIT_CRITICAL();
+
+	return Retry;
+}
+
+static uint8_t usart_wait_rx(USART_Num_t USART_Num, TimeOut_t *Time_Out, TickType_t *Ticks_Left)
+{
+	uint8_t Retry = 1;
+
+	if(xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+	{
+		return 0;
+	}
+
+	(void)ulTaskNotifyTakeIndexed(USART_NOTIFY_INDEX, pdTRUE, 0);
+	USART_Rx_Waiter[USART_Num] = xTaskGetCurrentTaskHandle();
+
+	if(usart_buff_rx_count(USART_Num) == 0)
+	{
+		if(xTaskCheckForTimeOut(Time_Out, Ticks_Left) != pdFALSE)
+		{
+			Retry = 0;
+		}
+		else
+		{
+			(void)ulTaskNotifyTakeIndexed(USART_NOTIFY_INDEX, pdTRUE, *Ticks_Left);
+		}
+	}
+
+	USART_Rx_Waiter[USART_Num] = NULL;
+	return Retry;
+}
+
+#if ((USART_RX_DMA == ENABLE) || (USART_TX_DMA == ENABLE))
+/*
+ * usart_dma_clk_enable():
+ *  - USART1/USART6 requests are served by DMA2, all other USARTs by DMA1.
+ */
+static void usart_dma_clk_enable(USART_Num_t USART_Num)
+{
+	if((USART_Num == USART_NUM_1) || (USART_Num == USART_NUM_6))
+	{
+		__HAL_RCC_DMA2_CLK_ENABLE();
+	}
+	else
+	{
+		__HAL_RCC_DMA1_CLK_ENABLE();
+	}
+}
+#endif
+
+#if (USART_RX_DMA == ENABLE)
+/*
+ * usart_rx_dma_init():
+ *  - Enables the DMA controller clock, configures the RX stream in circular
+ *    peripheral-to-memory byte mode and links it to the HAL UART handle.
+ *
+ * usart_rx_dma_start():
+ *  - (Re)starts circular reception into USART_Rx_DMA_Buff[] with IDLE detection.
+ */
+static uint8_t usart_rx_dma_init(USART_Num_t USART_Num)
+{
+	DMA_HandleTypeDef *hdma = &USART_Rx_DMA_Handler[USART_Num];
+
+	usart_dma_clk_enable(USART_Num);
+
+	hdma->Instance                 = USART_Rx_DMA_Stream[USART_Num];
+	hdma->Init.Channel             = USART_Rx_DMA_Channel[USART_Num];
+	hdma->Init.Direction           = DMA_PERIPH_TO_MEMORY;
+	hdma->Init.PeriphInc           = DMA_PINC_DISABLE;
+	hdma->Init.MemInc              = DMA_MINC_ENABLE;
+	hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdma->Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+	hdma->Init.Mode                = DMA_CIRCULAR;
+	hdma->Init.Priority            = DMA_PRIORITY_HIGH;
+	hdma->Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+
+	if(HAL_DMA_Init(hdma) != HAL_OK)
+	{
+		return 0;
+	}
+
+	__HAL_LINKDMA(&USART_Handler[USART_Num], hdmarx, USART_Rx_DMA_Handler[USART_Num]);
+
+	HAL_NVIC_SetPriority(USART_Rx_DMA_IRQ[USART_Num], USART_NVIC_GROUP_PRIORITY, USART_NVIC_SUB_PRIORITY);
+	HAL_NVIC_EnableIRQ(USART_Rx_DMA_IRQ[USART_Num]);
+
+	return 1;
+}
+
+static void usart_rx_dma_start(USART_Num_t USART_Num)
+{
+	USART_Rx_DMA_Pos[USART_Num] = 0;
+	(void)HAL_UARTEx_ReceiveToIdle_DMA(&USART_Handler[USART_Num], USART_Rx_DMA_Buff[USART_Num], USART_RX_DMA_SIZE);
+}
+#endif
+
+#if (USART_TX_DMA == ENABLE)
+/*
+ * usart_tx_dma_init():
+ *  - Configures the TX stream in normal memory-to-peripheral byte mode and links it
+ *    to the HAL UART handle. Each USART_SendBuffer() call reprograms address/length.
+ */
+static uint8_t usart_tx_dma_init(USART_Num_t USART_Num)
+{
+	DMA_HandleTypeDef *hdma = &USART_Tx_DMA_Handler[USART_Num];
+
+	usart_dma_clk_enable(USART_Num);
+
+	hdma->Instance                 = USART_Tx_DMA_Stream[USART_Num];
+	hdma->Init.Channel             = USART_Tx_DMA_Channel[USART_Num];
+	hdma->Init.Direction           = DMA_MEMORY_TO_PERIPH;
+	hdma->Init.PeriphInc           = DMA_PINC_DISABLE;
+	hdma->Init.MemInc              = DMA_MINC_ENABLE;
+	hdma->Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdma->Init.MemDataAlignment    = DMA_MDATAALIGN_BYTE;
+	hdma->Init.Mode                = DMA_NORMAL;
+	hdma->Init.Priority            = DMA_PRIORITY_MEDIUM;
+	hdma->Init.FIFOMode            = DMA_FIFOMODE_DISABLE;
+
+	if(HAL_DMA_Init(hdma) != HAL_OK)
+	{
+		return 0;
+	}
+
+	__HAL_LINKDMA(&USART_Handler[USART_Num], hdmatx, USART_Tx_DMA_Handler[USART_Num]);
+
+	HAL_NVIC_SetPriority(USART_Tx_DMA_IRQ[USART_Num], USART_NVIC_GROUP_PRIORITY, USART_NVIC_SUB_PRIORITY);
+	HAL_NVIC_EnableIRQ(USART_Tx_DMA_IRQ[USART_Num]);
+
+	return 1;
+}
+#endif
+
+/*
+ * usart_flow_cfg_valid():
+ *  - Returns 0 if the flow control settings of USART_Config[] cannot work:
+ *      * RTS/CTS requested on UART4/5 (no flow control lines on these ports)
+ *      * RTS/CTS pin missing from USART_Pin_Config[]
+ *      * software RTS watermark combined with hardware RTS, or low mark >= high mark
+ *      * XON/XOFF low mark >= high mark, or high mark above the RX buffer size
+ */
+static uint8_t usart_flow_cfg_valid(USART_Num_t USART_Num)
+{
+	const USART_Config_t     *Cfg = &USART_Config[USART_Num];
+	const USART_Pin_Config_t *Pin = &USART_Pin_Config[USART_Num];
+	uint8_t Valid = 1;
+
+	if((Cfg->HwFlowCtl != UART_HWCONTROL_NONE) && ((USART_Num == USART_NUM_4) || (USART_Num == USART_NUM_5)))
+	{
+		Valid = 0;
+	}
+	else if(((Cfg->HwFlowCtl & UART_HWCONTROL_CTS) != 0U) && (Pin->Cts_Port == NULL))
+	{
+		Valid = 0;
+	}
+	else if(((Cfg->HwFlowCtl & UART_HWCONTROL_RTS) != 0U) && (Pin->Rts_Port == NULL))
+	{
+		Valid = 0;
+	}
+	else if(Cfg->Rts_High_Water != 0U)
+	{
+		if(((Cfg->HwFlowCtl & UART_HWCONTROL_RTS) != 0U) || (Pin->Rts_Port == NULL) ||
+		   (Cfg->Rts_Low_Water >= Cfg->Rts_High_Water) || (Cfg->Rts_High_Water > Cfg->Rx_Buff_Size))
+		{
+			Valid = 0;
+		}
+	}
+	else
+	{
+		/* No flow control or valid hardware-only setup. */
+	}
+
+	if((Cfg->Xoff_High_Water != 0U) &&
+	   ((Cfg->Xon_Low_Water >= Cfg->Xoff_High_Water) || (Cfg->Xoff_High_Water > Cfg->Rx_Buff_Size)))
+	{
+		Valid = 0;
+	}
+
+	return Valid;
+}
+
+/* =========================================================================================
+ *                                  USART_Init()
+ * =========================================================================================
+ *
+ * General peripheral init pattern used here:
+ *   1) Validate arguments
+ *   2) Enable peripheral clock
+ *   3) Enable GPIO clocks
+ *   4) Configure GPIO pins for Alternate Function (TX/RX, RTS/CTS if enabled)
+ *   5) Configure USART parameters via HAL handle
+ *   6) Initialize USART with HAL_UART_Init()
+ *   7) Create RTOS resources (TX/RX queues)
+ *   8) Configure TX DMA stream (optional)
+ *   9) Configure NVIC + enable interrupts (optional)
+ *  10) Start RX interrupt or DMA reception (optional)
+ *
+ * Steps 9-10 only run once 7-8 succeeded, and the port is marked initialized only
+ * if every step did: a failed port never has interrupts writing unallocated buffers.
+ *
+ * Returns:
+ *   - USART_InitSuccess on success
+ *   - Error codes on invalid args, HAL init failure, queue creation failure, etc.
+ */
+USART_Err_St_t USART_Init(USART_Num_t USART_Num)
+{
+	USART_Err_St_t USART_Err_Ret = USART_InitSuccess;
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+	/* 1) Validate argument: USART_Num must be within configured range. */
+	if(USART_Num >= USART_MAX_NUM)
+	{
+		USART_Err_Ret = USART_Invalid_Arg;
+	}
+	/* Flow control must match the port capabilities and the pin table. */
+	else if(usart_flow_cfg_valid(USART_Num) == 0)
+	{
+		USART_Err_Ret = USART_Invalid_Arg;
+	}
+	else
+	{
+#if (USART_PROFILE == ENABLE)
+		/* Cycle counter for the profiling probes (left running, never reset here). */
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+		/* 2) Enable USART peripheral clock. */
+		usart_clk_enable(USART_Num);
+
+		/* 3) Enable GPIO clocks for configured TX/RX ports. */
+		usart_gpio_clk_enable(USART_Pin_Config[USART_Num].Tx_Port);
+		usart_gpio_clk_enable(USART_Pin_Config[USART_Num].Rx_Port);
+
+		/* 4) Configure TX pin as Alternate Function Push-Pull. */
+		GPIO_InitStruct.Pin = USART_Pin_Config[USART_Num].Tx_Pin;
+		GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+		GPIO_InitStruct.Pull = GPIO_NOPULL;
+		GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+
+		/* Select AF mapping: USART1/2/3 use AF7, UART4/5/USART6 often AF8 on STM32F4. */
+		if((USART_Num == USART_NUM_1) || (USART_Num == USART_NUM_2) || (USART_Num == USART_NUM_3))
+		{
+			GPIO_InitStruct.Alternate = USART_GPIO_AF7;
+		}
+		else
+		{
+			GPIO_InitStruct.Alternate = USART_GPIO_AF8;
+		}
+
+		HAL_GPIO_Init(USART_Pin_Config[USART_Num].Tx_Port, &GPIO_InitStruct);
+
+		/* Configure RX pin with the same AF parameters (Pin field changed only). */
+		GPIO_InitStruct.Pin = USART_Pin_Config[USART_Num].Rx_Pin;
+		HAL_GPIO_Init(USART_Pin_Config[USART_Num].Rx_Port, &GPIO_InitStruct);
+
+		/* Hardware flow control lines use the same AF as TX/RX. */
+		if((USART_Config[USART_Num].HwFlowCtl & UART_HWCONTROL_CTS) != 0U)
+		{
+			usart_gpio_clk_enable(USART_Pin_Config[USART_Num].Cts_Port);
+			GPIO_InitStruct.Pin = USART_Pin_Config[USART_Num].Cts_Pin;
+			HAL_GPIO_Init(USART_Pin_Config[USART_Num].Cts_Port, &GPIO_InitStruct);
+		}
+
+		if((USART_Config[USART_Num].HwFlowCtl & UART_HWCONTROL_RTS) != 0U)
+		{
+			usart_gpio_clk_enable(USART_Pin_Config[USART_Num].Rts_Port);
+			GPIO_InitStruct.Pin = USART_Pin_Config[USART_Num].Rts_Pin;
+			HAL_GPIO_Init(USART_Pin_Config[USART_Num].Rts_Port, &GPIO_InitStruct);
+		}
+#if (USART_SW_RTS == ENABLE)
+		/* Software RTS: plain output, asserted (low = ready) until the high mark is hit. */
+		else if(USART_Config[USART_Num].Rts_High_Water != 0U)
+		{
+			usart_gpio_clk_enable(USART_Pin_Config[USART_Num].Rts_Port);
+			USART_Rts_Throttled[USART_Num] = 0U;
+			HAL_GPIO_WritePin(USART_Pin_Config[USART_Num].Rts_Port, USART_Pin_Config[USART_Num].Rts_Pin, GPIO_PIN_RESET);
+
+			GPIO_InitStruct.Pin = USART_Pin_Config[USART_Num].Rts_Pin;
+			GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
+			GPIO_InitStruct.Alternate = 0;
+			HAL_GPIO_Init(USART_Pin_Config[USART_Num].Rts_Port, &GPIO_InitStruct);
+		}
+#endif
+
+		/* 5) Fill HAL handle init parameters from configuration tables. */
+		USART_Handler[USART_Num].Instance          = USART_Base_Num[USART_Num];
+		USART_Handler[USART_Num].Init.BaudRate     = USART_Config[USART_Num].BaudRate;
+		USART_Handler[USART_Num].Init.WordLength   = USART_Config[USART_Num].WordLength;
+		USART_Handler[USART_Num].Init.StopBits     = USART_Config[USART_Num].stop_bit;
+		USART_Handler[USART_Num].Init.Parity       = USART_Config[USART_Num].Parity;
+		USART_Handler[USART_Num].Init.Mode         = UART_MODE_TX_RX;
+		USART_Handler[USART_Num].Init.HwFlowCtl    = USART_Config[USART_Num].HwFlowCtl;
+		USART_Handler[USART_Num].Init.OverSampling = USART_Config[USART_Num].OverSampling;
+
+		/* 6) Initialize hardware via HAL. */
+		if(HAL_UART_Init(&USART_Handler[USART_Num]) != HAL_OK)
+		{
+			USART_Err_Ret = USART_InitFailed;
+		}
+
+		if( USART_Err_Ret == USART_InitSuccess)
+		{
+			/* 7) Create TX/RX buffers (queues or rings, byte-sized elements). */
+			if(usart_buff_create(USART_Num) == 0)
+			{
+				USART_Err_Ret = USART_CreateBuff_Failed;
+			}
+
+			/* 8) Prepare the TX DMA stream for USART_SendBuffer() if enabled. */
+#if (USART_TX_DMA == ENABLE)
+			if((USART_Err_Ret == USART_InitSuccess) && (usart_tx_dma_init(USART_Num) == 0))
+			{
+				USART_Err_Ret = USART_InitFailed;
+			}
+#endif
+
+			/*
+			 * Steps 9-10 arm interrupts that write the buffers: a port whose buffers or
+			 * DMA could not be set up stays USART_Not_Init with RX off.
+			 */
+			if(USART_Err_Ret == USART_InitSuccess)
+			{
+				/* 9) Configure NVIC only if at least one direction uses interrupts.
+				 *    TX DMA also needs it: completion is signalled by the USART TC interrupt. */
+#if  ((USART_RX_INT ==  ENABLE) || (USART_TX_INT ==  ENABLE) || (USART_TX_DMA == ENABLE))
+				HAL_NVIC_SetPriority(USART_IRQ[USART_Num], USART_NVIC_GROUP_PRIORITY, USART_NVIC_SUB_PRIORITY);
+				HAL_NVIC_EnableIRQ(USART_IRQ[USART_Num]);
+#endif
+
+				/* 10) Start RX reception: circular DMA, or interrupt one byte at a time. */
+#if (USART_RX_DMA == ENABLE)
+				if(usart_rx_dma_init(USART_Num) == 0)
+				{
+					USART_Err_Ret = USART_InitFailed;
+				}
+				else
+				{
+					usart_rx_dma_start(USART_Num);
+				}
+#elif (USART_RX_INT ==  ENABLE) && (USART_FAST_ISR == ENABLE)
+				LL_USART_EnableIT_RXNE(USART_Handler[USART_Num].Instance);
+#elif (USART_RX_INT ==  ENABLE)
+				HAL_UART_Receive_IT(&USART_Handler[USART_Num] , &USART_Rx_Byte[USART_Num], 1);
+#endif
+			}
+
+			if(USART_Err_Ret == USART_InitSuccess)
+			{
+				USART_Init_St[USART_Num] = USART_InitSuccess;
+			}
+		}
+	}
+	return USART_Err_Ret;
+}
+
+/* =========================================================================================
+ *                                  USART_RxCyclic()
+ * =========================================================================================
+ *
+ * Polling-based receive "service routine" (used when RX interrupts are disabled).
+ *
+ * What it does:
+ *  - Iterates over all configured USART instances
+ *  - For each initialized instance, polls RXNE flag
+ *  - While RXNE is set, reads DR (which clears RXNE) and pushes byte to RX queue
+ *
+ * Why this exists:
+ *  - In polling mode, application tasks should NOT touch hardware registers directly.
+ *    Instead they read from an RTOS queue; this function performs the HW draining.
+ *
+ * Call frequency:
+ *  - Should be called periodically from a dedicated task or main loop.
+ *  - The faster you call it, the less chance of RX overrun if incoming data is fast.
+ */
+void USART_RxCyclic(void)
+{
+	USART_TypeDef *USART_Instance = NULL ;
+
+	for(uint8_t usart_num = 0 ; usart_num < USART_MAX_NUM ; usart_num++)
+	{
+		USART_Instance = USART_Handler[usart_num].Instance;
+
+		if((USART_Instance != NULL) && (USART_Init_St[usart_num] == USART_InitSuccess))
+		{
+			USART_PROF_START(Prof_Start);
+#if USART_RX_INT == DISABLE
+			uint8_t  Received = 0;
+			uint32_t Sr = LL_USART_ReadReg(USART_Instance, SR);
+
+			/* RXNE = 1 means there is unread data in the receive data register. */
+			while((Sr & USART_SR_RXNE) != 0U)
+			{
+				/* Error flags belong to this byte: SR was read first, DR read clears them. */
+				usart_stat_sr(usart_num, Sr);
+
+				/* Reading DR returns the received byte and clears RXNE. */
+				USART_Rx_Byte[usart_num] = LL_USART_ReceiveData8(USART_Instance);
+
+				/* Push received byte into the RX buffer (non-blocking). */
+				if(usart_rx_filter(usart_num, USART_Rx_Byte[usart_num]))
+				{
+					usart_stat_rx(usart_num, 1U, (usart_rx_store(usart_num, USART_Rx_Byte[usart_num]) == 0U));
+				}
+				else
+				{
+					usart_stat_rx(usart_num, 1U, 0U);
+				}
+				Received = 1;
+				Sr = LL_USART_ReadReg(USART_Instance, SR);
+			}
+
+			/* Wake a task blocked in USART_Receive() / the registered event task. */
+			if(Received != 0)
+			{
+				usart_rx_signal(usart_num);
+			}
+#endif
+			USART_PROF_STOP(usart_num, USART_PROF_RX_CYCLIC, Prof_Start);
+		}
+	}
+}
+
+/* =========================================================================================
+ *                                  USART_TxCyclic()
+ * =========================================================================================
+ *
+ * Polling-based transmit "service routine" (used when TX interrupts are disabled).
+ *
+ * What it does:
+ *  - Iterates over all USART instances
  *  - For each initialized instance:
  *      - If TXE is set (data register empty) AND TX queue has bytes waiting
  *      - Pop a byte from TX queue and write it to DR to start transmission
  *
- * TXE flag:
- *  - TXE = 1 means the transmit data register can accept a new byte.
- *  - Once you write DR, hardware clears TXE until it copies DR into the shift register.
+ * TXE flag:
+ *  - TXE = 1 means the transmit data register can accept a new byte.
+ *  - Once you write DR, hardware clears TXE until it copies DR into the shift register.
+ *
+ * Note on pdPASS:
+ *  - xQueueReceive() returns pdPASS when it successfully removed an item from the queue.
+ *  - If it fails (empty queue), it returns errQUEUE_EMPTY (usually pdFALSE).
+ *
+ * NOTE (pdPASS vs pdTRUE):
+ *  - In FreeRTOS, pdPASS is the standard success return for queue/semaphore operations.
+ *  - pdTRUE is commonly used for boolean-style returns (timers, some APIs).
+ *  - Many ports define both as 1, but you should compare against the documented macro
+ *    used by that API (for queues: pdPASS).
+ */
+void USART_TxCyclic(void)
+{
+	USART_TypeDef *USART_Instance = NULL ;
+
+	for(uint8_t usart_num = 0 ; usart_num < USART_MAX_NUM ; usart_num++)
+	{
+		USART_Instance = USART_Handler[usart_num].Instance;
+
+		if((USART_Instance != NULL) && (USART_Init_St[usart_num] == USART_InitSuccess))
+		{
+			USART_PROF_START(Prof_Start);
+#if USART_TX_INT == DISABLE
+			/* TXE must be set and there must be something to send in the buffer. */
+			usart_tx_drain(usart_num, USART_Instance);
+#endif
+			USART_PROF_STOP(usart_num, USART_PROF_TX_CYCLIC, Prof_Start);
+		}
+	}
+}
+
+/* =========================================================================================
+ *                                  USART_ReceiveByte()
+ * =========================================================================================
+ *
+ * Application API to receive one byte from the RX queue.
+ *
+ * Behavior:
+ *  - Non-blocking read from RX queue
+ *  - If a byte is available -> returns USART_Rx_Ok and stores it in *Rx_data
+ *  - If no data -> returns USART_Rx_NoData
+ */
+USART_Err_St_t USART_ReceiveByte(USART_Num_t USART_Num , uint8_t *Rx_data)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_InitFailed;
+	USART_PROF_START(Prof_Start);
+
+	/* Validate arguments. */
+	if(USART_Num >= USART_MAX_NUM ||  Rx_data == NULL)
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	/* Non-blocking buffer read. */
+	else if(usart_buff_rx_get(USART_Num, Rx_data))
+	{
+		usart_rts_release(USART_Num);
+#if (USART_XON_XOFF == ENABLE)
+		usart_xon_release(USART_Num);
+#endif
+		USART_Err_Ret =  USART_Rx_Ok;
+	}
+	else
+	{
+		USART_Err_Ret =  USART_Rx_NoData;
+	}
+
+	USART_PROF_STOP(USART_Num, USART_PROF_RECEIVE_BYTE, Prof_Start);
+	return USART_Err_Ret;
+}
+
+/* =========================================================================================
+ *                                  USART_SendByte()
+ * =========================================================================================
+ *
+ * Application API to send one byte.
+ *
+ * Polling TX mode:
+ *  - First drains the buffer into HW as long as TXE is ready (makes room)
+ *  - Pushes the byte into the TX buffer, then drains again (usart_tx_kick)
+ *  - DR is written only by the drain, so tasks sending on the same port never
+ *    race on the data register
+ *
+ * Interrupt TX mode:
+ *  - Push byte into TX queue
+ *  - If TX not active, start the first TX using HAL_UART_Transmit_IT() (usart_tx_kick)
+ *  - Further bytes are sent in HAL_UART_TxCpltCallback(), chaining until queue empty
+ *
+ * Return values:
+ *  - USART_Tx_Ok: byte accepted (sent immediately or queued)
+ *  - USART_Tx_Busy: queue full, byte rejected
+ *  - USART_Not_Init / USART_Invalid_Arg: invalid usage
+ */
+USART_Err_St_t USART_SendByte(USART_Num_t USART_Num , uint8_t Tx_data)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Tx_Ok;
+	USART_PROF_START(Prof_Start);
+
+	/* Validate arguments. */
+	if(USART_Num >= USART_MAX_NUM )
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else if(USART_Init_St[USART_Num] == USART_Not_Init)
+	{
+		USART_Err_Ret =  USART_Not_Init;
+	}
+	else
+	{
+#if USART_TX_INT == DISABLE
+		/* Drain buffered bytes into HW while TXE is ready (makes room first). */
+		usart_tx_drain(USART_Num, USART_Handler[USART_Num].Instance);
+#endif
+
+		/*
+		 * The buffer itself is safe against the Tx callback and other sending tasks
+		 * (queue: internal locking, ring: atomic reservation). usart_tx_kick() claims
+		 * the transmitter with a CAS on USART_Tx_State against the callback (polling
+		 * mode: drains with the scheduler suspended).
+		 */
+		if(usart_buff_tx_put(USART_Num, Tx_data) == 0)
+		{
+			/* Buffer full -> cannot accept new byte. */
+			USART_Err_Ret =  USART_Tx_Busy;
+		}
+		else
+		{
+			usart_stat_tx_level(USART_Num);
+
+			/* Start the IT chain if idle / drain into DR in polling mode. */
+			usart_tx_kick(USART_Num);
+		}
+	}
+	USART_PROF_STOP(USART_Num, USART_PROF_SEND_BYTE, Prof_Start);
+	return USART_Err_Ret;
+}
+
+/* =========================================================================================
+ *                                    USART_Send()
+ * =========================================================================================
+ *
+ * Application API to send a span of bytes, blocking up to Timeout_Ms for TX space.
+ *
+ * Behavior:
+ *  - Copy as much of the span as fits into the TX buffer in one operation
+ *  - Kick the transmitter (IT chain start, or direct drain in polling mode)
+ *  - If bytes remain, sleep on a task notification until the TX side freed room
+ *    (no vTaskDelay() retry loop), then continue with the rest
+ */
+USART_Err_St_t USART_Send(USART_Num_t USART_Num , const uint8_t *Data, uint32_t Len, uint32_t Timeout_Ms)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Tx_Ok;
+	TimeOut_t      Time_Out;
+	TickType_t     Ticks_Left = usart_ms_to_ticks(Timeout_Ms);
+	uint32_t       Sent = 0;
+	uint32_t       Need;
+
+	/* Validate arguments. */
+	if((USART_Num >= USART_MAX_NUM) || ((Data == NULL) && (Len != 0)))
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else if(USART_Init_St[USART_Num] == USART_Not_Init)
+	{
+		USART_Err_Ret =  USART_Not_Init;
+	}
+	else
+	{
+		vTaskSetTimeOutState(&Time_Out);
+
+		while(Sent < Len)
+		{
+			Sent += usart_buff_tx_write(USART_Num, &Data[Sent], Len - Sent);
+			usart_stat_tx_level(USART_Num);
+			usart_tx_kick(USART_Num);
+
+			/* Whole rest if it fits the buffer (written in one piece), else half a buffer per wake-up. */
+			Need = Len - Sent;
+			if(Need > USART_Config[USART_Num].Tx_Buff_Size)
+			{
+				Need = USART_Config[USART_Num].Tx_Buff_Size / 2U;
+			}
+
+			if((Sent < Len) && (usart_wait_tx(USART_Num, Need, &Time_Out, &Ticks_Left) == 0))
+			{
+				USART_Err_Ret =  USART_Tx_Busy;
+				break;
+			}
+		}
+	}
+	return USART_Err_Ret;
+}
+
+#if (USART_BUFF_BACKEND == USART_BUFF_RING)
+/* =========================================================================================
+ *                      USART_TxReserve() / USART_TxWrite() / USART_TxCommit()
+ * =========================================================================================
+ *
+ * Multi-producer TX: a task claims Len contiguous TX ring slots, fills them at its
+ * own pace and publishes them in one step. No mutex is held while the hardware
+ * sends, and bytes of different tasks never interleave.
+ *
+ * Behavior:
+ *  - Reserve: atomic claim (USART_Ring_Reserve); while the ring is too full the task
+ *    sleeps on the TX-space notification like USART_Send()
+ *  - Write:   copies into the reserved range, no locking (the range is private)
+ *  - Commit:  gives back unwritten bytes if possible, publishes the range once all
+ *    earlier reservations are committed, then kicks the transmitter. Unwritten bytes
+ *    pinned by a later reservation stay in the ring but are marked to be skipped:
+ *    the transmitter steps over them, so only written bytes reach the wire.
+ */
+USART_Err_St_t USART_TxReserve(USART_Num_t USART_Num , uint32_t Len, uint32_t Timeout_Ms, USART_TxResv_t *Resv)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Tx_Ok;
+	TimeOut_t      Time_Out;
+	TickType_t     Ticks_Left = usart_ms_to_ticks(Timeout_Ms);
+
+	/* Validate arguments. */
+	if((USART_Num >= USART_MAX_NUM) || (Resv == NULL))
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else if(USART_Init_St[USART_Num] == USART_Not_Init)
+	{
+		USART_Err_Ret =  USART_Not_Init;
+	}
+	else if((Len == 0U) || (Len > USART_Config[USART_Num].Tx_Buff_Size))
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else
+	{
+		vTaskSetTimeOutState(&Time_Out);
+
+		while(USART_Ring_Reserve(&USART_Tx_Buffer[USART_Num], Len, &Resv->Pos) == 0U)
+		{
+			/* Polling TX: drain first, the buffer may only be full of sent-ready bytes. */
+			usart_tx_kick(USART_Num);
+
+			if(usart_wait_tx(USART_Num, Len, &Time_Out, &Ticks_Left) == 0)
+			{
+				USART_Err_Ret =  USART_Tx_Busy;
+				break;
+			}
+		}
+	}
+
+	if(Resv != NULL)
+	{
+		/* Failed reservations are not valid handles for Write/Commit. */
+		Resv->USART_Num = (USART_Err_Ret == USART_Tx_Ok) ? USART_Num : USART_MAX_NUM;
+		Resv->Len       = (USART_Err_Ret == USART_Tx_Ok) ? Len : 0U;
+		Resv->Used      = 0U;
+	}
+	return USART_Err_Ret;
+}
+
+USART_Err_St_t USART_TxWrite(USART_TxResv_t *Resv, const uint8_t *Data, uint32_t Len)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Tx_Ok;
+
+	/* Validate arguments. */
+	if((Resv == NULL) || (Resv->USART_Num >= USART_MAX_NUM) ||
+	   ((Data == NULL) && (Len != 0U)) || (Len > (Resv->Len - Resv->Used)))
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else
+	{
+		USART_Ring_Fill(&USART_Tx_Buffer[Resv->USART_Num], Resv->Pos + Resv->Used, Data, Len);
+		Resv->Used += Len;
+	}
+	return USART_Err_Ret;
+}
+
+USART_Err_St_t USART_TxCommit(USART_TxResv_t *Resv)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Tx_Ok;
+	USART_Ring_t  *Ring;
+	USART_Num_t    USART_Num;
+
+	/* Validate arguments. */
+	if((Resv == NULL) || (Resv->USART_Num >= USART_MAX_NUM))
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else
+	{
+		USART_Num = Resv->USART_Num;
+		Ring      = &USART_Tx_Buffer[USART_Num];
+
+		/* Last reservation: shrink it. Otherwise the gap is fixed and skipped when sent. */
+		if((Resv->Used < Resv->Len) && USART_Ring_Shrink(Ring, Resv->Pos, Resv->Len, Resv->Used))
+		{
+			Resv->Len = Resv->Used;
+		}
+
+		if(Resv->Len != 0U)
+		{
+			usart_ring_tx_commit(USART_Num, Resv->Pos, Resv->Len, Resv->Used);
+			usart_stat_tx_level(USART_Num);
+			usart_tx_kick(USART_Num);
+		}
+
+		/* The handle is spent. */
+		Resv->USART_Num = USART_MAX_NUM;
+	}
+	return USART_Err_Ret;
+}
+
+/* =========================================================================================
+ *                            USART_TxAcquire() / USART_TxPublish()
+ * =========================================================================================
+ *
+ * In-place TX: a serializer gets a writable span of the TX ring itself
+ * (USART_Ring_Acquire, the same atomic claim as USART_TxReserve) and encodes the
+ * message straight into it, then publishes what it wrote.
  *
- * Note on pdPASS:
- *  - xQueueReceive() returns pdPASS when it successfully removed an item from the queue.
- *  - If it fails (empty queue), it returns errQUEUE_EMPTY (usually pdFALSE).
+ * Behavior:
+ *  - Acquire: non-blocking; the span is contiguous, so it ends at the end of the
+ *    storage even if more space is free past the wrap (acquire again after
+ *    publishing). The span is a caller-owned USART_TxResv_t, like a reservation,
+ *    so any number of tasks may hold spans on one port.
+ *  - Publish: USART_TxCommit() on the span with Len bytes marked written (shrink
+ *    or skip the rest, publish in claim order), which only starts the transmitter
+ *    if it is idle.
+ */
+USART_Err_St_t USART_TxAcquire(USART_Num_t USART_Num , uint32_t Want, USART_TxResv_t *Resv, uint8_t **Data, uint32_t *Got)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Tx_Busy;
+	uint32_t       Pos = 0U;
+	uint32_t       Len = 0U;
+
+	/* Validate arguments. */
+	if((USART_Num >= USART_MAX_NUM) || (Resv == NULL) || (Data == NULL) || (Got == NULL) || (Want == 0U))
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else if(USART_Init_St[USART_Num] == USART_Not_Init)
+	{
+		USART_Err_Ret =  USART_Not_Init;
+	}
+	else
+	{
+		Len = USART_Ring_Acquire(&USART_Tx_Buffer[USART_Num], Want, &Pos);
+		if(Len != 0U)
+		{
+			Resv->Pos = Pos;
+			*Data = &USART_Tx_Buffer[USART_Num].Buff[Pos & USART_Tx_Buffer[USART_Num].Mask];
+			USART_Err_Ret =  USART_Tx_Ok;
+		}
+		else
+		{
+			/* Polling TX: the buffer may only be full of sent-ready bytes. */
+			usart_tx_kick(USART_Num);
+		}
+	}
+
+	if(Resv != NULL)
+	{
+		/* Failed acquisitions are not valid handles for Publish. */
+		Resv->USART_Num = (USART_Err_Ret == USART_Tx_Ok) ? USART_Num : USART_MAX_NUM;
+		Resv->Len       = Len;
+		Resv->Used      = 0U;
+	}
+	if(Got != NULL)
+	{
+		*Got = Len;
+	}
+	return USART_Err_Ret;
+}
+
+USART_Err_St_t USART_TxPublish(USART_TxResv_t *Resv, uint32_t Len)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Invalid_Arg;
+
+	/* Validate arguments: the span stays open on error. */
+	if((Resv != NULL) && (Resv->USART_Num < USART_MAX_NUM) && (Len <= Resv->Len))
+	{
+		/* The bytes are already in place: only the length is recorded. */
+		Resv->Used    = Len;
+		USART_Err_Ret = USART_TxCommit(Resv);
+	}
+	return USART_Err_Ret;
+}
+#endif /* USART_BUFF_RING */
+
+/* =========================================================================================
+ *                                   USART_Receive()
+ * =========================================================================================
  *
- * NOTE (pdPASS vs pdTRUE):
- *  - In FreeRTOS, pdPASS is the standard success return for queue/semaphore operations.
- *  - pdTRUE is commonly used for boolean-style returns (timers, some APIs).
- *  - Many ports define both as 1, but you should compare against the documented macro
- *    used by that API (for queues: pdPASS).
+ * Application API to receive up to Max_Len bytes, blocking up to Timeout_Ms for data.
+ *
+ * Behavior:
+ *  - Copy everything available (up to Max_Len) out of the RX buffer in one operation
+ *  - If nothing is available, sleep on a task notification raised by the RX path
+ *    (ISR, DMA event or USART_RxCyclic) and try again
  */
-void USART_TxCyclic(void)
+USART_Err_St_t USART_Receive(USART_Num_t USART_Num , uint8_t *Data, uint32_t Max_Len, uint32_t Timeout_Ms, uint32_t *Rx_Len)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Rx_NoData;
+	TimeOut_t      Time_Out;
+	TickType_t     Ticks_Left = usart_ms_to_ticks(Timeout_Ms);
+	uint32_t       Got = 0;
+
+	/* Validate arguments. */
+	if((USART_Num >= USART_MAX_NUM) || (Data == NULL) || (Max_Len == 0))
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else if(USART_Init_St[USART_Num] == USART_Not_Init)
+	{
+		USART_Err_Ret =  USART_Not_Init;
+	}
+	else
+	{
+		vTaskSetTimeOutState(&Time_Out);
+
+		do
+		{
+			Got = usart_buff_rx_read(USART_Num, Data, Max_Len);
+		}
+		while((Got == 0) && (usart_wait_rx(USART_Num, &Time_Out, &Ticks_Left) != 0));
+
+		if(Got > 0)
+		{
+			usart_rts_release(USART_Num);
+#if (USART_XON_XOFF == ENABLE)
+			usart_xon_release(USART_Num);
+#endif
+			USART_Err_Ret =  USART_Rx_Ok;
+		}
+	}
+
+	if(Rx_Len != NULL)
+	{
+		*Rx_Len = Got;
+	}
+	return USART_Err_Ret;
+}
+
+#if (USART_BUFF_BACKEND == USART_BUFF_RING)
+/* =========================================================================================
+ *                              USART_RxPeek() / USART_RxConsume()
+ * =========================================================================================
+ *
+ * In-place RX: the reader task gets the oldest bytes as a span of the RX ring
+ * (USART_Ring_Peek) and releases what it parsed (USART_Ring_Consume). The ISR
+ * keeps filling the ring meanwhile; it never writes into a span not yet consumed.
+ * Consuming frees space, so RTS / XON are released like after USART_Receive().
+ */
+USART_Err_St_t USART_RxPeek(USART_Num_t USART_Num , const uint8_t **Data, uint32_t *Len)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Rx_NoData;
+
+	/* Validate arguments. */
+	if((USART_Num >= USART_MAX_NUM) || (Data == NULL) || (Len == NULL))
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else if(USART_Init_St[USART_Num] == USART_Not_Init)
+	{
+		USART_Err_Ret =  USART_Not_Init;
+	}
+	else
+	{
+		*Len = USART_Ring_Peek(&USART_Rx_Buffer[USART_Num], Data);
+		if(*Len > 0U)
+		{
+			USART_Err_Ret =  USART_Rx_Ok;
+		}
+	}
+	return USART_Err_Ret;
+}
+
+USART_Err_St_t USART_RxConsume(USART_Num_t USART_Num , uint32_t Len)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Rx_Ok;
+
+	/* Validate arguments. */
+	if(USART_Num >= USART_MAX_NUM)
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else if(USART_Init_St[USART_Num] == USART_Not_Init)
+	{
+		USART_Err_Ret =  USART_Not_Init;
+	}
+	else if(Len > USART_Ring_Count(&USART_Rx_Buffer[USART_Num]))
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else if(Len > 0U)
+	{
+		(void)USART_Ring_Consume(&USART_Rx_Buffer[USART_Num], Len);
+
+		usart_rts_release(USART_Num);
+#if (USART_XON_XOFF == ENABLE)
+		usart_xon_release(USART_Num);
+#endif
+	}
+	return USART_Err_Ret;
+}
+#endif
+
+/* =========================================================================================
+ *                                 USART_SetEventTask()
+ * =========================================================================================
+ *
+ * Registers (or clears with NULL) the consumer task that receives driver events as
+ * notification bits on USART_EVENT_NOTIFY_INDEX:
+ *  - USART_EVT_RX(num): new data in the RX buffer
+ *  - USART_EVT_TX(num): TX buffer fully drained
+ * Events are raised straight from the ISR (xTaskNotifyIndexedFromISR + portYIELD_FROM_ISR),
+ * so the consumer can block with xTaskNotifyWaitIndexed() instead of polling.
+ */
+USART_Err_St_t USART_SetEventTask(USART_Num_t USART_Num , TaskHandle_t Task)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Ok;
+
+	if(USART_Num >= USART_MAX_NUM)
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else
+	{
+		USART_Event_Task[USART_Num] = Task;
+	}
+	return USART_Err_Ret;
+}
+
+/* =========================================================================================
+ *                                   USART_SetRxHook()
+ * =========================================================================================
+ *
+ * Registers (or clears with NULL) a stream consumer for the received bytes of one port.
+ * The hook runs where the bytes arrive (RX ISR, DMA event callback or USART_RxCyclic),
+ * so protocol parsers (e.g. USART_Frame) work on the data in a single pass instead of
+ * a task reading it back out of the RX buffer. XON/XOFF characters are filtered first.
+ */
+USART_Err_St_t USART_SetRxHook(USART_Num_t USART_Num , USART_RxHook_t Hook)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Ok;
+
+	if(USART_Num >= USART_MAX_NUM)
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else
+	{
+		USART_Rx_Hook[USART_Num] = Hook;
+	}
+	return USART_Err_Ret;
+}
+
+/* =========================================================================================
+ *                             USART_SetBaud() / USART_GetBaud()
+ * =========================================================================================
+ *
+ * Runtime baud rate change. USART_Config[] only holds the rate USART_Init() starts
+ * with; the current rate is kept in USART_Handler[].Init.BaudRate.
+ *
+ * USART_SetBaud():
+ *  1) Check BRR can reach the rate: at most PCLK / 16 (PCLK / 8 with OVER8), at least
+ *     what the largest mantissa (0xFFF) gives.
+ *  2) Drain TX: wait in 1-tick steps until the TX buffer is empty, nothing is in
+ *     flight (IT chain, DMA, XON/XOFF character) and TC is set, i.e. the last stop
+ *     bit has left the pin. It gives up once the TX buffer has not moved for two
+ *     frame times at the old rate (+2 ticks): with flow control holding the line the
+ *     rate is left unchanged and USART_Tx_Busy returned. (A bound on the whole drain
+ *     would not fit polling TX mode, which moves bytes at the service task's rate.)
+ *  3) Write BRR, in a critical section that first checks the drain again (a producer
+ *     may have queued bytes after step 2; they would go out at the new rate, so the
+ *     call returns USART_Tx_Busy instead). The receiver keeps running: a byte
+ *     arriving while BRR changes is garbled, so switch between frames (e.g. once the
+ *     peer acknowledged the rate).
+ */
+static uint32_t usart_pclk(USART_Num_t USART_Num)
+{
+	/* USART1 / USART6 are on APB2, the others on APB1. */
+	return ((USART_Num == USART_NUM_1) || (USART_Num == USART_NUM_6)) ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+}
+
+static uint8_t usart_tx_drained(USART_Num_t USART_Num)
+{
+	return (usart_buff_tx_count(USART_Num) == 0U) &&
+	       (usart_tx_pending(USART_Num) == 0U) &&
+	       (USART_Tx_State[USART_Num] == USART_TX_IDLE) &&
+	       (usart_tx_dma_busy(USART_Num) == 0U) &&
+	       ((LL_USART_ReadReg(USART_Handler[USART_Num].Instance, SR) & USART_SR_TC) != 0U);
+}
+
+USART_Err_St_t USART_SetBaud(USART_Num_t USART_Num , uint32_t Baud)
+{
+	USART_Err_St_t USART_Err_Ret = USART_Ok;
+	uint32_t       Pclk;
+	uint32_t       Div;
+	uint32_t       Brr;
+	uint32_t       Count;
+	TickType_t     Limit;
+	TickType_t     Stalled = 0;
+
+	if(USART_Num >= USART_MAX_NUM)
+	{
+		USART_Err_Ret = USART_Invalid_Arg;
+	}
+	else if(USART_Init_St[USART_Num] != USART_InitSuccess)
+	{
+		USART_Err_Ret = USART_Not_Init;
+	}
+	else
+	{
+		Pclk = usart_pclk(USART_Num);
+		Div  = (USART_Handler[USART_Num].Init.OverSampling == UART_OVERSAMPLING_8) ? 8U : 16U;
+
+		if((Baud == 0U) || (Baud > (Pclk / Div)) || (((uint64_t)Baud * Div * 0xFFFU) < Pclk))
+		{
+			USART_Err_Ret = USART_Invalid_Arg;
+		}
+		else
+		{
+			/* Two frames of up to 12 bits (9 data bits + 2 stop bits). */
+			Limit = pdMS_TO_TICKS(24000U / USART_Handler[USART_Num].Init.BaudRate) + 2U;
+			Count = usart_buff_tx_count(USART_Num);
+
+			while((usart_tx_drained(USART_Num) == 0U) && (Stalled < Limit))
+			{
+				/* Polling TX mode: the caller moves the bytes itself, as in USART_Send(). */
+				usart_tx_kick(USART_Num);
+				vTaskDelay(1);
+
+				Stalled++;
+				if(usart_buff_tx_count(USART_Num) != Count)
+				{
+					Count   = usart_buff_tx_count(USART_Num);
+					Stalled = 0;
+				}
+			}
+
+			Brr = (Div == 8U) ? UART_BRR_SAMPLING8(Pclk, Baud) : UART_BRR_SAMPLING16(Pclk, Baud);
+
+			/* Check again with tasks and ISRs held off: one may have sent since the loop. */
+			taskENTER_CRITICAL();
+			if(usart_tx_drained(USART_Num) == 0U)
+			{
+				USART_Err_Ret = USART_Tx_Busy;
+			}
+			else
+			{
+				LL_USART_WriteReg(USART_Handler[USART_Num].Instance, BRR, Brr);
+				USART_Handler[USART_Num].Init.BaudRate = Baud;
+			}
+			taskEXIT_CRITICAL();
+		}
+	}
+	return USART_Err_Ret;
+}
+
+USART_Err_St_t USART_GetBaud(USART_Num_t USART_Num , uint32_t *Baud)
+{
+	USART_Err_St_t USART_Err_Ret = USART_Ok;
+
+	if((USART_Num >= USART_MAX_NUM) || (Baud == NULL))
+	{
+		USART_Err_Ret = USART_Invalid_Arg;
+	}
+	else if(USART_Init_St[USART_Num] != USART_InitSuccess)
+	{
+		USART_Err_Ret = USART_Not_Init;
+	}
+	else
+	{
+		*Baud = USART_Handler[USART_Num].Init.BaudRate;
+	}
+	return USART_Err_Ret;
+}
+
+/* =========================================================================================
+ *                             USART_GetStats() / USART_ResetStats()
+ * =========================================================================================
+ *
+ * Copy / clear the per-port counters. Both take a short critical section so the
+ * snapshot is consistent against the RX/TX interrupts.
+ * With USART_STATS == DISABLE nothing is counted and USART_GetStats() returns zeros.
+ */
+USART_Err_St_t USART_GetStats(USART_Num_t USART_Num , USART_Stats_t *Stats)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Ok;
+
+	if((USART_Num >= USART_MAX_NUM) || (Stats == NULL))
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else
+	{
+#if (USART_STATS == ENABLE)
+		taskENTER_CRITICAL();
+		*Stats = USART_Stats[USART_Num];
+		taskEXIT_CRITICAL();
+#else
+		memset(Stats, 0, sizeof(USART_Stats_t));
+#endif
+	}
+	return USART_Err_Ret;
+}
+
+USART_Err_St_t USART_ResetStats(USART_Num_t USART_Num)
 {
-	USART_TypeDef *USART_Instance = NULL ;
+	USART_Err_St_t USART_Err_Ret =  USART_Ok;
 
-	for(uint8_t usart_num = 0 ; usart_num < USART_MAX_NUM ; usart_num++)
+	if(USART_Num >= USART_MAX_NUM)
 	{
-		USART_Instance = USART_Handler[usart_num].Instance;
-
-		if(USART_Instance != NULL)
-		{
-#if USART_TX_INT == DISABLE
-			/* TXE must be set and there must be something to send in the queue. */
-			while((LL_USART_IsActiveFlag_TXE(USART_Instance) != RESET) &&
-				  (uxQueueMessagesWaiting(USART_Tx_Buffer[usart_num]) > 0))
-			{
-				/* Pop one byte from queue (non-blocking). */
-				if(xQueueReceive(USART_Tx_Buffer[usart_num], &USART_Tx_Byte[usart_num], 0) == pdPASS)
-				{
-					/* Write byte to DR -> starts hardware transmission. */
-					LL_USART_TransmitData8(USART_Instance, USART_Tx_Byte[usart_num]);
-				}
-				else
-				{
-					/* Queue unexpectedly empty -> exit the loop. */
-					break;
-				}
-			}
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else
+	{
+#if (USART_STATS == ENABLE)
+		taskENTER_CRITICAL();
+		memset(&USART_Stats[USART_Num], 0, sizeof(USART_Stats_t));
+		taskEXIT_CRITICAL();
 #endif
-		}
 	}
+	return USART_Err_Ret;
 }
 
 /* =========================================================================================
- *                                  USART_ReceiveByte()
+ *                           USART_GetProfile() / USART_ResetProfile()
  * =========================================================================================
  *
- * Application API to receive one byte from the RX queue.
- *
- * Behavior:
- *  - Non-blocking read from RX queue
- *  - If a byte is available -> returns USART_Rx_Ok and stores it in *Rx_data
- *  - If no data -> returns USART_Rx_NoData
+ * Copy / clear the cycle profiles, under a short critical section like the statistics.
+ * With USART_PROFILE == DISABLE no probe exists and USART_GetProfile() returns zeros.
  */
-USART_Err_St_t USART_ReceiveByte(USART_Num_t USART_Num , uint8_t *Rx_data)
+USART_Err_St_t USART_GetProfile(USART_Num_t USART_Num , USART_Prof_Point_t Point, USART_Prof_t *Prof)
 {
-	USART_Err_St_t USART_Err_Ret =  USART_InitFailed;
+	USART_Err_St_t USART_Err_Ret =  USART_Ok;
 
-	/* Validate arguments. */
-	if(USART_Num >= USART_MAX_NUM ||  Rx_data == NULL)
+	if((USART_Num >= USART_MAX_NUM) || (Point >= USART_PROF_POINTS) || (Prof == NULL))
 	{
 		USART_Err_Ret =  USART_Invalid_Arg;
 	}
+	else
+	{
+#if (USART_PROFILE == ENABLE)
+		taskENTER_CRITICAL();
+		*Prof = USART_Prof[USART_Num][Point];
+		taskEXIT_CRITICAL();
+#else
+		memset(Prof, 0, sizeof(USART_Prof_t));
+#endif
+	}
+	return USART_Err_Ret;
+}
+
+USART_Err_St_t USART_ResetProfile(USART_Num_t USART_Num)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Ok;
 
-	/* Non-blocking queue read. */
-	if(xQueueReceive(USART_Rx_Buffer[USART_Num], Rx_data, 0) == pdPASS)
+	if(USART_Num >= USART_MAX_NUM)
 	{
-		USART_Err_Ret =  USART_Rx_Ok;
+		USART_Err_Ret =  USART_Invalid_Arg;
 	}
 	else
 	{
-		USART_Err_Ret =  USART_Rx_NoData;
+#if (USART_PROFILE == ENABLE)
+		taskENTER_CRITICAL();
+		memset(USART_Prof[USART_Num], 0, sizeof(USART_Prof[USART_Num]));
+		taskEXIT_CRITICAL();
+#endif
 	}
-
 	return USART_Err_Ret;
 }
 
-/* Debug counters (optional): used to observe buffering/draining behavior while testing. */
-uint8_t Buffering_Counter = 0;
-uint8_t D_C = 0;
-
+#if (USART_TX_DMA == ENABLE)
 /* =========================================================================================
- *                                  USART_SendByte()
+ *                                  USART_SendBuffer()
  * =========================================================================================
  *
- * Application API to send one byte.
- *
- * Polling TX mode:
- *  - First drains queue into HW as long as TXE is ready (reduces backlog)
- *  - If queue empty and TXE ready -> write directly to DR (fast path)
- *  - Otherwise -> push byte into TX queue (buffering path)
+ * Application API to send a whole caller-owned buffer by DMA (zero-copy).
  *
- * Interrupt TX mode:
- *  - Push byte into TX queue inside a critical section
- *  - If TX not active, start the first TX using HAL_UART_Transmit_IT()
- *  - Further bytes are sent in HAL_UART_TxCpltCallback(), chaining until queue empty
+ * Ownership of the transmitter:
+ *  - The DMA transfer claims the transmitter (USART_Tx_State IDLE -> ACTIVE) just
+ *    like the byte IT chain does, so both never run at the same time.
+ *  - Interrupt TX mode: bytes queued by USART_SendByte() during the transfer are
+ *    chained after it completes.
+ *  - Polling TX mode: refused while TX-buffered bytes are pending (keeps ordering);
+ *    the drain path stays away from DR while the DMA is busy.
  *
  * Return values:
- *  - USART_Tx_Ok: byte accepted (sent immediately or queued)
- *  - USART_Tx_Busy: queue full, byte rejected
+ *  - USART_Tx_Ok: transfer started, Done_Cb will be called on completion
+ *  - USART_Tx_Busy: transmitter in use, nothing started (retry later)
  *  - USART_Not_Init / USART_Invalid_Arg: invalid usage
  */
-USART_Err_St_t USART_SendByte(USART_Num_t USART_Num , uint8_t Tx_data)
+USART_Err_St_t USART_SendBuffer(USART_Num_t USART_Num , const uint8_t *Data, uint16_t Len, USART_TxDoneCb_t Done_Cb)
 {
-	USART_Err_St_t USART_Err_Ret =  USART_Tx_Ok;
-	USART_TypeDef *USART_Instance = NULL ;
+	USART_Err_St_t    USART_Err_Ret =  USART_Tx_Busy;
+	HAL_StatusTypeDef Hal_Ret;
 
 	/* Validate arguments. */
-	if(USART_Num >= USART_MAX_NUM )
+	if((USART_Num >= USART_MAX_NUM) || (Data == NULL) || (Len == 0))
 	{
 		USART_Err_Ret =  USART_Invalid_Arg;
 	}
@@ -377,90 +2645,39 @@ USART_Err_St_t USART_SendByte(USART_Num_t USART_Num , uint8_t Tx_data)
 	}
 	else
 	{
-#if USART_TX_INT == DISABLE
-
-		USART_Instance = USART_Handler[USART_Num].Instance;
-
-		/* 1) Drain queued bytes into HW while TXE is ready. */
-		while( (uxQueueMessagesWaiting(USART_Tx_Buffer[USART_Num]) > 0) &&
-			   (LL_USART_IsActiveFlag_TXE(USART_Instance) != RESET) )
+		/* Claim the transmitter atomically against SendByte() and the TX callback. */
+#if (USART_TX_INT == ENABLE)
+		if(USART_Atomic_Cas(&USART_Tx_State[USART_Num], USART_TX_IDLE, USART_TX_ACTIVE))
+#else
+		if((usart_buff_tx_count(USART_Num) == 0) &&
+		   USART_Atomic_Cas(&USART_Tx_State[USART_Num], USART_TX_IDLE, USART_TX_ACTIVE))
+#endif
 		{
-			if(xQueueReceive(USART_Tx_Buffer[USART_Num], &USART_Tx_Byte[USART_Num], 0) == pdPASS)
-			{
-				LL_USART_TransmitData8(USART_Instance, USART_Tx_Byte[USART_Num]);
-				D_C++;
-
-				/* Optional debug: track buffered bytes count. */
-				if(Buffering_Counter > 0)
-				{
-					Buffering_Counter--;
-				}
-			}
-		}
+			USART_Tx_DMA_Busy[USART_Num] = 1;
+			USART_Tx_DMA_Cb[USART_Num]   = Done_Cb;
 
-		/* 2) If nothing buffered and TXE is ready, send directly (no queue latency). */
-		if((uxQueueMessagesWaiting(USART_Tx_Buffer[USART_Num]) == 0) &&
-		   (LL_USART_IsActiveFlag_TXE(USART_Instance) != RESET))
-		{
-			LL_USART_TransmitData8(USART_Instance,Tx_data);
-			D_C++;
-		}
-		else
-		{
-			/* 3) Otherwise buffer the byte in the TX queue. */
-			USART_Tx_Byte[USART_Num] = Tx_data;
+			/* Same handle / CR1 sharing with the port IRQ as usart_tx_chain(). */
+			HAL_NVIC_DisableIRQ(USART_IRQ[USART_Num]);
+			Hal_Ret = HAL_UART_Transmit_DMA(&USART_Handler[USART_Num], Data, Len);
+			HAL_NVIC_EnableIRQ(USART_IRQ[USART_Num]);
 
-			if(xQueueSend(USART_Tx_Buffer[USART_Num], &USART_Tx_Byte[USART_Num], 0) != pdPASS)
+			if(Hal_Ret == HAL_OK)
 			{
-				/* Queue full -> cannot accept new byte. */
-				UBaseType_t Buff_Curr_Count = uxQueueMessagesWaiting(USART_Tx_Buffer[USART_Num]);
-				(void)Buff_Curr_Count; /* Keep local var for debugging (avoid unused warning). */
-
-				USART_Err_Ret =  USART_Tx_Busy;
+				usart_stat_tx(USART_Num, Len);
+				USART_Err_Ret =  USART_Tx_Ok;
 			}
 			else
 			{
-				Buffering_Counter++;
-			}
-		}
-#endif
-
-#if USART_TX_INT == ENABLE
-		/*
-		 * Critical section protects:
-		 *  - Queue operations from concurrent ISR access (Tx callback)
-		 *  - usart_active_flag state from race conditions
-		 *
-		 * NOTE:
-		 *  - FreeRTOS recommends taskENTER_CRITICAL() for short regions only.
-		 *  - Alternative design: use a mutex for task-to-task, and FromISR APIs for ISR.
-		 */
-		taskENTER_CRITICAL();
-
-		USART_Tx_Byte[USART_Num] = Tx_data;
-
-		if(xQueueSend(USART_Tx_Buffer[USART_Num], &USART_Tx_Byte[USART_Num], 0) != pdPASS)
-		{
-			USART_Err_Ret =  USART_Tx_Busy;
-		}
-		else
-		{
-			/* If no active TX in progress, kick-start the interrupt chain. */
-			if(usart_active_flag[USART_Num] == 0)
-			{
-				usart_active_flag[USART_Num] = 1;
-
-				/* Pop first byte and start IT transmit of 1 byte. */
-				xQueueReceive(USART_Tx_Buffer[USART_Num], &USART_Tx_Byte[USART_Num], 0);
-				HAL_UART_Transmit_IT(&USART_Handler[USART_Num], &USART_Tx_Byte[USART_Num], 1);
+				/* HAL refused (handle busy): release the claim, restart bytes queued meanwhile. */
+				USART_Tx_DMA_Busy[USART_Num] = 0;
+				USART_Tx_State[USART_Num]    = USART_TX_IDLE;
+				usart_tx_kick(USART_Num);
 			}
 		}
-
-		taskEXIT_CRITICAL();
-#endif
 	}
 	return USART_Err_Ret;
 }
+#endif
 
 /* =========================================================================================
  *                                  Clock Enable Helpers
@@ -566,9 +2783,11 @@ void usart_gpio_clk_enable(GPIO_TypeDef *port)
  * =========================================================================================
  *
  * HAL_UART_TxCpltCallback():
- *  - Called by HAL when the previously requested IT transmit completes.
- *  - We use it to pop the next byte from the TX queue and start a new IT transfer.
- *  - If queue is empty, clear usart_active_flag -> TX idle.
+ *  - Called by HAL when the previously requested IT or DMA transmit completes.
+ *  - A finished USART_SendBuffer() transfer is reported to its Done_Cb first.
+ *  - In interrupt TX mode we then pop the next byte from the TX queue and start a
+ *    new IT transfer. If queue is empty, let go of the transmitter (usart_tx_release).
+ *  - Polling TX mode: the finished DMA transfer hands the transmitter back to the drain.
  *
  * HAL_UART_RxCpltCallback():
  *  - Called when one byte has been received (Receive_IT length = 1).
@@ -581,83 +2800,381 @@ void usart_gpio_clk_enable(GPIO_TypeDef *port)
  */
 void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 {
-	USART_Num_t USRAT_Num ;
+	/* Map HAL handle to driver logical USART number. */
+	USART_Num_t USRAT_Num = usart_get_num(huart);
+	USART_PROF_START(Prof_Start);
+
+#if (USART_TX_DMA == ENABLE)
+	/* Caller buffer fully sent -> hand it back. */
+	if(USART_Tx_DMA_Busy[USRAT_Num] != 0)
+	{
+		USART_Tx_DMA_Busy[USRAT_Num] = 0;
 
-	/* Map HAL handle instance to driver logical USART number. */
-	if(huart->Instance == USART1)      { USRAT_Num = USART_NUM_1; }
-	else if(huart->Instance == USART2) { USRAT_Num = USART_NUM_2; }
-	else if(huart->Instance == USART3) { USRAT_Num = USART_NUM_3; }
-	else if(huart->Instance == UART4)  { USRAT_Num = USART_NUM_4; }
-	else if(huart->Instance == UART5)  { USRAT_Num = USART_NUM_5; }
-	else                               { USRAT_Num = USART_NUM_6; }
+		if(USART_Tx_DMA_Cb[USRAT_Num] != NULL)
+		{
+			USART_Tx_DMA_Cb[USRAT_Num](USRAT_Num);
+		}
+	}
+#endif
 
+#if (USART_TX_INT == ENABLE) && (USART_FAST_ISR == DISABLE)
 	/* If more bytes queued, continue transmitting next byte. */
-	if(xQueueReceiveFromISR(USART_Tx_Buffer[USRAT_Num], &USART_Tx_Byte[USRAT_Num], NULL) == pdPASS)
+	if(usart_tx_chain_isr(USRAT_Num))
 	{
-		HAL_UART_Transmit_IT(&USART_Handler[USRAT_Num], &USART_Tx_Byte[USRAT_Num], 1);
+		/* Room freed: wake a task blocked in USART_Send() once enough is free. */
+		usart_tx_space_isr(USRAT_Num);
 	}
-	else
+	else if(usart_buff_tx_count(USRAT_Num) == 0)
+	{
+		/* Queue empty (not just paused by XOFF) -> TX idle. */
+		usart_tx_idle_isr(USRAT_Num);
+	}
+#elif (USART_TX_DMA == ENABLE)
+	/* Polling TX: bytes queued meanwhile are drained by the cyclic path. */
+	USART_Tx_State[USRAT_Num] = USART_TX_IDLE;
+	if(usart_buff_tx_count(USRAT_Num) == 0)
 	{
-		/* Queue empty -> mark TX chain inactive. */
-		usart_active_flag[USRAT_Num] = 0;
+		usart_tx_idle_isr(USRAT_Num);
 	}
+#endif
+
+	USART_PROF_STOP(USRAT_Num, USART_PROF_TX_CPLT, Prof_Start);
+#if (USART_TX_DMA == DISABLE) && ((USART_TX_INT == DISABLE) || (USART_FAST_ISR == ENABLE)) && (USART_PROFILE == DISABLE)
+	(void)USRAT_Num;
+#endif
 }
 
 void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
 {
-	USART_Num_t USRAT_Num ;
+	/* Map HAL handle to driver logical USART number. */
+	USART_Num_t USRAT_Num = usart_get_num(huart);
+	USART_PROF_START(Prof_Start);
 
-	/* Map HAL handle instance to driver logical USART number. */
-	if(huart->Instance == USART1)      { USRAT_Num = USART_NUM_1; }
-	else if(huart->Instance == USART2) { USRAT_Num = USART_NUM_2; }
-	else if(huart->Instance == USART3) { USRAT_Num = USART_NUM_3; }
-	else if(huart->Instance == UART4)  { USRAT_Num = USART_NUM_4; }
-	else if(huart->Instance == UART5)  { USRAT_Num = USART_NUM_5; }
-	else                               { USRAT_Num = USART_NUM_6; }
+	/* Push received byte into RX buffer (ISR context). */
+	if(usart_rx_filter(USRAT_Num, USART_Rx_Byte[USRAT_Num]))
+	{
+		usart_stat_rx(USRAT_Num, 1U, (usart_rx_store_isr(USRAT_Num, USART_Rx_Byte[USRAT_Num]) == 0U));
+	}
+	else
+	{
+		usart_stat_rx(USRAT_Num, 1U, 0U);
+	}
 
-	/* Push received byte into RX queue (ISR context). */
-	xQueueSendFromISR(USART_Rx_Buffer[USRAT_Num], &USART_Rx_Byte[USRAT_Num], NULL);
+	/* Wake a task blocked in USART_Receive() / the registered event task. */
+	usart_rx_signal_isr(USRAT_Num);
 
 	/* Restart single-byte reception for continuous stream capture. */
 	HAL_UART_Receive_IT(&USART_Handler[USRAT_Num], &USART_Rx_Byte[USRAT_Num], 1);
+
+	USART_PROF_STOP(USRAT_Num, USART_PROF_RX_CPLT, Prof_Start);
+}
+
+#if (USART_RX_DMA == ENABLE)
+/*
+ * HAL_UARTEx_RxEventCallback():
+ *  - Called on DMA half-transfer, DMA transfer-complete and USART IDLE-line events.
+ *  - Size is the current DMA write offset in USART_Rx_DMA_Buff[] (1..USART_RX_DMA_SIZE).
+ *  - Everything between the last handled offset and Size is moved to the RX buffer in
+ *    at most two chunks (the second one when the DMA wrapped around).
+ */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+	USART_Num_t USRAT_Num = usart_get_num(huart);
+	uint16_t    Last_Pos  = USART_Rx_DMA_Pos[USRAT_Num];
+
+	if(Size != Last_Pos)
+	{
+		if(Size > Last_Pos)
+		{
+			/* Linear region: [Last_Pos .. Size). */
+			usart_rx_write_isr(USRAT_Num, &USART_Rx_DMA_Buff[USRAT_Num][Last_Pos], Size - Last_Pos);
+		}
+		else
+		{
+			/* Wrapped: [Last_Pos .. end) then [0 .. Size). */
+			usart_rx_write_isr(USRAT_Num, &USART_Rx_DMA_Buff[USRAT_Num][Last_Pos], USART_RX_DMA_SIZE - Last_Pos);
+			usart_rx_write_isr(USRAT_Num, &USART_Rx_DMA_Buff[USRAT_Num][0], Size);
+		}
+
+		/* Transfer-complete reports Size == buffer size: next data starts at offset 0. */
+		USART_Rx_DMA_Pos[USRAT_Num] = (Size == USART_RX_DMA_SIZE) ? 0U : Size;
+
+		/* Wake a task blocked in USART_Receive() / the registered event task. */
+		usart_rx_signal_isr(USRAT_Num);
+	}
+}
+#endif
+
+/*
+ * HAL_UART_ErrorCallback():
+ *  - Count the line errors HAL reported (ORE/FE/NE/PE) for USART_GetStats().
+ *  - HAL aborts reception on blocking errors (overrun, or any error while RX DMA
+ *    is active). Restart it so one line glitch does not silence the port forever.
+ */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+	USART_Num_t USRAT_Num = usart_get_num(huart);
+
+	usart_stat_hal_err(USRAT_Num, huart->ErrorCode);
+
+	if(huart->RxState == HAL_UART_STATE_READY)
+	{
+#if (USART_RX_DMA == ENABLE)
+		usart_rx_dma_start(USRAT_Num);
+#elif (USART_RX_INT == ENABLE)
+		HAL_UART_Receive_IT(&USART_Handler[USRAT_Num], &USART_Rx_Byte[USRAT_Num], 1);
+#else
+		(void)USRAT_Num;
+#endif
+	}
 }
 
 /* =========================================================================================
  *                                   IRQ Handlers
  * =========================================================================================
  *
- * Each IRQ handler forwards the interrupt to HAL_UART_IRQHandler() with the proper handle.
- * HAL then calls the relevant callbacks (TxCplt/RxCplt/Error, etc.).
+ * Default: each IRQ handler forwards the interrupt to HAL_UART_IRQHandler() with the
+ * proper handle. HAL then calls the relevant callbacks (TxCplt/RxCplt/Error, etc.).
+ *
+ * USART_FAST_ISR: each IRQ handler calls usart_irq_fast() with constant arguments, so
+ * the compiler inlines one specialised register-level handler per port.
  *
  * NOTE:
  *  - These handlers must match the vector table names for STM32F4 startup code.
  */
+#if (USART_FAST_ISR == ENABLE)
+/*
+ * usart_irq_fast():
+ *  - RX: while RXNE (or ORE) is set, read DR straight into the RX buffer. Reading SR
+ *    then DR also clears ORE/NE/FE/PE, so a line error cannot lock the IRQ up.
+ *  - TX: while TXE is set and TXEIE armed, write the next buffered byte to DR. When
+ *    the buffer runs empty, disarm TXEIE and let go of the transmitter
+ *    (usart_tx_release) for the next usart_tx_kick().
+ *  - Wake-ups for blocked tasks are raised once per interrupt, not per byte.
+ *  - Registers are accessed through LL_USART_ReadReg/WriteReg (plain volatile accesses
+ *    on target) so the host simulation (Sim/) can model the SR/DR side effects.
+ */
+static inline __attribute__((always_inline)) void usart_irq_fast(USART_Num_t USART_Num, USART_TypeDef *USART_Instance)
+{
+	uint32_t Sr = LL_USART_ReadReg(USART_Instance, SR);
+
+#if (USART_RX_INT == ENABLE)
+	uint8_t Received = 0;
+
+	while((Sr & (USART_SR_RXNE | USART_SR_ORE)) != 0U)
+	{
+		uint8_t Data = (uint8_t)LL_USART_ReadReg(USART_Instance, DR);
+
+		usart_stat_sr(USART_Num, Sr);
+		if(usart_rx_filter(USART_Num, Data))
+		{
+			usart_stat_rx(USART_Num, 1U, (usart_rx_store_isr(USART_Num, Data) == 0U));
+		}
+		else
+		{
+			usart_stat_rx(USART_Num, 1U, 0U);
+		}
+		Received = 1;
+		Sr = LL_USART_ReadReg(USART_Instance, SR);
+	}
+
+	if(Received != 0)
+	{
+		usart_rx_signal_isr(USART_Num);
+	}
+#endif
+
+#if (USART_TX_INT == ENABLE)
+	if((LL_USART_ReadReg(USART_Instance, CR1) & USART_CR1_TXEIE) != 0U)
+	{
+		uint8_t Sent = 0;
+
+		while((Sr & USART_SR_TXE) != 0U)
+		{
+			if(usart_tx_next_isr(USART_Num, &USART_Tx_Byte[USART_Num]))
+			{
+				LL_USART_WriteReg(USART_Instance, DR, USART_Tx_Byte[USART_Num]);
+				Sent = 1;
+				Sr = LL_USART_ReadReg(USART_Instance, SR);
+			}
+			else
+			{
+				/* Nothing left: stop TXE interrupts, next send re-arms via usart_tx_kick(). */
+				LL_USART_DisableIT_TXE(USART_Instance);
+				if(usart_tx_release(USART_Num))
+				{
+					/* Handed back meanwhile: continue on the next TXE interrupt. */
+					LL_USART_EnableIT_TXE(USART_Instance);
+				}
+				else if(usart_buff_tx_count(USART_Num) == 0)
+				{
+					usart_tx_idle_isr(USART_Num);
+				}
+				break;
+			}
+		}
+
+		if(Sent != 0)
+		{
+			usart_tx_space_isr(USART_Num);
+		}
+	}
+#endif
+}
+
+void USART1_IRQHandler(void)
+{
+	USART_PROF_START(Prof_Start);
+	usart_irq_fast(USART_NUM_1, USART1);
+	USART_PROF_STOP(USART_NUM_1, USART_PROF_IRQ, Prof_Start);
+}
+
+void USART2_IRQHandler(void)
+{
+	USART_PROF_START(Prof_Start);
+	usart_irq_fast(USART_NUM_2, USART2);
+	USART_PROF_STOP(USART_NUM_2, USART_PROF_IRQ, Prof_Start);
+}
+
+void USART3_IRQHandler(void)
+{
+	USART_PROF_START(Prof_Start);
+	usart_irq_fast(USART_NUM_3, USART3);
+	USART_PROF_STOP(USART_NUM_3, USART_PROF_IRQ, Prof_Start);
+}
+
+void UART4_IRQHandler(void)
+{
+	USART_PROF_START(Prof_Start);
+	usart_irq_fast(USART_NUM_4, UART4);
+	USART_PROF_STOP(USART_NUM_4, USART_PROF_IRQ, Prof_Start);
+}
+
+void UART5_IRQHandler(void)
+{
+	USART_PROF_START(Prof_Start);
+	usart_irq_fast(USART_NUM_5, UART5);
+	USART_PROF_STOP(USART_NUM_5, USART_PROF_IRQ, Prof_Start);
+}
+
+void USART6_IRQHandler(void)
+{
+	USART_PROF_START(Prof_Start);
+	usart_irq_fast(USART_NUM_6, USART6);
+	USART_PROF_STOP(USART_NUM_6, USART_PROF_IRQ, Prof_Start);
+}
+#else
 void USART1_IRQHandler(void)
 {
+	USART_PROF_START(Prof_Start);
 	HAL_UART_IRQHandler(&USART_Handler[USART_NUM_1]);
+	USART_PROF_STOP(USART_NUM_1, USART_PROF_IRQ, Prof_Start);
 }
 
 void USART2_IRQHandler(void)
 {
+	USART_PROF_START(Prof_Start);
 	HAL_UART_IRQHandler(&USART_Handler[USART_NUM_2]);
+	USART_PROF_STOP(USART_NUM_2, USART_PROF_IRQ, Prof_Start);
 }
 
 void USART3_IRQHandler(void)
 {
+	USART_PROF_START(Prof_Start);
 	HAL_UART_IRQHandler(&USART_Handler[USART_NUM_3]);
+	USART_PROF_STOP(USART_NUM_3, USART_PROF_IRQ, Prof_Start);
 }
 
 void UART4_IRQHandler(void)
 {
+	USART_PROF_START(Prof_Start);
 	HAL_UART_IRQHandler(&USART_Handler[USART_NUM_4]);
+	USART_PROF_STOP(USART_NUM_4, USART_PROF_IRQ, Prof_Start);
 }
 
 void UART5_IRQHandler(void)
 {
+	USART_PROF_START(Prof_Start);
 	HAL_UART_IRQHandler(&USART_Handler[USART_NUM_5]);
+	USART_PROF_STOP(USART_NUM_5, USART_PROF_IRQ, Prof_Start);
 }
 
 void USART6_IRQHandler(void)
 {
+	USART_PROF_START(Prof_Start);
 	HAL_UART_IRQHandler(&USART_Handler[USART_NUM_6]);
+	USART_PROF_STOP(USART_NUM_6, USART_PROF_IRQ, Prof_Start);
+}
+#endif
+
+#if (USART_RX_DMA == ENABLE)
+/*
+ * RX DMA stream IRQ handlers: forward to HAL_DMA_IRQHandler(), which reports
+ * half-transfer / transfer-complete through HAL_UARTEx_RxEventCallback().
+ */
+void DMA2_Stream2_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&USART_Rx_DMA_Handler[USART_NUM_1]);
+}
+
+void DMA1_Stream5_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&USART_Rx_DMA_Handler[USART_NUM_2]);
+}
+
+void DMA1_Stream1_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&USART_Rx_DMA_Handler[USART_NUM_3]);
+}
+
+void DMA1_Stream2_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&USART_Rx_DMA_Handler[USART_NUM_4]);
+}
+
+void DMA1_Stream0_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&USART_Rx_DMA_Handler[USART_NUM_5]);
+}
+
+void DMA2_Stream1_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&USART_Rx_DMA_Handler[USART_NUM_6]);
+}
+#endif
+
+#if (USART_TX_DMA == ENABLE)
+/*
+ * TX DMA stream IRQ handlers: forward to HAL_DMA_IRQHandler(). HAL then enables the
+ * USART TC interrupt, and HAL_UART_TxCpltCallback() runs once the last bit is out.
+ */
+void DMA2_Stream7_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&USART_Tx_DMA_Handler[USART_NUM_1]);
 }
+
+void DMA1_Stream6_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&USART_Tx_DMA_Handler[USART_NUM_2]);
+}
+
+void DMA1_Stream3_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&USART_Tx_DMA_Handler[USART_NUM_3]);
+}
+
+void DMA1_Stream4_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&USART_Tx_DMA_Handler[USART_NUM_4]);
+}
+
+void DMA1_Stream7_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&USART_Tx_DMA_Handler[USART_NUM_5]);
+}
+
+void DMA2_Stream6_IRQHandler(void)
+{
+	HAL_DMA_IRQHandler(&USART_Tx_DMA_Handler[USART_NUM_6]);
+}
+#endif
@@ -19,17 +19,36 @@
  *   1) Call USART_Init(USART_NUM_x) once per needed instance.
  *   2) For sending:
  *        - USART_SendByte() queues/sends one byte (non-blocking).
+ *        - USART_Send() queues a whole span, blocking up to a timeout for space.
+ *        - USART_TxReserve() / USART_TxWrite() / USART_TxCommit() build one message
+ *          in place when several tasks share a port (ring backend).
+ *        - USART_TxAcquire() / USART_TxPublish() let a serializer write straight
+ *          into the TX buffer, without a staging copy (ring backend).
  *   3) For receiving:
  *        - USART_ReceiveByte() reads one byte from RX queue (non-blocking).
- *   4) If interrupts are DISABLED for TX/RX, call:
+ *        - USART_Receive() reads up to N bytes, blocking up to a timeout for data.
+ *        - USART_RxPeek() / USART_RxConsume() parse in place, without a copy (ring backend).
+ *   4) With USART_TX_DMA enabled:
+ *        - USART_SendBuffer() transmits a caller-owned buffer by DMA (zero-copy).
+ *   5) Diagnostics:
+ *        - USART_GetStats() / USART_ResetStats() expose per-port byte, line error,
+ *          drop and high-water counters.
+ *   6) Event-driven consumers:
+ *        - USART_SetEventTask() registers a task that gets USART_EVT_RX/TX bits
+ *          from the ISR, so no polling task is needed in interrupt/DMA modes.
+ *   7) Baud rate at runtime:
+ *        - USART_SetBaud() drains TX and reprograms BRR; USART_GetBaud() reads it back.
+ *        - USART_AutoBaud() (USART_AUTOBAUD == ENABLE) measures a 0x55 sync byte
+ *          from the peer with a timer input capture and switches to its rate.
+ *   8) If interrupts are DISABLED for TX/RX, call:
  *        - USART_TxCyclic() periodically to drain TX queue into hardware
  *        - USART_RxCyclic() periodically to move HW RX bytes into RX queue
  *
  *  Notes:
  *  ------
  *  - USART_Num_t is an index (0..USART_MAX_NUM-1). It must match config tables.
- *  - This interface is byte-oriented by design (simple + portable).
- *  - Consider adding future APIs for strings/buffers/timeouts if needed.
+ *  - The byte APIs never block; USART_Send/USART_Receive block on a task
+ *    notification (no polling) until space/data is available or the timeout expires.
  * =========================================================================================
  */
 
@@ -38,6 +57,9 @@
 
 #include <stdint.h>   /* for uint8_t */
 
+#include "FreeRTOS.h" /* for TaskHandle_t (event task registration) */
+#include "task.h"
+
 /* =========================================================================================
  *                               Driver Return / Error States
  * =========================================================================================
@@ -62,6 +84,9 @@
  *
  * USART_Tx_Ok / USART_Tx_Busy:
  *  - TX byte accepted (sent or queued) / rejected due to full queue.
+ *
+ * USART_Ok:
+ *  - Generic success for configuration/query APIs (events, statistics, ...).
  */
 typedef enum USART_Err_St_e
 {
@@ -74,6 +99,7 @@ typedef enum USART_Err_St_e
 	USART_Rx_NoData,
 	USART_Tx_Busy,
 	USART_Tx_Ok,
+	USART_Ok,
 } USART_Err_St_t;
 
 /* =========================================================================================
@@ -99,6 +125,137 @@ typedef uint8_t USART_Num_t;
 #define USART_NUM_5    ((USART_Num_t)4)
 #define USART_NUM_6    ((USART_Num_t)5)
 
+/*
+ * USART_TxDoneCb_t:
+ *  - Completion callback for USART_SendBuffer().
+ *  - Called from interrupt context once the whole buffer left the transmitter;
+ *    the buffer may be reused or freed from this point on.
+ *  - Keep it short; use FromISR RTOS APIs only (e.g. vTaskNotifyGiveFromISR).
+ */
+typedef void (*USART_TxDoneCb_t)(USART_Num_t USART_Num);
+
+/*
+ * USART_RxHook_t:
+ *  - Stream consumer for received bytes (USART_SetRxHook), replacing the RX buffer.
+ *  - Called from interrupt context (or from USART_RxCyclic() with RX polling), with
+ *    one byte per call, or a whole DMA chunk with USART_RX_DMA.
+ *  - Keep it short; use FromISR RTOS APIs only.
+ */
+typedef void (*USART_RxHook_t)(USART_Num_t USART_Num, const uint8_t *Data, uint32_t Len);
+
+/*
+ * USART_TxResv_t:
+ *  - A TX buffer range owned by one task (USART_TxReserve .. USART_TxCommit, or
+ *    USART_TxAcquire .. USART_TxPublish).
+ *  - Pos / Len: reserved range, Used: bytes written so far by USART_TxWrite().
+ *  - Opaque to the application; lives on the caller's stack.
+ *  - While a task holds one, it must not send anything else on that port
+ *    (USART_SendByte / USART_Send / printf on USART_STDIO_PORT, another span):
+ *    those bytes are queued behind the open range and only go out after it is
+ *    committed, and a blocking send that needs the space the range pins can
+ *    only time out. Other tasks may keep sending on the port.
+ */
+typedef struct
+{
+	USART_Num_t USART_Num;
+	uint32_t    Pos;
+	uint32_t    Len;
+	uint32_t    Used;
+} USART_TxResv_t;
+
+/*
+ * Timeout helpers for blocking APIs (USART_Send / USART_Receive), in milliseconds.
+ */
+#define USART_NO_WAIT        ((uint32_t)0U)
+#define USART_WAIT_FOREVER   ((uint32_t)0xFFFFFFFFU)
+
+/*
+ * Sync byte the peer sends for USART_AutoBaud(): 0x55 alternates every bit, so the
+ * line has a falling edge every two bit times.
+ */
+#define USART_AUTOBAUD_SYNC  ((uint8_t)0x55U)
+
+/*
+ * Event notification (USART_SetEventTask):
+ *
+ * USART_EVENT_NOTIFY_INDEX:
+ *  - Task-notification index the events are written to (eSetBits).
+ *    Wait with xTaskNotifyWaitIndexed(USART_EVENT_NOTIFY_INDEX, 0, ULONG_MAX, &bits, ...).
+ *
+ * USART_EVT_RX(num) / USART_EVT_TX(num):
+ *  - Per-port bits, so one task can serve several USARTs:
+ *      RX: new data available in the RX buffer
+ *      TX: TX buffer fully drained (room for a whole new message)
+ */
+#define USART_EVENT_NOTIFY_INDEX   0U
+#define USART_EVT_RX(num)          ((uint32_t)1U << (num))
+#define USART_EVT_TX(num)          ((uint32_t)1U << ((num) + 8U))
+
+/*
+ * USART_Stats_t (USART_GetStats):
+ *
+ * Rx_Bytes / Tx_Bytes:
+ *  - Bytes taken from the receiver / handed to the transmitter (DR or DMA)
+ *
+ * Overrun / Framing / Noise / Parity:
+ *  - Line errors flagged by the USART (ORE / FE / NE / PE). An overrun means at
+ *    least one byte was lost in hardware because DR was not read in time.
+ *
+ * Rx_Drops:
+ *  - Received bytes discarded because the RX buffer was full
+ *
+ * Rx_High_Water / Tx_High_Water:
+ *  - Highest RX / TX buffer fill level seen (bytes); compare with the buffer size
+ *    to see how close the port came to dropping data
+ */
+typedef struct USART_Stats_s
+{
+	uint32_t Rx_Bytes;
+	uint32_t Tx_Bytes;
+	uint32_t Overrun;
+	uint32_t Framing;
+	uint32_t Noise;
+	uint32_t Parity;
+	uint32_t Rx_Drops;
+	uint32_t Rx_High_Water;
+	uint32_t Tx_High_Water;
+} USART_Stats_t;
+
+/*
+ * USART_Prof_Point_t (USART_GetProfile, USART_PROFILE == ENABLE):
+ *  - Instrumented hot paths. TX/RX_CYCLIC time one port's share of the cyclic
+ *    routine; TX/RX_CPLT are the HAL completion callbacks (not reached with
+ *    USART_FAST_ISR); IRQ is the whole USARTx_IRQHandler() including callbacks.
+ *
+ * USART_Prof_t:
+ *  - Cycle counts (DWT->CYCCNT) of one probe point: Count calls, Min / Max,
+ *    Total for the mean (Total / Count).
+ *  - Hist[i] counts calls that took [2^i, 2^(i+1)) cycles (Hist[0]: 0..1 cycles);
+ *    the last bin also takes everything longer.
+ */
+typedef enum USART_Prof_Point_e
+{
+	USART_PROF_SEND_BYTE = 0,
+	USART_PROF_RECEIVE_BYTE,
+	USART_PROF_TX_CYCLIC,
+	USART_PROF_RX_CYCLIC,
+	USART_PROF_TX_CPLT,
+	USART_PROF_RX_CPLT,
+	USART_PROF_IRQ,
+	USART_PROF_POINTS
+} USART_Prof_Point_t;
+
+#define USART_PROF_BINS    16U
+
+typedef struct USART_Prof_s
+{
+	uint32_t Count;
+	uint32_t Min;
+	uint32_t Max;
+	uint64_t Total;
+	uint32_t Hist[USART_PROF_BINS];
+} USART_Prof_t;
+
 /* =========================================================================================
  *                                  Public API Prototypes
  * =========================================================================================
@@ -131,6 +288,217 @@ USART_Err_St_t USART_ReceiveByte(USART_Num_t USART_Num , uint8_t *Rx_data);
  */
 USART_Err_St_t USART_SendByte(USART_Num_t USART_Num , uint8_t Tx_data);
 
+/**
+ * @brief  Send Len bytes, blocking until all are buffered or the timeout expires.
+ *         Copies contiguous spans into the TX buffer (one copy per wrap with the ring
+ *         backend) and sleeps on a task notification while the buffer is full.
+ * @param  USART_Num   Logical USART instance ID
+ * @param  Data        Bytes to send
+ * @param  Len         Number of bytes
+ * @param  Timeout_Ms  Max time to wait for TX space (USART_NO_WAIT / USART_WAIT_FOREVER)
+ * @return USART_Tx_Ok if all bytes were accepted, USART_Tx_Busy on timeout (a prefix
+ *         of Data may already be queued), or error codes for invalid args/not init.
+ * @note   Task context only. In polling TX mode the caller also drains the hardware
+ *         itself between waits, so it works even without a USART_TxCyclic() task.
+ */
+USART_Err_St_t USART_Send(USART_Num_t USART_Num , const uint8_t *Data, uint32_t Len, uint32_t Timeout_Ms);
+
+/**
+ * @brief  Reserve Len contiguous bytes in the TX buffer (USART_BUFF_RING backend).
+ *         The reservation is taken with an atomic compare-and-swap, so several tasks
+ *         can build messages on one port at the same time without a mutex; each
+ *         message goes out contiguously, in reservation order.
+ * @param  USART_Num   Logical USART instance ID
+ * @param  Len         Bytes to reserve (1..Tx_Buff_Size)
+ * @param  Timeout_Ms  Max time to wait for TX space (USART_NO_WAIT / USART_WAIT_FOREVER)
+ * @param  Resv        Reservation handle, passed to USART_TxWrite() / USART_TxCommit()
+ * @return USART_Tx_Ok, USART_Tx_Busy on timeout, or error codes for invalid args/not init.
+ * @note   Task context only. Commit promptly: later writes on the same port are
+ *         held back until this one is committed. See USART_TxResv_t for what the
+ *         holder must not do meanwhile.
+ */
+USART_Err_St_t USART_TxReserve(USART_Num_t USART_Num , uint32_t Len, uint32_t Timeout_Ms, USART_TxResv_t *Resv);
+
+/**
+ * @brief  Append Len bytes to a reservation.
+ * @return USART_Tx_Ok, or USART_Invalid_Arg if the data does not fit the reservation.
+ */
+USART_Err_St_t USART_TxWrite(USART_TxResv_t *Resv, const uint8_t *Data, uint32_t Len);
+
+/**
+ * @brief  Publish a reservation to the transmitter and start it if idle.
+ *         Only the bytes written by USART_TxWrite() are sent. Unwritten bytes
+ *         are given back if no later reservation exists; otherwise their slots
+ *         stay taken until the transmitter steps over them.
+ * @return USART_Tx_Ok, or USART_Invalid_Arg for an unknown / already committed handle.
+ * @note   The handle is spent in every case except USART_Invalid_Arg.
+ */
+USART_Err_St_t USART_TxCommit(USART_TxResv_t *Resv);
+
+/**
+ * @brief  Get a writable span of the TX buffer to encode a message in place
+ *         (USART_BUFF_RING backend). Never blocks.
+ * @param  USART_Num  Logical USART instance ID
+ * @param  Want       Bytes wanted (>= 1)
+ * @param  Resv       Span handle (caller-owned), passed to USART_TxPublish()
+ * @param  Data       Receives a pointer to the span
+ * @param  Got        Receives the span length: up to Want, less when the TX buffer
+ *                    is nearly full or the span reaches the end of the buffer
+ * @return USART_Tx_Ok if *Got > 0, USART_Tx_Busy if the TX buffer is full,
+ *         USART_Invalid_Arg or USART_Not_Init.
+ * @note   Task context only. Every span acquired must be published, also on error
+ *         paths (USART_TxPublish(Resv, 0) releases it): later writes on the port
+ *         are held back until it is. See USART_TxResv_t for what the holder must
+ *         not do meanwhile.
+ */
+USART_Err_St_t USART_TxAcquire(USART_Num_t USART_Num , uint32_t Want, USART_TxResv_t *Resv, uint8_t **Data, uint32_t *Got);
+
+/**
+ * @brief  Send the first Len bytes written into a span from USART_TxAcquire(),
+ *         starting the transmitter if it is idle.
+ * @param  Resv  Span handle
+ * @param  Len   Bytes written (0..*Got)
+ * @return USART_Tx_Ok: exactly Len bytes sent, the rest of the span given back
+ *         (or, while a later reservation pins the span's end, skipped when sent).
+ *         USART_Invalid_Arg: unknown / spent handle or Len too large; the span stays
+ *         open and must still be published.
+ */
+USART_Err_St_t USART_TxPublish(USART_TxResv_t *Resv, uint32_t Len);
+
+/**
+ * @brief  Receive up to Max_Len bytes. Returns as soon as at least one byte is
+ *         available, blocking on a task notification up to Timeout_Ms otherwise.
+ * @param  USART_Num   Logical USART instance ID
+ * @param  Data        Destination buffer
+ * @param  Max_Len     Destination capacity
+ * @param  Timeout_Ms  Max time to wait for data (USART_NO_WAIT / USART_WAIT_FOREVER)
+ * @param  Rx_Len      Returns number of bytes copied (may be NULL)
+ * @return USART_Rx_Ok if at least one byte was read, USART_Rx_NoData on timeout,
+ *         or error codes for invalid args/not init.
+ * @note   Task context only. One reader task per USART.
+ */
+USART_Err_St_t USART_Receive(USART_Num_t USART_Num , uint8_t *Data, uint32_t Max_Len, uint32_t Timeout_Ms, uint32_t *Rx_Len);
+
+/**
+ * @brief  Expose the oldest received bytes in place (USART_BUFF_RING backend), so a
+ *         parser can run on the RX buffer without copying. Never blocks.
+ * @param  USART_Num  Logical USART instance ID
+ * @param  Data       Receives a pointer to the first unread byte
+ * @param  Len        Receives the length of the contiguous span at *Data; bytes past
+ *                    the end of the buffer show up in the next span
+ * @return USART_Rx_Ok if *Len > 0, USART_Rx_NoData if the buffer is empty,
+ *         or error codes for invalid args/not init.
+ * @note   Task context only, same single reader as USART_Receive(). The span stays
+ *         valid and unchanged until USART_RxConsume() releases it.
+ */
+USART_Err_St_t USART_RxPeek(USART_Num_t USART_Num , const uint8_t **Data, uint32_t *Len);
+
+/**
+ * @brief  Release Len bytes from the start of the RX buffer (after USART_RxPeek()).
+ * @return USART_Rx_Ok, USART_Invalid_Arg if fewer than Len bytes are stored,
+ *         or USART_Not_Init.
+ */
+USART_Err_St_t USART_RxConsume(USART_Num_t USART_Num , uint32_t Len);
+
+/**
+ * @brief  Register the consumer task for RX/TX events (NULL to unregister).
+ * @param  USART_Num  Logical USART instance ID
+ * @param  Task       Task handle notified with USART_EVT_RX/TX(USART_Num) bits
+ * @return USART_Ok, or USART_Invalid_Arg for a bad USART number.
+ */
+USART_Err_St_t USART_SetEventTask(USART_Num_t USART_Num , TaskHandle_t Task);
+
+/**
+ * @brief  Register a stream consumer for the received bytes (NULL to unregister).
+ *         While set, received bytes go to Hook instead of the RX buffer.
+ * @param  USART_Num  Logical USART instance ID
+ * @param  Hook       Consumer, called from ISR context (see USART_RxHook_t)
+ * @return USART_Ok, or USART_Invalid_Arg for a bad USART number.
+ */
+USART_Err_St_t USART_SetRxHook(USART_Num_t USART_Num , USART_RxHook_t Hook);
+
+/**
+ * @brief  Change the baud rate of an initialized port at runtime.
+ *         Waits until everything queued so far has left the pin, then reprograms BRR.
+ * @param  USART_Num  Logical USART instance ID
+ * @param  Baud       New rate (reachable from the port clock with the configured oversampling)
+ * @return USART_Ok, USART_Tx_Busy if TX stopped draining (flow control) or was
+ *         refilled just before BRR was written (rate unchanged in both cases),
+ *         USART_Invalid_Arg for a bad USART number / rate, or USART_Not_Init.
+ * @note   Task context only. Bytes sent by other tasks during the call never go out
+ *         at the new rate; received bytes are not drained, so switch between frames.
+ */
+USART_Err_St_t USART_SetBaud(USART_Num_t USART_Num , uint32_t Baud);
+
+/**
+ * @brief  Current baud rate of a port (the USART_Config[] rate until USART_SetBaud()).
+ * @return USART_Ok, USART_Invalid_Arg for a bad USART number / NULL pointer, or USART_Not_Init.
+ */
+USART_Err_St_t USART_GetBaud(USART_Num_t USART_Num , uint32_t *Baud);
+
+/**
+ * @brief  Auto-baud (USART_AUTOBAUD == ENABLE): wait for the peer's sync byte
+ *         (USART_AUTOBAUD_SYNC, 0x55), measure it with the port's capture timer and
+ *         switch the port to that rate (USART_SetBaud). The sync byte is consumed.
+ * @param  USART_Num   Logical USART instance ID (with a capture timer, see USART_AutoBaud.c)
+ * @param  Timeout_Ms  Max time to wait for the sync byte (USART_NO_WAIT / USART_WAIT_FOREVER)
+ * @param  Baud        Returns the rate locked onto (may be NULL)
+ * @return USART_Ok, USART_Rx_NoData on timeout (rate unchanged), USART_Tx_Busy (see
+ *         USART_SetBaud), USART_Invalid_Arg for a port without capture timer, or USART_Not_Init.
+ * @note   Task context only. The receiver is off during the measurement.
+ */
+USART_Err_St_t USART_AutoBaud(USART_Num_t USART_Num , uint32_t Timeout_Ms, uint32_t *Baud);
+
+/**
+ * @brief  Copy the error/throughput counters of one USART (USART_STATS == ENABLE).
+ * @param  USART_Num  Logical USART instance ID
+ * @param  Stats      Destination for the snapshot (all zero if statistics are disabled)
+ * @return USART_Ok, or USART_Invalid_Arg for a bad USART number / NULL pointer.
+ */
+USART_Err_St_t USART_GetStats(USART_Num_t USART_Num , USART_Stats_t *Stats);
+
+/**
+ * @brief  Clear all counters and high-water marks of one USART.
+ * @param  USART_Num  Logical USART instance ID
+ * @return USART_Ok, or USART_Invalid_Arg for a bad USART number.
+ */
+USART_Err_St_t USART_ResetStats(USART_Num_t USART_Num);
+
+/**
+ * @brief  Copy the cycle profile of one probe point (USART_PROFILE == ENABLE).
+ * @param  USART_Num  Logical USART instance ID
+ * @param  Point      Probe point (USART_PROF_SEND_BYTE .. USART_PROF_IRQ)
+ * @param  Prof       Destination for the snapshot (all zero if profiling is disabled)
+ * @return USART_Ok, or USART_Invalid_Arg for a bad USART number / point / NULL pointer.
+ */
+USART_Err_St_t USART_GetProfile(USART_Num_t USART_Num , USART_Prof_Point_t Point, USART_Prof_t *Prof);
+
+/**
+ * @brief  Clear the cycle profiles of all probe points of one USART.
+ * @param  USART_Num  Logical USART instance ID
+ * @return USART_Ok, or USART_Invalid_Arg for a bad USART number.
+ */
+USART_Err_St_t USART_ResetProfile(USART_Num_t USART_Num);
+
+/**
+ * @brief  Number of printf() spans dropped by the USART stdout retarget
+ *         (USART_STDIO == ENABLE): no TX room under the no-wait policy, or
+ *         printed from an ISR. Always 0 with USART_STDIO disabled.
+ */
+uint32_t USART_StdioDropped(void);
+
+/**
+ * @brief  Zero-copy transmit of a caller-owned buffer via DMA (USART_TX_DMA == ENABLE).
+ *         The buffer is NOT copied: it must stay valid and unchanged until Done_Cb runs.
+ * @param  USART_Num  Logical USART instance ID
+ * @param  Data       Buffer to send (must be DMA-accessible, i.e. not in CCM RAM)
+ * @param  Len        Number of bytes (1..65535)
+ * @param  Done_Cb    Completion callback (ISR context), may be NULL
+ * @return USART_Tx_Ok if the transfer started, USART_Tx_Busy if the transmitter is
+ *         in use (DMA in flight or byte TX pending), or error codes for invalid args/not init.
+ */
+USART_Err_St_t USART_SendBuffer(USART_Num_t USART_Num , const uint8_t *Data, uint16_t Len, USART_TxDoneCb_t Done_Cb);
+
 /**
  * @brief  Polling RX service routine (only used when RX interrupts are disabled).
  *         Moves bytes from hardware DR into RX queue.
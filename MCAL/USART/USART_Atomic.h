@@ -0,0 +1,53 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Atomic.h
+ *  Author    : Ahmed
+ *  Created   : Feb 12, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Lock-free 32-bit compare-and-swap used by the USART driver where several
+ *  producers (tasks, ISRs) update the same word without a critical section.
+ *
+ *  Target (Cortex-M4): LDREX / STREX exclusive access. The store fails if any
+ *  other access to the monitor (another context, an exception entry/exit) came
+ *  in between, so a failed CAS is simply retried by the caller.
+ *  Host builds: GCC __atomic builtins.
+ * =========================================================================================
+ */
+
+#ifndef USART_USART_ATOMIC_H_
+#define USART_USART_ATOMIC_H_
+
+#include <stdint.h>
+
+#if defined(__ARM_ARCH)
+#include "stm32f4xx.h"   /* CMSIS __LDREXW / __STREXW / __CLREX */
+#endif
+
+/**
+ * @brief  Atomically replace *Addr with Desired if it still holds Expected.
+ * @return 1 if the swap happened, 0 if *Addr changed (or the exclusive store was
+ *         interrupted); re-read and retry in that case.
+ */
+static inline uint8_t USART_Atomic_Cas(volatile uint32_t *Addr, uint32_t Expected, uint32_t Desired)
+{
+#if defined(__ARM_ARCH)
+	uint8_t ret = 0;
+
+	if(__LDREXW(Addr) == Expected)
+	{
+		ret = (__STREXW(Desired, Addr) == 0U);
+	}
+	else
+	{
+		/* Drop the exclusive reservation taken by LDREX. */
+		__CLREX();
+	}
+	return ret;
+#else
+	return (uint8_t)__atomic_compare_exchange_n(Addr, &Expected, Desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
+#endif /* USART_USART_ATOMIC_H_ */
@@ -0,0 +1,391 @@
+/*
+ * =========================================================================================
+ *  File      : USART_AutoBaud.c
+ *  Author    : Ahmed
+ *  Created   : Feb 24, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Auto-baud detection (USART_AutoBaud, USART_AUTOBAUD == ENABLE).
+ *
+ *  The STM32F4 USART has no hardware auto-baud, so the peer's sync byte is timed
+ *  with a general-purpose timer on the RX pin instead:
+ *   1) The receiver is switched off and the RX pin is given to the timer's input
+ *      capture channel (alternate function), capturing falling edges.
+ *   2) USART_AUTOBAUD_SYNC (0x55) on the wire, LSB first:
+ *
+ *        idle  S  1  0  1  0  1  0  1  0  P  idle
+ *        ----+  +--+  +--+  +--+  +--+  +--------
+ *            |__|  |__|  |__|  |__|  |__|
+ *            ^     ^     ^     ^     ^
+ *            5 falling edges, 2 bit times apart: edge 1 -> edge 5 = 8 bit times
+ *
+ *      The capture interrupt accepts an edge only if its distance to the previous
+ *      one is within 25 % of the first distance, otherwise it starts over from the
+ *      previous edge (noise, a partial byte or a different character).
+ *   3) Baud = timer clock * 8 / (edge 5 - edge 1), snapped to the nearest standard
+ *      rate when within 3 %. The pin goes back to the USART after the stop bit and
+ *      USART_SetBaud() programs the rate.
+ *
+ *  Capture timers (USART_AutoBaud_Tim[]):
+ *  --------------------------------------
+ *   - One per port whose RX pin has a timer channel, for the pins in USART_Pin_Config[]:
+ *       USART1 RX PB7 -> TIM4_CH2 (AF2, 16 bit)
+ *       USART2 RX PA3 -> TIM5_CH4 (AF2, 32 bit)   (TIM2_CH4 is the Modbus timer)
+ *   - Other ports: NULL (USART_AutoBaud() returns USART_Invalid_Arg). Change an entry
+ *     together with the RX pin; this file owns the IRQ handlers of the timers used.
+ *   - All are APB1 timers. 16-bit timers are prescaled so that 8 bit times at
+ *     USART_AUTOBAUD_MIN_BAUD fit one counter period; the error is one count in
+ *     (timer clock * 8 / baud), about 0.1 % at 921600 baud on a 84 MHz 32-bit timer.
+ * =========================================================================================
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "stm32f4xx_hal.h"
+#include "stm32f4xx_ll_usart.h"
+
+#include "USART.h"
+#include "USART_Prv.h"
+#include "USART_Cfg.h"
+
+#if (USART_AUTOBAUD == ENABLE)
+
+#define USART_AB_EDGES      5U      /* falling edges of the sync byte */
+#define USART_AB_BITS       8U      /* bit times from the first to the last one */
+#define USART_AB_SNAP_PCT   3U      /* snap to a standard rate within this */
+
+/* Defined in USART.c. */
+extern UART_HandleTypeDef USART_Handler[USART_MAX_NUM];
+
+typedef struct
+{
+	TIM_TypeDef *Tim;       /* NULL: no auto-baud on this port */
+	uint8_t      Channel;   /* 0..3 = CH1..CH4 */
+	uint8_t      Af;        /* GPIO alternate function of the timer on the RX pin */
+	IRQn_Type    Irq;
+	uint32_t     Mask;      /* counter width */
+} usart_ab_tim_t;
+
+static const usart_ab_tim_t USART_AutoBaud_Tim[USART_MAX_NUM] =
+{
+	{ TIM4, 1U, GPIO_AF2_TIM4, TIM4_IRQn, 0x0000FFFFU },   /* USART1: PB7 = TIM4_CH2 */
+	{ TIM5, 3U, GPIO_AF2_TIM5, TIM5_IRQn, 0xFFFFFFFFU },   /* USART2: PA3 = TIM5_CH4 */
+	{ NULL, 0U, 0U,            (IRQn_Type)0, 0U },
+	{ NULL, 0U, 0U,            (IRQn_Type)0, 0U },
+	{ NULL, 0U, 0U,            (IRQn_Type)0, 0U },
+	{ NULL, 0U, 0U,            (IRQn_Type)0, 0U },
+};
+
+/* Measurement state of one port, written by the capture interrupt. */
+typedef struct
+{
+	TaskHandle_t volatile Waiter;
+	volatile uint8_t      Edges;
+	uint32_t              First;
+	uint32_t              Prev;
+	uint32_t              Ref;
+	volatile uint32_t     Total;
+} usart_ab_t;
+
+static usart_ab_t Usart_Ab[USART_MAX_NUM];
+
+static const uint32_t Usart_Ab_Std[] =
+{
+	1200U, 2400U, 4800U, 9600U, 19200U, 38400U, 57600U, 115200U, 230400U, 460800U, 921600U
+};
+
+/* =========================================================================================
+ *                                   Internal Helpers
+ * =========================================================================================
+ */
+
+/* Same conversion as the driver's blocking calls. */
+static TickType_t usart_ab_ms_to_ticks(uint32_t Timeout_Ms)
+{
+	TickType_t Ticks = portMAX_DELAY;
+
+	if(Timeout_Ms != USART_WAIT_FOREVER)
+	{
+		Ticks = (TickType_t)(((uint64_t)Timeout_Ms * configTICK_RATE_HZ) / 1000U);
+	}
+	return Ticks;
+}
+
+/* APB1 timers run at 2 x PCLK1 unless APB1 is undivided. */
+static uint32_t usart_ab_tim_clock(void)
+{
+	uint32_t Clock = HAL_RCC_GetPCLK1Freq();
+
+	if((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+	{
+		Clock *= 2U;
+	}
+	return Clock;
+}
+
+static void usart_ab_clk_enable(const TIM_TypeDef *Tim)
+{
+	if(Tim == TIM4)
+	{
+		__HAL_RCC_TIM4_CLK_ENABLE();
+	}
+	else
+	{
+		__HAL_RCC_TIM5_CLK_ENABLE();
+	}
+}
+
+/* RX pin to the timer (Af) or back to the USART (AF7 for USART1..3, AF8 otherwise, as in USART_Init). */
+static void usart_ab_rx_pin(USART_Num_t USART_Num, uint32_t Af)
+{
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+	GPIO_InitStruct.Pin       = USART_Pin_Config[USART_Num].Rx_Pin;
+	GPIO_InitStruct.Mode      = GPIO_MODE_AF_PP;
+	GPIO_InitStruct.Pull      = GPIO_NOPULL;
+	GPIO_InitStruct.Speed     = GPIO_SPEED_FREQ_VERY_HIGH;
+	GPIO_InitStruct.Alternate = Af;
+	HAL_GPIO_Init(USART_Pin_Config[USART_Num].Rx_Port, &GPIO_InitStruct);
+}
+
+static uint32_t usart_ab_usart_af(USART_Num_t USART_Num)
+{
+	return ((USART_Num == USART_NUM_1) || (USART_Num == USART_NUM_2) || (USART_Num == USART_NUM_3)) ?
+	       USART_GPIO_AF7 : USART_GPIO_AF8;
+}
+
+static void usart_ab_rx_enable(USART_Num_t USART_Num, uint8_t On)
+{
+	USART_TypeDef *Instance = USART_Handler[USART_Num].Instance;
+
+	taskENTER_CRITICAL();
+	if(On != 0U)
+	{
+		LL_USART_WriteReg(Instance, CR1, LL_USART_ReadReg(Instance, CR1) | USART_CR1_RE);
+	}
+	else
+	{
+		LL_USART_WriteReg(Instance, CR1, LL_USART_ReadReg(Instance, CR1) & ~USART_CR1_RE);
+	}
+	taskEXIT_CRITICAL();
+}
+
+/*
+ * usart_ab_tim_start():
+ *  - Free-running counter, channel in input capture on TIx, falling edge, filter N=8,
+ *    capture interrupt armed.
+ */
+static void usart_ab_tim_start(const usart_ab_tim_t *Cfg, uint32_t Psc)
+{
+	TIM_TypeDef       *Tim   = Cfg->Tim;
+	volatile uint32_t *Ccmr  = (Cfg->Channel < 2U) ? &Tim->CCMR1 : &Tim->CCMR2;
+	uint32_t           Shift = (Cfg->Channel & 1U) * 8U;
+
+	usart_ab_clk_enable(Tim);
+
+	Tim->CR1   = 0U;
+	Tim->DIER  = 0U;
+	Tim->CCER &= ~((TIM_CCER_CC1E | TIM_CCER_CC1P | TIM_CCER_CC1NP) << (Cfg->Channel * 4U));
+	*Ccmr      = (*Ccmr & ~(0xFFU << Shift)) | ((TIM_CCMR1_CC1S_0 | (3U << TIM_CCMR1_IC1F_Pos)) << Shift);
+	Tim->CCER |= (TIM_CCER_CC1E | TIM_CCER_CC1P) << (Cfg->Channel * 4U);
+	Tim->PSC   = Psc;
+	Tim->ARR   = Cfg->Mask;
+	Tim->EGR   = TIM_EGR_UG;        /* load PSC now */
+	Tim->SR    = 0U;
+	Tim->DIER  = TIM_DIER_CC1IE << Cfg->Channel;
+	Tim->CR1   = TIM_CR1_CEN;
+
+	HAL_NVIC_SetPriority(Cfg->Irq, USART_NVIC_GROUP_PRIORITY, USART_NVIC_SUB_PRIORITY);
+	HAL_NVIC_EnableIRQ(Cfg->Irq);
+}
+
+static void usart_ab_tim_stop(const usart_ab_tim_t *Cfg)
+{
+	HAL_NVIC_DisableIRQ(Cfg->Irq);
+	Cfg->Tim->DIER  = 0U;
+	Cfg->Tim->CR1   = 0U;
+	Cfg->Tim->CCER &= ~(TIM_CCER_CC1E << (Cfg->Channel * 4U));
+}
+
+/* Nearest standard rate if within USART_AB_SNAP_PCT, else the measurement itself. */
+static uint32_t usart_ab_snap(uint32_t Baud)
+{
+	uint32_t Best = Baud;
+
+	for(uint32_t i = 0 ; i < (sizeof(Usart_Ab_Std) / sizeof(Usart_Ab_Std[0])) ; i++)
+	{
+		uint32_t Diff = (Baud > Usart_Ab_Std[i]) ? (Baud - Usart_Ab_Std[i]) : (Usart_Ab_Std[i] - Baud);
+
+		if((Diff * 100U) <= (Usart_Ab_Std[i] * USART_AB_SNAP_PCT))
+		{
+			Best = Usart_Ab_Std[i];
+		}
+	}
+	return Best;
+}
+
+/*
+ * usart_ab_isr():
+ *  - One falling edge captured. Reading CCRx clears CCxIF; an overcapture (an edge
+ *    missed while the previous one was pending) only shows as a bad distance.
+ */
+static void usart_ab_isr(USART_Num_t USART_Num)
+{
+	const usart_ab_tim_t *Cfg   = &USART_AutoBaud_Tim[USART_Num];
+	usart_ab_t           *Ab    = &Usart_Ab[USART_Num];
+	BaseType_t            Woken = pdFALSE;
+	TaskHandle_t          Task;
+	uint32_t              Now;
+	uint32_t              Gap;
+	uint32_t              Diff;
+
+	if((Cfg->Tim->SR & (TIM_SR_CC1IF << Cfg->Channel)) != 0U)
+	{
+		Now = (&Cfg->Tim->CCR1)[Cfg->Channel];
+		Cfg->Tim->SR = ~(TIM_SR_CC1OF << Cfg->Channel);
+		Gap = (Now - Ab->Prev) & Cfg->Mask;
+
+		if(Ab->Edges == 0U)
+		{
+			Ab->First = Now;
+			Ab->Edges = 1U;
+		}
+		else if(Ab->Edges == 1U)
+		{
+			Ab->Ref   = Gap;
+			Ab->Edges = 2U;
+		}
+		else
+		{
+			Diff = (Gap > Ab->Ref) ? (Gap - Ab->Ref) : (Ab->Ref - Gap);
+			if((Diff * 4U) <= Ab->Ref)
+			{
+				Ab->Edges++;
+			}
+			else
+			{
+				/* Start over with the previous edge as the first one. */
+				Ab->First = Ab->Prev;
+				Ab->Ref   = Gap;
+				Ab->Edges = 2U;
+			}
+		}
+		Ab->Prev = Now;
+
+		if(Ab->Edges == USART_AB_EDGES)
+		{
+			Ab->Total = (Now - Ab->First) & Cfg->Mask;
+			Cfg->Tim->DIER = 0U;
+
+			Task = Ab->Waiter;
+			if(Task != NULL)
+			{
+				Ab->Waiter = NULL;
+				vTaskNotifyGiveIndexedFromISR(Task, USART_NOTIFY_INDEX, &Woken);
+			}
+		}
+	}
+	portYIELD_FROM_ISR(Woken);
+}
+
+/* =========================================================================================
+ *                                  USART_AutoBaud()
+ * =========================================================================================
+ */
+USART_Err_St_t USART_AutoBaud(USART_Num_t USART_Num , uint32_t Timeout_Ms, uint32_t *Baud)
+{
+	USART_Err_St_t        USART_Err_Ret =  USART_Rx_NoData;
+	const usart_ab_tim_t *Cfg;
+	usart_ab_t           *Ab;
+	uint32_t              Clock;
+	uint32_t              Psc           =  0U;
+	uint32_t              Old;
+	uint32_t              Measured      =  0U;
+
+	if((USART_Num >= USART_MAX_NUM) || (USART_AutoBaud_Tim[USART_Num].Tim == NULL))
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else if(USART_GetBaud(USART_Num, &Old) != USART_Ok)
+	{
+		USART_Err_Ret =  USART_Not_Init;
+	}
+	else
+	{
+		Cfg   = &USART_AutoBaud_Tim[USART_Num];
+		Ab    = &Usart_Ab[USART_Num];
+		Clock = usart_ab_tim_clock();
+
+		/* 16-bit counter: 8 bit times at the slowest rate must fit one period. */
+		if(Cfg->Mask != 0xFFFFFFFFU)
+		{
+			Psc = (uint32_t)(((uint64_t)Clock * USART_AB_BITS) / ((uint64_t)(Cfg->Mask + 1U) * USART_AUTOBAUD_MIN_BAUD));
+		}
+
+		usart_ab_rx_enable(USART_Num, 0U);
+		usart_ab_rx_pin(USART_Num, Cfg->Af);
+
+		Ab->Edges  = 0U;
+		Ab->Total  = 0U;
+		(void)ulTaskNotifyTakeIndexed(USART_NOTIFY_INDEX, pdTRUE, 0);
+		Ab->Waiter = xTaskGetCurrentTaskHandle();
+		usart_ab_tim_start(Cfg, Psc);
+
+		if(Ab->Edges != USART_AB_EDGES)
+		{
+			(void)ulTaskNotifyTakeIndexed(USART_NOTIFY_INDEX, pdTRUE, usart_ab_ms_to_ticks(Timeout_Ms));
+		}
+
+		usart_ab_tim_stop(Cfg);
+		Ab->Waiter = NULL;
+
+		if((Ab->Edges == USART_AB_EDGES) && (Ab->Total != 0U))
+		{
+			Measured = (uint32_t)((((uint64_t)Clock * USART_AB_BITS) + ((uint64_t)(Psc + 1U) * Ab->Total / 2U)) /
+			                      ((uint64_t)(Psc + 1U) * Ab->Total));
+		}
+
+		if(Measured != 0U)
+		{
+			Measured = usart_ab_snap(Measured);
+
+			/* Let the last data bit and the stop bit pass before the USART listens again. */
+			vTaskDelay(pdMS_TO_TICKS((2000U / Measured) + 1U) + 1U);
+		}
+
+		usart_ab_rx_pin(USART_Num, usart_ab_usart_af(USART_Num));
+		usart_ab_rx_enable(USART_Num, 1U);
+
+		if(Measured != 0U)
+		{
+			USART_Err_Ret = USART_SetBaud(USART_Num, Measured);
+			if((USART_Err_Ret == USART_Ok) && (Baud != NULL))
+			{
+				*Baud = Measured;
+			}
+		}
+	}
+	return USART_Err_Ret;
+}
+
+/* =========================================================================================
+ *                                   IRQ Handlers
+ * =========================================================================================
+ * Capture timers of USART_AutoBaud_Tim[], at the USART IRQ priority.
+ */
+void TIM4_IRQHandler(void)
+{
+	usart_ab_isr(USART_NUM_1);
+}
+
+void TIM5_IRQHandler(void)
+{
+	usart_ab_isr(USART_NUM_2);
+}
+
+#endif /* USART_AUTOBAUD */
@@ -14,6 +14,7 @@
  *      - Maps each logical USART index (USART_NUM_1 .. USART_NUM_6) to:
  *          * TX GPIO port + pin
  *          * RX GPIO port + pin
+ *          * RTS/CTS GPIO port + pin (optional)
  *
  *   2) USART_Config[]:
  *      - Defines UART peripheral parameters per instance:
@@ -22,11 +23,14 @@
  *          * Parity
  *          * Word length
  *          * Oversampling
+ *          * Flow control (hardware RTS/CTS, software RTS watermark, XON/XOFF)
+ *          * TX/RX buffer storage and size
  *
  *  How the driver uses these tables:
  *  -------------------------------
  *  - USART_Init() reads USART_Pin_Config[] to configure GPIO pins in AF mode.
  *  - USART_Init() reads USART_Config[] to populate the HAL UART init structure.
+ *  - USART_Init() attaches Tx_Buff / Rx_Buff to the TX/RX buffer of the instance.
  *
  *  IMPORTANT NOTES:
  *  ---------------
@@ -60,6 +64,184 @@
 
 #include "USART_Prv.h"
 #include "USART_Cfg.h"
+#include "USART_Ring.h"
+
+/*
+ * =========================================================================================
+ *                               Static TX/RX Buffer Storage
+ * =========================================================================================
+ *
+ * One array per port and direction, sized by USARTx_TX_BUFF_SIZE / USARTx_RX_BUFF_SIZE
+ * in USART_Cfg.h. A size of 0 reserves nothing, so unused ports cost no RAM.
+ * With the ring backend each TX ring also gets its commit and skip bitmaps (one bit per byte each).
+ * The arrays land in .bss: their sizes are listed symbol by symbol in the .map file.
+ */
+#if (USART_BUFF_BACKEND == USART_BUFF_RING)
+#define USART_BUFF_SIZE_OK(x)   (((x) == 0U) || USART_RING_IS_POW2(x))
+
+#if !USART_BUFF_SIZE_OK(USART1_TX_BUFF_SIZE)
+#error "USART1_TX_BUFF_SIZE must be 0 or a power of two with USART_BUFF_RING"
+#endif
+#if !USART_BUFF_SIZE_OK(USART1_RX_BUFF_SIZE)
+#error "USART1_RX_BUFF_SIZE must be 0 or a power of two with USART_BUFF_RING"
+#endif
+#if !USART_BUFF_SIZE_OK(USART2_TX_BUFF_SIZE)
+#error "USART2_TX_BUFF_SIZE must be 0 or a power of two with USART_BUFF_RING"
+#endif
+#if !USART_BUFF_SIZE_OK(USART2_RX_BUFF_SIZE)
+#error "USART2_RX_BUFF_SIZE must be 0 or a power of two with USART_BUFF_RING"
+#endif
+#if !USART_BUFF_SIZE_OK(USART3_TX_BUFF_SIZE)
+#error "USART3_TX_BUFF_SIZE must be 0 or a power of two with USART_BUFF_RING"
+#endif
+#if !USART_BUFF_SIZE_OK(USART3_RX_BUFF_SIZE)
+#error "USART3_RX_BUFF_SIZE must be 0 or a power of two with USART_BUFF_RING"
+#endif
+#if !USART_BUFF_SIZE_OK(UART4_TX_BUFF_SIZE)
+#error "UART4_TX_BUFF_SIZE must be 0 or a power of two with USART_BUFF_RING"
+#endif
+#if !USART_BUFF_SIZE_OK(UART4_RX_BUFF_SIZE)
+#error "UART4_RX_BUFF_SIZE must be 0 or a power of two with USART_BUFF_RING"
+#endif
+#if !USART_BUFF_SIZE_OK(UART5_TX_BUFF_SIZE)
+#error "UART5_TX_BUFF_SIZE must be 0 or a power of two with USART_BUFF_RING"
+#endif
+#if !USART_BUFF_SIZE_OK(UART5_RX_BUFF_SIZE)
+#error "UART5_RX_BUFF_SIZE must be 0 or a power of two with USART_BUFF_RING"
+#endif
+#if !USART_BUFF_SIZE_OK(USART6_TX_BUFF_SIZE)
+#error "USART6_TX_BUFF_SIZE must be 0 or a power of two with USART_BUFF_RING"
+#endif
+#if !USART_BUFF_SIZE_OK(USART6_RX_BUFF_SIZE)
+#error "USART6_RX_BUFF_SIZE must be 0 or a power of two with USART_BUFF_RING"
+#endif
+#endif
+
+#if (USART1_TX_BUFF_SIZE > 0U)
+static uint8_t USART1_Tx_Storage[USART1_TX_BUFF_SIZE];
+#define USART1_TX_BUFF   USART1_Tx_Storage
+#else
+#define USART1_TX_BUFF   NULL
+#endif
+
+#if (USART1_TX_BUFF_SIZE > 0U) && (USART_BUFF_BACKEND == USART_BUFF_RING)
+static uint32_t USART1_Tx_Marks[USART_RING_MARK_WORDS(USART1_TX_BUFF_SIZE)];
+#define USART1_TX_MARKS  USART1_Tx_Marks
+#else
+#define USART1_TX_MARKS  NULL
+#endif
+
+#if (USART1_RX_BUFF_SIZE > 0U)
+static uint8_t USART1_Rx_Storage[USART1_RX_BUFF_SIZE];
+#define USART1_RX_BUFF   USART1_Rx_Storage
+#else
+#define USART1_RX_BUFF   NULL
+#endif
+
+#if (USART2_TX_BUFF_SIZE > 0U)
+static uint8_t USART2_Tx_Storage[USART2_TX_BUFF_SIZE];
+#define USART2_TX_BUFF   USART2_Tx_Storage
+#else
+#define USART2_TX_BUFF   NULL
+#endif
+
+#if (USART2_TX_BUFF_SIZE > 0U) && (USART_BUFF_BACKEND == USART_BUFF_RING)
+static uint32_t USART2_Tx_Marks[USART_RING_MARK_WORDS(USART2_TX_BUFF_SIZE)];
+#define USART2_TX_MARKS  USART2_Tx_Marks
+#else
+#define USART2_TX_MARKS  NULL
+#endif
+
+#if (USART2_RX_BUFF_SIZE > 0U)
+static uint8_t USART2_Rx_Storage[USART2_RX_BUFF_SIZE];
+#define USART2_RX_BUFF   USART2_Rx_Storage
+#else
+#define USART2_RX_BUFF   NULL
+#endif
+
+#if (USART3_TX_BUFF_SIZE > 0U)
+static uint8_t USART3_Tx_Storage[USART3_TX_BUFF_SIZE];
+#define USART3_TX_BUFF   USART3_Tx_Storage
+#else
+#define USART3_TX_BUFF   NULL
+#endif
+
+#if (USART3_TX_BUFF_SIZE > 0U) && (USART_BUFF_BACKEND == USART_BUFF_RING)
+static uint32_t USART3_Tx_Marks[USART_RING_MARK_WORDS(USART3_TX_BUFF_SIZE)];
+#define USART3_TX_MARKS  USART3_Tx_Marks
+#else
+#define USART3_TX_MARKS  NULL
+#endif
+
+#if (USART3_RX_BUFF_SIZE > 0U)
+static uint8_t USART3_Rx_Storage[USART3_RX_BUFF_SIZE];
+#define USART3_RX_BUFF   USART3_Rx_Storage
+#else
+#define USART3_RX_BUFF   NULL
+#endif
+
+#if (UART4_TX_BUFF_SIZE > 0U)
+static uint8_t UART4_Tx_Storage[UART4_TX_BUFF_SIZE];
+#define UART4_TX_BUFF   UART4_Tx_Storage
+#else
+#define UART4_TX_BUFF   NULL
+#endif
+
+#if (UART4_TX_BUFF_SIZE > 0U) && (USART_BUFF_BACKEND == USART_BUFF_RING)
+static uint32_t UART4_Tx_Marks[USART_RING_MARK_WORDS(UART4_TX_BUFF_SIZE)];
+#define UART4_TX_MARKS  UART4_Tx_Marks
+#else
+#define UART4_TX_MARKS  NULL
+#endif
+
+#if (UART4_RX_BUFF_SIZE > 0U)
+static uint8_t UART4_Rx_Storage[UART4_RX_BUFF_SIZE];
+#define UART4_RX_BUFF   UART4_Rx_Storage
+#else
+#define UART4_RX_BUFF   NULL
+#endif
+
+#if (UART5_TX_BUFF_SIZE > 0U)
+static uint8_t UART5_Tx_Storage[UART5_TX_BUFF_SIZE];
+#define UART5_TX_BUFF   UART5_Tx_Storage
+#else
+#define UART5_TX_BUFF   NULL
+#endif
+
+#if (UART5_TX_BUFF_SIZE > 0U) && (USART_BUFF_BACKEND == USART_BUFF_RING)
+static uint32_t UART5_Tx_Marks[USART_RING_MARK_WORDS(UART5_TX_BUFF_SIZE)];
+#define UART5_TX_MARKS  UART5_Tx_Marks
+#else
+#define UART5_TX_MARKS  NULL
+#endif
+
+#if (UART5_RX_BUFF_SIZE > 0U)
+static uint8_t UART5_Rx_Storage[UART5_RX_BUFF_SIZE];
+#define UART5_RX_BUFF   UART5_Rx_Storage
+#else
+#define UART5_RX_BUFF   NULL
+#endif
+
+#if (USART6_TX_BUFF_SIZE > 0U)
+static uint8_t USART6_Tx_Storage[USART6_TX_BUFF_SIZE];
+#define USART6_TX_BUFF   USART6_Tx_Storage
+#else
+#define USART6_TX_BUFF   NULL
+#endif
+
+#if (USART6_TX_BUFF_SIZE > 0U) && (USART_BUFF_BACKEND == USART_BUFF_RING)
+static uint32_t USART6_Tx_Marks[USART_RING_MARK_WORDS(USART6_TX_BUFF_SIZE)];
+#define USART6_TX_MARKS  USART6_Tx_Marks
+#else
+#define USART6_TX_MARKS  NULL
+#endif
+
+#if (USART6_RX_BUFF_SIZE > 0U)
+static uint8_t USART6_Rx_Storage[USART6_RX_BUFF_SIZE];
+#define USART6_RX_BUFF   USART6_Rx_Storage
+#else
+#define USART6_RX_BUFF   NULL
+#endif
 
 /*
  * =========================================================================================
@@ -94,34 +276,42 @@ const USART_Pin_Config_t USART_Pin_Config[USART_MAX_NUM] =
 	 *   TX = PB6, RX = PB7
 	 * Verify against your exact MCU datasheet / board schematic.
 	 */
-	{ .Tx_Port = USART_PORT_B, .Tx_Pin = USART_PIN_6, .Rx_Port = USART_PORT_B, .Rx_Pin = USART_PIN_7 },
+	{ .Tx_Port = USART_PORT_B, .Tx_Pin = USART_PIN_6, .Rx_Port = USART_PORT_B, .Rx_Pin = USART_PIN_7,
+	  .Rts_Port = NULL, .Rts_Pin = 0, .Cts_Port = NULL, .Cts_Pin = 0 },
 
 	/* ===================================== USART_2 =======================================
 	 * Typical STM32F4 mapping:
-	 *   TX = PA2, RX = PA3
+	 *   TX = PA2, RX = PA3, RTS = PA1, CTS = PA0
+	 * (RTS/CTS are only configured when flow control is enabled in USART_Config[].
+	 *  On the STM32F4 Discovery PA0 is also the user button.)
 	 */
-	{ .Tx_Port = USART_PORT_A, .Tx_Pin = USART_PIN_2, .Rx_Port = USART_PORT_A, .Rx_Pin = USART_PIN_3 },
+	{ .Tx_Port = USART_PORT_A, .Tx_Pin = USART_PIN_2, .Rx_Port = USART_PORT_A, .Rx_Pin = USART_PIN_3,
+	  .Rts_Port = USART_PORT_A, .Rts_Pin = USART_PIN_1, .Cts_Port = USART_PORT_A, .Cts_Pin = USART_PIN_0 },
 
 	/* ===================================== USART_3 =======================================
-	 * TODO: Fill with your actual board mapping if used.
-	 * Example placeholders (set to safe/unused until defined):
+	 * Default USART_STDIO_PORT (printf):
+	 *   TX = PD8, RX = PD9 (free on the STM32F4 Discovery)
 	 */
-	{ .Tx_Port = NULL, .Tx_Pin = 0, .Rx_Port = NULL, .Rx_Pin = 0 },
+	{ .Tx_Port = USART_PORT_D, .Tx_Pin = USART_PIN_8, .Rx_Port = USART_PORT_D, .Rx_Pin = USART_PIN_9,
+	  .Rts_Port = NULL, .Rts_Pin = 0, .Cts_Port = NULL, .Cts_Pin = 0 },
 
 	/* ===================================== UART_4 =======================================
 	 * TODO: Fill with your actual board mapping if used.
 	 */
-	{ .Tx_Port = NULL, .Tx_Pin = 0, .Rx_Port = NULL, .Rx_Pin = 0 },
+	{ .Tx_Port = NULL, .Tx_Pin = 0, .Rx_Port = NULL, .Rx_Pin = 0,
+	  .Rts_Port = NULL, .Rts_Pin = 0, .Cts_Port = NULL, .Cts_Pin = 0 },
 
 	/* ===================================== UART_5 =======================================
 	 * TODO: Fill with your actual board mapping if used.
 	 */
-	{ .Tx_Port = NULL, .Tx_Pin = 0, .Rx_Port = NULL, .Rx_Pin = 0 },
+	{ .Tx_Port = NULL, .Tx_Pin = 0, .Rx_Port = NULL, .Rx_Pin = 0,
+	  .Rts_Port = NULL, .Rts_Pin = 0, .Cts_Port = NULL, .Cts_Pin = 0 },
 
 	/* ===================================== USART_6 ======================================
 	 * TODO: Fill with your actual board mapping if used.
 	 */
-	{ .Tx_Port = NULL, .Tx_Pin = 0, .Rx_Port = NULL, .Rx_Pin = 0 },
+	{ .Tx_Port = NULL, .Tx_Pin = 0, .Rx_Port = NULL, .Rx_Pin = 0,
+	  .Rts_Port = NULL, .Rts_Pin = 0, .Cts_Port = NULL, .Cts_Pin = 0 },
 };
 
 /*
@@ -140,55 +330,115 @@ const USART_Config_t USART_Config[USART_MAX_NUM] =
 {
 	/* ===================================== USART_1 ===================================== */
 	{
-		.BaudRate     = USART_BAUDRATE_9600,
+		.BaudRate     = USART1_BAUDRATE,
 		.stop_bit     = USART_STOPBIT_1_,
 		.Parity       = USART_PARITY_NONE_,
 		.WordLength   = USART_WORD_LEN_8_,
-		.OverSampling = USART_OVERSAMPLING_8_
+		.OverSampling = USART_OVERSAMPLING_8_,
+		.HwFlowCtl      = USART_FLOW_NONE_,
+		.Rts_High_Water = 0U,
+		.Rts_Low_Water  = 0U,
+		.Xoff_High_Water = USART1_XOFF_HIGH_WATER,
+		.Xon_Low_Water   = USART1_XON_LOW_WATER,
+		.Tx_Buff      = USART1_TX_BUFF,
+		.Tx_Buff_Size = USART1_TX_BUFF_SIZE,
+		.Rx_Buff      = USART1_RX_BUFF,
+		.Rx_Buff_Size = USART1_RX_BUFF_SIZE,
+		.Tx_Marks     = USART1_TX_MARKS
 	},
 
 	/* ===================================== USART_2 ===================================== */
 	{
-		.BaudRate     = USART_BAUDRATE_115200,
+		.BaudRate     = USART2_BAUDRATE,
 		.stop_bit     = USART_STOPBIT_1_,
 		.Parity       = USART_PARITY_NONE_,
 		.WordLength   = USART_WORD_LEN_8_,
-		.OverSampling = USART_OVERSAMPLING_8_
+		.OverSampling = USART_OVERSAMPLING_8_,
+		.HwFlowCtl      = USART_FLOW_NONE_,
+		.Rts_High_Water = 0U,
+		.Rts_Low_Water  = 0U,
+		.Xoff_High_Water = USART2_XOFF_HIGH_WATER,
+		.Xon_Low_Water   = USART2_XON_LOW_WATER,
+		.Tx_Buff      = USART2_TX_BUFF,
+		.Tx_Buff_Size = USART2_TX_BUFF_SIZE,
+		.Rx_Buff      = USART2_RX_BUFF,
+		.Rx_Buff_Size = USART2_RX_BUFF_SIZE,
+		.Tx_Marks     = USART2_TX_MARKS
 	},
 
 	/* ===================================== USART_3 ===================================== */
 	{
-		.BaudRate     = USART_BAUDRATE_9600,
+		.BaudRate     = USART3_BAUDRATE,
 		.stop_bit     = USART_STOPBIT_1_,
 		.Parity       = USART_PARITY_NONE_,
 		.WordLength   = USART_WORD_LEN_8_,
-		.OverSampling = USART_OVERSAMPLING_8_
+		.OverSampling = USART_OVERSAMPLING_8_,
+		.HwFlowCtl      = USART_FLOW_NONE_,
+		.Rts_High_Water = 0U,
+		.Rts_Low_Water  = 0U,
+		.Xoff_High_Water = USART3_XOFF_HIGH_WATER,
+		.Xon_Low_Water   = USART3_XON_LOW_WATER,
+		.Tx_Buff      = USART3_TX_BUFF,
+		.Tx_Buff_Size = USART3_TX_BUFF_SIZE,
+		.Rx_Buff      = USART3_RX_BUFF,
+		.Rx_Buff_Size = USART3_RX_BUFF_SIZE,
+		.Tx_Marks     = USART3_TX_MARKS
 	},
 
 	/* ===================================== UART_4 ====================================== */
 	{
-		.BaudRate     = USART_BAUDRATE_9600,
+		.BaudRate     = UART4_BAUDRATE,
 		.stop_bit     = USART_STOPBIT_1_,
 		.Parity       = USART_PARITY_NONE_,
 		.WordLength   = USART_WORD_LEN_8_,
-		.OverSampling = USART_OVERSAMPLING_8_
+		.OverSampling = USART_OVERSAMPLING_8_,
+		.HwFlowCtl      = USART_FLOW_NONE_,
+		.Rts_High_Water = 0U,
+		.Rts_Low_Water  = 0U,
+		.Xoff_High_Water = UART4_XOFF_HIGH_WATER,
+		.Xon_Low_Water   = UART4_XON_LOW_WATER,
+		.Tx_Buff      = UART4_TX_BUFF,
+		.Tx_Buff_Size = UART4_TX_BUFF_SIZE,
+		.Rx_Buff      = UART4_RX_BUFF,
+		.Rx_Buff_Size = UART4_RX_BUFF_SIZE,
+		.Tx_Marks     = UART4_TX_MARKS
 	},
 
 	/* ===================================== UART_5 ====================================== */
 	{
-		.BaudRate     = USART_BAUDRATE_9600,
+		.BaudRate     = UART5_BAUDRATE,
 		.stop_bit     = USART_STOPBIT_1_,
 		.Parity       = USART_PARITY_NONE_,
 		.WordLength   = USART_WORD_LEN_8_,
-		.OverSampling = USART_OVERSAMPLING_8_
+		.OverSampling = USART_OVERSAMPLING_8_,
+		.HwFlowCtl      = USART_FLOW_NONE_,
+		.Rts_High_Water = 0U,
+		.Rts_Low_Water  = 0U,
+		.Xoff_High_Water = UART5_XOFF_HIGH_WATER,
+		.Xon_Low_Water   = UART5_XON_LOW_WATER,
+		.Tx_Buff      = UART5_TX_BUFF,
+		.Tx_Buff_Size = UART5_TX_BUFF_SIZE,
+		.Rx_Buff      = UART5_RX_BUFF,
+		.Rx_Buff_Size = UART5_RX_BUFF_SIZE,
+		.Tx_Marks     = UART5_TX_MARKS
 	},
 
 	/* ===================================== USART_6 ===================================== */
 	{
-		.BaudRate     = USART_BAUDRATE_9600,
+		.BaudRate     = USART6_BAUDRATE,
 		.stop_bit     = USART_STOPBIT_1_,
 		.Parity       = USART_PARITY_NONE_,
 		.WordLength   = USART_WORD_LEN_8_,
-		.OverSampling = USART_OVERSAMPLING_8_
+		.OverSampling = USART_OVERSAMPLING_8_,
+		.HwFlowCtl      = USART_FLOW_NONE_,
+		.Rts_High_Water = 0U,
+		.Rts_Low_Water  = 0U,
+		.Xoff_High_Water = USART6_XOFF_HIGH_WATER,
+		.Xon_Low_Water   = USART6_XON_LOW_WATER,
+		.Tx_Buff      = USART6_TX_BUFF,
+		.Tx_Buff_Size = USART6_TX_BUFF_SIZE,
+		.Rx_Buff      = USART6_RX_BUFF,
+		.Rx_Buff_Size = USART6_RX_BUFF_SIZE,
+		.Tx_Marks     = USART6_TX_MARKS
 	},
 };
@@ -11,23 +11,37 @@
  *  This file contains:
  *   - GPIO pin/port helper macros for readable configuration tables
  *   - Common USART parameter macros (baud, word length, stop bits, parity, oversampling)
- *   - Queue buffer length (USART_MAX_BUFF)
+ *   - Per-port baud rates (USARTx_BAUDRATE)
+ *   - Per-port TX/RX buffer sizes (USARTx_TX_BUFF_SIZE / USARTx_RX_BUFF_SIZE)
  *   - Configuration structures:
  *        * USART_Pin_Config_t : TX/RX pin mapping per instance
  *        * USART_Config_t     : UART peripheral parameters per instance
  *   - External configuration tables (defined in USART_Cfg.c)
  *   - Compile-time selection of polling vs interrupt operation for TX/RX
+ *   - Hardware RTS/CTS, software RTS watermark and XON/XOFF flow control
+ *   - Statistics and DWT cycle profiling switches (USART_STATS / USART_PROFILE)
+ *   - printf() retarget to a USART (USART_STDIO)
+ *   - COBS/SLIP packet framing layer (USART_FRAME) and frame checksums
+ *     (USART_FRAME_CRC / USART_CRC_HW)
+ *   - Auto-baud detection with a timer input capture (USART_AUTOBAUD)
  *
  *  How to use:
  *  -----------
  *   1) Edit USART_Pin_Config[] to map each USART_NUM_x to the correct pins/ports.
  *   2) Edit USART_Config[] to set baud rate, parity, stop bits, etc. per instance.
- *   3) Select interrupt/polling mode using USART_RX_INT and USART_TX_INT.
+ *   3) Select interrupt/polling mode using USART_RX_INT and USART_TX_INT
+ *      (and optionally DMA transfers using USART_RX_DMA / USART_TX_DMA).
  *
  *  Notes:
  *  ------
  *  - Macros here map directly to STM32 HAL constants (UART_WORDLENGTH_8B, etc.).
- *  - USART_MAX_BUFF controls the FreeRTOS queue depth for TX and RX.
+ *  - USARTx_TX/RX_BUFF_SIZE set the buffer capacity of each port (0 = unused).
+ *  - USART_BUFF_BACKEND selects FreeRTOS queues or lock-free rings for TX/RX.
+ *  - Settings wrapped in #ifndef (baud rates, buffer sizes, backend, INT/DMA/FAST_ISR
+ *    modes, USART_PROFILE, USART_STDIO, USART_FRAME, USART_FRAME_CRC, USART_CRC_HW,
+ *    USART_AUTOBAUD, USART_MODBUS)
+ *    can be overridden from the compiler command line (-D), which is how the
+ *    benchmark sweeps (TASKS/USART_Bench.c) build one image per configuration.
  *  - If enabling interrupts with FreeRTOS, confirm NVIC priority settings are
  *    compatible with FreeRTOSConfig.h (max syscall interrupt priority).
  * =========================================================================================
@@ -90,6 +104,9 @@
 #define USART_BAUDRATE_19200   19200U
 #define USART_BAUDRATE_57600   57600U
 #define USART_BAUDRATE_115200  115200U
+#define USART_BAUDRATE_230400  230400U
+#define USART_BAUDRATE_460800  460800U
+#define USART_BAUDRATE_921600  921600U
 
 /*
  * Word length macros map to HAL UART defines.
@@ -112,19 +129,179 @@
 #define USART_OVERSAMPLING_8_  UART_OVERSAMPLING_8
 #define USART_OVERSAMPLING_16_ UART_OVERSAMPLING_16
 
+/*
+ * Hardware flow control macros map to HAL UART defines.
+ * NOTE:
+ *  - Only USART1/2/3/6 have RTS/CTS lines; UART4/5 must use USART_FLOW_NONE_.
+ *  - Hardware RTS only reflects the data register (deasserted while one byte is
+ *    unread), not the driver RX buffer. Use the software RTS watermark for that.
+ */
+#define USART_FLOW_NONE_     UART_HWCONTROL_NONE
+#define USART_FLOW_RTS_      UART_HWCONTROL_RTS
+#define USART_FLOW_CTS_      UART_HWCONTROL_CTS
+#define USART_FLOW_RTS_CTS_  UART_HWCONTROL_RTS_CTS
+
+/* =========================================================================================
+ *                                  Per-Port Baud Rates
+ * =========================================================================================
+ *
+ * USARTx_BAUDRATE:
+ *  - Baud rate of each USART instance, used by USART_Config[] in USART_Cfg.c.
+ *  - Any value the USART clock can reach works, the presets above are for convenience.
+ */
+#ifndef USART1_BAUDRATE
+#define USART1_BAUDRATE   USART_BAUDRATE_9600
+#endif
+#ifndef USART2_BAUDRATE
+#define USART2_BAUDRATE   USART_BAUDRATE_115200
+#endif
+#ifndef USART3_BAUDRATE
+#define USART3_BAUDRATE   USART_BAUDRATE_9600
+#endif
+#ifndef UART4_BAUDRATE
+#define UART4_BAUDRATE    USART_BAUDRATE_9600
+#endif
+#ifndef UART5_BAUDRATE
+#define UART5_BAUDRATE    USART_BAUDRATE_9600
+#endif
+#ifndef USART6_BAUDRATE
+#define USART6_BAUDRATE   USART_BAUDRATE_9600
+#endif
+
+/* =========================================================================================
+ *                              Per-Port TX/RX Buffer Sizes
+ * =========================================================================================
+ *
+ * USARTx_TX_BUFF_SIZE / USARTx_RX_BUFF_SIZE:
+ *  - Capacity (bytes) of the TX and RX buffer of each USART instance.
+ *  - Storage is allocated statically in USART_Cfg.c, so the totals show up in the
+ *    .bss section of the .map file and are checked by the linker, not at run time.
+ *  - 0 means "port unused": no storage is reserved and USART_Init() on that port
+ *    returns USART_CreateBuff_Failed.
+ *  - With USART_BUFF_RING every non-zero size MUST be a power of two.
+ *  - USART1 is the default USART_LOG_PORT (USART_Log.h): mostly TX, small RX.
+ *  - USART3 is the default USART_STDIO_PORT: buffered only while USART_STDIO is
+ *    enabled (set both sizes explicitly when moving stdout to another port).
+ */
+#ifndef USART1_TX_BUFF_SIZE
+#define USART1_TX_BUFF_SIZE   256U
+#endif
+#ifndef USART1_RX_BUFF_SIZE
+#define USART1_RX_BUFF_SIZE   16U
+#endif
+
+#ifndef USART2_TX_BUFF_SIZE
+#define USART2_TX_BUFF_SIZE   256U
+#endif
+#ifndef USART2_RX_BUFF_SIZE
+#define USART2_RX_BUFF_SIZE   256U
+#endif
+
+#ifndef USART3_TX_BUFF_SIZE
+#define USART3_TX_BUFF_SIZE   ((USART_STDIO == ENABLE) ? 256U : 0U)
+#endif
+#ifndef USART3_RX_BUFF_SIZE
+#define USART3_RX_BUFF_SIZE   ((USART_STDIO == ENABLE) ? 16U : 0U)
+#endif
+
+#ifndef UART4_TX_BUFF_SIZE
+#define UART4_TX_BUFF_SIZE    0U
+#endif
+#ifndef UART4_RX_BUFF_SIZE
+#define UART4_RX_BUFF_SIZE    0U
+#endif
+
+#ifndef UART5_TX_BUFF_SIZE
+#define UART5_TX_BUFF_SIZE    0U
+#endif
+#ifndef UART5_RX_BUFF_SIZE
+#define UART5_RX_BUFF_SIZE    0U
+#endif
+
+#ifndef USART6_TX_BUFF_SIZE
+#define USART6_TX_BUFF_SIZE   0U
+#endif
+#ifndef USART6_RX_BUFF_SIZE
+#define USART6_RX_BUFF_SIZE   0U
+#endif
+
+/* =========================================================================================
+ *                              Per-Port XON/XOFF Watermarks
+ * =========================================================================================
+ *
+ * USARTx_XOFF_HIGH_WATER / USARTx_XON_LOW_WATER:
+ *  - Xoff_High_Water / Xon_Low_Water of each port (see USART_Config_t), 0 = off.
+ *  - Only used with USART_XON_XOFF == ENABLE; USART_Init() rejects a low mark that is
+ *    not below the high mark, or a high mark above USARTx_RX_BUFF_SIZE.
+ */
+#ifndef USART1_XOFF_HIGH_WATER
+#define USART1_XOFF_HIGH_WATER   0U
+#endif
+#ifndef USART1_XON_LOW_WATER
+#define USART1_XON_LOW_WATER     0U
+#endif
+
+#ifndef USART2_XOFF_HIGH_WATER
+#define USART2_XOFF_HIGH_WATER   0U
+#endif
+#ifndef USART2_XON_LOW_WATER
+#define USART2_XON_LOW_WATER     0U
+#endif
+
+#ifndef USART3_XOFF_HIGH_WATER
+#define USART3_XOFF_HIGH_WATER   0U
+#endif
+#ifndef USART3_XON_LOW_WATER
+#define USART3_XON_LOW_WATER     0U
+#endif
+
+#ifndef UART4_XOFF_HIGH_WATER
+#define UART4_XOFF_HIGH_WATER    0U
+#endif
+#ifndef UART4_XON_LOW_WATER
+#define UART4_XON_LOW_WATER      0U
+#endif
+
+#ifndef UART5_XOFF_HIGH_WATER
+#define UART5_XOFF_HIGH_WATER    0U
+#endif
+#ifndef UART5_XON_LOW_WATER
+#define UART5_XON_LOW_WATER      0U
+#endif
+
+#ifndef USART6_XOFF_HIGH_WATER
+#define USART6_XOFF_HIGH_WATER   0U
+#endif
+#ifndef USART6_XON_LOW_WATER
+#define USART6_XON_LOW_WATER     0U
+#endif
+
 /* =========================================================================================
- *                              FreeRTOS Queue Buffer Length
+ *                              TX/RX Buffer Backend Selection
  * =========================================================================================
  *
- * USART_MAX_BUFF:
- *  - Queue depth for BOTH TX and RX queues per USART instance.
- *  - Larger values reduce the chance of overflow at the cost of heap usage.
- *  - Each instance allocates:
- *      TX queue: USART_MAX_BUFF bytes
- *      RX queue: USART_MAX_BUFF bytes
- *    plus queue control overhead.
+ * USART_BUFF_BACKEND:
+ *  - USART_BUFF_QUEUE : one FreeRTOS queue per direction. Every byte goes through
+ *                       xQueueSend/xQueueReceive, which enters a critical section
+ *                       and checks the task lists. The queue storage area is the
+ *                       static per-port buffer when configSUPPORT_STATIC_ALLOCATION
+ *                       is 1 (xQueueCreateStatic), otherwise it comes from the heap.
+ *  - USART_BUFF_RING  : lock-free SPSC ring per direction (USART_Ring.h),
+ *                       static storage, no critical section per byte.
+ *
+ * Ring ownership rules:
+ *  - One consumer per ring. In practice:
+ *      TX: any number of tasks write, each through its own reserve/commit range
+ *          (slots claimed by CAS, published in reservation order);
+ *          cyclic/ISR code drains.
+ *      RX: cyclic/ISR code fills (single producer), one application task reads.
  */
-#define USART_MAX_BUFF  200U
+#define USART_BUFF_QUEUE     0
+#define USART_BUFF_RING      1
+
+#ifndef USART_BUFF_BACKEND
+#define USART_BUFF_BACKEND   USART_BUFF_RING
+#endif
 
 /* =========================================================================================
  *                              Configuration Structures
@@ -139,6 +316,11 @@
  *
  * Tx_Pin / Rx_Pin:
  *  - GPIO pin mask (GPIO_PIN_x)
+ *
+ * Rts_Port / Rts_Pin, Cts_Port / Cts_Pin:
+ *  - Flow control lines (NULL / 0 when not wired)
+ *  - RTS is an AF pin with hardware RTS, or a plain GPIO output with the software
+ *    RTS watermark (see USART_Config_t.Rts_High_Water)
  */
 typedef struct USART_Pin_Config_s
 {
@@ -146,6 +328,10 @@ typedef struct USART_Pin_Config_s
 	GPIO_TypeDef *Rx_Port;
 	uint16_t       Tx_Pin;
 	uint16_t       Rx_Pin;
+	GPIO_TypeDef *Rts_Port;
+	GPIO_TypeDef *Cts_Port;
+	uint16_t       Rts_Pin;
+	uint16_t       Cts_Pin;
 } USART_Pin_Config_t;
 
 /**
@@ -165,6 +351,36 @@ typedef struct USART_Pin_Config_s
  *
  * OverSampling:
  *  - HAL oversampling selection (UART_OVERSAMPLING_8/16)
+ *
+ * HwFlowCtl:
+ *  - HAL flow control selection (USART_FLOW_NONE_/RTS_/CTS_/RTS_CTS_)
+ *
+ * Rts_High_Water / Rts_Low_Water:
+ *  - Software RTS watermark (needs USART_SW_RTS == ENABLE), 0 = off.
+ *  - RTS is deasserted once the RX buffer holds Rts_High_Water bytes or more and
+ *    asserted again when the application has read it down to Rts_Low_Water.
+ *  - Leave room above the high mark for the bytes the peer still sends after RTS
+ *    drops (its TX shift register plus its reaction time).
+ *  - Must not be combined with hardware RTS (USART_FLOW_RTS_ / USART_FLOW_RTS_CTS_).
+ *
+ * Xoff_High_Water / Xon_Low_Water:
+ *  - XON/XOFF software flow control (needs USART_XON_XOFF == ENABLE), 0 = off.
+ *  - XOFF is sent once the RX buffer holds Xoff_High_Water bytes or more, XON once
+ *    the application has read it down to Xon_Low_Water. Received XOFF/XON pause and
+ *    resume our own TX.
+ *  - Leave room above the high mark for the bytes the peer still sends after XOFF: its
+ *    TX shift and data registers, plus with USART_RX_DMA up to USART_RX_DMA_SIZE / 2
+ *    on each end (DMA data, and the XOFF in it, are only seen at half/complete/IDLE).
+ *
+ * Tx_Buff / Rx_Buff:
+ *  - Static storage for the TX/RX buffer (NULL for an unused direction)
+ *
+ * Tx_Buff_Size / Rx_Buff_Size:
+ *  - Size of Tx_Buff / Rx_Buff in bytes (USARTx_TX_BUFF_SIZE / USARTx_RX_BUFF_SIZE)
+ *
+ * Tx_Marks:
+ *  - Commit and skip bitmaps of the TX ring (USART_BUFF_RING), USART_RING_MARK_WORDS(Tx_Buff_Size)
+ *    words; NULL with the queue backend or an unused TX direction
  */
 typedef struct USART_Config_s
 {
@@ -173,6 +389,16 @@ typedef struct USART_Config_s
 	uint8_t  WordLength;
 	uint32_t BaudRate;
 	uint32_t OverSampling;
+	uint32_t HwFlowCtl;
+	uint32_t Rts_High_Water;
+	uint32_t Rts_Low_Water;
+	uint32_t Xoff_High_Water;
+	uint32_t Xon_Low_Water;
+	uint8_t  *Tx_Buff;
+	uint8_t  *Rx_Buff;
+	uint32_t  Tx_Buff_Size;
+	uint32_t  Rx_Buff_Size;
+	uint32_t  *Tx_Marks;
 } USART_Config_t;
 
 /* =========================================================================================
@@ -211,7 +437,239 @@ extern const USART_Config_t     USART_Config[USART_MAX_NUM];
  *  - RX_INT = ENABLE,  TX_INT = ENABLE:
  *      Fully interrupt-driven. Cyclic functions are not required.
  */
+#ifndef USART_RX_INT
 #define USART_RX_INT  ENABLE
+#endif
+#ifndef USART_TX_INT
 #define USART_TX_INT  DISABLE
+#endif
+
+/*
+ * USART_RX_DMA:
+ *  - ENABLE: RX uses one circular DMA stream per USART (HAL_UARTEx_ReceiveToIdle_DMA).
+ *            The DMA half-transfer, transfer-complete and USART IDLE-line events hand
+ *            whole chunks to the RX buffer, so the CPU takes a few interrupts per burst
+ *            instead of one per byte.
+ *  - DISABLE: RX handled per byte (interrupt or polling, see USART_RX_INT).
+ *  - Requires USART_RX_INT == ENABLE (IDLE-line event is delivered by the USART IRQ).
+ *
+ * USART_RX_DMA_SIZE:
+ *  - Circular DMA landing buffer per USART instance (bytes).
+ *  - Must hold at least the bytes that can arrive during the worst-case ISR latency
+ *    times two (an event is raised every half buffer).
+ *
+ * DMA stream mapping (fixed by STM32F407 request mapping, see RM0090 DMA tables):
+ *  - USART1_RX: DMA2 Stream2 Ch4   - USART2_RX: DMA1 Stream5 Ch4
+ *  - USART3_RX: DMA1 Stream1 Ch4   - UART4_RX : DMA1 Stream2 Ch4
+ *  - UART5_RX : DMA1 Stream0 Ch4   - USART6_RX: DMA2 Stream1 Ch5
+ */
+#ifndef USART_RX_DMA
+#define USART_RX_DMA       DISABLE
+#endif
+#define USART_RX_DMA_SIZE  64U
+
+/*
+ * USART_TX_DMA:
+ *  - ENABLE: adds USART_SendBuffer(), which hands a caller-owned buffer straight to a
+ *            DMA stream (no copy into the TX buffer, no per-byte interrupt). The
+ *            completion callback tells the caller when the buffer may be reused.
+ *  - Byte APIs (USART_SendByte) keep working; bytes queued while a DMA transfer is in
+ *    flight are sent after it completes.
+ *
+ * DMA stream mapping (STM32F407, see RM0090 DMA tables):
+ *  - USART1_TX: DMA2 Stream7 Ch4   - USART2_TX: DMA1 Stream6 Ch4
+ *  - USART3_TX: DMA1 Stream3 Ch4   - UART4_TX : DMA1 Stream4 Ch4
+ *  - UART5_TX : DMA1 Stream7 Ch4   - USART6_TX: DMA2 Stream6 Ch5
+ */
+#ifndef USART_TX_DMA
+#define USART_TX_DMA       DISABLE
+#endif
+
+/*
+ * USART_FAST_ISR:
+ *  - ENABLE: USARTx_IRQHandler() is serviced by the driver directly at register
+ *            level (SR/DR) instead of HAL_UART_IRQHandler() -> UART_Receive_IT() ->
+ *            HAL callbacks. RXNE is drained and TXE is refilled in a loop, and the
+ *            per-port state is selected by a compile-time constant per handler.
+ *            TX runs off the TXE interrupt (TXEIE on while bytes are buffered).
+ *  - DISABLE: HAL interrupt path (one HAL_UART_Receive_IT/Transmit_IT per byte).
+ *  - Only affects directions configured with USART_RX_INT / USART_TX_INT = ENABLE.
+ *  - Requires USART_RX_DMA == DISABLE and USART_TX_DMA == DISABLE (DMA events are
+ *    reported through the HAL path).
+ */
+#ifndef USART_FAST_ISR
+#define USART_FAST_ISR     DISABLE
+#endif
+
+/*
+ * USART_SW_RTS:
+ *  - ENABLE: the driver drives the RTS pin of ports with a non-zero Rts_High_Water
+ *            as a GPIO from the RX buffer fill level (see USART_Config_t). The peer
+ *            (with CTS enabled) pauses before the RX buffer overflows instead of the
+ *            driver dropping bytes.
+ *  - DISABLE: no watermark checks in the RX path.
+ */
+#define USART_SW_RTS       DISABLE
+
+/*
+ * USART_XON_XOFF:
+ *  - ENABLE: in-band software flow control for ports without RTS/CTS wiring, on the
+ *            ports with a non-zero Xoff_High_Water (USARTx_XOFF_HIGH_WATER).
+ *              * RX: XOFF/XON from the peer are removed from the RX stream and
+ *                    pause/resume our TX (buffered data is held, not dropped).
+ *              * TX: XOFF/XON are sent ahead of buffered data when the RX buffer
+ *                    crosses the high/low watermark.
+ *  - DISABLE: no flow control characters are interpreted or generated.
+ *  - Only for text links: binary payloads may contain 0x11/0x13.
+ *
+ * USART_XON_CHAR / USART_XOFF_CHAR:
+ *  - Flow control characters (DC1 / DC3 by convention).
+ */
+#ifndef USART_XON_XOFF
+#define USART_XON_XOFF     DISABLE
+#endif
+#define USART_XON_CHAR     0x11U
+#define USART_XOFF_CHAR    0x13U
+
+/*
+ * USART_STATS:
+ *  - ENABLE: per-port counters (bytes in/out, overrun/framing/noise/parity errors,
+ *            RX buffer-full drops, RX/TX high-water marks), read with USART_GetStats().
+ *            A few increments per byte/interrupt.
+ *  - DISABLE: counters compiled out, USART_GetStats() returns zeros.
+ */
+#define USART_STATS        ENABLE
+
+/*
+ * USART_PROFILE:
+ *  - ENABLE: cycle-accurate hot-path instrumentation from the DWT cycle counter.
+ *            USART_SendByte / USART_ReceiveByte, the cyclic routines, the HAL TX/RX
+ *            complete callbacks and the IRQ handlers record min / max / mean cycles
+ *            and a log2 histogram per port, read with USART_GetProfile().
+ *            Two CYCCNT reads plus a few compares per probed call; USART_Init()
+ *            switches the cycle counter on.
+ *  - DISABLE: probes compiled out to nothing, USART_GetProfile() returns zeros.
+ */
+#ifndef USART_PROFILE
+#define USART_PROFILE      DISABLE
+#endif
+
+/*
+ * USART_STDIO:
+ *  - ENABLE: printf()/puts() go out of USART_STDIO_PORT (USART_Stdio.c overrides the
+ *            weak ITM/SWO _write() in syscalls.c). Each _write() span is copied into
+ *            the TX buffer in one USART_Send() and the call returns immediately, so it
+ *            works without a debugger attached. The port must be initialized.
+ *  - DISABLE: printf() keeps using ITM/SWO (blocks per character, debug only).
+ *
+ * USART_STDIO_PORT:
+ *  - USART_NUM_x that stdout / stderr are sent on. Give it a port of its own: text
+ *    mixed into the data port (USART_NUM_2) or the binary log port corrupts their
+ *    streams (TASKS.c checks both). TASKS_Init() initializes it.
+ *
+ * USART_STDIO_TIMEOUT_MS:
+ *  - Policy when the TX buffer has no room for a span:
+ *      0U                 : drop it, never block (counted, see USART_StdioDropped())
+ *      n / 0xFFFFFFFFU    : block the printing task up to n ms / forever
+ *  - Size USARTx_TX_BUFF_SIZE for the longest line: longer spans go out in pieces.
+ */
+#ifndef USART_STDIO
+#define USART_STDIO             DISABLE
+#endif
+
+#ifndef USART_STDIO_PORT
+#define USART_STDIO_PORT        USART_NUM_3
+#endif
+
+#ifndef USART_STDIO_TIMEOUT_MS
+#define USART_STDIO_TIMEOUT_MS  0U
+#endif
+
+/*
+ * USART_FRAME:
+ *  - ENABLE: COBS / SLIP packet layer (USART_Frame.h). Attached ports decode in the
+ *            RX interrupt / DMA event straight into a static pool of frame buffers.
+ *  - DISABLE: compiled out, no pool RAM reserved.
+ *
+ * USART_FRAME_POOL_COUNT:
+ *  - Frame buffers shared by all attached ports (received frames not yet released,
+ *    plus one being decoded per port).
+ *
+ * USART_FRAME_MAX_LEN:
+ *  - Largest decoded payload in bytes; longer frames are discarded and counted.
+ */
+#ifndef USART_FRAME
+#define USART_FRAME             DISABLE
+#endif
+
+#ifndef USART_FRAME_POOL_COUNT
+#define USART_FRAME_POOL_COUNT  8U
+#endif
+
+#ifndef USART_FRAME_MAX_LEN
+#define USART_FRAME_MAX_LEN     128U
+#endif
+
+/*
+ * USART_FRAME_CRC:
+ *  - Checksum appended (big endian) by USART_Frame_Send() and checked, then
+ *    stripped, by USART_Frame_Receive(); frames that fail are discarded and counted
+ *    as errors. Both ends must use the same setting.
+ *  - USART_FRAME_CRC_NONE / USART_FRAME_CRC_16 (CRC-16/CCITT-FALSE) /
+ *    USART_FRAME_CRC_32 (CRC-32/MPEG-2). The value is the trailer length in bytes,
+ *    which counts against USART_FRAME_MAX_LEN.
+ *
+ * USART_CRC_HW:
+ *  - ENABLE: USART_Crc32() runs on the STM32 CRC unit (USART_Crc.h).
+ *  - DISABLE: table-driven software CRC.
+ *  - Default: ENABLE when the device header defines the CRC peripheral, so host
+ *    builds (Sim/) fall back to software automatically.
+ */
+#define USART_FRAME_CRC_NONE    0U
+#define USART_FRAME_CRC_16      2U
+#define USART_FRAME_CRC_32      4U
+
+#ifndef USART_FRAME_CRC
+#define USART_FRAME_CRC         USART_FRAME_CRC_NONE
+#endif
+
+#ifndef USART_CRC_HW
+#if defined(CRC)
+#define USART_CRC_HW            ENABLE
+#else
+#define USART_CRC_HW            DISABLE
+#endif
+#endif
+
+/*
+ * USART_AUTOBAUD:
+ *  - ENABLE: USART_AutoBaud() (USART_AutoBaud.c). The RX pin is lent to a timer input
+ *            capture channel while the peer's sync byte is measured; the ports that
+ *            have one are listed in that file's table. The file owns the IRQ handlers
+ *            of those timers (TIM4, TIM5).
+ *  - DISABLE: compiled out, USART_AutoBaud() is not available.
+ *
+ * USART_AUTOBAUD_MIN_BAUD:
+ *  - Slowest rate to detect. Sets the prescaler of 16-bit capture timers so the sync
+ *    byte fits one counter period; faster rates are measured with fewer counts.
+ */
+#ifndef USART_AUTOBAUD
+#define USART_AUTOBAUD          DISABLE
+#endif
+
+#ifndef USART_AUTOBAUD_MIN_BAUD
+#define USART_AUTOBAUD_MIN_BAUD 1200U
+#endif
+
+/*
+ * USART_MODBUS:
+ *  - ENABLE: Modbus RTU slave (TASKS/USART_Modbus.c, USART_Modbus.h). It time-stamps
+ *            every byte in the RX interrupt, so it needs USART_RX_INT without
+ *            USART_RX_DMA. USART_Modbus_Tim.c owns TIM2 and its IRQ handler.
+ *  - DISABLE: both files compile to nothing; TIM2 stays free.
+ */
+#ifndef USART_MODBUS
+#define USART_MODBUS            DISABLE
+#endif
 
 #endif /* USART_USART_CFG_H_ */
@@ -0,0 +1,68 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Crc.h
+ *  Author    : Ahmed
+ *  Created   : Feb 20, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Frame checksums for USART traffic (used by USART_Frame.c when USART_FRAME_CRC is
+ *  set, see USART_Cfg.h).
+ *
+ *  Algorithms:
+ *  -----------
+ *   - CRC-32/MPEG-2 : poly 0x04C11DB7, init 0xFFFFFFFF, MSB first, no final XOR.
+ *                     This is the fixed algorithm of the STM32F4 CRC unit.
+ *                     Check value ("123456789"): 0x0376E6E7.
+ *   - CRC-16/CCITT-FALSE : poly 0x1021, init 0xFFFF, MSB first, no final XOR.
+ *                     Check value ("123456789"): 0x29B1.
+ *   - CRC-16/MODBUS : poly 0x8005 reflected (0xA001), init 0xFFFF, LSB first, no
+ *                     final XOR. Check value ("123456789"): 0x4B37.
+ *
+ *  None has a final XOR: a message followed by its own CRC checks to 0, which is
+ *  how frames are verified. The CRC is appended big endian for the MSB-first
+ *  algorithms, little endian (low byte first) for CRC-16/MODBUS.
+ *
+ *  Implementations:
+ *  ----------------
+ *   - USART_Crc32() : CRC unit when USART_CRC_HW == ENABLE (whole 32-bit words, the
+ *                     last 0..3 bytes in software), else the table below.
+ *   - USART_Crc32Sw(), USART_Crc16(), USART_Crc16Modbus() : table driven, one
+ *                     lookup per byte (1 KB / 512 B / 512 B of const tables in flash).
+ * =========================================================================================
+ */
+
+#ifndef USART_USART_CRC_H_
+#define USART_USART_CRC_H_
+
+#include <stdint.h>
+
+/* Start value for USART_Crc16Modbus(). */
+#define USART_CRC16_MODBUS_INIT     0xFFFFU
+
+/**
+ * @brief  CRC-32/MPEG-2 of a buffer, on the CRC unit if USART_CRC_HW == ENABLE.
+ * @note   Any context (task or ISR). The CRC unit is shared: the calculation runs
+ *         with interrupts masked up to configMAX_SYSCALL_INTERRUPT_PRIORITY, about
+ *         one cycle per byte.
+ */
+uint32_t USART_Crc32(const uint8_t *Data, uint32_t Len);
+
+/**
+ * @brief  CRC-32/MPEG-2 of a buffer, always in software (same result as USART_Crc32).
+ */
+uint32_t USART_Crc32Sw(const uint8_t *Data, uint32_t Len);
+
+/**
+ * @brief  CRC-16/CCITT-FALSE of a buffer (software).
+ */
+uint16_t USART_Crc16(const uint8_t *Data, uint32_t Len);
+
+/**
+ * @brief  Continue a CRC-16/MODBUS over more bytes (incremental: start with
+ *         USART_CRC16_MODBUS_INIT, feed the bytes as they arrive).
+ * @return Updated CRC; low byte goes first on the wire.
+ */
+uint16_t USART_Crc16Modbus(uint16_t Crc, const uint8_t *Data, uint32_t Len);
+
+#endif /* USART_USART_CRC_H_ */
@@ -0,0 +1,723 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Frame.c
+ *  Author    : Ahmed
+ *  Created   : Feb 18, 2026
+ *
+ *  Description:
+ *  ------------
+ *  COBS / SLIP framing layer (see USART_Frame.h for the API and encodings).
+ *
+ *  RX path:
+ *   - usart_frame_rx_hook() is the port's RX hook. It runs one small state machine
+ *     per port (usart_frame_rx_t) and writes decoded bytes straight into a pool
+ *     buffer taken from Frame_Free_Q. On the delimiter the buffer pointer goes to the
+ *     port's Frame_Ready_Q and the reader task is notified (USART_NOTIFY_INDEX).
+ *   - Both queues carry USART_Frame_t pointers only: a frame is never copied.
+ *   - No free buffer / frame too long / malformed: the rest of the frame is skipped
+ *     up to the next delimiter and counted (USART_Frame_GetStats).
+ *
+ *  TX path:
+ *   - usart_frame_encode() produces the encoded frame in USART_FRAME_CHUNK pieces
+ *     through a sink: counting only, a TX reservation (ring backend), or USART_Send().
+ *   - The source is the payload followed by the USART_FRAME_CRC trailer
+ *     (usart_frame_src_t), so the trailer is never copied next to the payload.
+ *
+ *  Checksum (USART_FRAME_CRC != USART_FRAME_CRC_NONE):
+ *   - Verified in USART_Frame_Receive(), in task context, so the RX interrupt only
+ *     decodes.
+ * =========================================================================================
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "USART.h"
+#include "USART_Prv.h"
+#include "USART_Cfg.h"
+#include "USART_Frame.h"
+#include "USART_Crc.h"
+
+#if (USART_FRAME == ENABLE)
+
+#define USART_FRAME_COBS_DELIM      0x00U
+#define USART_FRAME_SLIP_END        0xC0U
+#define USART_FRAME_SLIP_ESC        0xDBU
+#define USART_FRAME_SLIP_ESC_END    0xDCU
+#define USART_FRAME_SLIP_ESC_ESC    0xDDU
+
+/* COBS: a code byte covers at most 254 data bytes (code 0xFF, no implied zero). */
+#define USART_FRAME_COBS_BLOCK      254U
+
+/* Encoder output chunk: one USART_TxWrite() / USART_Send() per chunk. */
+#define USART_FRAME_CHUNK           32U
+
+/* =========================================================================================
+ *                                     Frame Pool
+ * =========================================================================================
+ *
+ * Frame_Pool / Frame_Storage:
+ *  - USART_FRAME_POOL_COUNT buffers of USART_FRAME_MAX_LEN bytes, shared by all ports.
+ *
+ * Frame_Free_Q:
+ *  - Free buffers. Taken by the decoders (ISR), given back by USART_Frame_Release().
+ *
+ * Frame_Ready_Q:
+ *  - Completed frames per port, in arrival order, for USART_Frame_Receive().
+ */
+static uint8_t       Frame_Storage[USART_FRAME_POOL_COUNT][USART_FRAME_MAX_LEN];
+static USART_Frame_t Frame_Pool[USART_FRAME_POOL_COUNT];
+
+static QueueHandle_t Frame_Free_Q;
+static QueueHandle_t Frame_Ready_Q[USART_MAX_NUM];
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+static StaticQueue_t Frame_Free_Cb;
+static uint8_t       Frame_Free_Buff[USART_FRAME_POOL_COUNT * sizeof(USART_Frame_t *)];
+static StaticQueue_t Frame_Ready_Cb[USART_MAX_NUM];
+static uint8_t       Frame_Ready_Buff[USART_MAX_NUM][USART_FRAME_POOL_COUNT * sizeof(USART_Frame_t *)];
+#endif
+
+/*
+ * usart_frame_rx_t:
+ *  - Cur  : pool buffer being filled (NULL until the first payload byte)
+ *  - Skip : discard everything up to the next delimiter
+ *  - Esc  : SLIP, previous byte was ESC
+ *  - Code : COBS, code byte of the current block (0 = no block yet)
+ *  - Left : COBS, data bytes still expected in the current block
+ */
+typedef struct
+{
+	USART_Frame_t *Cur;
+	uint8_t        Proto;
+	uint8_t        Skip;
+	uint8_t        Esc;
+	uint8_t        Code;
+	uint8_t        Left;
+} usart_frame_rx_t;
+
+static usart_frame_rx_t      Frame_Rx[USART_MAX_NUM];
+static USART_Frame_Stats_t   Frame_Stats[USART_MAX_NUM];
+static volatile uint8_t      Frame_Attached[USART_MAX_NUM];
+
+/* Task blocked in USART_Frame_Receive(), NULL if none (same scheme as the driver). */
+static TaskHandle_t volatile Frame_Waiter[USART_MAX_NUM];
+
+/*
+ * usart_frame_src_t:
+ *  - Bytes to encode: Data[0 .. Len) then Tail[0 .. Tail_Len) (the CRC trailer).
+ */
+typedef struct
+{
+	const uint8_t *Data;
+	uint32_t       Len;
+	uint8_t        Tail[USART_FRAME_CRC_32];
+	uint32_t       Tail_Len;
+} usart_frame_src_t;
+
+/*
+ * usart_frame_tx_t:
+ *  - Encoder sink. Count_Only: just count the encoded length (Count).
+ *    Otherwise chunks go to Resv (USART_TxWrite) if set, else to USART_Send().
+ */
+typedef struct
+{
+	USART_Num_t     USART_Num;
+	uint8_t         Count_Only;
+	USART_Err_St_t  Err;
+	uint32_t        Count;
+	uint32_t        Timeout_Ms;
+	USART_TxResv_t *Resv;
+	uint32_t        Fill;
+	uint8_t         Buff[USART_FRAME_CHUNK];
+} usart_frame_tx_t;
+
+/* =========================================================================================
+ *                                     RX Decoder
+ * =========================================================================================
+ */
+static inline void usart_frame_put(USART_Num_t USART_Num, usart_frame_rx_t *Rx, uint8_t Data)
+{
+	if((Rx->Cur == NULL) && (xQueueReceiveFromISR(Frame_Free_Q, &Rx->Cur, NULL) != pdPASS))
+	{
+		Rx->Cur  = NULL;
+		Rx->Skip = 1U;
+		Frame_Stats[USART_Num].Drops++;
+	}
+	else if(Rx->Cur->Len >= USART_FRAME_MAX_LEN)
+	{
+		Rx->Skip = 1U;
+		Frame_Stats[USART_Num].Errors++;
+	}
+	else
+	{
+		Rx->Cur->Data[Rx->Cur->Len++] = Data;
+	}
+}
+
+/*
+ * usart_frame_end():
+ *  - Delimiter received. Valid == 0 means the encoding was cut off mid-way.
+ */
+static void usart_frame_end(USART_Num_t USART_Num, usart_frame_rx_t *Rx, uint8_t Valid, BaseType_t *Woken)
+{
+	TaskHandle_t Task;
+
+	if(Rx->Skip == 0U)
+	{
+		if(Valid == 0U)
+		{
+			Frame_Stats[USART_Num].Errors++;
+		}
+		else if((Rx->Cur != NULL) && (Rx->Cur->Len != 0U))
+		{
+			if(xQueueSendFromISR(Frame_Ready_Q[USART_Num], &Rx->Cur, Woken) == pdPASS)
+			{
+				Rx->Cur = NULL;
+
+				Task = Frame_Waiter[USART_Num];
+				if(Task != NULL)
+				{
+					Frame_Waiter[USART_Num] = NULL;
+					vTaskNotifyGiveIndexedFromISR(Task, USART_NOTIFY_INDEX, Woken);
+				}
+			}
+			else
+			{
+				Frame_Stats[USART_Num].Drops++;
+			}
+		}
+	}
+
+	/* Start over; a buffer that was not delivered is reused for the next frame. */
+	if(Rx->Cur != NULL)
+	{
+		Rx->Cur->Len = 0U;
+	}
+	Rx->Skip = 0U;
+	Rx->Esc  = 0U;
+	Rx->Code = 0U;
+	Rx->Left = 0U;
+}
+
+static inline void usart_frame_cobs_byte(USART_Num_t USART_Num, usart_frame_rx_t *Rx, uint8_t Data, BaseType_t *Woken)
+{
+	if(Data == USART_FRAME_COBS_DELIM)
+	{
+		/* Valid only on a block boundary (a lone delimiter has no block: just a resync). */
+		usart_frame_end(USART_Num, Rx, (uint8_t)(Rx->Left == 0U), Woken);
+	}
+	else if(Rx->Skip != 0U)
+	{
+		/* Discarding up to the next delimiter. */
+	}
+	else if(Rx->Left == 0U)
+	{
+		/* Code byte: the previous block (unless a full 0xFF one) ended with a zero. */
+		if((Rx->Code != 0U) && (Rx->Code != 0xFFU))
+		{
+			usart_frame_put(USART_Num, Rx, 0x00U);
+		}
+		Rx->Code = Data;
+		Rx->Left = (uint8_t)(Data - 1U);
+	}
+	else
+	{
+		usart_frame_put(USART_Num, Rx, Data);
+		Rx->Left--;
+	}
+}
+
+static inline void usart_frame_slip_byte(USART_Num_t USART_Num, usart_frame_rx_t *Rx, uint8_t Data, BaseType_t *Woken)
+{
+	if(Data == USART_FRAME_SLIP_END)
+	{
+		usart_frame_end(USART_Num, Rx, (uint8_t)(Rx->Esc == 0U), Woken);
+	}
+	else if(Rx->Skip != 0U)
+	{
+		/* Discarding up to the next END. */
+	}
+	else if(Rx->Esc != 0U)
+	{
+		Rx->Esc = 0U;
+		if(Data == USART_FRAME_SLIP_ESC_END)
+		{
+			usart_frame_put(USART_Num, Rx, USART_FRAME_SLIP_END);
+		}
+		else if(Data == USART_FRAME_SLIP_ESC_ESC)
+		{
+			usart_frame_put(USART_Num, Rx, USART_FRAME_SLIP_ESC);
+		}
+		else
+		{
+			Rx->Skip = 1U;
+			Frame_Stats[USART_Num].Errors++;
+		}
+	}
+	else if(Data == USART_FRAME_SLIP_ESC)
+	{
+		Rx->Esc = 1U;
+	}
+	else
+	{
+		usart_frame_put(USART_Num, Rx, Data);
+	}
+}
+
+/* RX hook (ISR context, or USART_RxCyclic with RX polling). */
+static void usart_frame_rx_hook(USART_Num_t USART_Num, const uint8_t *Data, uint32_t Len)
+{
+	usart_frame_rx_t *Rx    = &Frame_Rx[USART_Num];
+	BaseType_t        Woken = pdFALSE;
+
+	if(Rx->Proto == (uint8_t)USART_FRAME_COBS)
+	{
+		for(uint32_t i = 0 ; i < Len ; i++)
+		{
+			usart_frame_cobs_byte(USART_Num, Rx, Data[i], &Woken);
+		}
+	}
+	else
+	{
+		for(uint32_t i = 0 ; i < Len ; i++)
+		{
+			usart_frame_slip_byte(USART_Num, Rx, Data[i], &Woken);
+		}
+	}
+	portYIELD_FROM_ISR(Woken);
+}
+
+/* =========================================================================================
+ *                                     TX Encoder
+ * =========================================================================================
+ */
+static void usart_frame_flush(usart_frame_tx_t *Tx)
+{
+	if((Tx->Fill != 0U) && (Tx->Err == USART_Tx_Ok))
+	{
+#if (USART_BUFF_BACKEND == USART_BUFF_RING)
+		if(Tx->Resv != NULL)
+		{
+			Tx->Err = USART_TxWrite(Tx->Resv, Tx->Buff, Tx->Fill);
+		}
+		else
+#endif
+		{
+			Tx->Err = USART_Send(Tx->USART_Num, Tx->Buff, Tx->Fill, Tx->Timeout_Ms);
+		}
+	}
+	Tx->Fill = 0U;
+}
+
+static void usart_frame_emit(usart_frame_tx_t *Tx, const uint8_t *Data, uint32_t Len)
+{
+	uint32_t Part;
+
+	Tx->Count += Len;
+
+	while((Tx->Count_Only == 0U) && (Len != 0U))
+	{
+		Part = USART_FRAME_CHUNK - Tx->Fill;
+		if(Part > Len)
+		{
+			Part = Len;
+		}
+		memcpy(&Tx->Buff[Tx->Fill], Data, Part);
+		Tx->Fill += Part;
+		Data     += Part;
+		Len      -= Part;
+
+		if(Tx->Fill == USART_FRAME_CHUNK)
+		{
+			usart_frame_flush(Tx);
+		}
+	}
+}
+
+static inline void usart_frame_emit_byte(usart_frame_tx_t *Tx, uint8_t Data)
+{
+	usart_frame_emit(Tx, &Data, 1U);
+}
+
+static inline uint8_t usart_frame_src_at(const usart_frame_src_t *Src, uint32_t Pos)
+{
+	return (Pos < Src->Len) ? Src->Data[Pos] : Src->Tail[Pos - Src->Len];
+}
+
+/* Emit source bytes [Pos .. Pos + Len), which may straddle payload and trailer. */
+static void usart_frame_emit_src(usart_frame_tx_t *Tx, const usart_frame_src_t *Src, uint32_t Pos, uint32_t Len)
+{
+	uint32_t Part = 0;
+
+	if(Pos < Src->Len)
+	{
+		Part = Src->Len - Pos;
+		if(Part > Len)
+		{
+			Part = Len;
+		}
+		usart_frame_emit(Tx, &Src->Data[Pos], Part);
+	}
+	if(Part < Len)
+	{
+		usart_frame_emit(Tx, &Src->Tail[(Pos + Part) - Src->Len], Len - Part);
+	}
+}
+
+static void usart_frame_encode(usart_frame_tx_t *Tx, uint8_t Proto, const usart_frame_src_t *Src)
+{
+	uint32_t Len = Src->Len + Src->Tail_Len;
+	uint32_t Pos = 0;
+	uint32_t Run;
+	uint32_t Start;
+	uint8_t  Data;
+
+	if(Proto == (uint8_t)USART_FRAME_COBS)
+	{
+		while(1)
+		{
+			/* One block: up to 254 non-zero bytes, announced by its code byte. */
+			Run = 0;
+			while(((Pos + Run) < Len) && (usart_frame_src_at(Src, Pos + Run) != 0x00U) && (Run < USART_FRAME_COBS_BLOCK))
+			{
+				Run++;
+			}
+			usart_frame_emit_byte(Tx, (uint8_t)(Run + 1U));
+			usart_frame_emit_src(Tx, Src, Pos, Run);
+			Pos += Run;
+
+			if(Pos == Len)
+			{
+				break;
+			}
+			if(Run != USART_FRAME_COBS_BLOCK)
+			{
+				/* The zero that ended the block is implied by its code. */
+				Pos++;
+			}
+		}
+		usart_frame_emit_byte(Tx, USART_FRAME_COBS_DELIM);
+	}
+	else
+	{
+		/* Leading END flushes any line noise the receiver collected. */
+		usart_frame_emit_byte(Tx, USART_FRAME_SLIP_END);
+		while(Pos < Len)
+		{
+			/* Copy runs of plain bytes in one go. */
+			Start = Pos;
+			while(Pos < Len)
+			{
+				Data = usart_frame_src_at(Src, Pos);
+				if((Data == USART_FRAME_SLIP_END) || (Data == USART_FRAME_SLIP_ESC))
+				{
+					break;
+				}
+				Pos++;
+			}
+			usart_frame_emit_src(Tx, Src, Start, Pos - Start);
+
+			if(Pos < Len)
+			{
+				usart_frame_emit_byte(Tx, USART_FRAME_SLIP_ESC);
+				usart_frame_emit_byte(Tx, (usart_frame_src_at(Src, Pos) == USART_FRAME_SLIP_END) ? USART_FRAME_SLIP_ESC_END : USART_FRAME_SLIP_ESC_ESC);
+				Pos++;
+			}
+		}
+		usart_frame_emit_byte(Tx, USART_FRAME_SLIP_END);
+	}
+	usart_frame_flush(Tx);
+}
+
+/*
+ * usart_frame_crc_ok():
+ *  - Check the USART_FRAME_CRC trailer and strip it from Frame->Len.
+ *  - A message followed by its CRC (big endian) checks to 0 for both algorithms.
+ */
+static uint8_t usart_frame_crc_ok(USART_Frame_t *Frame)
+{
+	uint8_t Ok = 1U;
+
+#if (USART_FRAME_CRC == USART_FRAME_CRC_32)
+	Ok = (Frame->Len > USART_FRAME_CRC) && (USART_Crc32(Frame->Data, Frame->Len) == 0U);
+#elif (USART_FRAME_CRC == USART_FRAME_CRC_16)
+	Ok = (Frame->Len > USART_FRAME_CRC) && (USART_Crc16(Frame->Data, Frame->Len) == 0U);
+#endif
+	if(Ok != 0U)
+	{
+		Frame->Len -= USART_FRAME_CRC;
+	}
+	return Ok;
+}
+
+/* Same conversion as the driver's blocking calls. */
+static TickType_t usart_frame_ms_to_ticks(uint32_t Timeout_Ms)
+{
+	TickType_t Ticks = portMAX_DELAY;
+
+	if(Timeout_Ms != USART_WAIT_FOREVER)
+	{
+		Ticks = (TickType_t)(((uint64_t)Timeout_Ms * configTICK_RATE_HZ) / 1000U);
+	}
+	return Ticks;
+}
+
+/* =========================================================================================
+ *                                     Public API
+ * =========================================================================================
+ */
+USART_Err_St_t USART_Frame_Attach(USART_Num_t USART_Num , USART_Frame_Proto_t Proto)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Ok;
+	USART_Frame_t *Frame;
+
+	if((USART_Num >= USART_MAX_NUM) || ((Proto != USART_FRAME_COBS) && (Proto != USART_FRAME_SLIP)))
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else
+	{
+		/* Pool and queues are created on first use (call Attach from init code). */
+		if(Frame_Free_Q == NULL)
+		{
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+			Frame_Free_Q = xQueueCreateStatic(USART_FRAME_POOL_COUNT, sizeof(USART_Frame_t *), Frame_Free_Buff, &Frame_Free_Cb);
+#else
+			Frame_Free_Q = xQueueCreate(USART_FRAME_POOL_COUNT, sizeof(USART_Frame_t *));
+#endif
+			for(uint32_t i = 0 ; (Frame_Free_Q != NULL) && (i < USART_FRAME_POOL_COUNT) ; i++)
+			{
+				Frame_Pool[i].Data = Frame_Storage[i];
+				Frame_Pool[i].Len  = 0U;
+				Frame = &Frame_Pool[i];
+				(void)xQueueSend(Frame_Free_Q, &Frame, 0);
+			}
+		}
+		if(Frame_Ready_Q[USART_Num] == NULL)
+		{
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+			Frame_Ready_Q[USART_Num] = xQueueCreateStatic(USART_FRAME_POOL_COUNT, sizeof(USART_Frame_t *),
+			                                              Frame_Ready_Buff[USART_Num], &Frame_Ready_Cb[USART_Num]);
+#else
+			Frame_Ready_Q[USART_Num] = xQueueCreate(USART_FRAME_POOL_COUNT, sizeof(USART_Frame_t *));
+#endif
+		}
+
+		if((Frame_Free_Q == NULL) || (Frame_Ready_Q[USART_Num] == NULL))
+		{
+			USART_Err_Ret =  USART_CreateBuff_Failed;
+		}
+		else
+		{
+			/* Quiesce the decoder while its state is reset. */
+			(void)USART_SetRxHook(USART_Num, NULL);
+
+			if(Frame_Rx[USART_Num].Cur != NULL)
+			{
+				Frame_Rx[USART_Num].Cur->Len = 0U;
+			}
+			Frame_Rx[USART_Num].Proto = (uint8_t)Proto;
+			Frame_Rx[USART_Num].Skip  = 0U;
+			Frame_Rx[USART_Num].Esc   = 0U;
+			Frame_Rx[USART_Num].Code  = 0U;
+			Frame_Rx[USART_Num].Left  = 0U;
+			Frame_Attached[USART_Num] = 1U;
+
+			(void)USART_SetRxHook(USART_Num, usart_frame_rx_hook);
+		}
+	}
+	return USART_Err_Ret;
+}
+
+USART_Err_St_t USART_Frame_Detach(USART_Num_t USART_Num)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Ok;
+
+	if(USART_Num >= USART_MAX_NUM)
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else
+	{
+		(void)USART_SetRxHook(USART_Num, NULL);
+		Frame_Attached[USART_Num] = 0U;
+	}
+	return USART_Err_Ret;
+}
+
+USART_Err_St_t USART_Frame_Receive(USART_Num_t USART_Num , USART_Frame_t **Frame, uint32_t Timeout_Ms)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Rx_NoData;
+	TimeOut_t      Time_Out;
+	TickType_t     Ticks_Left = usart_frame_ms_to_ticks(Timeout_Ms);
+	uint8_t        Ok;
+
+	if((USART_Num >= USART_MAX_NUM) || (Frame == NULL))
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else if(Frame_Ready_Q[USART_Num] == NULL)
+	{
+		USART_Err_Ret =  USART_Not_Init;
+	}
+	else
+	{
+		vTaskSetTimeOutState(&Time_Out);
+
+		while(1)
+		{
+			if(xQueueReceive(Frame_Ready_Q[USART_Num], Frame, 0) == pdPASS)
+			{
+				Ok = usart_frame_crc_ok(*Frame);
+
+				taskENTER_CRITICAL();
+				if(Ok != 0U)
+				{
+					Frame_Stats[USART_Num].Frames++;
+				}
+				else
+				{
+					Frame_Stats[USART_Num].Errors++;
+				}
+				taskEXIT_CRITICAL();
+
+				if(Ok != 0U)
+				{
+					USART_Err_Ret =  USART_Rx_Ok;
+					break;
+				}
+				USART_Frame_Release(*Frame);
+				*Frame = NULL;
+				continue;
+			}
+
+			/* Drop stale notifications -> publish waiter -> re-check -> sleep. */
+			(void)ulTaskNotifyTakeIndexed(USART_NOTIFY_INDEX, pdTRUE, 0);
+			Frame_Waiter[USART_Num] = xTaskGetCurrentTaskHandle();
+
+			if(uxQueueMessagesWaiting(Frame_Ready_Q[USART_Num]) == 0U)
+			{
+				if(xTaskCheckForTimeOut(&Time_Out, &Ticks_Left) != pdFALSE)
+				{
+					Frame_Waiter[USART_Num] = NULL;
+					break;
+				}
+				(void)ulTaskNotifyTakeIndexed(USART_NOTIFY_INDEX, pdTRUE, Ticks_Left);
+			}
+			Frame_Waiter[USART_Num] = NULL;
+		}
+	}
+	return USART_Err_Ret;
+}
+
+void USART_Frame_Release(USART_Frame_t *Frame)
+{
+	if((Frame != NULL) && (Frame_Free_Q != NULL))
+	{
+		Frame->Len = 0U;
+		(void)xQueueSend(Frame_Free_Q, &Frame, 0);
+	}
+}
+
+USART_Err_St_t USART_Frame_Send(USART_Num_t USART_Num , const uint8_t *Data, uint32_t Len, uint32_t Timeout_Ms)
+{
+	USART_Err_St_t   USART_Err_Ret =  USART_Tx_Ok;
+	usart_frame_tx_t  Tx;
+	usart_frame_src_t Src;
+	USART_TxResv_t    Resv;
+#if (USART_FRAME_CRC != USART_FRAME_CRC_NONE)
+	uint32_t          Crc;
+#endif
+
+	if((USART_Num >= USART_MAX_NUM) || (Data == NULL) || (Len == 0U))
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else if(Frame_Attached[USART_Num] == 0U)
+	{
+		USART_Err_Ret =  USART_Not_Init;
+	}
+	else
+	{
+		Tx.USART_Num  = USART_Num;
+		Tx.Err        = USART_Tx_Ok;
+		Tx.Timeout_Ms = Timeout_Ms;
+		Tx.Resv       = NULL;
+		Tx.Fill       = 0U;
+		Tx.Count      = 0U;
+		Tx.Count_Only = 0U;
+
+		Src.Data     = Data;
+		Src.Len      = Len;
+		Src.Tail_Len = USART_FRAME_CRC;
+#if (USART_FRAME_CRC == USART_FRAME_CRC_32)
+		Crc = USART_Crc32(Data, Len);
+		Src.Tail[0] = (uint8_t)(Crc >> 24);
+		Src.Tail[1] = (uint8_t)(Crc >> 16);
+		Src.Tail[2] = (uint8_t)(Crc >> 8);
+		Src.Tail[3] = (uint8_t)Crc;
+#elif (USART_FRAME_CRC == USART_FRAME_CRC_16)
+		Crc = USART_Crc16(Data, Len);
+		Src.Tail[0] = (uint8_t)(Crc >> 8);
+		Src.Tail[1] = (uint8_t)Crc;
+#endif
+
+#if (USART_BUFF_BACKEND == USART_BUFF_RING)
+		/* Size the frame first, then encode straight into one TX reservation. */
+		Tx.Count_Only = 1U;
+		usart_frame_encode(&Tx, Frame_Rx[USART_Num].Proto, &Src);
+		Tx.Count_Only = 0U;
+
+		if(Tx.Count <= USART_Config[USART_Num].Tx_Buff_Size)
+		{
+			Tx.Err  = USART_TxReserve(USART_Num, Tx.Count, Timeout_Ms, &Resv);
+			Tx.Resv = &Resv;
+		}
+#else
+		(void)Resv;
+#endif
+		if(Tx.Err == USART_Tx_Ok)
+		{
+			usart_frame_encode(&Tx, Frame_Rx[USART_Num].Proto, &Src);
+
+#if (USART_BUFF_BACKEND == USART_BUFF_RING)
+			if(Tx.Resv != NULL)
+			{
+				/* Short frame after a write error: the first error wins. */
+				USART_Err_St_t Commit_Ret = USART_TxCommit(Tx.Resv);
+
+				if(Tx.Err == USART_Tx_Ok)
+				{
+					Tx.Err = Commit_Ret;
+				}
+			}
+#endif
+		}
+		USART_Err_Ret = Tx.Err;
+	}
+	return USART_Err_Ret;
+}
+
+USART_Err_St_t USART_Frame_GetStats(USART_Num_t USART_Num , USART_Frame_Stats_t *Stats)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Ok;
+
+	if((USART_Num >= USART_MAX_NUM) || (Stats == NULL))
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else
+	{
+		taskENTER_CRITICAL();
+		*Stats = Frame_Stats[USART_Num];
+		taskEXIT_CRITICAL();
+	}
+	return USART_Err_Ret;
+}
+
+#endif /* USART_FRAME */
@@ -0,0 +1,137 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Frame.h
+ *  Author    : Ahmed
+ *  Created   : Feb 18, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Packet framing on top of the USART byte driver: COBS or SLIP per port
+ *  (USART_FRAME == ENABLE, see USART_Cfg.h).
+ *
+ *  RX (incremental, zero-copy):
+ *   - USART_Frame_Attach() registers the decoder as the port's RX hook
+ *     (USART_SetRxHook), so every byte is decoded once, where it arrives (RX ISR,
+ *     DMA event, or USART_RxCyclic), straight into a buffer from a static frame pool.
+ *   - A completed frame is handed to the application as a pointer
+ *     (USART_Frame_Receive); the application returns it to the pool with
+ *     USART_Frame_Release(). Frame bytes are never copied again.
+ *
+ *  TX (streaming):
+ *   - USART_Frame_Send() encodes in small chunks straight into the TX buffer. With
+ *     the ring backend the encoded frame is one TX reservation (USART_TxReserve), so
+ *     frames from several tasks never interleave.
+ *
+ *  Encodings:
+ *   - COBS: 0x00 never appears inside a frame; each frame ends with 0x00.
+ *           Overhead: 1 byte per 254 bytes of payload (+1 delimiter).
+ *   - SLIP (RFC 1055): frames are wrapped in END (0xC0); END / ESC (0xDB) inside
+ *           the payload are sent as ESC 0xDC / ESC 0xDD. Up to 2x for binary data.
+ *   Empty frames are not delivered (both encodings use them as line resync).
+ *
+ *  Checksum (USART_FRAME_CRC, see USART_Cfg.h):
+ *   - Optional CRC-16 / CRC-32 trailer over the payload (USART_Crc.h), appended
+ *     before encoding and checked after decoding. The application never sees it.
+ * =========================================================================================
+ */
+
+#ifndef USART_USART_FRAME_H_
+#define USART_USART_FRAME_H_
+
+#include <stdint.h>
+
+#include "USART.h"
+
+/*
+ * USART_Frame_Proto_t:
+ *  - Encoding used on one port (USART_Frame_Attach).
+ */
+typedef enum
+{
+	USART_FRAME_COBS = 0,
+	USART_FRAME_SLIP,
+} USART_Frame_Proto_t;
+
+/*
+ * USART_Frame_t:
+ *  - One pool buffer holding a received frame.
+ *  - Data: decoded payload (USART_FRAME_MAX_LEN bytes of storage), Len: payload length.
+ *  - Owned by the application between USART_Frame_Receive() and USART_Frame_Release().
+ */
+typedef struct
+{
+	uint8_t  *Data;
+	uint32_t  Len;
+} USART_Frame_t;
+
+/*
+ * USART_Frame_Stats_t (USART_Frame_GetStats):
+ *
+ * Frames:
+ *  - Frames delivered to the application
+ *
+ * Errors:
+ *  - Frames discarded as malformed (bad COBS code / SLIP escape), longer than
+ *    USART_FRAME_MAX_LEN, or failing the USART_FRAME_CRC check
+ *
+ * Drops:
+ *  - Frames lost because no pool buffer was free or the ready queue was full
+ */
+typedef struct
+{
+	uint32_t Frames;
+	uint32_t Errors;
+	uint32_t Drops;
+} USART_Frame_Stats_t;
+
+/**
+ * @brief  Start framing on a port: received bytes go to the frame decoder instead of
+ *         the RX buffer, and USART_Frame_Send() uses the same encoding.
+ * @param  USART_Num  Logical USART instance ID (initialized)
+ * @param  Proto      USART_FRAME_COBS or USART_FRAME_SLIP
+ * @return USART_Ok, USART_CreateBuff_Failed if the pool queues cannot be created,
+ *         or error codes for invalid args/not init.
+ * @note   Task context. Frames in progress are discarded.
+ */
+USART_Err_St_t USART_Frame_Attach(USART_Num_t USART_Num , USART_Frame_Proto_t Proto);
+
+/**
+ * @brief  Stop framing on a port; received bytes go to the RX buffer again.
+ * @note   Frames already delivered stay valid until released.
+ */
+USART_Err_St_t USART_Frame_Detach(USART_Num_t USART_Num);
+
+/**
+ * @brief  Wait for the next complete frame.
+ * @param  USART_Num   Logical USART instance ID
+ * @param  Frame       Returns the frame (pool buffer, release it after use)
+ * @param  Timeout_Ms  Max time to wait (USART_NO_WAIT / USART_WAIT_FOREVER)
+ * @return USART_Rx_Ok with *Frame set, USART_Rx_NoData on timeout,
+ *         or USART_Invalid_Arg / USART_Not_Init (port not attached).
+ * @note   Task context only. One reader task per port.
+ */
+USART_Err_St_t USART_Frame_Receive(USART_Num_t USART_Num , USART_Frame_t **Frame, uint32_t Timeout_Ms);
+
+/**
+ * @brief  Return a frame obtained from USART_Frame_Receive() to the pool.
+ */
+void USART_Frame_Release(USART_Frame_t *Frame);
+
+/**
+ * @brief  Encode and send one frame with the port's encoding.
+ * @param  USART_Num   Logical USART instance ID (attached)
+ * @param  Data        Payload
+ * @param  Len         Payload length (> 0)
+ * @param  Timeout_Ms  Max time to wait for TX space (USART_NO_WAIT / USART_WAIT_FOREVER)
+ * @return USART_Tx_Ok, USART_Tx_Busy on timeout (with the ring backend nothing was
+ *         sent if the encoded frame fits the TX buffer), or error codes.
+ * @note   Task context only.
+ */
+USART_Err_St_t USART_Frame_Send(USART_Num_t USART_Num , const uint8_t *Data, uint32_t Len, uint32_t Timeout_Ms);
+
+/**
+ * @brief  Copy the frame counters of one port.
+ */
+USART_Err_St_t USART_Frame_GetStats(USART_Num_t USART_Num , USART_Frame_Stats_t *Stats);
+
+#endif /* USART_USART_FRAME_H_ */
@@ -66,6 +66,29 @@
 #define USART_NVIC_GROUP_PRIORITY   4
 #define USART_NVIC_SUB_PRIORITY     4
 
+/*
+ * USART_NOTIFY_INDEX:
+ *  - FreeRTOS task-notification index used to wake tasks blocked in the driver
+ *    (USART_Send / USART_Receive). Index 0 (USART_EVENT_NOTIFY_INDEX, USART.h)
+ *    carries the driver's RX/TX event bits to the task registered for events, so
+ *    the two never share an index.
+ *  - Requires configTASK_NOTIFICATION_ARRAY_ENTRIES > USART_NOTIFY_INDEX.
+ */
+#define USART_NOTIFY_INDEX          1
+
+/*
+ * USART_Tx_State_t:
+ *  - Who owns the transmitter of a port (USART_Tx_State[] in USART.c). Changed only
+ *    with USART_Atomic_Cas() or by the current owner, see "TX State Machine" in USART.c.
+ */
+typedef enum
+{
+	USART_TX_IDLE = 0,
+	USART_TX_ACTIVE,
+	USART_TX_DRAINING,
+	USART_TX_SUSPENDED
+} USART_Tx_State_t;
+
 /* =========================================================================================
  *                                Private Helper Prototypes
  * =========================================================================================
@@ -0,0 +1,423 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Ring.c
+ *  Author    : Ahmed
+ *  Created   : Jan 10, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Lock-free SPSC byte ring buffer used as the USART TX/RX backing store.
+ *  See USART_Ring.h for the ownership and memory-ordering rules.
+ * =========================================================================================
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "USART_Ring.h"
+#include "USART_Atomic.h"
+
+uint8_t USART_Ring_Init(USART_Ring_t *Ring, uint8_t *Buff, uint32_t Size)
+{
+	uint8_t ret = 0;
+
+	if((Ring != NULL) && (Buff != NULL) && USART_RING_IS_POW2(Size))
+	{
+		Ring->Buff = Buff;
+		Ring->Mask = Size - 1U;
+		Ring->Head = 0;
+		Ring->Tail = 0;
+		Ring->Reserve = 0;
+		Ring->Done = NULL;
+		Ring->Skip = NULL;
+		ret = 1;
+	}
+	return ret;
+}
+
+uint8_t USART_Ring_InitMp(USART_Ring_t *Ring, uint8_t *Buff, uint32_t Size, uint32_t *Marks)
+{
+	uint8_t ret = 0;
+
+	if((Marks != NULL) && USART_Ring_Init(Ring, Buff, Size))
+	{
+		memset(Marks, 0, USART_RING_MARK_WORDS(Size) * sizeof(uint32_t));
+		Ring->Done = Marks;
+		Ring->Skip = &Marks[USART_RING_MARK_WORDS(Size) / 2U];
+		ret = 1;
+	}
+	return ret;
+}
+
+/*
+ * Done / Skip bitmap helpers. Bit (Pos & Mask) of a bitmap belongs to slot Pos; a
+ * run of slots is handled one bitmap word at a time and never crosses the end of
+ * the storage (the next run starts again at bit 0).
+ */
+static inline uint32_t ring_run_len(const USART_Ring_t *Ring, uint32_t Idx, uint32_t Len)
+{
+	uint32_t Run = 32U - (Idx & 31U);
+
+	if(Run > ((Ring->Mask + 1U) - Idx))
+	{
+		Run = (Ring->Mask + 1U) - Idx;
+	}
+	return (Run > Len) ? Len : Run;
+}
+
+static inline uint32_t ring_run_mask(uint32_t Idx, uint32_t Run)
+{
+	return ((Run >= 32U) ? 0xFFFFFFFFU : ((1U << Run) - 1U)) << (Idx & 31U);
+}
+
+/* Run of set bits from slot Idx on (0 if Idx is clear); *Word receives the bitmap word. */
+static inline uint32_t ring_run_set(const volatile uint32_t *Map, const USART_Ring_t *Ring, uint32_t Idx, uint32_t *Word)
+{
+	uint32_t Ones;
+
+	*Word = Map[Idx >> 5];
+	Ones  = ~(*Word >> (Idx & 31U));
+
+	/* Length of the run is the position of the first zero. */
+	return ((Ones & 1U) != 0U) ? 0U : ring_run_len(Ring, Idx, (Ones == 0U) ? 32U : (uint32_t)__builtin_ctz(Ones));
+}
+
+/*
+ * Consumer side: move Tail over the Skip-marked slots at Tail (never past Head).
+ * Producers set bits of the same words concurrently, so the marks are cleared with
+ * a CAS, before Tail hands the slots back to them.
+ */
+static uint32_t ring_skip(USART_Ring_t *Ring, uint32_t Tail, uint32_t Head)
+{
+	uint32_t Idx;
+	uint32_t Old;
+	uint32_t Run;
+
+	/* Do not read the marks before Head has been observed. */
+	USART_RING_DMB();
+	while(Tail != Head)
+	{
+		Idx = Tail & Ring->Mask;
+		Run = ring_run_set(Ring->Skip, Ring, Idx, &Old);
+		if(Run == 0U)
+		{
+			break;
+		}
+		if(Run > (Head - Tail))
+		{
+			Run = Head - Tail;
+		}
+
+		if(USART_Atomic_Cas(&Ring->Skip[Idx >> 5], Old, Old & ~ring_run_mask(Idx, Run)))
+		{
+			USART_RING_DMB();
+			Tail      += Run;
+			Ring->Tail = Tail;
+		}
+	}
+	return Tail;
+}
+
+uint32_t USART_Ring_Count(const USART_Ring_t *Ring)
+{
+	/* Unsigned subtraction stays correct across counter overflow. */
+	return (Ring->Head - Ring->Tail);
+}
+
+uint32_t USART_Ring_Free(const USART_Ring_t *Ring)
+{
+	/* Open reservations are not readable yet but already take space. */
+	return ((Ring->Mask + 1U) - (Ring->Reserve - Ring->Tail));
+}
+
+uint8_t USART_Ring_Put(USART_Ring_t *Ring, uint8_t Data)
+{
+	uint8_t  ret  = 0;
+	uint32_t head = Ring->Head;
+
+	if((head - Ring->Tail) <= Ring->Mask)
+	{
+		Ring->Buff[head & Ring->Mask] = Data;
+
+		/* Data must be visible before the consumer can see the new Head. */
+		USART_RING_DMB();
+		Ring->Head    = head + 1U;
+		Ring->Reserve = head + 1U;
+		ret = 1;
+	}
+	return ret;
+}
+
+uint8_t USART_Ring_Get(USART_Ring_t *Ring, uint8_t *Data)
+{
+	uint8_t  ret  = 0;
+	uint32_t tail = Ring->Tail;
+	uint32_t head = Ring->Head;
+
+	if((Ring->Skip != NULL) && (head != tail))
+	{
+		tail = ring_skip(Ring, tail, head);
+	}
+
+	if(head != tail)
+	{
+		/* Do not read the slot before Head has been observed. */
+		USART_RING_DMB();
+		*Data = Ring->Buff[tail & Ring->Mask];
+
+		/* Slot read must complete before the producer may reuse it. */
+		USART_RING_DMB();
+		Ring->Tail = tail + 1U;
+		ret = 1;
+	}
+	return ret;
+}
+
+uint32_t USART_Ring_Write(USART_Ring_t *Ring, const uint8_t *Data, uint32_t Len)
+{
+	uint32_t head  = Ring->Head;
+	uint32_t space = (Ring->Mask + 1U) - (head - Ring->Tail);
+	uint32_t idx   = head & Ring->Mask;
+	uint32_t first;
+
+	if(Len > space)
+	{
+		Len = space;
+	}
+
+	/* Copy in at most two segments: [idx .. end) then [0 .. rest). */
+	first = (Ring->Mask + 1U) - idx;
+	if(first > Len)
+	{
+		first = Len;
+	}
+	memcpy(&Ring->Buff[idx], Data, first);
+	memcpy(&Ring->Buff[0], &Data[first], Len - first);
+
+	USART_RING_DMB();
+	Ring->Head    = head + Len;
+	Ring->Reserve = head + Len;
+
+	return Len;
+}
+
+uint32_t USART_Ring_Read(USART_Ring_t *Ring, uint8_t *Data, uint32_t Len)
+{
+	uint32_t tail  = Ring->Tail;
+	uint32_t avail = Ring->Head - tail;
+	uint32_t idx   = tail & Ring->Mask;
+	uint32_t first;
+
+	if(Len > avail)
+	{
+		Len = avail;
+	}
+
+	USART_RING_DMB();
+
+	first = (Ring->Mask + 1U) - idx;
+	if(first > Len)
+	{
+		first = Len;
+	}
+	memcpy(Data, &Ring->Buff[idx], first);
+	memcpy(&Data[first], &Ring->Buff[0], Len - first);
+
+	USART_RING_DMB();
+	Ring->Tail = tail + Len;
+
+	return Len;
+}
+
+uint32_t USART_Ring_Peek(const USART_Ring_t *Ring, const uint8_t **Data)
+{
+	uint32_t tail  = Ring->Tail;
+	uint32_t avail = Ring->Head - tail;
+	uint32_t idx   = tail & Ring->Mask;
+	uint32_t first = (Ring->Mask + 1U) - idx;
+
+	if(first > avail)
+	{
+		first = avail;
+	}
+
+	/* The caller reads the span after this: not before Head has been observed. */
+	USART_RING_DMB();
+	*Data = &Ring->Buff[idx];
+
+	return first;
+}
+
+uint32_t USART_Ring_Consume(USART_Ring_t *Ring, uint32_t Len)
+{
+	uint32_t tail  = Ring->Tail;
+	uint32_t avail = Ring->Head - tail;
+
+	if(Len > avail)
+	{
+		Len = avail;
+	}
+
+	/* The caller's reads of the span must complete before the producer reuses it. */
+	USART_RING_DMB();
+	Ring->Tail = tail + Len;
+
+	return Len;
+}
+
+uint8_t USART_Ring_Reserve(USART_Ring_t *Ring, uint32_t Len, uint32_t *Pos)
+{
+	uint8_t  ret = 0;
+	uint32_t resv;
+
+	while(Len != 0U)
+	{
+		resv = Ring->Reserve;
+
+		/* Tail only moves forward meanwhile, so this check can only be pessimistic. */
+		if(((resv - Ring->Tail) + Len) > (Ring->Mask + 1U))
+		{
+			break;
+		}
+		if(USART_Atomic_Cas(&Ring->Reserve, resv, resv + Len))
+		{
+			*Pos = resv;
+			ret  = 1;
+			break;
+		}
+	}
+	return ret;
+}
+
+uint32_t USART_Ring_Acquire(USART_Ring_t *Ring, uint32_t Want, uint32_t *Pos)
+{
+	uint32_t resv;
+	uint32_t len = 0;
+
+	while(Want != 0U)
+	{
+		resv = Ring->Reserve;
+
+		/* Free space, cut at the end of the storage. */
+		len = (Ring->Mask + 1U) - (resv - Ring->Tail);
+		if(len > ((Ring->Mask + 1U) - (resv & Ring->Mask)))
+		{
+			len = (Ring->Mask + 1U) - (resv & Ring->Mask);
+		}
+		if(len > Want)
+		{
+			len = Want;
+		}
+
+		if((len == 0U) || USART_Atomic_Cas(&Ring->Reserve, resv, resv + len))
+		{
+			*Pos = resv;
+			break;
+		}
+	}
+	return len;
+}
+
+void USART_Ring_Fill(USART_Ring_t *Ring, uint32_t Pos, const uint8_t *Data, uint32_t Len)
+{
+	uint32_t idx   = Pos & Ring->Mask;
+	uint32_t first = (Ring->Mask + 1U) - idx;
+
+	if(first > Len)
+	{
+		first = Len;
+	}
+	memcpy(&Ring->Buff[idx], Data, first);
+	memcpy(&Ring->Buff[0], &Data[first], Len - first);
+}
+
+uint8_t USART_Ring_Shrink(USART_Ring_t *Ring, uint32_t Pos, uint32_t Len, uint32_t Used)
+{
+	return USART_Atomic_Cas(&Ring->Reserve, Pos + Len, Pos + Used);
+}
+
+static void ring_mark(volatile uint32_t *Map, const USART_Ring_t *Ring, uint32_t Pos, uint32_t Len)
+{
+	uint32_t Idx;
+	uint32_t Run;
+	uint32_t Bits;
+	uint32_t Old;
+
+	while(Len != 0U)
+	{
+		Idx  = Pos & Ring->Mask;
+		Run  = ring_run_len(Ring, Idx, Len);
+		Bits = ring_run_mask(Idx, Run);
+
+		/* Other producers mark their own slots in the same word. */
+		do
+		{
+			Old = Map[Idx >> 5];
+		} while(USART_Atomic_Cas(&Map[Idx >> 5], Old, Old | Bits) == 0U);
+
+		Pos += Run;
+		Len -= Run;
+	}
+}
+
+/*
+ * Move Head over the committed slots that follow it. Clearing a run of marks with
+ * a CAS makes the caller the only one allowed to move Head over that run. If Head
+ * moved meanwhile (the caller was preempted for a whole lap and the marks belong to
+ * a later one), they are put back and the loop starts again from the new Head.
+ */
+static void ring_publish(USART_Ring_t *Ring)
+{
+	uint32_t Head;
+	uint32_t Idx;
+	uint32_t Old;
+	uint32_t Run;
+
+	for(;;)
+	{
+		Head = Ring->Head;
+		Idx  = Head & Ring->Mask;
+		Run  = ring_run_set(Ring->Done, Ring, Idx, &Old);
+		if(Run == 0U)
+		{
+			break;
+		}
+
+		if(USART_Atomic_Cas(&Ring->Done[Idx >> 5], Old, Old & ~ring_run_mask(Idx, Run)))
+		{
+			/* The committer's data and Skip marks before the new Head. */
+			USART_RING_DMB();
+			if(USART_Atomic_Cas(&Ring->Head, Head, Head + Run) == 0U)
+			{
+				ring_mark(Ring->Done, Ring, Head, Run);
+			}
+		}
+	}
+}
+
+void USART_Ring_Commit(USART_Ring_t *Ring, uint32_t Pos, uint32_t Len, uint32_t Used)
+{
+	if(Used < Len)
+	{
+		/* Never written: the consumer steps over these slots. */
+		ring_mark(Ring->Skip, Ring, Pos + Used, Len - Used);
+	}
+
+	/* Data and Skip marks must be visible before the range can be published. */
+	USART_RING_DMB();
+
+	if(Ring->Head == Pos)
+	{
+		/* Next in line: nobody else can move Head from Pos. */
+		Ring->Head = Pos + Len;
+	}
+	else
+	{
+		/* An earlier range is still open: leave the marks for its committer. */
+		ring_mark(Ring->Done, Ring, Pos, Len);
+	}
+
+	/* Marks before Head reads (and the Head store before mark reads) on both sides. */
+	USART_RING_DMB();
+	ring_publish(Ring);
+}
@@ -0,0 +1,213 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Ring.h
+ *  Author    : Ahmed
+ *  Created   : Jan 10, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Lock-free single-consumer byte ring buffer, with a single-producer (SPSC) and a
+ *  multi-producer (reserve / fill / commit) write side.
+ *
+ *  Used by the USART driver as the TX/RX backing store when
+ *  USART_BUFF_BACKEND == USART_BUFF_RING (see USART_Cfg.h).
+ *
+ *  Design:
+ *  -------
+ *   - Capacity is a power of two, so wrap-around is a simple index mask.
+ *   - Head/Tail are free-running 32-bit counters:
+ *        * Head is written ONLY by the producer
+ *        * Tail is written ONLY by the consumer
+ *     (Head - Tail) is the fill level, even after the counters overflow.
+ *   - No critical sections: one task + one ISR (or two tasks) can use the
+ *     same ring concurrently as long as there is exactly one producer and
+ *     exactly one consumer.
+ *
+ *  Multi-producer writes (USART TX path):
+ *  --------------------------------------
+ *   - Reserve is a third free-running counter, claimed with an atomic
+ *     compare-and-swap (LDREX/STREX), so several producers can each own a
+ *     contiguous slot range [Pos .. Pos + Len) at the same time.
+ *   - Producers fill their range, then commit. Head still moves strictly in
+ *     reservation order, but a commit never waits for an earlier producer: it
+ *     marks its slots in the Done bitmap (one bit per slot) and returns. Whoever
+ *     moves Head next also moves it over every marked slot that follows, clearing
+ *     the marks with a CAS, so the last of the earlier producers to commit
+ *     publishes the later ranges too.
+ *   - A range only partly filled whose end cannot be given back (a later range
+ *     follows it) is committed with its Used length: the unwritten slots are
+ *     marked in the Skip bitmap and USART_Ring_Get() steps over them, so the
+ *     consumer never sees bytes nobody wrote. Count/Read/Peek do not look at
+ *     Skip: the consumer of a reserve/commit ring uses USART_Ring_Get() only.
+ *   - Tail <= Head <= Reserve. Put/Write keep Reserve == Head, so a ring must use
+ *     either the SPSC or the reserve/commit write side, never both. The
+ *     reserve/commit side needs USART_Ring_InitMp() (Done and Skip bitmap storage).
+ *
+ *  Memory ordering (Cortex-M4):
+ *  ----------------------------
+ *   - Producer: write data byte(s) -> DMB -> publish new Head
+ *   - Consumer: read Head -> DMB -> read data byte(s) -> DMB -> publish new Tail
+ *   The DMB makes sure the other side never observes an index update before
+ *   the data it guards.
+ * =========================================================================================
+ */
+
+#ifndef USART_USART_RING_H_
+#define USART_USART_RING_H_
+
+#include <stdint.h>
+
+/* =========================================================================================
+ *                                  Memory Barrier
+ * =========================================================================================
+ *
+ * On target the CMSIS __DMB() intrinsic is used. Any other build (host tools)
+ * falls back to a full compiler/CPU fence.
+ */
+#if defined(__ARM_ARCH)
+#include "stm32f4xx.h"
+#define USART_RING_DMB()   __DMB()
+#else
+#define USART_RING_DMB()   __sync_synchronize()
+#endif
+
+/* Helper: evaluates to 1 if x is a non-zero power of two. */
+#define USART_RING_IS_POW2(x)  (((x) != 0U) && (((x) & ((x) - 1U)) == 0U))
+
+/* Words of bitmap storage USART_Ring_InitMp() needs for a ring of Size bytes (Done + Skip). */
+#define USART_RING_MARK_WORDS(Size)  (2U * (((Size) + 31U) / 32U))
+
+/**
+ * @brief SPSC ring control block.
+ *
+ * Buff:
+ *  - Caller-provided storage (size must be a power of two)
+ *
+ * Mask:
+ *  - (size - 1), used to wrap the free-running indexes
+ *
+ * Head / Tail:
+ *  - Free-running write / read counters
+ *
+ * Reserve:
+ *  - Free-running counter of slots claimed by producers (== Head when no
+ *    reservation is open)
+ *
+ * Done:
+ *  - Multi-producer side: one bit per slot, set by USART_Ring_Commit() for slots
+ *    committed ahead of Head, cleared when Head moves over them (NULL for SPSC use)
+ *
+ * Skip:
+ *  - Multi-producer side: one bit per slot, set by USART_Ring_Commit() for slots
+ *    reserved but never written, cleared when USART_Ring_Get() steps over them
+ *    (NULL for SPSC use)
+ */
+typedef struct USART_Ring_s
+{
+	uint8_t           *Buff;
+	uint32_t           Mask;
+	volatile uint32_t  Head;
+	volatile uint32_t  Tail;
+	volatile uint32_t  Reserve;
+	volatile uint32_t *Done;
+	volatile uint32_t *Skip;
+} USART_Ring_t;
+
+/**
+ * @brief  Attach storage to a ring and reset it to empty.
+ * @param  Ring  Ring control block
+ * @param  Buff  Storage area
+ * @param  Size  Storage size in bytes (must be a power of two)
+ * @return 1 on success, 0 if arguments are invalid.
+ */
+uint8_t  USART_Ring_Init(USART_Ring_t *Ring, uint8_t *Buff, uint32_t Size);
+
+/**
+ * @brief  USART_Ring_Init() for the reserve/commit write side.
+ * @param  Marks  Bitmap storage of USART_RING_MARK_WORDS(Size) words (cleared here)
+ * @return 1 on success, 0 if arguments are invalid.
+ */
+uint8_t  USART_Ring_InitMp(USART_Ring_t *Ring, uint8_t *Buff, uint32_t Size, uint32_t *Marks);
+
+/**
+ * @brief  Producer side: append one byte.
+ * @return 1 if stored, 0 if ring full.
+ */
+uint8_t  USART_Ring_Put(USART_Ring_t *Ring, uint8_t Data);
+
+/**
+ * @brief  Consumer side: remove one byte, stepping over slots marked in Skip.
+ * @return 1 if a byte was read, 0 if ring empty.
+ */
+uint8_t  USART_Ring_Get(USART_Ring_t *Ring, uint8_t *Data);
+
+/**
+ * @brief  Producer side: append up to Len bytes.
+ * @return Number of bytes actually stored.
+ */
+uint32_t USART_Ring_Write(USART_Ring_t *Ring, const uint8_t *Data, uint32_t Len);
+
+/**
+ * @brief  Consumer side: remove up to Len bytes.
+ * @return Number of bytes actually read.
+ */
+uint32_t USART_Ring_Read(USART_Ring_t *Ring, uint8_t *Data, uint32_t Len);
+
+/**
+ * @brief  Consumer side: expose the oldest bytes in place, without removing them.
+ * @param  Data  Receives a pointer to the first stored byte
+ * @return Length of the contiguous span at *Data (up to the end of the storage;
+ *         the rest, if any, starts at Buff[0]), 0 if the ring is empty.
+ */
+uint32_t USART_Ring_Peek(const USART_Ring_t *Ring, const uint8_t **Data);
+
+/**
+ * @brief  Consumer side: remove up to Len bytes already read through USART_Ring_Peek().
+ * @return Number of bytes actually removed.
+ */
+uint32_t USART_Ring_Consume(USART_Ring_t *Ring, uint32_t Len);
+
+/** @brief Number of bytes currently stored (safe from either side). */
+uint32_t USART_Ring_Count(const USART_Ring_t *Ring);
+
+/** @brief Number of bytes that can still be written or reserved (safe from either side). */
+uint32_t USART_Ring_Free(const USART_Ring_t *Ring);
+
+/**
+ * @brief  Multi-producer side: claim Len contiguous slots (all or nothing).
+ * @param  Pos  Receives the ring position of the first claimed slot
+ * @return 1 if claimed, 0 if Len is 0 or does not fit right now.
+ */
+uint8_t  USART_Ring_Reserve(USART_Ring_t *Ring, uint32_t Len, uint32_t *Pos);
+
+/**
+ * @brief  Multi-producer side: claim up to Want slots that are contiguous in the
+ *         storage (the claim stops at the end of Buff), for writing in place.
+ * @param  Pos  Receives the ring position of the first claimed slot; the slots
+ *              are Buff[Pos & Mask] onwards
+ * @return Number of slots claimed, 0 if Want is 0 or the ring is full.
+ */
+uint32_t USART_Ring_Acquire(USART_Ring_t *Ring, uint32_t Want, uint32_t *Pos);
+
+/**
+ * @brief  Multi-producer side: copy Len bytes into claimed slots starting at Pos.
+ */
+void     USART_Ring_Fill(USART_Ring_t *Ring, uint32_t Pos, const uint8_t *Data, uint32_t Len);
+
+/**
+ * @brief  Multi-producer side: give back the unused end of the newest reservation.
+ * @return 1 if [Pos + Used .. Pos + Len) was released, 0 if a later reservation
+ *         exists (commit the range with its Used length then).
+ */
+uint8_t  USART_Ring_Shrink(USART_Ring_t *Ring, uint32_t Pos, uint32_t Len, uint32_t Used);
+
+/**
+ * @brief  Multi-producer side: hand a reservation to the consumer. Never waits:
+ *         if an earlier reservation is still open, the range is published together
+ *         with it, when that one is committed.
+ * @param  Len   Reserved length (after any USART_Ring_Shrink())
+ * @param  Used  Bytes filled from Pos (<= Len); the consumer skips the other ones
+ */
+void     USART_Ring_Commit(USART_Ring_t *Ring, uint32_t Pos, uint32_t Len, uint32_t Used);
+
+#endif /* USART_USART_RING_H_ */
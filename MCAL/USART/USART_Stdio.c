@@ -0,0 +1,90 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Stdio.c
+ *  Author    : Ahmed
+ *  Created   : Feb 16, 2026
+ *
+ *  Description:
+ *  ------------
+ *  printf()/puts() retarget to a USART (USART_STDIO == ENABLE, see USART_Cfg.h).
+ *
+ *  Defines a strong _write() that takes precedence over the weak ITM/SWO one in
+ *  Core/Src/syscalls.c. Each call hands the whole span newlib passes (one line, stdout
+ *  is line buffered) to USART_Send() in one operation: with the ring backend that is
+ *  one reservation and one copy, and the call returns as soon as the bytes are in
+ *  the TX buffer.
+ *
+ *  When the span does not fit:
+ *   - USART_STDIO_TIMEOUT_MS == 0: dropped (never blocks), counted in
+ *     USART_StdioDropped().
+ *   - otherwise: the calling task blocks up to that long for TX space.
+ *  ISRs and code running before vTaskStartScheduler() always use the no-wait path
+ *  (ISRs drop: the TX path is task-only).
+ *
+ *  _write() always reports the full length: a short count would make newlib retry
+ *  the rest in a loop, and -1 would latch the stream error flag.
+ * =========================================================================================
+ */
+
+#include <stdint.h>
+#include <errno.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "USART.h"
+#include "USART_Prv.h"
+#include "USART_Cfg.h"
+
+#if (USART_STDIO == ENABLE)
+
+static volatile uint32_t USART_Stdio_Dropped;
+
+int _write(int file, char *ptr, int len)
+{
+	int      ret     = len;
+	uint32_t Timeout = USART_STDIO_TIMEOUT_MS;
+
+	if((file != 1) && (file != 2))
+	{
+		/* Only stdout / stderr exist. */
+		errno = EBADF;
+		ret   = -1;
+	}
+	else if((len <= 0) || (ptr == NULL))
+	{
+		ret = 0;
+	}
+	else if(xPortIsInsideInterrupt() != pdFALSE)
+	{
+		USART_Stdio_Dropped++;
+	}
+	else
+	{
+		if(xTaskGetSchedulerState() != taskSCHEDULER_RUNNING)
+		{
+			/* No task to block yet (or scheduler suspended): never wait. */
+			Timeout = USART_NO_WAIT;
+		}
+
+		if(USART_Send(USART_STDIO_PORT, (const uint8_t *)ptr, (uint32_t)len, Timeout) != USART_Tx_Ok)
+		{
+			USART_Stdio_Dropped++;
+		}
+	}
+	return ret;
+}
+
+uint32_t USART_StdioDropped(void)
+{
+	return USART_Stdio_Dropped;
+}
+
+#else
+
+uint32_t USART_StdioDropped(void)
+{
+	return 0U;
+}
+
+#endif /* USART_STDIO */
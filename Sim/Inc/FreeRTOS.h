@@ -0,0 +1,67 @@
+/*
+ * =========================================================================================
+ *  File      : FreeRTOS.h  (host simulation shim)
+ *  Author    : Ahmed
+ *  Created   : Feb 2, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Deterministic single-task stand-in for the FreeRTOS kernel, used ONLY by the
+ *  host simulation build in Sim/ (implementation: USART_Sim_Rtos.c).
+ *
+ *  Model:
+ *   - Exactly one task runs (the host main()). Other TaskHandle_t objects exist
+ *     only as notification targets (e.g. a USART_SetEventTask() consumer).
+ *   - Time is simulated. A blocking call (ulTaskNotifyTake, xTaskNotifyWait,
+ *     vTaskDelay) advances the simulated USART hardware until it is satisfied or
+ *     its timeout expires; nothing else advances time.
+ *   - Interrupts are delivered only while time advances, never in the middle of
+ *     task code, so critical sections and scheduler suspension are no-ops.
+ *
+ *  Configuration values mirror Third_Party/FreeRtos/Source/FreeRTOSConfig.h.
+ * =========================================================================================
+ */
+
+#ifndef SIM_FREERTOS_H_
+#define SIM_FREERTOS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef long          BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t      TickType_t;
+
+#define configTICK_RATE_HZ                     ((TickType_t)1000)
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES  2
+#define configSUPPORT_STATIC_ALLOCATION        0
+#define configSUPPORT_DYNAMIC_ALLOCATION       1
+
+#define portMAX_DELAY        ((TickType_t)0xffffffffUL)
+#define portTICK_PERIOD_MS   ((TickType_t)1000 / configTICK_RATE_HZ)
+
+#define pdFALSE              ((BaseType_t)0)
+#define pdTRUE               ((BaseType_t)1)
+#define pdPASS               (pdTRUE)
+#define pdFAIL               (pdFALSE)
+#define errQUEUE_EMPTY       ((BaseType_t)0)
+#define errQUEUE_FULL        ((BaseType_t)0)
+
+#define pdMS_TO_TICKS(xTimeInMs) \
+	((TickType_t)(((TickType_t)(xTimeInMs) * (TickType_t)configTICK_RATE_HZ) / (TickType_t)1000U))
+
+/* No preemption inside task code: see the model description above. */
+#define portYIELD_FROM_ISR(x)   ((void)(x))
+#define taskENTER_CRITICAL()    do { } while(0U)
+#define taskEXIT_CRITICAL()     do { } while(0U)
+#define taskENTER_CRITICAL_FROM_ISR()      (0U)
+#define taskEXIT_CRITICAL_FROM_ISR(x)      ((void)(x))
+
+#define configASSERT(x)                                                  \
+	do {                                                                 \
+		if((x) == 0) { vAssertCalled(__FILE__, __LINE__); }              \
+	} while(0U)
+
+void vAssertCalled(const char *File, int Line);
+
+#endif /* SIM_FREERTOS_H_ */
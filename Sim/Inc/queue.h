@@ -0,0 +1,44 @@
+/*
+ * =========================================================================================
+ *  File      : queue.h  (host simulation shim)
+ *  Author    : Ahmed
+ *  Created   : Feb 2, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Copy-by-value queues of the simulated kernel (USART_BUFF_QUEUE backend).
+ *  Only non-blocking use is supported (xTicksToWait must be 0), which is all the
+ *  driver needs: blocking is done with task notifications.
+ * =========================================================================================
+ */
+
+#ifndef SIM_QUEUE_H_
+#define SIM_QUEUE_H_
+
+#include "FreeRTOS.h"
+
+typedef struct QueueDefinition
+{
+	uint8_t     *Storage;
+	UBaseType_t  Length;
+	UBaseType_t  Item_Size;
+	UBaseType_t  Count;
+	UBaseType_t  Head;
+	UBaseType_t  Tail;
+	uint8_t      Dynamic;
+} StaticQueue_t;
+
+typedef StaticQueue_t *QueueHandle_t;
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize);
+QueueHandle_t xQueueCreateStatic(UBaseType_t uxQueueLength, UBaseType_t uxItemSize, uint8_t *pucQueueStorage, StaticQueue_t *pxStaticQueue);
+
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait);
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait);
+BaseType_t xQueueSendFromISR(QueueHandle_t xQueue, const void *pvItemToQueue, BaseType_t *pxHigherPriorityTaskWoken);
+BaseType_t xQueueReceiveFromISR(QueueHandle_t xQueue, void *pvBuffer, BaseType_t *pxHigherPriorityTaskWoken);
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue);
+UBaseType_t uxQueueMessagesWaitingFromISR(QueueHandle_t xQueue);
+
+#endif /* SIM_QUEUE_H_ */
@@ -0,0 +1,217 @@
+/*
+ * =========================================================================================
+ *  File      : stm32f407xx.h  (host simulation shim)
+ *  Author    : Ahmed
+ *  Created   : Feb 2, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Minimal stand-in for the CMSIS device header, used ONLY by the host simulation
+ *  build in Sim/. It provides the types, instance pointers and bit definitions the
+ *  USART driver uses, with the same names and values as the real header.
+ *
+ *  Peripheral instance pointers keep their real base addresses but are never
+ *  dereferenced on the host: every register access of the driver goes through
+ *  the LL shim (stm32f4xx_ll_usart.h), which forwards it to the simulated USART.
+ * =========================================================================================
+ */
+
+#ifndef SIM_STM32F407XX_H_
+#define SIM_STM32F407XX_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* =========================================================================================
+ *                                   Core Definitions
+ * =========================================================================================
+ */
+#define __IO    volatile
+
+/* Memory barrier: the simulation is single threaded, a compiler fence is enough. */
+#define __DMB()   __sync_synchronize()
+
+typedef enum
+{
+	RESET = 0U,
+	SET   = !RESET
+} FlagStatus, ITStatus;
+
+typedef enum
+{
+	DMA1_Stream0_IRQn = 11,
+	DMA1_Stream1_IRQn = 12,
+	DMA1_Stream2_IRQn = 13,
+	DMA1_Stream3_IRQn = 14,
+	DMA1_Stream4_IRQn = 15,
+	DMA1_Stream5_IRQn = 16,
+	DMA1_Stream6_IRQn = 17,
+	DMA1_Stream7_IRQn = 47,
+	DMA2_Stream0_IRQn = 56,
+	DMA2_Stream1_IRQn = 57,
+	DMA2_Stream2_IRQn = 58,
+	DMA2_Stream3_IRQn = 59,
+	DMA2_Stream4_IRQn = 60,
+	DMA2_Stream5_IRQn = 68,
+	DMA2_Stream6_IRQn = 69,
+	DMA2_Stream7_IRQn = 70,
+	USART1_IRQn = 37,
+	USART2_IRQn = 38,
+	USART3_IRQn = 39,
+	UART4_IRQn  = 52,
+	UART5_IRQn  = 53,
+	USART6_IRQn = 71,
+} IRQn_Type;
+
+/* =========================================================================================
+ *                                Peripheral Register Blocks
+ * =========================================================================================
+ */
+typedef struct
+{
+	__IO uint32_t SR;
+	__IO uint32_t DR;
+	__IO uint32_t BRR;
+	__IO uint32_t CR1;
+	__IO uint32_t CR2;
+	__IO uint32_t CR3;
+	__IO uint32_t GTPR;
+} USART_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t CR;
+	__IO uint32_t NDTR;
+	__IO uint32_t PAR;
+	__IO uint32_t M0AR;
+	__IO uint32_t M1AR;
+	__IO uint32_t FCR;
+} DMA_Stream_TypeDef;
+
+typedef struct
+{
+	__IO uint32_t MODER;
+	__IO uint32_t OTYPER;
+	__IO uint32_t OSPEEDR;
+	__IO uint32_t PUPDR;
+	__IO uint32_t IDR;
+	__IO uint32_t ODR;
+	__IO uint32_t BSRR;
+	__IO uint32_t LCKR;
+	__IO uint32_t AFR[2];
+} GPIO_TypeDef;
+
+/*
+ * Debug cycle counter (core_cm4.h names). DWT is a function call on the host:
+ * every DWT->... access refreshes CYCCNT from the host monotonic clock in ns
+ * (a "1 GHz core"), so USART_PROFILE probes measure native driver code.
+ */
+typedef struct
+{
+	__IO uint32_t CTRL;
+	__IO uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+	__IO uint32_t DEMCR;
+} CoreDebug_Type;
+
+DWT_Type *USART_Sim_Dwt(void);
+extern CoreDebug_Type USART_Sim_CoreDebug;
+
+#define DWT                           (USART_Sim_Dwt())
+#define CoreDebug                     (&USART_Sim_CoreDebug)
+#define DWT_CTRL_CYCCNTENA_Msk        0x00000001UL
+#define CoreDebug_DEMCR_TRCENA_Msk    0x01000000UL
+
+/* =========================================================================================
+ *                                 Peripheral Instances
+ * =========================================================================================
+ */
+#define USART1_BASE   0x40011000UL
+#define USART2_BASE   0x40004400UL
+#define USART3_BASE   0x40004800UL
+#define UART4_BASE    0x40004C00UL
+#define UART5_BASE    0x40005000UL
+#define USART6_BASE   0x40011400UL
+
+#define USART1   ((USART_TypeDef *) USART1_BASE)
+#define USART2   ((USART_TypeDef *) USART2_BASE)
+#define USART3   ((USART_TypeDef *) USART3_BASE)
+#define UART4    ((USART_TypeDef *) UART4_BASE)
+#define UART5    ((USART_TypeDef *) UART5_BASE)
+#define USART6   ((USART_TypeDef *) USART6_BASE)
+
+/* DMA streams: the HAL shim (USART_Sim.c) keeps the stream state, see HAL_DMA_Init(). */
+#define DMA1_BASE     0x40026000UL
+#define DMA2_BASE     0x40026400UL
+#define DMA_STREAM(_BASE_, _N_)   ((DMA_Stream_TypeDef *) ((_BASE_) + 0x10UL + (0x18UL * (_N_))))
+
+#define DMA1_Stream0  DMA_STREAM(DMA1_BASE, 0U)
+#define DMA1_Stream1  DMA_STREAM(DMA1_BASE, 1U)
+#define DMA1_Stream2  DMA_STREAM(DMA1_BASE, 2U)
+#define DMA1_Stream3  DMA_STREAM(DMA1_BASE, 3U)
+#define DMA1_Stream4  DMA_STREAM(DMA1_BASE, 4U)
+#define DMA1_Stream5  DMA_STREAM(DMA1_BASE, 5U)
+#define DMA1_Stream6  DMA_STREAM(DMA1_BASE, 6U)
+#define DMA1_Stream7  DMA_STREAM(DMA1_BASE, 7U)
+#define DMA2_Stream0  DMA_STREAM(DMA2_BASE, 0U)
+#define DMA2_Stream1  DMA_STREAM(DMA2_BASE, 1U)
+#define DMA2_Stream2  DMA_STREAM(DMA2_BASE, 2U)
+#define DMA2_Stream3  DMA_STREAM(DMA2_BASE, 3U)
+#define DMA2_Stream4  DMA_STREAM(DMA2_BASE, 4U)
+#define DMA2_Stream5  DMA_STREAM(DMA2_BASE, 5U)
+#define DMA2_Stream6  DMA_STREAM(DMA2_BASE, 6U)
+#define DMA2_Stream7  DMA_STREAM(DMA2_BASE, 7U)
+
+#define GPIOA    ((GPIO_TypeDef *) 0x40020000UL)
+#define GPIOB    ((GPIO_TypeDef *) 0x40020400UL)
+#define GPIOC    ((GPIO_TypeDef *) 0x40020800UL)
+#define GPIOD    ((GPIO_TypeDef *) 0x40020C00UL)
+#define GPIOE    ((GPIO_TypeDef *) 0x40021000UL)
+#define GPIOF    ((GPIO_TypeDef *) 0x40021400UL)
+#define GPIOG    ((GPIO_TypeDef *) 0x40021800UL)
+#define GPIOH    ((GPIO_TypeDef *) 0x40021C00UL)
+#define GPIOI    ((GPIO_TypeDef *) 0x40022000UL)
+
+/* =========================================================================================
+ *                                 USART Bit Definitions
+ * =========================================================================================
+ */
+#define USART_SR_PE        0x00000001UL
+#define USART_SR_FE        0x00000002UL
+#define USART_SR_NE        0x00000004UL
+#define USART_SR_ORE       0x00000008UL
+#define USART_SR_IDLE      0x00000010UL
+#define USART_SR_RXNE      0x00000020UL
+#define USART_SR_TC        0x00000040UL
+#define USART_SR_TXE       0x00000080UL
+#define USART_SR_LBD       0x00000100UL
+#define USART_SR_CTS       0x00000200UL
+
+#define USART_CR1_SBK      0x00000001UL
+#define USART_CR1_RWU      0x00000002UL
+#define USART_CR1_RE       0x00000004UL
+#define USART_CR1_TE       0x00000008UL
+#define USART_CR1_IDLEIE   0x00000010UL
+#define USART_CR1_RXNEIE   0x00000020UL
+#define USART_CR1_TCIE     0x00000040UL
+#define USART_CR1_TXEIE    0x00000080UL
+#define USART_CR1_PEIE     0x00000100UL
+#define USART_CR1_PS       0x00000200UL
+#define USART_CR1_PCE      0x00000400UL
+#define USART_CR1_WAKE     0x00000800UL
+#define USART_CR1_M        0x00001000UL
+#define USART_CR1_UE       0x00002000UL
+#define USART_CR1_OVER8    0x00008000UL
+
+#define USART_CR2_STOP_1   0x00002000UL
+
+#define USART_CR3_EIE      0x00000001UL
+#define USART_CR3_DMAR     0x00000040UL
+#define USART_CR3_DMAT     0x00000080UL
+#define USART_CR3_RTSE     0x00000100UL
+#define USART_CR3_CTSE     0x00000200UL
+
+#endif /* SIM_STM32F407XX_H_ */
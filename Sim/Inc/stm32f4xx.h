@@ -0,0 +1,18 @@
+/*
+ * =========================================================================================
+ *  File      : stm32f4xx.h  (host simulation shim)
+ *  Author    : Ahmed
+ *  Created   : Feb 2, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Host simulation stand-in for the CMSIS family header (see stm32f407xx.h).
+ * =========================================================================================
+ */
+
+#ifndef SIM_STM32F4XX_H_
+#define SIM_STM32F4XX_H_
+
+#include "stm32f407xx.h"
+
+#endif /* SIM_STM32F4XX_H_ */
@@ -0,0 +1,184 @@
+/*
+ * =========================================================================================
+ *  File      : stm32f4xx_hal.h  (host simulation shim)
+ *  Author    : Ahmed
+ *  Created   : Feb 2, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Subset of the STM32F4 HAL used by the USART driver, for the host simulation
+ *  build in Sim/. Names, types and constant values follow the real HAL.
+ *
+ *  The functions declared here are implemented by USART_Sim.c:
+ *   - GPIO: pin writes are tracked so a software RTS pin can throttle the peer
+ *   - NVIC: enable state decides whether the simulated USART IRQ is delivered
+ *   - RCC : clock enables are no-ops
+ *   - DMA : circular / normal peripheral-to-memory streams (RX DMA); memory-to-
+ *           peripheral is not simulated (USART_TX_DMA must be DISABLE)
+ * =========================================================================================
+ */
+
+#ifndef SIM_STM32F4XX_HAL_H_
+#define SIM_STM32F4XX_HAL_H_
+
+#include "stm32f4xx.h"
+
+typedef enum
+{
+	HAL_OK       = 0x00U,
+	HAL_ERROR    = 0x01U,
+	HAL_BUSY     = 0x02U,
+	HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+/* =========================================================================================
+ *                                         GPIO
+ * =========================================================================================
+ */
+typedef struct
+{
+	uint32_t Pin;
+	uint32_t Mode;
+	uint32_t Pull;
+	uint32_t Speed;
+	uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+typedef enum
+{
+	GPIO_PIN_RESET = 0,
+	GPIO_PIN_SET
+} GPIO_PinState;
+
+#define GPIO_PIN_0                 ((uint16_t)0x0001)
+#define GPIO_PIN_1                 ((uint16_t)0x0002)
+#define GPIO_PIN_2                 ((uint16_t)0x0004)
+#define GPIO_PIN_3                 ((uint16_t)0x0008)
+#define GPIO_PIN_4                 ((uint16_t)0x0010)
+#define GPIO_PIN_5                 ((uint16_t)0x0020)
+#define GPIO_PIN_6                 ((uint16_t)0x0040)
+#define GPIO_PIN_7                 ((uint16_t)0x0080)
+#define GPIO_PIN_8                 ((uint16_t)0x0100)
+#define GPIO_PIN_9                 ((uint16_t)0x0200)
+#define GPIO_PIN_10                ((uint16_t)0x0400)
+#define GPIO_PIN_11                ((uint16_t)0x0800)
+#define GPIO_PIN_12                ((uint16_t)0x1000)
+#define GPIO_PIN_13                ((uint16_t)0x2000)
+#define GPIO_PIN_14                ((uint16_t)0x4000)
+#define GPIO_PIN_15                ((uint16_t)0x8000)
+
+#define GPIO_MODE_INPUT            0x00000000U
+#define GPIO_MODE_OUTPUT_PP        0x00000001U
+#define GPIO_MODE_AF_PP            0x00000002U
+
+#define GPIO_NOPULL                0x00000000U
+#define GPIO_PULLUP                0x00000001U
+#define GPIO_PULLDOWN              0x00000002U
+
+#define GPIO_SPEED_FREQ_LOW        0x00000000U
+#define GPIO_SPEED_FREQ_MEDIUM     0x00000001U
+#define GPIO_SPEED_FREQ_HIGH       0x00000002U
+#define GPIO_SPEED_FREQ_VERY_HIGH  0x00000003U
+
+#define GPIO_AF7_USART1            ((uint8_t)0x07)
+#define GPIO_AF7_USART2            ((uint8_t)0x07)
+#define GPIO_AF7_USART3            ((uint8_t)0x07)
+#define GPIO_AF8_UART4             ((uint8_t)0x08)
+#define GPIO_AF8_UART5             ((uint8_t)0x08)
+#define GPIO_AF8_USART6            ((uint8_t)0x08)
+
+void          HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+void          HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+
+/* =========================================================================================
+ *                                       NVIC / RCC
+ * =========================================================================================
+ */
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn);
+
+uint32_t HAL_GetTick(void);
+
+/* Bus clocks of the target clock tree (MCAL/System/Sys.c): 42 / 84 MHz. */
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+uint32_t HAL_RCC_GetPCLK2Freq(void);
+
+#define __HAL_RCC_USART1_CLK_ENABLE()   do { } while(0U)
+#define __HAL_RCC_USART2_CLK_ENABLE()   do { } while(0U)
+#define __HAL_RCC_USART3_CLK_ENABLE()   do { } while(0U)
+#define __HAL_RCC_UART4_CLK_ENABLE()    do { } while(0U)
+#define __HAL_RCC_UART5_CLK_ENABLE()    do { } while(0U)
+#define __HAL_RCC_USART6_CLK_ENABLE()   do { } while(0U)
+#define __HAL_RCC_GPIOA_CLK_ENABLE()    do { } while(0U)
+#define __HAL_RCC_GPIOB_CLK_ENABLE()    do { } while(0U)
+#define __HAL_RCC_GPIOC_CLK_ENABLE()    do { } while(0U)
+#define __HAL_RCC_GPIOD_CLK_ENABLE()    do { } while(0U)
+#define __HAL_RCC_GPIOE_CLK_ENABLE()    do { } while(0U)
+#define __HAL_RCC_GPIOF_CLK_ENABLE()    do { } while(0U)
+#define __HAL_RCC_GPIOG_CLK_ENABLE()    do { } while(0U)
+#define __HAL_RCC_GPIOH_CLK_ENABLE()    do { } while(0U)
+#define __HAL_RCC_DMA1_CLK_ENABLE()     do { } while(0U)
+#define __HAL_RCC_DMA2_CLK_ENABLE()     do { } while(0U)
+
+/* =========================================================================================
+ *                                          DMA
+ * =========================================================================================
+ * The stream itself (NDTR, half / complete flags) lives in USART_Sim.c. Init fields
+ * and callbacks follow the real HAL; only the values the driver uses are defined.
+ */
+typedef struct
+{
+	uint32_t Channel;
+	uint32_t Direction;
+	uint32_t PeriphInc;
+	uint32_t MemInc;
+	uint32_t PeriphDataAlignment;
+	uint32_t MemDataAlignment;
+	uint32_t Mode;
+	uint32_t Priority;
+	uint32_t FIFOMode;
+} DMA_InitTypeDef;
+
+typedef struct __DMA_HandleTypeDef
+{
+	DMA_Stream_TypeDef *Instance;
+	DMA_InitTypeDef     Init;
+	void               *Parent;
+	void              (*XferCpltCallback)(struct __DMA_HandleTypeDef *hdma);
+	void              (*XferHalfCpltCallback)(struct __DMA_HandleTypeDef *hdma);
+} DMA_HandleTypeDef;
+
+#define DMA_CHANNEL_4              0x08000000U
+#define DMA_CHANNEL_5              0x0A000000U
+
+#define DMA_PERIPH_TO_MEMORY       0x00000000U
+#define DMA_MEMORY_TO_PERIPH       0x00000040U
+
+#define DMA_PINC_DISABLE           0x00000000U
+#define DMA_MINC_ENABLE            0x00000400U
+
+#define DMA_PDATAALIGN_BYTE        0x00000000U
+#define DMA_MDATAALIGN_BYTE        0x00000000U
+
+#define DMA_NORMAL                 0x00000000U
+#define DMA_CIRCULAR               0x00000100U
+
+#define DMA_PRIORITY_MEDIUM        0x00010000U
+#define DMA_PRIORITY_HIGH          0x00020000U
+
+#define DMA_FIFOMODE_DISABLE       0x00000000U
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma);
+void              HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma);
+
+#define __HAL_LINKDMA(__HANDLE__, __PPP_DMA_FIELD__, __DMA_HANDLE__)   \
+	do {                                                              \
+		(__HANDLE__)->__PPP_DMA_FIELD__ = &(__DMA_HANDLE__);          \
+		(__DMA_HANDLE__).Parent = (__HANDLE__);                       \
+	} while(0U)
+
+#include "stm32f4xx_hal_uart.h"
+
+#endif /* SIM_STM32F4XX_HAL_H_ */
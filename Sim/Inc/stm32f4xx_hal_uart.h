@@ -0,0 +1,109 @@
+/*
+ * =========================================================================================
+ *  File      : stm32f4xx_hal_uart.h  (host simulation shim)
+ *  Author    : Ahmed
+ *  Created   : Feb 2, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Subset of the HAL UART API used by the USART driver, for the host simulation
+ *  build. HAL_UART_Init / _Transmit_IT / _Receive_IT / HAL_UARTEx_ReceiveToIdle_DMA /
+ *  _IRQHandler are implemented by USART_Sim.c with the same state handling as the real HAL (gState/RxState,
+ *  ErrorCode, callbacks). The callbacks themselves come from the driver.
+ * =========================================================================================
+ */
+
+#ifndef SIM_STM32F4XX_HAL_UART_H_
+#define SIM_STM32F4XX_HAL_UART_H_
+
+#include "stm32f4xx_hal.h"
+
+typedef struct
+{
+	uint32_t BaudRate;
+	uint32_t WordLength;
+	uint32_t StopBits;
+	uint32_t Parity;
+	uint32_t Mode;
+	uint32_t HwFlowCtl;
+	uint32_t OverSampling;
+} UART_InitTypeDef;
+
+typedef enum
+{
+	HAL_UART_STATE_RESET      = 0x00U,
+	HAL_UART_STATE_READY      = 0x20U,
+	HAL_UART_STATE_BUSY       = 0x24U,
+	HAL_UART_STATE_BUSY_TX    = 0x21U,
+	HAL_UART_STATE_BUSY_RX    = 0x22U,
+	HAL_UART_STATE_BUSY_TX_RX = 0x23U,
+	HAL_UART_STATE_TIMEOUT    = 0xA0U,
+	HAL_UART_STATE_ERROR      = 0xE0U
+} HAL_UART_StateTypeDef;
+
+typedef struct __UART_HandleTypeDef
+{
+	USART_TypeDef                  *Instance;
+	UART_InitTypeDef                Init;
+	const uint8_t                  *pTxBuffPtr;
+	uint16_t                        TxXferSize;
+	__IO uint16_t                   TxXferCount;
+	uint8_t                        *pRxBuffPtr;
+	uint16_t                        RxXferSize;
+	__IO uint16_t                   RxXferCount;
+	DMA_HandleTypeDef              *hdmatx;
+	DMA_HandleTypeDef              *hdmarx;
+	__IO HAL_UART_StateTypeDef      gState;
+	__IO HAL_UART_StateTypeDef      RxState;
+	__IO uint32_t                   ReceptionType;
+	__IO uint32_t                   ErrorCode;
+} UART_HandleTypeDef;
+
+#define HAL_UART_RECEPTION_STANDARD   0x00000000U
+#define HAL_UART_RECEPTION_TOIDLE     0x00000001U
+
+#define HAL_UART_ERROR_NONE      0x00000000U
+#define HAL_UART_ERROR_PE        0x00000001U
+#define HAL_UART_ERROR_NE        0x00000002U
+#define HAL_UART_ERROR_FE        0x00000004U
+#define HAL_UART_ERROR_ORE       0x00000008U
+#define HAL_UART_ERROR_DMA       0x00000010U
+
+#define UART_WORDLENGTH_8B       0x00000000U
+#define UART_WORDLENGTH_9B       ((uint32_t)USART_CR1_M)
+
+#define UART_STOPBITS_1          0x00000000U
+#define UART_STOPBITS_2          ((uint32_t)USART_CR2_STOP_1)
+
+#define UART_PARITY_NONE         0x00000000U
+#define UART_PARITY_EVEN         ((uint32_t)USART_CR1_PCE)
+#define UART_PARITY_ODD          ((uint32_t)(USART_CR1_PCE | USART_CR1_PS))
+
+#define UART_HWCONTROL_NONE      0x00000000U
+#define UART_HWCONTROL_RTS       ((uint32_t)USART_CR3_RTSE)
+#define UART_HWCONTROL_CTS       ((uint32_t)USART_CR3_CTSE)
+#define UART_HWCONTROL_RTS_CTS   ((uint32_t)(USART_CR3_RTSE | USART_CR3_CTSE))
+
+#define UART_MODE_RX             ((uint32_t)USART_CR1_RE)
+#define UART_MODE_TX             ((uint32_t)USART_CR1_TE)
+#define UART_MODE_TX_RX          ((uint32_t)(USART_CR1_TE | USART_CR1_RE))
+
+#define UART_OVERSAMPLING_16     0x00000000U
+#define UART_OVERSAMPLING_8      ((uint32_t)USART_CR1_OVER8)
+
+/* The model keeps the baud rate itself in BRR (see HAL_UART_Init in USART_Sim.c). */
+#define UART_BRR_SAMPLING16(_PCLK_, _BAUD_)   ((uint32_t)(_BAUD_))
+#define UART_BRR_SAMPLING8(_PCLK_, _BAUD_)    ((uint32_t)(_BAUD_))
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size);
+void              HAL_UART_IRQHandler(UART_HandleTypeDef *huart);
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart);
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size);
+
+#endif /* SIM_STM32F4XX_HAL_UART_H_ */
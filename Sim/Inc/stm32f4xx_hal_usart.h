@@ -0,0 +1,19 @@
+/*
+ * =========================================================================================
+ *  File      : stm32f4xx_hal_usart.h  (host simulation shim)
+ *  Author    : Ahmed
+ *  Created   : Feb 2, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Placeholder so the driver include list builds unchanged on the host.
+ *  Everything the driver needs from this module lives in stm32f4xx_hal.h.
+ * =========================================================================================
+ */
+
+#ifndef SIM_STM32F4XX_HAL_USART_H_
+#define SIM_STM32F4XX_HAL_USART_H_
+
+#include "stm32f4xx_hal.h"
+
+#endif /* SIM_STM32F4XX_HAL_USART_H_ */
@@ -0,0 +1,70 @@
+/*
+ * =========================================================================================
+ *  File      : stm32f4xx_ll_usart.h  (host simulation shim)
+ *  Author    : Ahmed
+ *  Created   : Feb 2, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Subset of the LL USART API used by the driver, for the host simulation build.
+ *
+ *  On target these are plain volatile register accesses. Here every access is
+ *  routed to the simulated USART (USART_Sim_ReadReg / USART_Sim_WriteReg) so the
+ *  hardware side effects are modelled:
+ *   - reading DR clears RXNE and the PE/FE/NE/ORE error flags
+ *   - writing DR clears TXE (and TC) until the byte moves to the shift register
+ *   - CR1 interrupt-enable bits decide whether the USART IRQ is raised
+ * =========================================================================================
+ */
+
+#ifndef SIM_STM32F4XX_LL_USART_H_
+#define SIM_STM32F4XX_LL_USART_H_
+
+#include <stddef.h>
+#include "stm32f4xx.h"
+
+uint32_t USART_Sim_ReadReg(const USART_TypeDef *USARTx, size_t Offset);
+void     USART_Sim_WriteReg(USART_TypeDef *USARTx, size_t Offset, uint32_t Value);
+
+#define LL_USART_ReadReg(__INSTANCE__, __REG__)            \
+	USART_Sim_ReadReg((__INSTANCE__), offsetof(USART_TypeDef, __REG__))
+
+#define LL_USART_WriteReg(__INSTANCE__, __REG__, __VALUE__) \
+	USART_Sim_WriteReg((__INSTANCE__), offsetof(USART_TypeDef, __REG__), (uint32_t)(__VALUE__))
+
+static inline uint32_t LL_USART_IsActiveFlag_TXE(const USART_TypeDef *USARTx)
+{
+	return ((LL_USART_ReadReg(USARTx, SR) & USART_SR_TXE) == USART_SR_TXE) ? 1UL : 0UL;
+}
+
+static inline uint32_t LL_USART_IsActiveFlag_RXNE(const USART_TypeDef *USARTx)
+{
+	return ((LL_USART_ReadReg(USARTx, SR) & USART_SR_RXNE) == USART_SR_RXNE) ? 1UL : 0UL;
+}
+
+static inline void LL_USART_TransmitData8(USART_TypeDef *USARTx, uint8_t Value)
+{
+	LL_USART_WriteReg(USARTx, DR, Value);
+}
+
+static inline uint8_t LL_USART_ReceiveData8(const USART_TypeDef *USARTx)
+{
+	return (uint8_t)LL_USART_ReadReg(USARTx, DR);
+}
+
+static inline void LL_USART_EnableIT_RXNE(USART_TypeDef *USARTx)
+{
+	LL_USART_WriteReg(USARTx, CR1, LL_USART_ReadReg(USARTx, CR1) | USART_CR1_RXNEIE);
+}
+
+static inline void LL_USART_EnableIT_TXE(USART_TypeDef *USARTx)
+{
+	LL_USART_WriteReg(USARTx, CR1, LL_USART_ReadReg(USARTx, CR1) | USART_CR1_TXEIE);
+}
+
+static inline void LL_USART_DisableIT_TXE(USART_TypeDef *USARTx)
+{
+	LL_USART_WriteReg(USARTx, CR1, LL_USART_ReadReg(USARTx, CR1) & ~USART_CR1_TXEIE);
+}
+
+#endif /* SIM_STM32F4XX_LL_USART_H_ */
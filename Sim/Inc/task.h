@@ -0,0 +1,88 @@
+/*
+ * =========================================================================================
+ *  File      : task.h  (host simulation shim)
+ *  Author    : Ahmed
+ *  Created   : Feb 2, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Task-notification, timeout and delay services of the simulated kernel.
+ *  See FreeRTOS.h (shim) for the execution model.
+ * =========================================================================================
+ */
+
+#ifndef SIM_TASK_H_
+#define SIM_TASK_H_
+
+#include "FreeRTOS.h"
+
+typedef struct tskTaskControlBlock
+{
+	const char        *Name;
+	volatile uint32_t  Notify_Value[configTASK_NOTIFICATION_ARRAY_ENTRIES];
+	volatile uint8_t   Notify_State[configTASK_NOTIFICATION_ARRAY_ENTRIES];
+} StaticTask_t;
+
+typedef StaticTask_t *TaskHandle_t;
+
+typedef enum
+{
+	eNoAction = 0,
+	eSetBits,
+	eIncrement,
+	eSetValueWithOverwrite,
+	eSetValueWithoutOverwrite
+} eNotifyAction;
+
+/* The simulated main task runs from the start: always taskSCHEDULER_RUNNING. */
+#define taskSCHEDULER_SUSPENDED    ((BaseType_t)0)
+#define taskSCHEDULER_NOT_STARTED  ((BaseType_t)1)
+#define taskSCHEDULER_RUNNING      ((BaseType_t)2)
+
+typedef struct xTIME_OUT
+{
+	TickType_t Time_On_Entering;
+} TimeOut_t;
+
+/* Scheduler */
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+TickType_t   xTaskGetTickCount(void);
+TickType_t   xTaskGetTickCountFromISR(void);
+void         vTaskDelay(TickType_t xTicksToDelay);
+void         vTaskSuspendAll(void);
+BaseType_t   xTaskResumeAll(void);
+BaseType_t   xTaskGetSchedulerState(void);
+
+/* Timeouts */
+void       vTaskSetTimeOutState(TimeOut_t *pxTimeOut);
+BaseType_t xTaskCheckForTimeOut(TimeOut_t *pxTimeOut, TickType_t *pxTicksToWait);
+
+/* Notifications */
+BaseType_t xTaskGenericNotify(TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue);
+uint32_t   ulTaskGenericNotifyTake(UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+BaseType_t xTaskGenericNotifyWait(UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait);
+
+#define xTaskNotifyIndexed(xTask, uxIndex, ulValue, eAction) \
+	xTaskGenericNotify((xTask), (uxIndex), (ulValue), (eAction), NULL)
+#define xTaskNotifyIndexedFromISR(xTask, uxIndex, ulValue, eAction, pxWoken) \
+	((void)(pxWoken), xTaskGenericNotify((xTask), (uxIndex), (ulValue), (eAction), NULL))
+#define xTaskNotify(xTask, ulValue, eAction) \
+	xTaskNotifyIndexed((xTask), 0, (ulValue), (eAction))
+
+#define xTaskNotifyGiveIndexed(xTask, uxIndex) \
+	xTaskGenericNotify((xTask), (uxIndex), 0, eIncrement, NULL)
+#define vTaskNotifyGiveIndexedFromISR(xTask, uxIndex, pxWoken) \
+	((void)(pxWoken), (void)xTaskGenericNotify((xTask), (uxIndex), 0, eIncrement, NULL))
+#define xTaskNotifyGive(xTask)                  xTaskNotifyGiveIndexed((xTask), 0)
+#define vTaskNotifyGiveFromISR(xTask, pxWoken)  vTaskNotifyGiveIndexedFromISR((xTask), 0, (pxWoken))
+
+#define ulTaskNotifyTakeIndexed(uxIndex, xClear, xTicks) \
+	ulTaskGenericNotifyTake((uxIndex), (xClear), (xTicks))
+#define ulTaskNotifyTake(xClear, xTicks)        ulTaskNotifyTakeIndexed(0, (xClear), (xTicks))
+
+#define xTaskNotifyWaitIndexed(uxIndex, ulEntry, ulExit, pulValue, xTicks) \
+	xTaskGenericNotifyWait((uxIndex), (ulEntry), (ulExit), (pulValue), (xTicks))
+#define xTaskNotifyWait(ulEntry, ulExit, pulValue, xTicks) \
+	xTaskNotifyWaitIndexed(0, (ulEntry), (ulExit), (pulValue), (xTicks))
+
+#endif /* SIM_TASK_H_ */
@@ -0,0 +1,1250 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Sim.c
+ *  Author    : Ahmed
+ *  Created   : Feb 2, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Host model of the STM32F4 USART peripherals plus the HAL services the driver
+ *  calls (UART IT path, RX DMA, GPIO, NVIC). See USART_Sim.h for what is and is not
+ *  modelled.
+ *
+ *  Event loop:
+ *  -----------
+ *  USART_Sim_Step() jumps straight to the next event (end of a TX frame, end of a
+ *  frame from the external device, IDLE line, timer channel, 1 ms tick) instead of
+ *  ticking a fixed clock, so simulated seconds cost microseconds of host time. After
+ *  every event pending interrupts are dispatched until the interrupt lines are quiet
+ *  again.
+ * =========================================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "stm32f4xx.h"
+#include "stm32f4xx_hal.h"
+#include "stm32f4xx_hal_uart.h"
+#include "stm32f4xx_ll_usart.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "USART.h"
+#include "USART_Prv.h"
+#include "USART_Cfg.h"
+#include "USART_Sim.h"
+
+#if (USART_TX_DMA == ENABLE)
+#error "The host simulation does not model TX DMA: set USART_TX_DMA to DISABLE"
+#endif
+
+#if (USART_AUTOBAUD == ENABLE)
+#error "The host simulation does not model the auto-baud capture timers: set USART_AUTOBAUD to DISABLE"
+#endif
+
+/* =========================================================================================
+ *                                    Model Parameters
+ * =========================================================================================
+ */
+#define SIM_NS_PER_TICK      (1000000000ULL / configTICK_RATE_HZ)
+#define SIM_EXT_FIFO_SIZE    4096U     /* Bytes an external device can have in flight  */
+#define SIM_IRQ_LOOP_MAX     1024U     /* Back-to-back IRQs before reporting a storm   */
+#define SIM_GPIO_PORTS       9U        /* GPIOA..GPIOI                                  */
+#define SIM_GPIO_STRIDE      0x400UL
+#define SIM_ALARMS           4U        /* One-shot timer channels (USART_Sim_SetAlarm)  */
+#define SIM_DMA_STREAMS      16U       /* DMA1 / DMA2 streams 0..7                      */
+#define SIM_DMA_STRIDE       0x18UL
+
+#define SIM_DMA_HT           0x01U     /* Half-transfer flag of a stream                */
+#define SIM_DMA_TC           0x02U     /* Transfer-complete flag of a stream            */
+
+#define SIM_SR_ERRORS        (USART_SR_PE | USART_SR_FE | USART_SR_NE | USART_SR_ORE)
+
+/* =========================================================================================
+ *                                      Port State
+ * =========================================================================================
+ *
+ * Regs.DR holds the last RECEIVED byte (what a DR read returns). A DR write goes to
+ * Tdr (transmit data register), which moves to the shift register as soon as the
+ * line is free and CTS allows it.
+ */
+typedef struct
+{
+	USART_TypeDef     Regs;
+	uint64_t          Frame_Ns;
+
+	/* Transmitter */
+	uint8_t           Tdr;
+	uint8_t           Tdr_Full;
+	uint8_t           Shift;
+	uint8_t           Shift_Active;
+	uint64_t          Shift_End;
+
+	/* Error flags attached to the next received frame */
+	uint32_t          Err_Next;
+
+	/* IDLE detection: one idle frame after the last received frame */
+	uint8_t           Idle_Armed;
+	uint64_t          Idle_At;
+
+	/* RX DMA stream serving DR reads while CR3.DMAR is set (NULL: none) */
+	struct Sim_Dma_s *Rx_Dma;
+
+	/* External device on the far end of an unconnected port */
+	uint8_t           Ext_Fifo[SIM_EXT_FIFO_SIZE];
+	uint32_t          Ext_Head;
+	uint32_t          Ext_Tail;
+	uint8_t           Ext_Byte;
+	uint8_t           Ext_Active;
+	uint8_t           Ext_Paused;
+	uint64_t          Ext_End;
+	USART_Sim_Sink_t  Sink;
+
+	/* Wiring */
+	uint8_t           Connected;
+	USART_Num_t       Peer;
+
+	uint8_t           Nvic_En;
+	USART_Sim_Line_t  Line;
+} Sim_Port_t;
+
+/*
+ * One DMA stream. Ndtr counts down per transferred byte; a circular stream reloads it
+ * at 0. HT / TC are raised at half and full transfer and handled by the driver's
+ * DMAx_StreamN_IRQHandler() through HAL_DMA_IRQHandler().
+ */
+typedef struct Sim_Dma_s
+{
+	DMA_HandleTypeDef *Hdma;
+	USART_Num_t        USART_Num;
+	uint8_t           *Mem;
+	uint16_t           Size;
+	uint16_t           Ndtr;
+	uint8_t            Enabled;
+	uint8_t            Flags;
+	uint8_t            Nvic_En;
+} Sim_Dma_t;
+
+/* One timer compare channel: Hook(Arg) runs once when the simulated clock reaches At. */
+typedef struct
+{
+	uint8_t            Armed;
+	uint64_t           At;
+	USART_Sim_Alarm_t  Hook;
+	uint32_t           Arg;
+} Sim_Alarm_t;
+
+extern void USART1_IRQHandler(void);
+extern void USART2_IRQHandler(void);
+extern void USART3_IRQHandler(void);
+extern void UART4_IRQHandler(void);
+extern void UART5_IRQHandler(void);
+extern void USART6_IRQHandler(void);
+
+static USART_TypeDef * const Sim_Base[USART_MAX_NUM] = {USART1, USART2, USART3, UART4, UART5, USART6};
+static const IRQn_Type       Sim_Irq[USART_MAX_NUM]  = {USART1_IRQn, USART2_IRQn, USART3_IRQn, UART4_IRQn, UART5_IRQn, USART6_IRQn};
+static void (* const         Sim_Isr[USART_MAX_NUM])(void) =
+{
+	USART1_IRQHandler, USART2_IRQHandler, USART3_IRQHandler,
+	UART4_IRQHandler,  UART5_IRQHandler,  USART6_IRQHandler
+};
+
+static const IRQn_Type Sim_Dma_Irq[SIM_DMA_STREAMS] =
+{
+	DMA1_Stream0_IRQn, DMA1_Stream1_IRQn, DMA1_Stream2_IRQn, DMA1_Stream3_IRQn,
+	DMA1_Stream4_IRQn, DMA1_Stream5_IRQn, DMA1_Stream6_IRQn, DMA1_Stream7_IRQn,
+	DMA2_Stream0_IRQn, DMA2_Stream1_IRQn, DMA2_Stream2_IRQn, DMA2_Stream3_IRQn,
+	DMA2_Stream4_IRQn, DMA2_Stream5_IRQn, DMA2_Stream6_IRQn, DMA2_Stream7_IRQn
+};
+
+#if (USART_RX_DMA == ENABLE)
+extern void DMA1_Stream0_IRQHandler(void);
+extern void DMA1_Stream1_IRQHandler(void);
+extern void DMA1_Stream2_IRQHandler(void);
+extern void DMA1_Stream5_IRQHandler(void);
+extern void DMA2_Stream1_IRQHandler(void);
+extern void DMA2_Stream2_IRQHandler(void);
+
+/* Streams the driver uses for RX (USART_Rx_DMA_Stream[] in USART.c). */
+static void (* const Sim_Dma_Isr[SIM_DMA_STREAMS])(void) =
+{
+	[0]  = DMA1_Stream0_IRQHandler, [1]  = DMA1_Stream1_IRQHandler,
+	[2]  = DMA1_Stream2_IRQHandler, [5]  = DMA1_Stream5_IRQHandler,
+	[9]  = DMA2_Stream1_IRQHandler, [10] = DMA2_Stream2_IRQHandler
+};
+#else
+static void (* const Sim_Dma_Isr[SIM_DMA_STREAMS])(void);
+#endif
+
+static Sim_Port_t        Sim_Port[USART_MAX_NUM];
+static Sim_Dma_t         Sim_Dma[SIM_DMA_STREAMS];
+static uint8_t           Sim_Gpio_Level[SIM_GPIO_PORTS][16];
+static uint64_t          Sim_Now;
+static uint8_t           Sim_In_Isr;
+static uint8_t           Sim_In_Step;
+static USART_Sim_Hook_t  Sim_Tick_Hook;
+static Sim_Alarm_t       Sim_Alarm[SIM_ALARMS];
+
+/* =========================================================================================
+ *                                   Internal Helpers
+ * =========================================================================================
+ */
+static void sim_fatal(const char *Msg)
+{
+	fprintf(stderr, "[sim] fatal: %s (t=%llu ns)\n", Msg, (unsigned long long)Sim_Now);
+	abort();
+}
+
+static USART_Num_t sim_port_of(const USART_TypeDef *Instance)
+{
+	USART_Num_t USART_Num = 0;
+
+	while((USART_Num < USART_MAX_NUM) && (Sim_Base[USART_Num] != Instance))
+	{
+		USART_Num++;
+	}
+	if(USART_Num >= USART_MAX_NUM)
+	{
+		sim_fatal("access to an unknown USART instance");
+	}
+	return USART_Num;
+}
+
+static Sim_Dma_t *sim_dma_of(const DMA_Stream_TypeDef *Instance)
+{
+	uintptr_t Addr = (uintptr_t)Instance;
+	uintptr_t Idx  = SIM_DMA_STREAMS;
+
+	if((Addr >= (uintptr_t)DMA1_Stream0) && (Addr <= (uintptr_t)DMA1_Stream7))
+	{
+		Idx = (Addr - (uintptr_t)DMA1_Stream0) / SIM_DMA_STRIDE;
+	}
+	else if((Addr >= (uintptr_t)DMA2_Stream0) && (Addr <= (uintptr_t)DMA2_Stream7))
+	{
+		Idx = 8U + ((Addr - (uintptr_t)DMA2_Stream0) / SIM_DMA_STRIDE);
+	}
+	if(Idx >= SIM_DMA_STREAMS)
+	{
+		sim_fatal("access to an unknown DMA stream");
+	}
+	return &Sim_Dma[Idx];
+}
+
+static uint8_t sim_gpio_level(const GPIO_TypeDef *Port, uint16_t Pin)
+{
+	uintptr_t Idx = ((uintptr_t)Port - (uintptr_t)GPIOA) / SIM_GPIO_STRIDE;
+	uint8_t   Bit = 0;
+
+	if((Port == NULL) || (Idx >= SIM_GPIO_PORTS) || (Pin == 0U))
+	{
+		sim_fatal("access to an unknown GPIO pin");
+	}
+	while((Pin & (1U << Bit)) == 0U)
+	{
+		Bit++;
+	}
+	return Sim_Gpio_Level[Idx][Bit];
+}
+
+/*
+ * sim_rts_ready():
+ *  - State of the RTS line of a receiving port (1 = "send me more").
+ *  - Hardware RTS deasserts while RXNE is set; software RTS is whatever level the
+ *    driver last wrote to the configured pin (low = ready).
+ */
+static uint8_t sim_rts_ready(USART_Num_t USART_Num)
+{
+	const Sim_Port_t *Port  = &Sim_Port[USART_Num];
+	uint8_t           Ready = 1;
+
+	if((Port->Regs.CR3 & USART_CR3_RTSE) != 0U)
+	{
+		Ready = ((Port->Regs.SR & USART_SR_RXNE) == 0U);
+	}
+#if (USART_SW_RTS == ENABLE)
+	else if((USART_Config[USART_Num].Rts_High_Water != 0U) && (USART_Pin_Config[USART_Num].Rts_Port != NULL))
+	{
+		Ready = (sim_gpio_level(USART_Pin_Config[USART_Num].Rts_Port, USART_Pin_Config[USART_Num].Rts_Pin) == 0U);
+	}
+#endif
+	return Ready;
+}
+
+static uint8_t sim_cts_ok(USART_Num_t USART_Num)
+{
+	const Sim_Port_t *Port = &Sim_Port[USART_Num];
+	uint8_t           Ok   = 1;
+
+	if(((Port->Regs.CR3 & USART_CR3_CTSE) != 0U) && (Port->Connected != 0U))
+	{
+		Ok = sim_rts_ready(Port->Peer);
+	}
+	return Ok;
+}
+
+/*
+ * sim_set_frame():
+ *  - Frame time from BRR (the baud rate in this model) and the CR1 / CR2 frame format:
+ *    start + data (incl. parity) + stop bits.
+ */
+static void sim_set_frame(Sim_Port_t *Port)
+{
+	uint64_t Bits = 1U + (((Port->Regs.CR1 & USART_CR1_M) != 0U) ? 9U : 8U) +
+	                (((Port->Regs.CR2 & USART_CR2_STOP_1) != 0U) ? 2U : 1U);
+
+	if(Port->Regs.BRR != 0U)
+	{
+		Port->Frame_Ns = ((Bits * 1000000000ULL) + (Port->Regs.BRR / 2U)) / Port->Regs.BRR;
+	}
+}
+
+/*
+ * sim_dma_rx():
+ *  - The RX DMA request: the stream reads DR as soon as RXNE is set (RXNE never
+ *    stays set) and stores the byte at Mem[Size - Ndtr].
+ */
+static void sim_dma_rx(Sim_Dma_t *Dma, uint8_t Data)
+{
+	Dma->Mem[Dma->Size - Dma->Ndtr] = Data;
+	Dma->Ndtr--;
+
+	if((uint32_t)(Dma->Size - Dma->Ndtr) == (Dma->Size / 2U))
+	{
+		Dma->Flags |= SIM_DMA_HT;
+	}
+	if(Dma->Ndtr == 0U)
+	{
+		Dma->Flags |= SIM_DMA_TC;
+		if(Dma->Hdma->Init.Mode == DMA_CIRCULAR)
+		{
+			Dma->Ndtr = Dma->Size;
+		}
+		else
+		{
+			Dma->Enabled = 0;
+		}
+	}
+}
+
+/*
+ * sim_rx_deliver():
+ *  - A frame finished arriving. If the previous byte was not read yet the new one
+ *    is lost and ORE is raised, exactly like the hardware.
+ *  - With CR3.DMAR and an enabled stream the DMA takes the byte instead of RXNE;
+ *    error flags are still raised in SR.
+ *  - Every frame (re)arms IDLE detection one frame time later.
+ */
+static void sim_rx_deliver(USART_Num_t USART_Num, uint8_t Data)
+{
+	Sim_Port_t *Port = &Sim_Port[USART_Num];
+	uint32_t    Err  = Port->Err_Next;
+
+	Port->Err_Next = 0;
+
+	if((Port->Regs.CR1 & (USART_CR1_UE | USART_CR1_RE)) == (USART_CR1_UE | USART_CR1_RE))
+	{
+		Port->Idle_Armed = 1;
+		Port->Idle_At    = Sim_Now + Port->Frame_Ns;
+
+		if(((Port->Regs.CR3 & USART_CR3_DMAR) != 0U) && (Port->Rx_Dma != NULL) &&
+		   (Port->Rx_Dma->Enabled != 0U) && ((Port->Regs.SR & USART_SR_RXNE) == 0U))
+		{
+			Port->Regs.DR  = Data;
+			Port->Regs.SR |= Err;
+			Port->Line.Rx_Frames++;
+			sim_dma_rx(Port->Rx_Dma, Data);
+		}
+		else if((Port->Regs.SR & USART_SR_RXNE) != 0U)
+		{
+			Port->Regs.SR |= USART_SR_ORE;
+			Port->Line.Rx_Overrun++;
+		}
+		else
+		{
+			Port->Regs.DR  = Data;
+			Port->Regs.SR |= (USART_SR_RXNE | Err);
+			Port->Line.Rx_Frames++;
+		}
+	}
+}
+
+static void sim_tx_deliver(USART_Num_t USART_Num, uint8_t Data)
+{
+	Sim_Port_t *Port = &Sim_Port[USART_Num];
+
+	Port->Line.Tx_Frames++;
+
+	if(Port->Connected != 0U)
+	{
+		sim_rx_deliver(Port->Peer, Data);
+	}
+	else
+	{
+#if (USART_XON_XOFF == ENABLE)
+		/* The external device honours software flow control. */
+		if(Data == USART_XOFF_CHAR)
+		{
+			Port->Ext_Paused = 1;
+		}
+		else if(Data == USART_XON_CHAR)
+		{
+			Port->Ext_Paused = 0;
+		}
+#endif
+		if(Port->Sink != NULL)
+		{
+			Port->Sink(USART_Num, Data);
+		}
+	}
+}
+
+/* Move the holding register into the idle shift register when CTS allows it. */
+static void sim_tx_start(USART_Num_t USART_Num)
+{
+	Sim_Port_t *Port = &Sim_Port[USART_Num];
+
+	if((Port->Shift_Active == 0U) && (Port->Tdr_Full != 0U) &&
+	   ((Port->Regs.CR1 & USART_CR1_TE) != 0U) && sim_cts_ok(USART_Num))
+	{
+		Port->Shift        = Port->Tdr;
+		Port->Tdr_Full     = 0;
+		Port->Shift_Active = 1;
+		Port->Shift_End    = Sim_Now + Port->Frame_Ns;
+		Port->Regs.SR     |= USART_SR_TXE;
+	}
+}
+
+/* Start the next frame of the external device when the port's RTS allows it. */
+static void sim_ext_start(USART_Num_t USART_Num)
+{
+	Sim_Port_t *Port = &Sim_Port[USART_Num];
+
+	if((Port->Ext_Active == 0U) && (Port->Ext_Paused == 0U) && (Port->Ext_Head != Port->Ext_Tail) &&
+	   (Port->Frame_Ns != 0U) && sim_rts_ready(USART_Num))
+	{
+		Port->Ext_Byte   = Port->Ext_Fifo[Port->Ext_Tail % SIM_EXT_FIFO_SIZE];
+		Port->Ext_Tail++;
+		Port->Ext_Active = 1;
+		Port->Ext_End    = Sim_Now + Port->Frame_Ns;
+	}
+}
+
+static void sim_kick_all(void)
+{
+	for(USART_Num_t USART_Num = 0; USART_Num < USART_MAX_NUM; USART_Num++)
+	{
+		sim_tx_start(USART_Num);
+		sim_ext_start(USART_Num);
+	}
+}
+
+static uint8_t sim_irq_pending(USART_Num_t USART_Num)
+{
+	const Sim_Port_t *Port = &Sim_Port[USART_Num];
+	uint32_t Sr  = Port->Regs.SR;
+	uint32_t Cr1 = Port->Regs.CR1;
+	uint32_t Cr3 = Port->Regs.CR3;
+
+	return (Port->Nvic_En != 0U) &&
+	       ((((Cr1 & USART_CR1_RXNEIE) != 0U) && ((Sr & (USART_SR_RXNE | USART_SR_ORE)) != 0U)) ||
+	        (((Cr1 & USART_CR1_TXEIE)  != 0U) && ((Sr & USART_SR_TXE) != 0U)) ||
+	        (((Cr1 & USART_CR1_TCIE)   != 0U) && ((Sr & USART_SR_TC)  != 0U)) ||
+	        (((Cr1 & USART_CR1_PEIE)   != 0U) && ((Sr & USART_SR_PE)  != 0U)) ||
+	        (((Cr1 & USART_CR1_IDLEIE) != 0U) && ((Sr & USART_SR_IDLE) != 0U)) ||
+	        (((Cr3 & USART_CR3_EIE)    != 0U) && ((Sr & (USART_SR_FE | USART_SR_NE | USART_SR_ORE)) != 0U)));
+}
+
+static uint64_t sim_host_ns(void)
+{
+	struct timespec Ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &Ts);
+	return ((uint64_t)Ts.tv_sec * 1000000000ULL) + (uint64_t)Ts.tv_nsec;
+}
+
+/*
+ * sim_isr_timed():
+ *  - Runs one driver IRQ handler and books its host run time in the line counters.
+ */
+static void sim_isr_timed(USART_Num_t USART_Num)
+{
+	USART_Sim_Line_t *Line  = &Sim_Port[USART_Num].Line;
+	uint64_t          Start = sim_host_ns();
+	uint32_t          Ns;
+
+	Sim_Isr[USART_Num]();
+
+	Ns = (uint32_t)(sim_host_ns() - Start);
+	if((Line->Irq_Count == 0U) || (Ns < Line->Irq_Ns_Min))
+	{
+		Line->Irq_Ns_Min = Ns;
+	}
+	if(Ns > Line->Irq_Ns_Max)
+	{
+		Line->Irq_Ns_Max = Ns;
+	}
+	Line->Irq_Ns_Total += Ns;
+	Line->Irq_Count++;
+}
+
+/*
+ * sim_isr_dma():
+ *  - Runs the driver's handler of one DMA stream, booked on the port it serves.
+ */
+static void sim_isr_dma(Sim_Dma_t *Dma)
+{
+	void (*Isr)(void) = Sim_Dma_Isr[Dma - Sim_Dma];
+
+	if(Isr == NULL)
+	{
+		sim_fatal("DMA stream interrupt without a driver handler");
+	}
+	Sim_Port[Dma->USART_Num].Line.Dma_Irq_Count++;
+	Isr();
+}
+
+/*
+ * sim_dispatch():
+ *  - Runs USART / DMA IRQ handlers until no enabled interrupt condition is left. All
+ *    of them share one priority on target, so handlers never nest and, when several
+ *    are pending, the NVIC takes the lowest IRQ number first; so does this loop.
+ */
+static void sim_dispatch(void)
+{
+	uint32_t Loops = 0;
+	uint8_t  Any   = 1;
+
+	if(Sim_In_Isr == 0U)
+	{
+		while(Any != 0U)
+		{
+			int32_t    Best_Irq  = -1;
+			int32_t    Best_Usart = -1;
+			Sim_Dma_t *Best_Dma  = NULL;
+
+			for(USART_Num_t USART_Num = 0; USART_Num < USART_MAX_NUM; USART_Num++)
+			{
+				if(sim_irq_pending(USART_Num) && ((Best_Irq < 0) || ((int32_t)Sim_Irq[USART_Num] < Best_Irq)))
+				{
+					Best_Irq   = Sim_Irq[USART_Num];
+					Best_Usart = (int32_t)USART_Num;
+				}
+			}
+			for(uint32_t Idx = 0; Idx < SIM_DMA_STREAMS; Idx++)
+			{
+				if((Sim_Dma[Idx].Flags != 0U) && (Sim_Dma[Idx].Nvic_En != 0U) &&
+				   ((Best_Irq < 0) || ((int32_t)Sim_Dma_Irq[Idx] < Best_Irq)))
+				{
+					Best_Irq = Sim_Dma_Irq[Idx];
+					Best_Dma = &Sim_Dma[Idx];
+				}
+			}
+
+			Any = (Best_Irq >= 0);
+			if(Any != 0U)
+			{
+				Sim_In_Isr = 1;
+				if(Best_Dma != NULL)
+				{
+					sim_isr_dma(Best_Dma);
+				}
+				else
+				{
+					sim_isr_timed((USART_Num_t)Best_Usart);
+				}
+				Sim_In_Isr = 0;
+				sim_kick_all();
+			}
+			if(++Loops > SIM_IRQ_LOOP_MAX)
+			{
+				sim_fatal("interrupt storm: an enabled USART interrupt is never cleared");
+			}
+		}
+	}
+}
+
+/* =========================================================================================
+ *                                   Register Access
+ * =========================================================================================
+ */
+CoreDebug_Type USART_Sim_CoreDebug;
+
+DWT_Type *USART_Sim_Dwt(void)
+{
+	static DWT_Type Dwt;
+
+	if(((USART_Sim_CoreDebug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk) != 0U) &&
+	   ((Dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk) != 0U))
+	{
+		Dwt.CYCCNT = (uint32_t)sim_host_ns();
+	}
+	return &Dwt;
+}
+
+uint32_t USART_Sim_ReadReg(const USART_TypeDef *USARTx, size_t Offset)
+{
+	Sim_Port_t *Port  = &Sim_Port[sim_port_of(USARTx)];
+	uint32_t    Value = 0;
+
+	switch(Offset)
+	{
+	case offsetof(USART_TypeDef, SR):   Value = Port->Regs.SR;   break;
+	case offsetof(USART_TypeDef, BRR):  Value = Port->Regs.BRR;  break;
+	case offsetof(USART_TypeDef, CR1):  Value = Port->Regs.CR1;  break;
+	case offsetof(USART_TypeDef, CR2):  Value = Port->Regs.CR2;  break;
+	case offsetof(USART_TypeDef, CR3):  Value = Port->Regs.CR3;  break;
+	case offsetof(USART_TypeDef, GTPR): Value = Port->Regs.GTPR; break;
+	case offsetof(USART_TypeDef, DR):
+		/* SR-then-DR read sequence: clears RXNE, IDLE and the error flags. */
+		Value = Port->Regs.DR;
+		Port->Regs.SR &= ~(USART_SR_RXNE | USART_SR_IDLE | SIM_SR_ERRORS);
+		break;
+	default:
+		sim_fatal("read of an unknown USART register");
+		break;
+	}
+	return Value;
+}
+
+void USART_Sim_WriteReg(USART_TypeDef *USARTx, size_t Offset, uint32_t Value)
+{
+	USART_Num_t USART_Num = sim_port_of(USARTx);
+	Sim_Port_t *Port      = &Sim_Port[USART_Num];
+
+	switch(Offset)
+	{
+	case offsetof(USART_TypeDef, SR):
+		/* rc_w0 bits: writing 0 clears RXNE / TC, other bits are read-only. */
+		Port->Regs.SR &= (Value | ~(USART_SR_RXNE | USART_SR_TC));
+		break;
+	case offsetof(USART_TypeDef, DR):
+		Port->Tdr       = (uint8_t)Value;
+		Port->Tdr_Full  = 1;
+		Port->Regs.SR  &= ~(USART_SR_TXE | USART_SR_TC);
+		sim_tx_start(USART_Num);
+		break;
+	case offsetof(USART_TypeDef, BRR):
+		/* Runtime baud change: frames started from now on use the new rate. */
+		Port->Regs.BRR = Value;
+		sim_set_frame(Port);
+		break;
+	case offsetof(USART_TypeDef, CR1):  Port->Regs.CR1  = Value; break;
+	case offsetof(USART_TypeDef, CR2):  Port->Regs.CR2  = Value; break;
+	case offsetof(USART_TypeDef, CR3):  Port->Regs.CR3  = Value; break;
+	case offsetof(USART_TypeDef, GTPR): Port->Regs.GTPR = Value; break;
+	default:
+		sim_fatal("write of an unknown USART register");
+		break;
+	}
+}
+
+/* =========================================================================================
+ *                                 HAL UART (IT path)
+ * =========================================================================================
+ * Same flag/state handling as stm32f4xx_hal_uart.c for the services the driver uses.
+ */
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
+{
+	HAL_StatusTypeDef Status = HAL_ERROR;
+	Sim_Port_t       *Port;
+
+	if((huart != NULL) && (huart->Init.BaudRate != 0U))
+	{
+		Port = &Sim_Port[sim_port_of(huart->Instance)];
+
+		Port->Regs.CR1  = USART_CR1_UE | huart->Init.Mode | huart->Init.WordLength |
+		                  huart->Init.Parity | huart->Init.OverSampling;
+		Port->Regs.CR2  = huart->Init.StopBits;
+		Port->Regs.CR3  = huart->Init.HwFlowCtl;
+		Port->Regs.BRR  = huart->Init.BaudRate;
+		Port->Regs.SR   = USART_SR_TXE | USART_SR_TC;
+		sim_set_frame(Port);
+
+		huart->ErrorCode = HAL_UART_ERROR_NONE;
+		huart->gState    = HAL_UART_STATE_READY;
+		huart->RxState   = HAL_UART_STATE_READY;
+		Status = HAL_OK;
+	}
+	return Status;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_IT(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size)
+{
+	HAL_StatusTypeDef Status = HAL_BUSY;
+
+	if(huart->gState == HAL_UART_STATE_READY)
+	{
+		if((pData == NULL) || (Size == 0U))
+		{
+			Status = HAL_ERROR;
+		}
+		else
+		{
+			huart->pTxBuffPtr  = pData;
+			huart->TxXferSize  = Size;
+			huart->TxXferCount = Size;
+			huart->ErrorCode   = HAL_UART_ERROR_NONE;
+			huart->gState      = HAL_UART_STATE_BUSY_TX;
+			LL_USART_WriteReg(huart->Instance, CR1, LL_USART_ReadReg(huart->Instance, CR1) | USART_CR1_TXEIE);
+			Status = HAL_OK;
+		}
+	}
+	return Status;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+	HAL_StatusTypeDef Status = HAL_BUSY;
+
+	if(huart->RxState == HAL_UART_STATE_READY)
+	{
+		if((pData == NULL) || (Size == 0U))
+		{
+			Status = HAL_ERROR;
+		}
+		else
+		{
+			huart->pRxBuffPtr  = pData;
+			huart->RxXferSize  = Size;
+			huart->RxXferCount = Size;
+			huart->ErrorCode   = HAL_UART_ERROR_NONE;
+			huart->RxState     = HAL_UART_STATE_BUSY_RX;
+			LL_USART_WriteReg(huart->Instance, CR1, LL_USART_ReadReg(huart->Instance, CR1) | USART_CR1_PEIE | USART_CR1_RXNEIE);
+			LL_USART_WriteReg(huart->Instance, CR3, LL_USART_ReadReg(huart->Instance, CR3) | USART_CR3_EIE);
+			Status = HAL_OK;
+		}
+	}
+	return Status;
+}
+
+/* __weak in the HAL too: the driver only provides it with USART_RX_DMA. */
+__attribute__((weak)) void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+	(void)huart;
+	(void)Size;
+}
+
+/* UART_DMARxHalfCplt() / UART_DMAReceiveCplt() of the HAL, reception-to-idle only. */
+static void sim_uart_dma_rx_half(DMA_HandleTypeDef *hdma)
+{
+	UART_HandleTypeDef *huart = (UART_HandleTypeDef *)hdma->Parent;
+
+	HAL_UARTEx_RxEventCallback(huart, huart->RxXferSize / 2U);
+}
+
+static void sim_uart_dma_rx_cplt(DMA_HandleTypeDef *hdma)
+{
+	UART_HandleTypeDef *huart = (UART_HandleTypeDef *)hdma->Parent;
+
+	if(hdma->Init.Mode != DMA_CIRCULAR)
+	{
+		huart->RxXferCount = 0;
+		LL_USART_WriteReg(huart->Instance, CR1, LL_USART_ReadReg(huart->Instance, CR1) & ~(USART_CR1_PEIE | USART_CR1_IDLEIE));
+		LL_USART_WriteReg(huart->Instance, CR3, LL_USART_ReadReg(huart->Instance, CR3) & ~(USART_CR3_EIE | USART_CR3_DMAR));
+		huart->RxState       = HAL_UART_STATE_READY;
+		huart->ReceptionType = HAL_UART_RECEPTION_STANDARD;
+	}
+	HAL_UARTEx_RxEventCallback(huart, huart->RxXferSize);
+}
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData, uint16_t Size)
+{
+	HAL_StatusTypeDef Status = HAL_BUSY;
+	Sim_Dma_t        *Dma;
+
+	if(huart->RxState == HAL_UART_STATE_READY)
+	{
+		if((pData == NULL) || (Size == 0U) || (huart->hdmarx == NULL))
+		{
+			Status = HAL_ERROR;
+		}
+		else
+		{
+			huart->ReceptionType = HAL_UART_RECEPTION_TOIDLE;
+			huart->pRxBuffPtr    = pData;
+			huart->RxXferSize    = Size;
+			huart->ErrorCode     = HAL_UART_ERROR_NONE;
+			huart->RxState       = HAL_UART_STATE_BUSY_RX;
+
+			huart->hdmarx->XferHalfCpltCallback = sim_uart_dma_rx_half;
+			huart->hdmarx->XferCpltCallback     = sim_uart_dma_rx_cplt;
+
+			/* HAL_DMA_Start_IT(): stream from DR to pData, Size bytes, HT + TC enabled. */
+			Dma            = sim_dma_of(huart->hdmarx->Instance);
+			Dma->Hdma      = huart->hdmarx;
+			Dma->USART_Num = sim_port_of(huart->Instance);
+			Dma->Mem       = pData;
+			Dma->Size      = Size;
+			Dma->Ndtr      = Size;
+			Dma->Flags     = 0;
+			Dma->Enabled   = 1;
+			Sim_Port[Dma->USART_Num].Rx_Dma = Dma;
+
+			/* Clear ORE / IDLE (SR then DR), then errors, DMA requests and IDLE interrupt. */
+			(void)LL_USART_ReadReg(huart->Instance, SR);
+			(void)LL_USART_ReadReg(huart->Instance, DR);
+			if((LL_USART_ReadReg(huart->Instance, CR1) & USART_CR1_PCE) != 0U)
+			{
+				LL_USART_WriteReg(huart->Instance, CR1, LL_USART_ReadReg(huart->Instance, CR1) | USART_CR1_PEIE);
+			}
+			LL_USART_WriteReg(huart->Instance, CR3, LL_USART_ReadReg(huart->Instance, CR3) | USART_CR3_EIE | USART_CR3_DMAR);
+			LL_USART_WriteReg(huart->Instance, CR1, LL_USART_ReadReg(huart->Instance, CR1) | USART_CR1_IDLEIE);
+			Status = HAL_OK;
+		}
+	}
+	return Status;
+}
+
+static void sim_uart_end_rx(UART_HandleTypeDef *huart)
+{
+	LL_USART_WriteReg(huart->Instance, CR1, LL_USART_ReadReg(huart->Instance, CR1) & ~(USART_CR1_RXNEIE | USART_CR1_PEIE | USART_CR1_IDLEIE));
+	LL_USART_WriteReg(huart->Instance, CR3, LL_USART_ReadReg(huart->Instance, CR3) & ~USART_CR3_EIE);
+	huart->RxState       = HAL_UART_STATE_READY;
+	huart->ReceptionType = HAL_UART_RECEPTION_STANDARD;
+}
+
+/* Blocking error with RX DMA: stop the requests and the stream (HAL_DMA_Abort_IT). */
+static void sim_uart_abort_rx_dma(UART_HandleTypeDef *huart)
+{
+	LL_USART_WriteReg(huart->Instance, CR3, LL_USART_ReadReg(huart->Instance, CR3) & ~USART_CR3_DMAR);
+	if(huart->hdmarx != NULL)
+	{
+		Sim_Dma_t *Dma = sim_dma_of(huart->hdmarx->Instance);
+
+		Dma->Enabled = 0;
+		Dma->Flags   = 0;
+	}
+}
+
+static void sim_uart_receive_it(UART_HandleTypeDef *huart)
+{
+	uint8_t Data = (uint8_t)LL_USART_ReadReg(huart->Instance, DR);
+
+	if(huart->RxState == HAL_UART_STATE_BUSY_RX)
+	{
+		*huart->pRxBuffPtr = Data;
+		huart->pRxBuffPtr++;
+
+		if(--huart->RxXferCount == 0U)
+		{
+			sim_uart_end_rx(huart);
+			HAL_UART_RxCpltCallback(huart);
+		}
+	}
+}
+
+static void sim_uart_transmit_it(UART_HandleTypeDef *huart)
+{
+	uint32_t Cr1;
+
+	if(huart->gState == HAL_UART_STATE_BUSY_TX)
+	{
+		LL_USART_WriteReg(huart->Instance, DR, *huart->pTxBuffPtr);
+		huart->pTxBuffPtr++;
+
+		if(--huart->TxXferCount == 0U)
+		{
+			/* Last byte in DR: wait for TC before reporting completion. */
+			Cr1 = LL_USART_ReadReg(huart->Instance, CR1);
+			LL_USART_WriteReg(huart->Instance, CR1, (Cr1 & ~USART_CR1_TXEIE) | USART_CR1_TCIE);
+		}
+	}
+}
+
+void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
+{
+	uint32_t Sr     = LL_USART_ReadReg(huart->Instance, SR);
+	uint32_t Cr1    = LL_USART_ReadReg(huart->Instance, CR1);
+	uint32_t Cr3    = LL_USART_ReadReg(huart->Instance, CR3);
+	uint32_t Errors = Sr & SIM_SR_ERRORS;
+
+	if((Errors == 0U) && ((Sr & USART_SR_RXNE) != 0U) && ((Cr1 & USART_CR1_RXNEIE) != 0U))
+	{
+		sim_uart_receive_it(huart);
+	}
+	else if((Errors != 0U) && (((Cr3 & USART_CR3_EIE) != 0U) || ((Cr1 & (USART_CR1_RXNEIE | USART_CR1_PEIE)) != 0U)))
+	{
+		if(((Sr & USART_SR_PE) != 0U) && ((Cr1 & USART_CR1_PEIE) != 0U))
+		{
+			huart->ErrorCode |= HAL_UART_ERROR_PE;
+		}
+		if(((Sr & USART_SR_NE) != 0U) && ((Cr3 & USART_CR3_EIE) != 0U))
+		{
+			huart->ErrorCode |= HAL_UART_ERROR_NE;
+		}
+		if(((Sr & USART_SR_FE) != 0U) && ((Cr3 & USART_CR3_EIE) != 0U))
+		{
+			huart->ErrorCode |= HAL_UART_ERROR_FE;
+		}
+		if(((Sr & USART_SR_ORE) != 0U) && (((Cr1 & USART_CR1_RXNEIE) != 0U) || ((Cr3 & USART_CR3_EIE) != 0U)))
+		{
+			huart->ErrorCode |= HAL_UART_ERROR_ORE;
+		}
+
+		if(huart->ErrorCode != HAL_UART_ERROR_NONE)
+		{
+			if(((Sr & USART_SR_RXNE) != 0U) && ((Cr1 & USART_CR1_RXNEIE) != 0U))
+			{
+				sim_uart_receive_it(huart);
+			}
+
+			/* Overrun, or any error during DMA reception, is blocking: reception is
+			   aborted before the callback. */
+			if(((huart->ErrorCode & HAL_UART_ERROR_ORE) != 0U) || ((Cr3 & USART_CR3_DMAR) != 0U))
+			{
+				if((Cr3 & USART_CR3_DMAR) != 0U)
+				{
+					sim_uart_abort_rx_dma(huart);
+				}
+				sim_uart_end_rx(huart);
+				HAL_UART_ErrorCallback(huart);
+			}
+			else
+			{
+				HAL_UART_ErrorCallback(huart);
+				huart->ErrorCode = HAL_UART_ERROR_NONE;
+			}
+		}
+	}
+	else if((huart->ReceptionType == HAL_UART_RECEPTION_TOIDLE) &&
+	        ((Sr & USART_SR_IDLE) != 0U) && ((Cr1 & USART_CR1_IDLEIE) != 0U))
+	{
+		/* SR-then-DR read clears IDLE. Report what the stream wrote so far, unless it
+		   just wrapped (HT / TC reported that already). */
+		(void)LL_USART_ReadReg(huart->Instance, DR);
+		if(((Cr3 & USART_CR3_DMAR) != 0U) && (huart->hdmarx != NULL))
+		{
+			uint16_t Remaining = sim_dma_of(huart->hdmarx->Instance)->Ndtr;
+
+			if((Remaining > 0U) && (Remaining < huart->RxXferSize))
+			{
+				huart->RxXferCount = Remaining;
+				HAL_UARTEx_RxEventCallback(huart, huart->RxXferSize - Remaining);
+			}
+		}
+	}
+	else if(((Sr & USART_SR_TXE) != 0U) && ((Cr1 & USART_CR1_TXEIE) != 0U))
+	{
+		sim_uart_transmit_it(huart);
+	}
+	else if(((Sr & USART_SR_TC) != 0U) && ((Cr1 & USART_CR1_TCIE) != 0U))
+	{
+		LL_USART_WriteReg(huart->Instance, CR1, Cr1 & ~USART_CR1_TCIE);
+		huart->gState = HAL_UART_STATE_READY;
+		HAL_UART_TxCpltCallback(huart);
+	}
+}
+
+/* =========================================================================================
+ *                                       HAL DMA
+ * =========================================================================================
+ */
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma)
+{
+	HAL_StatusTypeDef Status = HAL_ERROR;
+
+	if((hdma != NULL) && (hdma->Init.Direction == DMA_PERIPH_TO_MEMORY))
+	{
+		Sim_Dma_t *Dma = sim_dma_of(hdma->Instance);
+
+		Dma->Enabled = 0;
+		Dma->Flags   = 0;
+		Status = HAL_OK;
+	}
+	return Status;
+}
+
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma)
+{
+	Sim_Dma_t *Dma   = sim_dma_of(hdma->Instance);
+	uint8_t    Flags = Dma->Flags;
+
+	Dma->Flags = 0;
+	if(((Flags & SIM_DMA_HT) != 0U) && (hdma->XferHalfCpltCallback != NULL))
+	{
+		hdma->XferHalfCpltCallback(hdma);
+	}
+	if(((Flags & SIM_DMA_TC) != 0U) && (hdma->XferCpltCallback != NULL))
+	{
+		hdma->XferCpltCallback(hdma);
+	}
+}
+
+/* =========================================================================================
+ *                                    GPIO / NVIC
+ * =========================================================================================
+ */
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+	/* Pin modes are not modelled; only output levels matter (software RTS). */
+	(void)sim_gpio_level(GPIOx, (uint16_t)GPIO_Init->Pin);
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+	uintptr_t Idx = ((uintptr_t)GPIOx - (uintptr_t)GPIOA) / SIM_GPIO_STRIDE;
+
+	(void)sim_gpio_level(GPIOx, GPIO_Pin);
+	for(uint8_t Bit = 0; Bit < 16U; Bit++)
+	{
+		if((GPIO_Pin & (1U << Bit)) != 0U)
+		{
+			Sim_Gpio_Level[Idx][Bit] = (PinState != GPIO_PIN_RESET);
+		}
+	}
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+	return (sim_gpio_level(GPIOx, GPIO_Pin) != 0U) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+static void sim_nvic_set(IRQn_Type IRQn, uint8_t Enable)
+{
+	for(USART_Num_t USART_Num = 0; USART_Num < USART_MAX_NUM; USART_Num++)
+	{
+		if(Sim_Irq[USART_Num] == IRQn)
+		{
+			Sim_Port[USART_Num].Nvic_En = Enable;
+		}
+	}
+	for(uint32_t Idx = 0; Idx < SIM_DMA_STREAMS; Idx++)
+	{
+		if(Sim_Dma_Irq[Idx] == IRQn)
+		{
+			Sim_Dma[Idx].Nvic_En = Enable;
+		}
+	}
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+	(void)IRQn;
+	(void)PreemptPriority;
+	(void)SubPriority;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+	sim_nvic_set(IRQn, 1U);
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+	sim_nvic_set(IRQn, 0U);
+}
+
+uint32_t HAL_GetTick(void)
+{
+	return (uint32_t)(Sim_Now / (1000000000ULL / 1000U));
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+	return 42000000U;
+}
+
+uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+	return 84000000U;
+}
+
+/* =========================================================================================
+ *                                    Public APIs
+ * =========================================================================================
+ */
+void USART_Sim_Connect(USART_Num_t USART_A, USART_Num_t USART_B)
+{
+	Sim_Port[USART_A].Connected = 1;
+	Sim_Port[USART_A].Peer      = USART_B;
+	Sim_Port[USART_B].Connected = 1;
+	Sim_Port[USART_B].Peer      = USART_A;
+}
+
+uint32_t USART_Sim_Inject(USART_Num_t USART_Num, const uint8_t *Data, uint32_t Len)
+{
+	Sim_Port_t *Port  = &Sim_Port[USART_Num];
+	uint32_t    count = 0;
+
+	while((count < Len) && ((Port->Ext_Head - Port->Ext_Tail) < SIM_EXT_FIFO_SIZE))
+	{
+		Port->Ext_Fifo[Port->Ext_Head % SIM_EXT_FIFO_SIZE] = Data[count];
+		Port->Ext_Head++;
+		count++;
+	}
+	return count;
+}
+
+void USART_Sim_InjectError(USART_Num_t USART_Num, uint32_t Sr_Flags)
+{
+	Sim_Port[USART_Num].Err_Next |= (Sr_Flags & (USART_SR_PE | USART_SR_FE | USART_SR_NE));
+}
+
+void USART_Sim_SetTxSink(USART_Num_t USART_Num, USART_Sim_Sink_t Sink)
+{
+	Sim_Port[USART_Num].Sink = Sink;
+}
+
+void USART_Sim_SetTickHook(USART_Sim_Hook_t Hook)
+{
+	Sim_Tick_Hook = Hook;
+}
+
+/*
+ * USART_Sim_SetAlarm():
+ *  - (Re)arms timer channel Channel to call Hook(Arg) Ns from now; Hook == NULL
+ *    disarms it. Callable from interrupt context (RX hooks) as well.
+ */
+void USART_Sim_SetAlarm(uint32_t Channel, uint64_t Ns, USART_Sim_Alarm_t Hook, uint32_t Arg)
+{
+	if(Channel >= SIM_ALARMS)
+	{
+		sim_fatal("timer channel out of range");
+	}
+	Sim_Alarm[Channel].At    = Sim_Now + Ns;
+	Sim_Alarm[Channel].Hook  = Hook;
+	Sim_Alarm[Channel].Arg   = Arg;
+	Sim_Alarm[Channel].Armed = (Hook != NULL);
+}
+
+void USART_Sim_GetLine(USART_Num_t USART_Num, USART_Sim_Line_t *Line)
+{
+	*Line = Sim_Port[USART_Num].Line;
+}
+
+void USART_Sim_ResetLine(USART_Num_t USART_Num)
+{
+	memset(&Sim_Port[USART_Num].Line, 0, sizeof(Sim_Port[USART_Num].Line));
+}
+
+uint32_t USART_Sim_RxDmaPos(USART_Num_t USART_Num)
+{
+	const Sim_Dma_t *Dma = Sim_Port[USART_Num].Rx_Dma;
+
+	return ((Dma != NULL) && (Dma->Enabled != 0U)) ? (uint32_t)(Dma->Size - Dma->Ndtr) : 0U;
+}
+
+uint64_t USART_Sim_TimeNs(void)
+{
+	return Sim_Now;
+}
+
+uint8_t USART_Sim_Step(uint64_t Limit_Ns)
+{
+	uint64_t Next;
+	uint64_t Next_Tick;
+
+	if(Sim_In_Step != 0U)
+	{
+		sim_fatal("blocking kernel call from an interrupt handler or the tick hook");
+	}
+	Sim_In_Step = 1;
+
+	/* Interrupts raised by task code since the last event run first. */
+	sim_kick_all();
+	sim_dispatch();
+
+	if(Sim_Now < Limit_Ns)
+	{
+		Next_Tick = ((Sim_Now / SIM_NS_PER_TICK) + 1U) * SIM_NS_PER_TICK;
+		Next      = (Next_Tick < Limit_Ns) ? Next_Tick : Limit_Ns;
+
+		for(USART_Num_t USART_Num = 0; USART_Num < USART_MAX_NUM; USART_Num++)
+		{
+			if((Sim_Port[USART_Num].Shift_Active != 0U) && (Sim_Port[USART_Num].Shift_End < Next))
+			{
+				Next = Sim_Port[USART_Num].Shift_End;
+			}
+			if((Sim_Port[USART_Num].Ext_Active != 0U) && (Sim_Port[USART_Num].Ext_End < Next))
+			{
+				Next = Sim_Port[USART_Num].Ext_End;
+			}
+			if((Sim_Port[USART_Num].Idle_Armed != 0U) && (Sim_Port[USART_Num].Idle_At < Next))
+			{
+				Next = Sim_Port[USART_Num].Idle_At;
+			}
+		}
+		for(uint32_t Channel = 0; Channel < SIM_ALARMS; Channel++)
+		{
+			if((Sim_Alarm[Channel].Armed != 0U) && (Sim_Alarm[Channel].At < Next))
+			{
+				Next = Sim_Alarm[Channel].At;
+			}
+		}
+		Sim_Now = Next;
+
+		for(USART_Num_t USART_Num = 0; USART_Num < USART_MAX_NUM; USART_Num++)
+		{
+			Sim_Port_t *Port = &Sim_Port[USART_Num];
+
+			if((Port->Shift_Active != 0U) && (Port->Shift_End <= Sim_Now))
+			{
+				Port->Shift_Active = 0;
+				sim_tx_deliver(USART_Num, Port->Shift);
+
+				/* TC only when nothing is waiting in the holding register. */
+				if(Port->Tdr_Full == 0U)
+				{
+					Port->Regs.SR |= USART_SR_TC;
+				}
+			}
+			if((Port->Ext_Active != 0U) && (Port->Ext_End <= Sim_Now))
+			{
+				Port->Ext_Active = 0;
+				sim_rx_deliver(USART_Num, Port->Ext_Byte);
+			}
+		}
+
+		/* IDLE: a full frame time without a new frame since the last one arrived. */
+		for(USART_Num_t USART_Num = 0; USART_Num < USART_MAX_NUM; USART_Num++)
+		{
+			Sim_Port_t *Port = &Sim_Port[USART_Num];
+
+			if((Port->Idle_Armed != 0U) && (Port->Idle_At <= Sim_Now))
+			{
+				Port->Idle_Armed = 0;
+				Port->Regs.SR   |= USART_SR_IDLE;
+			}
+		}
+
+		sim_kick_all();
+		sim_dispatch();
+
+		/* Timer channels share the USART IRQ priority: run after the USART handlers. */
+		for(uint32_t Channel = 0; Channel < SIM_ALARMS; Channel++)
+		{
+			if((Sim_Alarm[Channel].Armed != 0U) && (Sim_Alarm[Channel].At <= Sim_Now))
+			{
+				Sim_Alarm[Channel].Armed = 0;
+				Sim_In_Isr = 1;
+				Sim_Alarm[Channel].Hook(Sim_Alarm[Channel].Arg);
+				Sim_In_Isr = 0;
+				sim_kick_all();
+				sim_dispatch();
+			}
+		}
+
+		if((Sim_Now == Next_Tick) && (Sim_Tick_Hook != NULL))
+		{
+			Sim_Tick_Hook();
+			sim_kick_all();
+			sim_dispatch();
+		}
+	}
+
+	Sim_In_Step = 0;
+	return (Sim_Now < Limit_Ns);
+}
+
+void USART_Sim_Run(uint64_t Ns)
+{
+	uint64_t Limit = Sim_Now + Ns;
+
+	while(USART_Sim_Step(Limit) != 0U)
+	{
+	}
+}
@@ -0,0 +1,116 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Sim.h
+ *  Author    : Ahmed
+ *  Created   : Feb 2, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Host simulation of the STM32F4 USART peripherals the driver talks to.
+ *  The unmodified driver (MCAL/USART) is compiled against the shim headers in
+ *  Sim/Inc and runs on the PC against this model.
+ *
+ *  What is modelled (per port):
+ *   - Baud-rate clock: one frame takes (start + data + stop) bits / BaudRate
+ *   - TX: DR holding register + shift register, TXE / TC flags
+ *   - RX: RXNE, overrun (ORE) when a byte arrives before DR was read, injected
+ *     framing / noise / parity errors
+ *   - IDLE line: IDLE is set one frame time after the last received frame
+ *   - Interrupts: RXNEIE / TXEIE / TCIE / PEIE / EIE / IDLEIE + NVIC enable, delivered
+ *     to the driver's USARTx_IRQHandler(); HAL_UART_IRQHandler() is emulated. Pending
+ *     IRQs run lowest IRQ number first, like the NVIC at equal priority
+ *   - RX DMA: a stream per port with NDTR counting down per byte, circular reload,
+ *     half / complete flags delivered to the driver's DMAx_StreamN_IRQHandler(), and
+ *     HAL_UARTEx_ReceiveToIdle_DMA() with its half / complete / IDLE events
+ *   - Flow control: CTS gating from the peer's RTS (hardware RTS = RX not full,
+ *     software RTS = the GPIO pin written by the driver), XON/XOFF honoured by the
+ *     external sender
+ *   - One-shot timer channels (USART_Sim_SetAlarm), standing in for a TIMx compare
+ *     unit: the handler runs at the exact simulated time, at USART IRQ priority
+ *
+ *  What is NOT modelled:
+ *   - TX DMA (USART_TX_DMA must be DISABLE for the sim build)
+ *   - DMA bus timing: a stream takes a byte in the same instant RXNE would be set
+ *   - CPU time: driver code executes in zero simulated time
+ *   - Interrupts preempting task code: they are delivered only while the simulated
+ *     kernel advances time (see Sim/Inc/FreeRTOS.h)
+ *
+ *  Wiring:
+ *   - USART_Sim_Connect(a, b) crosses TX/RX (and RTS/CTS) of two ports; a == b is
+ *     a loopback plug.
+ *   - Unconnected ports talk to an "external device": USART_Sim_Inject() queues
+ *     bytes it sends at the port baud rate, USART_Sim_SetTxSink() receives what
+ *     the port transmits.
+ * =========================================================================================
+ */
+
+#ifndef SIM_USART_SIM_H_
+#define SIM_USART_SIM_H_
+
+#include <stdint.h>
+
+#include "USART.h"
+
+/* =========================================================================================
+ *                                     Public Types
+ * =========================================================================================
+ *
+ * USART_Sim_Sink_t:
+ *  - Receives every byte an unconnected port shifts out (at the end of its frame).
+ *
+ * USART_Sim_Hook_t:
+ *  - Called on every simulated 1 ms tick, in task context. Used to stand in for
+ *    the periodic task that runs USART_RxCyclic() / USART_TxCyclic().
+ *
+ * USART_Sim_Alarm_t:
+ *  - Timer channel handler (USART_Sim_SetAlarm), called in interrupt context.
+ *
+ * USART_Sim_Line_t:
+ *  - Line-level counters kept by the model, independent of the driver statistics.
+ *  - Irq_Ns_* is host wall-clock time spent inside the driver's IRQ handler; it
+ *    ranks modes against each other, it is not a Cortex-M cycle count.
+ */
+typedef void (*USART_Sim_Sink_t)(USART_Num_t USART_Num, uint8_t Data);
+typedef void (*USART_Sim_Hook_t)(void);
+typedef void (*USART_Sim_Alarm_t)(uint32_t Arg);
+
+typedef struct
+{
+	uint32_t Tx_Frames;    /* Frames shifted out on TX                        */
+	uint32_t Rx_Frames;    /* Frames that reached the RX data register        */
+	uint32_t Rx_Overrun;   /* Frames lost because RXNE was still set          */
+	uint32_t Irq_Count;    /* USARTx_IRQHandler() invocations                 */
+	uint32_t Dma_Irq_Count;/* RX DMA stream IRQ handler invocations           */
+	uint32_t Irq_Ns_Min;   /* Shortest handler run (host ns)                  */
+	uint32_t Irq_Ns_Max;   /* Longest handler run (host ns)                   */
+	uint64_t Irq_Ns_Total; /* Sum of all handler runs (host ns)               */
+} USART_Sim_Line_t;
+
+/* =========================================================================================
+ *                                     Public APIs
+ * =========================================================================================
+ */
+void     USART_Sim_Connect(USART_Num_t USART_A, USART_Num_t USART_B);
+uint32_t USART_Sim_Inject(USART_Num_t USART_Num, const uint8_t *Data, uint32_t Len);
+void     USART_Sim_InjectError(USART_Num_t USART_Num, uint32_t Sr_Flags);
+void     USART_Sim_SetTxSink(USART_Num_t USART_Num, USART_Sim_Sink_t Sink);
+void     USART_Sim_SetTickHook(USART_Sim_Hook_t Hook);
+void     USART_Sim_SetAlarm(uint32_t Channel, uint64_t Ns, USART_Sim_Alarm_t Hook, uint32_t Arg);
+void     USART_Sim_GetLine(USART_Num_t USART_Num, USART_Sim_Line_t *Line);
+void     USART_Sim_ResetLine(USART_Num_t USART_Num);
+
+/* Offset the RX DMA stream writes next in the landing buffer (0 without RX DMA). */
+uint32_t USART_Sim_RxDmaPos(USART_Num_t USART_Num);
+
+/*
+ * Simulated time.
+ *  - USART_Sim_Run() advances the model by Ns nanoseconds (delivering IRQs and
+ *    tick hooks on the way). Blocking kernel calls do the same internally.
+ *  - USART_Sim_Step() advances to the next event (frame end / tick) but never
+ *    past Limit_Ns; returns 0 when Limit_Ns has been reached.
+ */
+uint64_t USART_Sim_TimeNs(void);
+void     USART_Sim_Run(uint64_t Ns);
+uint8_t  USART_Sim_Step(uint64_t Limit_Ns);
+
+#endif /* SIM_USART_SIM_H_ */
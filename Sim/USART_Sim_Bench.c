@@ -0,0 +1,98 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Sim_Bench.c
+ *  Author    : Ahmed
+ *  Created   : Feb 9, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Host build of the benchmark suite (TASKS/USART_Bench.c), built with "make bench".
+ *
+ *  Platform hooks:
+ *   - USART_Bench_NowNs()    : simulated line time, so throughput / latency are what
+ *                              the configured baud rate and polling periods allow
+ *   - USART_Bench_Cycles()   : host CLOCK_MONOTONIC in ns (CyclesHz = 1 GHz); the
+ *                              driver runs natively, so "cycles" rank code paths
+ *                              against each other, they are not Cortex-M numbers
+ *   - USART_Bench_IsrProbe() : IRQ count / handler time kept by the model
+ *                              (USART_Sim_Line_t.Irq_*)
+ *
+ *  Exit code: 0 if the suite verified every byte, 1 otherwise.
+ * =========================================================================================
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "USART.h"
+#include "USART_Sim.h"
+#include "USART_Bench.h"
+
+#ifndef SIM_BENCH_PORT
+#define SIM_BENCH_PORT     USART_NUM_2
+#endif
+
+static void sim_service_task(void)
+{
+	USART_RxCyclic();
+	USART_TxCyclic();
+}
+
+/* =========================================================================================
+ *                                     Platform Hooks
+ * =========================================================================================
+ */
+uint32_t USART_Bench_Cycles(void)
+{
+	struct timespec Ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &Ts);
+	return (uint32_t)(((uint64_t)Ts.tv_sec * 1000000000ULL) + (uint64_t)Ts.tv_nsec);
+}
+
+uint32_t USART_Bench_CyclesHz(void)
+{
+	return 1000000000U;
+}
+
+uint64_t USART_Bench_NowNs(void)
+{
+	return USART_Sim_TimeNs();
+}
+
+void USART_Bench_IsrProbe(USART_Num_t USART_Num, uint32_t Window_Ms, USART_Bench_Isr_t *Isr)
+{
+	USART_Sim_Line_t Line;
+
+	USART_Sim_ResetLine(USART_Num);
+	vTaskDelay(pdMS_TO_TICKS(Window_Ms));
+	USART_Sim_GetLine(USART_Num, &Line);
+
+	Isr->Count = Line.Irq_Count;
+	Isr->Min   = Line.Irq_Ns_Min;
+	Isr->Max   = Line.Irq_Ns_Max;
+	Isr->Total = Line.Irq_Ns_Total;
+}
+
+int main(void)
+{
+	uint8_t Ok = 0;
+
+	USART_Sim_SetTickHook(sim_service_task);
+	USART_Sim_Connect(SIM_BENCH_PORT, SIM_BENCH_PORT);
+
+	if(USART_Init(SIM_BENCH_PORT) == USART_InitSuccess)
+	{
+		Ok = USART_Bench_Run(SIM_BENCH_PORT);
+	}
+	else
+	{
+		printf("BENCH,error,init_failed=1\n");
+	}
+
+	return (Ok != 0U) ? 0 : 1;
+}
@@ -0,0 +1,540 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Sim_Demo.c
+ *  Author    : Ahmed
+ *  Created   : Feb 2, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Host simulation scenario for the USART driver, built with Sim/Makefile.
+ *
+ *  USART2 (the only port with buffers in the default USART_Cfg.*) gets a loopback
+ *  plug and runs up to seven phases with the configuration from USART_Cfg.h:
+ *    1) Latency    : one byte, USART_Send() -> USART_Receive() round trip
+ *    2) Throughput : SIM_BULK_LEN bytes streamed through the loopback and checked
+ *    3) Burst      : an external device sends faster than the application reads,
+ *                    with a framing error injected, to exercise drops / error stats
+ *    4) Baud switch: USART_SetBaud() with bytes still queued (they must go out at the
+ *                    old rate first), latency at SIM_FAST_BAUD, then back
+ *       Commit     : (ring backend) short USART_TxCommit(): given back, or skipped
+ *                    by the transmitter (never sent)
+ *    5) Peek       : (ring backend) a block that wraps around the end of the RX ring
+ *                    is parsed in place with USART_RxPeek() / USART_RxConsume()
+ *    6) Acquire    : (ring backend) two spans open at once (short publish given back or
+ *                    skipped), then frames are encoded straight into the TX ring with
+ *                    USART_TxAcquire() / USART_TxPublish(), wrapping several times
+ *    7) RX DMA     : (USART_RX_DMA) bursts that end mid-buffer (IDLE event), cross the
+ *                    half-transfer point and wrap around the end of the circular DMA
+ *                    landing buffer, each checked byte for byte and by interrupt count
+ *
+ *  A periodic 1 ms "service task" (tick hook) runs USART_RxCyclic() / USART_TxCyclic()
+ *  exactly like the polling task on target; they do nothing for interrupt-driven
+ *  directions.
+ *
+ *  Exit code: 0 if the loopback data arrived complete and in order, 1 otherwise.
+ * =========================================================================================
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "stm32f4xx.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "USART.h"
+#include "USART_Prv.h"
+#include "USART_Cfg.h"
+#include "USART_Sim.h"
+
+#define SIM_DEMO_PORT      USART_NUM_2
+#define SIM_BULK_LEN       8192U
+#define SIM_CHUNK_LEN      64U
+#define SIM_BURST_LEN      600U
+#define SIM_FAST_BAUD      921600U
+#define SIM_FRAME_LEN      24U
+
+static uint8_t Sim_Tx_Data[SIM_BULK_LEN];
+static uint8_t Sim_Rx_Data[SIM_BULK_LEN];
+
+static void sim_service_task(void)
+{
+	USART_RxCyclic();
+	USART_TxCyclic();
+}
+
+static double sim_us(uint64_t Ns)
+{
+	return (double)Ns / 1000.0;
+}
+
+static uint32_t sim_baud(void)
+{
+	uint32_t Baud = 0;
+
+	(void)USART_GetBaud(SIM_DEMO_PORT, &Baud);
+	return Baud;
+}
+
+static void sim_print_stats(const char *Phase)
+{
+	USART_Stats_t    Stats;
+	USART_Sim_Line_t Line;
+
+	(void)USART_GetStats(SIM_DEMO_PORT, &Stats);
+	USART_Sim_GetLine(SIM_DEMO_PORT, &Line);
+
+	printf("  [%s] driver: rx=%lu tx=%lu drops=%lu ore=%lu fe=%lu ne=%lu pe=%lu rx_hw=%lu tx_hw=%lu\n",
+	       Phase,
+	       (unsigned long)Stats.Rx_Bytes, (unsigned long)Stats.Tx_Bytes, (unsigned long)Stats.Rx_Drops,
+	       (unsigned long)Stats.Overrun, (unsigned long)Stats.Framing, (unsigned long)Stats.Noise,
+	       (unsigned long)Stats.Parity, (unsigned long)Stats.Rx_High_Water, (unsigned long)Stats.Tx_High_Water);
+	printf("  [%s] line  : tx_frames=%lu rx_frames=%lu hw_overrun=%lu irqs=%lu\n",
+	       Phase,
+	       (unsigned long)Line.Tx_Frames, (unsigned long)Line.Rx_Frames,
+	       (unsigned long)Line.Rx_Overrun, (unsigned long)Line.Irq_Count);
+}
+
+/* Phase 1: single byte round trip through the loopback plug. */
+static uint8_t sim_phase_latency(void)
+{
+	uint8_t  Tx = 0xA5;
+	uint8_t  Rx = 0;
+	uint32_t Len = 0;
+	uint64_t Start = USART_Sim_TimeNs();
+	uint8_t  Ok;
+
+	(void)USART_Send(SIM_DEMO_PORT, &Tx, 1, 100);
+	Ok = (USART_Receive(SIM_DEMO_PORT, &Rx, 1, 100, &Len) == USART_Rx_Ok) && (Len == 1U) && (Rx == Tx);
+
+	printf("latency   : %s, %.1f us for one byte (one frame = %.1f us)\n",
+	       Ok ? "ok" : "FAILED", sim_us(USART_Sim_TimeNs() - Start),
+	       1000000.0 * 10.0 / (double)sim_baud());
+	return Ok;
+}
+
+/* Phase 2: stream SIM_BULK_LEN bytes and verify order and content. */
+static uint8_t sim_phase_throughput(void)
+{
+	uint32_t Sent  = 0;
+	uint32_t Got   = 0;
+	uint32_t Len   = 0;
+	uint64_t Start = USART_Sim_TimeNs();
+	uint64_t Elapsed;
+	double   Rate;
+	double   Line_Rate = (double)sim_baud() / 10.0;
+	uint8_t  Ok;
+
+	for(uint32_t i = 0; i < SIM_BULK_LEN; i++)
+	{
+		Sim_Tx_Data[i] = (uint8_t)((i * 7U) + (i >> 8));
+	}
+
+	while(Got < SIM_BULK_LEN)
+	{
+		if(Sent < SIM_BULK_LEN)
+		{
+			uint32_t Chunk = ((SIM_BULK_LEN - Sent) < SIM_CHUNK_LEN) ? (SIM_BULK_LEN - Sent) : SIM_CHUNK_LEN;
+
+			if(USART_Send(SIM_DEMO_PORT, &Sim_Tx_Data[Sent], Chunk, 1000) != USART_Tx_Ok)
+			{
+				break;
+			}
+			Sent += Chunk;
+		}
+
+		/* Drain without waiting while sending, wait for the tail afterwards. */
+		if(USART_Receive(SIM_DEMO_PORT, &Sim_Rx_Data[Got], SIM_BULK_LEN - Got,
+		                 (Sent < SIM_BULK_LEN) ? USART_NO_WAIT : 100U, &Len) == USART_Rx_Ok)
+		{
+			Got += Len;
+		}
+		else if(Sent >= SIM_BULK_LEN)
+		{
+			break;
+		}
+	}
+
+	Elapsed = USART_Sim_TimeNs() - Start;
+	Rate    = (double)Got * 1e9 / (double)Elapsed;
+	Ok      = (Got == SIM_BULK_LEN) && (memcmp(Sim_Tx_Data, Sim_Rx_Data, SIM_BULK_LEN) == 0);
+
+	printf("throughput: %s, %lu/%u bytes in %.2f ms = %.0f B/s (%.1f %% of line rate)\n",
+	       Ok ? "ok" : "FAILED", (unsigned long)Got, SIM_BULK_LEN, sim_us(Elapsed) / 1000.0,
+	       Rate, 100.0 * Rate / Line_Rate);
+	sim_print_stats("bulk ");
+	return Ok;
+}
+
+/* Phase 3: external burst the application does not read for 100 ms. */
+static void sim_phase_burst(void)
+{
+	uint8_t  Burst[SIM_BURST_LEN];
+	uint32_t Got = 0;
+	uint32_t Len = 0;
+
+	for(uint32_t i = 0; i < SIM_BURST_LEN; i++)
+	{
+		Burst[i] = (uint8_t)('A' + (i % 26U));
+	}
+
+	(void)USART_ResetStats(SIM_DEMO_PORT);
+	USART_Sim_InjectError(SIM_DEMO_PORT, USART_SR_FE);
+	(void)USART_Sim_Inject(SIM_DEMO_PORT, Burst, SIM_BURST_LEN);
+
+	vTaskDelay(pdMS_TO_TICKS(100));
+
+	while(USART_Receive(SIM_DEMO_PORT, Sim_Rx_Data, sizeof(Sim_Rx_Data), 5, &Len) == USART_Rx_Ok)
+	{
+		Got += Len;
+	}
+
+	printf("burst     : %u bytes sent, %lu delivered to the application\n", SIM_BURST_LEN, (unsigned long)Got);
+	sim_print_stats("burst");
+}
+
+/* Phase 4: switch to SIM_FAST_BAUD with SIM_CHUNK_LEN bytes still queued, then back. */
+static uint8_t sim_phase_baud(void)
+{
+	uint32_t Old  = sim_baud();
+	uint32_t Got  = 0;
+	uint32_t Len  = 0;
+	uint64_t Start;
+	uint64_t Drain;
+	uint8_t  Ok;
+
+	/* Empty whatever the burst left behind. */
+	while(USART_Receive(SIM_DEMO_PORT, Sim_Rx_Data, sizeof(Sim_Rx_Data), 5, &Len) == USART_Rx_Ok)
+	{
+	}
+
+	(void)USART_Send(SIM_DEMO_PORT, Sim_Tx_Data, SIM_CHUNK_LEN, 100);
+	Start = USART_Sim_TimeNs();
+	Ok    = (USART_SetBaud(SIM_DEMO_PORT, SIM_FAST_BAUD) == USART_Ok) && (sim_baud() == SIM_FAST_BAUD);
+	Drain = USART_Sim_TimeNs() - Start;
+
+	while((Got < SIM_CHUNK_LEN) &&
+	      (USART_Receive(SIM_DEMO_PORT, &Sim_Rx_Data[Got], SIM_CHUNK_LEN - Got, 100, &Len) == USART_Rx_Ok))
+	{
+		Got += Len;
+	}
+	Ok &= (Got == SIM_CHUNK_LEN) && (memcmp(Sim_Tx_Data, Sim_Rx_Data, SIM_CHUNK_LEN) == 0);
+
+	printf("baud      : %s, %lu -> %lu baud after %.2f ms TX drain (%u bytes queued)\n",
+	       Ok ? "ok" : "FAILED", (unsigned long)Old, (unsigned long)sim_baud(), sim_us(Drain) / 1000.0,
+	       SIM_CHUNK_LEN);
+
+	Ok &= sim_phase_latency();
+	Ok &= (USART_SetBaud(SIM_DEMO_PORT, Old) == USART_Ok);
+	Ok &= (USART_SetBaud(SIM_DEMO_PORT, 0U) == USART_Invalid_Arg) && (sim_baud() == Old);
+	return Ok;
+}
+
+#if (USART_BUFF_BACKEND == USART_BUFF_RING)
+/* Reservations committed short: given back when last, skipped when sent otherwise. */
+static uint8_t sim_commit_check(void)
+{
+	USART_TxResv_t First;
+	USART_TxResv_t Second;
+	uint8_t        Out[6] = {0x31, 0x32, 0x33, 0x34, 0x35, 0x36};
+	uint8_t        In[8];
+	uint32_t       Got = 0;
+	uint32_t       Len = 0;
+	uint8_t        Ok  = 1U;
+
+	/* Last reservation: the unwritten byte is given back. */
+	Ok &= (USART_TxReserve(SIM_DEMO_PORT, 3U, 100, &First) == USART_Tx_Ok);
+	Ok &= (USART_TxWrite(&First, &Out[0], 2U) == USART_Tx_Ok);
+	Ok &= (USART_TxCommit(&First) == USART_Tx_Ok);
+
+	/* A later reservation pins the end: the gap stays in the ring but is not sent. */
+	Ok &= (USART_TxReserve(SIM_DEMO_PORT, 3U, 100, &First) == USART_Tx_Ok);
+	Ok &= (USART_TxReserve(SIM_DEMO_PORT, 2U, 100, &Second) == USART_Tx_Ok);
+	Ok &= (USART_TxWrite(&First, &Out[2], 2U) == USART_Tx_Ok);
+	Ok &= (USART_TxWrite(&Second, &Out[4], 2U) == USART_Tx_Ok);
+	Ok &= (USART_TxCommit(&First) == USART_Tx_Ok);
+	Ok &= (USART_TxCommit(&Second) == USART_Tx_Ok);
+	Ok &= (USART_TxCommit(&First) == USART_Invalid_Arg);
+
+	/* Wait past the 6 bytes expected: a stray gap byte would show up as a 7th. */
+	while((Got < sizeof(In)) && (USART_Receive(SIM_DEMO_PORT, &In[Got], sizeof(In) - Got, 100, &Len) == USART_Rx_Ok))
+	{
+		Got += Len;
+	}
+	Ok &= (Got == 6U) && (memcmp(In, Out, 6U) == 0);
+
+	printf("commit    : %s, short commit given back when last, gap skipped otherwise\n",
+	       Ok ? "ok" : "FAILED");
+	return Ok;
+}
+
+/* Phase 5: a block that wraps around the end of the RX ring, parsed in place. */
+static uint8_t sim_phase_peek(void)
+{
+	uint32_t       Size  = USART_Config[SIM_DEMO_PORT].Rx_Buff_Size;
+	uint32_t       Block = Size - 8U;
+	uint32_t       Got   = 0;
+	uint32_t       Len   = 0;
+	uint32_t       First = 0;
+	uint32_t       Room  = 0;
+	uint32_t       Spans = 0;
+	const uint8_t *Span;
+	uint8_t        Ok    = 1U;
+
+	while(USART_Receive(SIM_DEMO_PORT, Sim_Rx_Data, sizeof(Sim_Rx_Data), 5, &Len) == USART_Rx_Ok)
+	{
+	}
+
+	for(uint32_t i = 0; i < Block; i++)
+	{
+		Sim_Tx_Data[i] = (uint8_t)((i * 13U) + 1U);
+	}
+	(void)USART_Sim_Inject(SIM_DEMO_PORT, Sim_Tx_Data, Block);
+	vTaskDelay(pdMS_TO_TICKS(((Block * 10000U) / sim_baud()) + 5U));
+
+	/* Parse straight from the ring: one span up to the end of the storage, then the rest. */
+	while(USART_RxPeek(SIM_DEMO_PORT, &Span, &Len) == USART_Rx_Ok)
+	{
+		if(Spans == 0U)
+		{
+			First = Len;
+			Room  = (uint32_t)(&USART_Config[SIM_DEMO_PORT].Rx_Buff[Size] - Span);
+		}
+		Ok &= (memcmp(Span, &Sim_Tx_Data[Got], Len) == 0);
+		Spans++;
+		Got  += Len;
+		Ok   &= (USART_RxConsume(SIM_DEMO_PORT, Len) == USART_Rx_Ok);
+	}
+
+	/* The first span is the largest contiguous one: all of it, or up to the end. */
+	Ok &= (Got == Block) && (First == ((Room < Block) ? Room : Block)) && (Spans == ((Room < Block) ? 2U : 1U));
+	Ok &= (USART_RxConsume(SIM_DEMO_PORT, 1U) == USART_Invalid_Arg);
+
+	printf("peek      : %s, %lu/%lu bytes parsed in place in %lu spans (first %lu, ring %lu)\n",
+	       Ok ? "ok" : "FAILED", (unsigned long)Got, (unsigned long)Block, (unsigned long)Spans,
+	       (unsigned long)First, (unsigned long)Size);
+	return Ok;
+}
+
+/* Phase 6: frames encoded in place in the TX ring, split where a span comes up short. */
+static uint8_t sim_phase_acquire(void)
+{
+	uint32_t  Total = (4U * USART_Config[SIM_DEMO_PORT].Tx_Buff_Size) + SIM_FRAME_LEN;
+	uint32_t  Sent  = 0;
+	uint32_t  Got   = 0;
+	uint32_t  Len   = 0;
+	uint32_t  Span  = 0;
+	uint32_t  Splits = 0;
+	uint32_t  Span2  = 0;
+	uint32_t  Exp    = 0;
+	uint8_t   Expect[16];
+	uint8_t  *Data;
+	uint8_t  *Data2;
+	uint8_t   Ok    = 1U;
+	USART_TxResv_t First;
+	USART_TxResv_t Second;
+
+	/* Two spans open at once: the first published whole, the last one short (given back). */
+	Ok &= (USART_TxAcquire(SIM_DEMO_PORT, 3U, &First, &Data, &Span) == USART_Tx_Ok);
+	Ok &= (USART_TxAcquire(SIM_DEMO_PORT, 3U, &Second, &Data2, &Span2) == USART_Tx_Ok);
+	memset(Data, 0x41, Span);
+	memset(Data2, 0x42, Span2);
+	Ok &= (USART_TxPublish(&First, Span + 1U) == USART_Invalid_Arg);
+	Ok &= (USART_TxPublish(&First, Span) == USART_Tx_Ok);
+	Ok &= (USART_TxPublish(&Second, 1U) == USART_Tx_Ok);
+	Ok &= (USART_TxPublish(&Second, 0U) == USART_Invalid_Arg);
+	memset(&Expect[Exp], 0x41, Span);
+	Exp += Span;
+	Expect[Exp++] = 0x42;
+
+	/* The first one short while the second is open: the rest of it is skipped. */
+	Ok &= (USART_TxAcquire(SIM_DEMO_PORT, 3U, &First, &Data, &Span) == USART_Tx_Ok);
+	Ok &= (USART_TxAcquire(SIM_DEMO_PORT, 3U, &Second, &Data2, &Span2) == USART_Tx_Ok);
+	Data[0] = 0x43;
+	memset(Data2, 0x44, Span2);
+	Ok &= (USART_TxPublish(&First, 1U) == USART_Tx_Ok);
+	Ok &= (USART_TxPublish(&Second, Span2) == USART_Tx_Ok);
+	Expect[Exp++] = 0x43;
+	memset(&Expect[Exp], 0x44, Span2);
+	Exp += Span2;
+
+	while((Got < Exp) && (USART_Receive(SIM_DEMO_PORT, &Sim_Rx_Data[Got], Exp - Got, 100, &Len) == USART_Rx_Ok))
+	{
+		Got += Len;
+	}
+	Ok &= (Got == Exp) && (memcmp(Sim_Rx_Data, Expect, Exp) == 0);
+	Got = 0;
+
+	for(uint32_t i = 0; i < Total; i++)
+	{
+		Sim_Tx_Data[i] = (uint8_t)(((i / SIM_FRAME_LEN) << 4) ^ (i % SIM_FRAME_LEN));
+	}
+
+	while((Got < Total) && (Ok != 0U))
+	{
+		if(Sent < Total)
+		{
+			/* Ask for a bit more than the rest of the frame, publish only the frame. */
+			uint32_t Rest = SIM_FRAME_LEN - (Sent % SIM_FRAME_LEN);
+
+			if(USART_TxAcquire(SIM_DEMO_PORT, Rest + 8U, &First, &Data, &Span) == USART_Tx_Ok)
+			{
+				Span = (Span < Rest) ? Span : Rest;
+				memcpy(Data, &Sim_Tx_Data[Sent], Span);
+				Ok     &= (USART_TxPublish(&First, Span) == USART_Tx_Ok);
+				Splits += (Span < Rest) ? 1U : 0U;
+				Sent   += Span;
+			}
+			else
+			{
+				/* TX ring full: let the line move. */
+				vTaskDelay(1);
+			}
+		}
+
+		if(USART_Receive(SIM_DEMO_PORT, &Sim_Rx_Data[Got], Total - Got,
+		                 (Sent < Total) ? USART_NO_WAIT : 100U, &Len) == USART_Rx_Ok)
+		{
+			Got += Len;
+		}
+		else if(Sent >= Total)
+		{
+			break;
+		}
+	}
+
+	Ok &= (Got == Total) && (memcmp(Sim_Tx_Data, Sim_Rx_Data, Total) == 0) && (Splits != 0U);
+
+	printf("acquire   : %s, %lu/%lu bytes encoded in place, %lu partial spans (ring end or full)\n",
+	       Ok ? "ok" : "FAILED", (unsigned long)Got, (unsigned long)Total, (unsigned long)Splits);
+	return Ok;
+}
+#endif
+
+#if (USART_RX_DMA == ENABLE)
+/*
+ * One burst from the external device, starting at DMA offset From: must arrive whole,
+ * on one IDLE interrupt plus one half / complete interrupt per half-buffer boundary
+ * crossed.
+ */
+static uint8_t sim_dma_burst(uint32_t From, uint32_t Len)
+{
+	USART_Sim_Line_t Before;
+	USART_Sim_Line_t After;
+	uint32_t         Half     = USART_RX_DMA_SIZE / 2U;
+	uint32_t         Dma_Irqs = ((From + Len) / Half) - (From / Half);
+	uint32_t         Got      = 0;
+	uint32_t         Rx       = 0;
+	uint8_t          Ok;
+
+	for(uint32_t i = 0; i < Len; i++)
+	{
+		Sim_Tx_Data[i] = (uint8_t)((From + i) ^ 0x5AU);
+	}
+
+	USART_Sim_GetLine(SIM_DEMO_PORT, &Before);
+	(void)USART_Sim_Inject(SIM_DEMO_PORT, Sim_Tx_Data, Len);
+
+	/* The whole burst plus the idle frame; nothing is read meanwhile. */
+	vTaskDelay(pdMS_TO_TICKS((((Len + 1U) * 10000U) / sim_baud()) + 2U));
+	USART_Sim_GetLine(SIM_DEMO_PORT, &After);
+
+	while((Got < Len) &&
+	      (USART_Receive(SIM_DEMO_PORT, &Sim_Rx_Data[Got], Len - Got, USART_NO_WAIT, &Rx) == USART_Rx_Ok))
+	{
+		Got += Rx;
+	}
+
+	Ok = (Got == Len) && (memcmp(Sim_Tx_Data, Sim_Rx_Data, Len) == 0) &&
+	     ((After.Irq_Count - Before.Irq_Count) == 1U) &&
+	     ((After.Dma_Irq_Count - Before.Dma_Irq_Count) == Dma_Irqs) &&
+	     (USART_Sim_RxDmaPos(SIM_DEMO_PORT) == ((From + Len) % USART_RX_DMA_SIZE));
+
+	printf("  [dma  ] %2lu..%3lu: %s, %lu/%lu bytes, %lu usart + %lu dma irqs\n",
+	       (unsigned long)From, (unsigned long)(From + Len), Ok ? "ok" : "FAILED",
+	       (unsigned long)Got, (unsigned long)Len,
+	       (unsigned long)(After.Irq_Count - Before.Irq_Count),
+	       (unsigned long)(After.Dma_Irq_Count - Before.Dma_Irq_Count));
+	return Ok;
+}
+
+/* Phase 7: circular RX DMA, offsets relative to the landing buffer (S bytes). */
+static uint8_t sim_phase_dma(void)
+{
+	const uint32_t S    = USART_RX_DMA_SIZE;
+	const uint32_t H    = S / 2U;
+	const uint32_t Room = USART_Config[SIM_DEMO_PORT].Rx_Buff_Size;
+	uint32_t       Len  = 0;
+	uint8_t        Ok   = 1U;
+
+	while(USART_Receive(SIM_DEMO_PORT, Sim_Rx_Data, sizeof(Sim_Rx_Data), 5, &Len) == USART_Rx_Ok)
+	{
+	}
+
+	/* Run up to the end of the buffer: the last byte raises TC and IDLE then has
+	   nothing left to report. */
+	Len = USART_Sim_RxDmaPos(SIM_DEMO_PORT);
+	Ok &= sim_dma_burst(Len, S - Len);
+
+	/* Ends mid-half: only the IDLE event delivers it. */
+	Ok &= sim_dma_burst(0U, H / 3U);
+
+	/* Crosses HT, ends in the second half: HT, then IDLE for the rest. */
+	Ok &= sim_dma_burst(H / 3U, H);
+
+	/* Wraps: TC at the end of the buffer, IDLE in the first half for the rest. */
+	Ok &= sim_dma_burst(H + (H / 3U), H);
+
+	/* Laps the landing buffer (as far as the RX buffer holds it unread). */
+	Ok &= sim_dma_burst(H / 3U, ((S + H) < Room) ? (S + H) : Room);
+
+	printf("rx dma    : %s, %lu byte circular buffer, wrap and IDLE mid-buffer\n",
+	       Ok ? "ok" : "FAILED", (unsigned long)S);
+	return Ok;
+}
+#endif
+
+int main(void)
+{
+	uint8_t Ok;
+
+	USART_Sim_SetTickHook(sim_service_task);
+	USART_Sim_Connect(SIM_DEMO_PORT, SIM_DEMO_PORT);
+
+	printf("USART host simulation: USART%u @ %lu baud, RX %s / TX %s, %s backend\n",
+	       (unsigned)(SIM_DEMO_PORT + 1U), (unsigned long)USART_Config[SIM_DEMO_PORT].BaudRate,
+	       (USART_RX_DMA == ENABLE) ? "DMA" : (USART_RX_INT == ENABLE) ? "interrupt" : "polling",
+	       (USART_TX_INT == ENABLE) ? "interrupt" : "polling",
+	       (USART_BUFF_BACKEND == USART_BUFF_RING) ? "ring" : "queue");
+
+	if(USART_Init(SIM_DEMO_PORT) != USART_InitSuccess)
+	{
+		printf("USART_Init failed\n");
+		return 1;
+	}
+
+#if (USART1_TX_BUFF_SIZE == 0U)
+	/* USART1 has no buffers: Init must fail and leave the port unusable, RX off. */
+	Ok = (USART_Init(USART_NUM_1) == USART_CreateBuff_Failed) &&
+	     (USART_SendByte(USART_NUM_1, 0x55U) == USART_Not_Init);
+	printf("unused    : %s, USART1 without buffers stays uninitialized\n", Ok ? "ok" : "FAILED");
+#else
+	Ok = 1U;
+#endif
+
+	Ok &= sim_phase_latency();
+	Ok &= sim_phase_throughput();
+	sim_phase_burst();
+	Ok &= sim_phase_baud();
+#if (USART_BUFF_BACKEND == USART_BUFF_RING)
+	Ok &= sim_commit_check();
+	Ok &= sim_phase_peek();
+	Ok &= sim_phase_acquire();
+#endif
+#if (USART_RX_DMA == ENABLE)
+	Ok &= sim_phase_dma();
+#endif
+
+	return (Ok != 0U) ? 0 : 1;
+}
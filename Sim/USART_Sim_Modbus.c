@@ -0,0 +1,358 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Sim_Modbus.c
+ *  Author    : Ahmed
+ *  Created   : Feb 22, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Host test of the Modbus RTU slave (TASKS/USART_Modbus.c), built with
+ *  "make modbus" in Sim/.
+ *
+ *  USART2 runs the slave (address SIM_MB_ADDR). The simulated master is the external
+ *  device on the far end of the line: it sends requests with USART_Sim_Inject() (at
+ *  line rate, so inter-character timing is real) and collects the replies through the
+ *  TX sink. Each case checks the reply byte for byte, or that no reply came.
+ *
+ *  Platform hooks: simulated time for USART_Modbus_NowUs(), USART_Sim_SetAlarm()
+ *  channels for the t3.5 timers.
+ *
+ *  Output: one line per case plus the slave counters and the turnaround, both as
+ *  measured by the slave (frame end -> reply queued) and on the wire (last request
+ *  bit -> first reply bit, which includes the t3.5 wait). Task code takes no
+ *  simulated time, so the slave-side figure is 0 here; on target it is the Poll()
+ *  task's wake-up latency plus processing.
+ *  Exit code: 0 if every case passed, 1 otherwise.
+ * =========================================================================================
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "USART.h"
+#include "USART_Prv.h"
+#include "USART_Cfg.h"
+#include "USART_Crc.h"
+#include "USART_Modbus.h"
+#include "USART_Sim.h"
+
+#if (USART_MODBUS != ENABLE)
+#error "USART_Sim_Modbus.c needs USART_MODBUS == ENABLE (build it with make modbus)"
+#endif
+
+#define SIM_MB_PORT        USART_NUM_2
+#define SIM_MB_ADDR        17U
+#define SIM_MB_REPLY_MAX   USART_MODBUS_ADU_MAX
+
+/* =========================================================================================
+ *                                     Register Map
+ * =========================================================================================
+ */
+static uint8_t  Sim_Coils[2];           /* 16 coils at 0x0000 */
+static uint8_t  Sim_Discrete[1] = { 0xA5U };  /* 8 inputs at 0x0100 */
+static uint16_t Sim_Holding[8];         /* 40001.. at 0x0000 */
+static uint16_t Sim_Input[4] = { 0x1111U, 0x2222U, 0x3333U, 0x4444U };  /* at 0x0200 */
+static uint32_t Sim_Write_Calls;
+
+static void sim_on_write(uint16_t Addr, uint16_t Count)
+{
+	(void)Addr;
+	(void)Count;
+	Sim_Write_Calls++;
+}
+
+static const USART_Modbus_Region_t Sim_Map[] =
+{
+	{ USART_MODBUS_COILS,    0x0000U, 16U, Sim_Coils,    sim_on_write },
+	{ USART_MODBUS_DISCRETE, 0x0100U,  8U, Sim_Discrete, NULL         },
+	{ USART_MODBUS_HOLDING,  0x0000U,  8U, Sim_Holding,  sim_on_write },
+	{ USART_MODBUS_INPUT,    0x0200U,  4U, Sim_Input,    NULL         },
+};
+
+/* =========================================================================================
+ *                                     Platform Hooks
+ * =========================================================================================
+ */
+static void sim_mb_alarm(uint32_t Channel)
+{
+	USART_Modbus_TimerIsr(Channel);
+}
+
+void USART_Modbus_TimerInit(void)
+{
+}
+
+uint32_t USART_Modbus_NowUs(void)
+{
+	return (uint32_t)(USART_Sim_TimeNs() / 1000U);
+}
+
+void USART_Modbus_TimerStart(uint32_t Channel, uint32_t Us)
+{
+	USART_Sim_SetAlarm(Channel, (uint64_t)Us * 1000U, sim_mb_alarm, Channel);
+}
+
+/* =========================================================================================
+ *                                   Simulated Master
+ * =========================================================================================
+ */
+static uint8_t  Sim_Reply[SIM_MB_REPLY_MAX];
+static uint32_t Sim_Reply_Len;
+static uint64_t Sim_Reply_First_Ns;
+static uint64_t Sim_Req_End_Ns;
+static uint64_t Sim_Wire_Max_Ns;
+static uint32_t Sim_Failed;
+
+static void sim_mb_sink(USART_Num_t USART_Num, uint8_t Data)
+{
+	(void)USART_Num;
+	if(Sim_Reply_Len == 0U)
+	{
+		Sim_Reply_First_Ns = USART_Sim_TimeNs();
+	}
+	if(Sim_Reply_Len < SIM_MB_REPLY_MAX)
+	{
+		Sim_Reply[Sim_Reply_Len++] = Data;
+	}
+}
+
+static void sim_service_task(void)
+{
+	USART_RxCyclic();
+	USART_TxCyclic();
+}
+
+static uint64_t sim_frame_ns(uint32_t Bytes)
+{
+	return ((uint64_t)Bytes * 10U * 1000000000ULL) / USART_Config[SIM_MB_PORT].BaudRate;
+}
+
+/* Midway between t1.5 and t3.5 (fixed 750 / 1750 us above 19200 baud). */
+static uint64_t sim_gap_ns(void)
+{
+	uint32_t Baud = USART_Config[SIM_MB_PORT].BaudRate;
+
+	return (Baud > 19200U) ? 1250000U : ((27500000000ULL + Baud - 1U) / Baud);
+}
+
+/* Address + PDU -> ADU with CRC, returns the ADU length. */
+static uint32_t sim_mb_adu(uint8_t *Adu, uint8_t Addr, const uint8_t *Pdu, uint32_t Pdu_Len)
+{
+	uint16_t Crc;
+
+	Adu[0] = Addr;
+	memcpy(&Adu[1], Pdu, Pdu_Len);
+	Crc = USART_Crc16Modbus(USART_CRC16_MODBUS_INIT, Adu, Pdu_Len + 1U);
+	Adu[Pdu_Len + 1U] = (uint8_t)Crc;
+	Adu[Pdu_Len + 2U] = (uint8_t)(Crc >> 8);
+	return Pdu_Len + 3U;
+}
+
+/* Send one raw ADU, let the slave answer, wait for the reply to go out. */
+static USART_Err_St_t sim_mb_transact(const uint8_t *Adu, uint32_t Len)
+{
+	USART_Err_St_t Ret;
+
+	Sim_Reply_Len  = 0U;
+	Sim_Req_End_Ns = USART_Sim_TimeNs() + sim_frame_ns(Len);
+	(void)USART_Sim_Inject(SIM_MB_PORT, Adu, Len);
+
+	Ret = USART_Modbus_Poll(SIM_MB_PORT, 20U);
+
+	/* Until the line is quiet: polled TX (USART_TX_INT == DISABLE) drains at tick rate. */
+	do
+	{
+		Len = Sim_Reply_Len;
+		USART_Sim_Run(sim_frame_ns(SIM_MB_REPLY_MAX) + 2000000U);
+	} while(Sim_Reply_Len != Len);
+
+	if((Sim_Reply_Len != 0U) && ((Sim_Reply_First_Ns - sim_frame_ns(1U) - Sim_Req_End_Ns) > Sim_Wire_Max_Ns))
+	{
+		Sim_Wire_Max_Ns = Sim_Reply_First_Ns - sim_frame_ns(1U) - Sim_Req_End_Ns;
+	}
+	return Ret;
+}
+
+/*
+ * sim_mb_case():
+ *  - Sends Addr + Pdu and expects the reply PDU Expect (Expect_Len == 0: no reply).
+ */
+static void sim_mb_case(const char *Name, uint8_t Addr, const uint8_t *Pdu, uint32_t Pdu_Len,
+                        const uint8_t *Expect, uint32_t Expect_Len)
+{
+	uint8_t Adu[USART_MODBUS_ADU_MAX];
+	uint8_t Want[USART_MODBUS_ADU_MAX];
+	uint8_t Ok;
+
+	(void)sim_mb_transact(Adu, sim_mb_adu(Adu, Addr, Pdu, Pdu_Len));
+
+	if(Expect_Len == 0U)
+	{
+		Ok = (Sim_Reply_Len == 0U);
+	}
+	else
+	{
+		Ok = (Sim_Reply_Len == (Expect_Len + 3U)) &&
+		     (memcmp(Sim_Reply, Want, sim_mb_adu(Want, Addr, Expect, Expect_Len)) == 0);
+	}
+
+	printf("%-28s: %s\n", Name, Ok ? "ok" : "FAILED");
+	if(Ok == 0U)
+	{
+		printf("  reply (%lu bytes):", (unsigned long)Sim_Reply_Len);
+		for(uint32_t i = 0; i < Sim_Reply_Len; i++)
+		{
+			printf(" %02X", Sim_Reply[i]);
+		}
+		printf("\n");
+		Sim_Failed++;
+	}
+}
+
+static void sim_mb_check(const char *Name, uint8_t Ok)
+{
+	printf("%-28s: %s\n", Name, Ok ? "ok" : "FAILED");
+	if(Ok == 0U)
+	{
+		Sim_Failed++;
+	}
+}
+
+/* =========================================================================================
+ *                                        Cases
+ * =========================================================================================
+ */
+static void sim_mb_cases(void)
+{
+	uint8_t              Adu[USART_MODBUS_ADU_MAX];
+	uint32_t             Len;
+	USART_Modbus_Stats_t Stats;
+
+	{
+		const uint8_t Req[] = { 0x10, 0x00, 0x01, 0x00, 0x02, 0x04, 0x12, 0x34, 0xAB, 0xCD };
+		const uint8_t Rsp[] = { 0x10, 0x00, 0x01, 0x00, 0x02 };
+		sim_mb_case("write multiple registers", SIM_MB_ADDR, Req, sizeof(Req), Rsp, sizeof(Rsp));
+	}
+	{
+		const uint8_t Req[] = { 0x03, 0x00, 0x00, 0x00, 0x03 };
+		const uint8_t Rsp[] = { 0x03, 0x06, 0x00, 0x00, 0x12, 0x34, 0xAB, 0xCD };
+		sim_mb_case("read holding registers", SIM_MB_ADDR, Req, sizeof(Req), Rsp, sizeof(Rsp));
+	}
+	{
+		const uint8_t Req[] = { 0x06, 0x00, 0x07, 0xBE, 0xEF };
+		sim_mb_case("write single register", SIM_MB_ADDR, Req, sizeof(Req), Req, sizeof(Req));
+		sim_mb_check("  register updated", Sim_Holding[7] == 0xBEEFU);
+	}
+	{
+		const uint8_t Req[] = { 0x04, 0x02, 0x01, 0x00, 0x02 };
+		const uint8_t Rsp[] = { 0x04, 0x04, 0x22, 0x22, 0x33, 0x33 };
+		sim_mb_case("read input registers", SIM_MB_ADDR, Req, sizeof(Req), Rsp, sizeof(Rsp));
+	}
+	{
+		const uint8_t Req[] = { 0x05, 0x00, 0x03, 0xFF, 0x00 };
+		sim_mb_case("write single coil", SIM_MB_ADDR, Req, sizeof(Req), Req, sizeof(Req));
+	}
+	{
+		const uint8_t Req[] = { 0x0F, 0x00, 0x08, 0x00, 0x08, 0x01, 0x55 };
+		const uint8_t Rsp[] = { 0x0F, 0x00, 0x08, 0x00, 0x08 };
+		sim_mb_case("write multiple coils", SIM_MB_ADDR, Req, sizeof(Req), Rsp, sizeof(Rsp));
+	}
+	{
+		/* Coil 3 from above, coils 8..15 = 0x55; 16 coils read back. */
+		const uint8_t Req[] = { 0x01, 0x00, 0x00, 0x00, 0x10 };
+		const uint8_t Rsp[] = { 0x01, 0x02, 0x08, 0x55 };
+		sim_mb_case("read coils", SIM_MB_ADDR, Req, sizeof(Req), Rsp, sizeof(Rsp));
+	}
+	{
+		const uint8_t Req[] = { 0x02, 0x01, 0x02, 0x00, 0x05 };
+		const uint8_t Rsp[] = { 0x02, 0x01, 0x09 };
+		sim_mb_case("read discrete inputs", SIM_MB_ADDR, Req, sizeof(Req), Rsp, sizeof(Rsp));
+	}
+	{
+		const uint8_t Req[] = { 0x2B, 0x0E, 0x01, 0x00, 0x00 };
+		const uint8_t Rsp[] = { 0xAB, 0x01 };
+		sim_mb_case("exception: illegal function", SIM_MB_ADDR, Req, sizeof(Req), Rsp, sizeof(Rsp));
+	}
+	{
+		const uint8_t Req[] = { 0x03, 0x00, 0x06, 0x00, 0x03 };
+		const uint8_t Rsp[] = { 0x83, 0x02 };
+		sim_mb_case("exception: illegal address", SIM_MB_ADDR, Req, sizeof(Req), Rsp, sizeof(Rsp));
+	}
+	{
+		const uint8_t Req[] = { 0x03, 0x00, 0x00, 0x00, 0x00 };
+		const uint8_t Rsp[] = { 0x83, 0x03 };
+		sim_mb_case("exception: illegal value", SIM_MB_ADDR, Req, sizeof(Req), Rsp, sizeof(Rsp));
+	}
+	{
+		const uint8_t Req[] = { 0x03, 0x00, 0x00, 0x00, 0x01 };
+		sim_mb_case("other slave: ignored", SIM_MB_ADDR + 1U, Req, sizeof(Req), NULL, 0U);
+	}
+	{
+		const uint8_t Req[] = { 0x06, 0x00, 0x00, 0x5A, 0x5A };
+		sim_mb_case("broadcast write: no reply", 0U, Req, sizeof(Req), NULL, 0U);
+		sim_mb_check("  broadcast executed", Sim_Holding[0] == 0x5A5AU);
+	}
+	{
+		const uint8_t Req[] = { 0x03, 0x00, 0x00, 0x00, 0x01 };
+
+		Len = sim_mb_adu(Adu, SIM_MB_ADDR, Req, sizeof(Req));
+		Adu[Len - 1U] ^= 0x01U;
+		sim_mb_check("bad crc: dropped", (sim_mb_transact(Adu, Len) == USART_Rx_NoData) && (Sim_Reply_Len == 0U));
+	}
+	{
+		/* Pause after 3 bytes of 27.5 bit times: between t1.5 and t3.5. */
+		const uint8_t Req[] = { 0x03, 0x00, 0x00, 0x00, 0x01 };
+
+		Len = sim_mb_adu(Adu, SIM_MB_ADDR, Req, sizeof(Req));
+		Sim_Reply_Len = 0U;
+		(void)USART_Sim_Inject(SIM_MB_PORT, Adu, 3U);
+		USART_Sim_Run(sim_frame_ns(3U) + sim_gap_ns());
+		sim_mb_check("t1.5 gap: dropped", (sim_mb_transact(&Adu[3], Len - 3U) == USART_Rx_NoData) && (Sim_Reply_Len == 0U));
+	}
+	{
+		/* The slave must be back in sync for the next frame. */
+		const uint8_t Req[] = { 0x03, 0x00, 0x07, 0x00, 0x01 };
+		const uint8_t Rsp[] = { 0x03, 0x02, 0xBE, 0xEF };
+		sim_mb_case("resync after errors", SIM_MB_ADDR, Req, sizeof(Req), Rsp, sizeof(Rsp));
+	}
+
+	sim_mb_check("on_write callbacks", Sim_Write_Calls == 5U);
+
+	(void)USART_Modbus_GetStats(SIM_MB_PORT, &Stats);
+	sim_mb_check("stats", (Stats.Requests == 12U) && (Stats.Broadcasts == 1U) && (Stats.Exceptions == 3U) &&
+	                      (Stats.Crc_Errors == 1U) && (Stats.Gap_Errors == 1U) && (Stats.Ignored == 1U) &&
+	                      (Stats.Overruns == 0U));
+
+	printf("stats     : requests=%lu broadcasts=%lu exceptions=%lu crc_errors=%lu gap_errors=%lu overruns=%lu ignored=%lu\n",
+	       (unsigned long)Stats.Requests, (unsigned long)Stats.Broadcasts, (unsigned long)Stats.Exceptions,
+	       (unsigned long)Stats.Crc_Errors, (unsigned long)Stats.Gap_Errors, (unsigned long)Stats.Overruns,
+	       (unsigned long)Stats.Ignored);
+	printf("turnaround: slave min=%lu us max=%lu us, wire max=%lu us (t3.5 + slave + TX start)\n",
+	       (unsigned long)Stats.Turn_Min_Us, (unsigned long)Stats.Turn_Max_Us,
+	       (unsigned long)(Sim_Wire_Max_Ns / 1000U));
+}
+
+int main(void)
+{
+	USART_Sim_SetTickHook(sim_service_task);
+	USART_Sim_SetTxSink(SIM_MB_PORT, sim_mb_sink);
+
+	if((USART_Init(SIM_MB_PORT) != USART_InitSuccess) ||
+	   (USART_Modbus_Start(SIM_MB_PORT, SIM_MB_ADDR, Sim_Map, sizeof(Sim_Map) / sizeof(Sim_Map[0])) != USART_Ok))
+	{
+		printf("modbus: init failed\n");
+		return 1;
+	}
+
+	/* Initial t3.5 of silence before the first request. */
+	USART_Sim_Run(5000000U);
+
+	sim_mb_cases();
+
+	printf("modbus    : %s\n", (Sim_Failed == 0U) ? "PASS" : "FAIL");
+	return (Sim_Failed == 0U) ? 0 : 1;
+}
@@ -0,0 +1,418 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Sim_Ring.c
+ *  Author    : Ahmed
+ *  Created   : Mar 2, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Host stress test of the lock-free ring (MCAL/USART/USART_Ring.c), built with
+ *  "make ring" in Sim/. Unlike the other Sim programs it does not use the simulated
+ *  USART or RTOS: producer and consumer are real pthreads, so the ring runs with true
+ *  concurrency and the host's memory ordering.
+ *
+ *  Cases (each one a producer thread and a consumer thread on one ring):
+ *   - Put / Get       : one byte at a time
+ *   - Write / Read    : variable chunks, so copies split at the end of the storage
+ *   - Write / Peek    : consumer parses in place with Peek + Consume
+ *   - Reserve/Commit  : two producer threads sharing the ring through reservations;
+ *                       odd records reserve one byte too many and commit short;
+ *                       where the ring has room, the next record is reserved behind
+ *                       and committed first, so the consumer must step over the
+ *                       unwritten byte (Skips)
+ *
+ *  Every case runs on 1, 8 and 256 byte rings (Reserve/Commit skips 1: a record is
+ *  4 bytes) with the free-running Head / Tail
+ *  counters started just below 2^32, so they overflow during the run. The byte
+ *  stream is a function of its index, so a lost, duplicated or reordered byte shows
+ *  up as a mismatch. The run also checks that the fill level never exceeds the
+ *  capacity and that each side hit the full / empty edge at least once.
+ *
+ *  Exit code: 0 if every case passed, 1 otherwise.
+ * =========================================================================================
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "USART_Ring.h"
+
+#define SIM_RING_BYTES       (1UL << 21)    /* bytes per SPSC case */
+#define SIM_RING_RECORDS     (1UL << 17)    /* records per producer, Reserve/Commit */
+#define SIM_RING_REC_LEN     4U             /* producer id + 24-bit sequence */
+#define SIM_RING_PRODUCERS   2U
+#define SIM_RING_START       0xFFFFFF00UL   /* counters overflow after 256 bytes */
+#define SIM_RING_CHUNK_MAX   37U            /* not a power of two: splits vary */
+
+typedef enum
+{
+	SIM_RING_BYTE,
+	SIM_RING_CHUNK,
+	SIM_RING_PEEK,
+	SIM_RING_RESERVE
+} Sim_Ring_Mode_t;
+
+typedef struct
+{
+	USART_Ring_t    Ring;
+	uint32_t        Size;
+	Sim_Ring_Mode_t Mode;
+
+	/* Results: Full_Hits and Skips from the producer side, the rest from the consumer. */
+	uint32_t        Full_Hits;
+	uint32_t        Skips;
+	uint32_t        Empty_Hits;
+	uint32_t        Max_Count;
+	uint32_t        Errors;
+	uint32_t        Received;
+} Sim_Ring_Case_t;
+
+typedef struct
+{
+	Sim_Ring_Case_t *Case;
+	uint8_t          Id;
+} Sim_Ring_Producer_t;
+
+static uint8_t  Sim_Storage[256];
+static uint32_t Sim_Marks[USART_RING_MARK_WORDS(sizeof(Sim_Storage))];
+
+/* Byte N of the stream: consecutive bytes differ in a way a slip cannot reproduce. */
+static uint8_t sim_ring_byte(uint32_t N)
+{
+	return (uint8_t)((N * 0x9E3779B1UL) >> 24);
+}
+
+/* Small deterministic chunk lengths, one generator per thread. */
+static uint32_t sim_ring_len(uint32_t *Seed)
+{
+	*Seed = (*Seed * 1103515245UL) + 12345UL;
+	return 1U + ((*Seed >> 16) % SIM_RING_CHUNK_MAX);
+}
+
+/* =========================================================================================
+ *                                     SPSC Producer
+ * =========================================================================================
+ */
+static void *sim_ring_producer(void *Arg)
+{
+	Sim_Ring_Case_t *Case = (Sim_Ring_Case_t *)Arg;
+	uint8_t          Chunk[SIM_RING_CHUNK_MAX];
+	uint32_t         Seed = 1U;
+	uint32_t         Sent = 0;
+
+	while(Sent < SIM_RING_BYTES)
+	{
+		if(Case->Mode == SIM_RING_BYTE)
+		{
+			if(USART_Ring_Put(&Case->Ring, sim_ring_byte(Sent)) != 0U)
+			{
+				Sent++;
+			}
+			else
+			{
+				Case->Full_Hits++;
+				sched_yield();
+			}
+		}
+		else
+		{
+			uint32_t Len = sim_ring_len(&Seed);
+			uint32_t Done;
+			uint32_t i;
+
+			if(Len > (SIM_RING_BYTES - Sent))
+			{
+				Len = SIM_RING_BYTES - Sent;
+			}
+			for(i = 0; i < Len; i++)
+			{
+				Chunk[i] = sim_ring_byte(Sent + i);
+			}
+
+			/* A short write keeps the rest for the next round. */
+			Done = USART_Ring_Write(&Case->Ring, Chunk, Len);
+			Sent += Done;
+			if(Done < Len)
+			{
+				Case->Full_Hits++;
+				sched_yield();
+			}
+		}
+	}
+	return NULL;
+}
+
+/* =========================================================================================
+ *                                     SPSC Consumer
+ * =========================================================================================
+ */
+static void sim_ring_check(Sim_Ring_Case_t *Case, uint8_t Data)
+{
+	if(Data != sim_ring_byte(Case->Received))
+	{
+		if(Case->Errors == 0U)
+		{
+			printf("  byte %u: got 0x%02X, expected 0x%02X\n", (unsigned)Case->Received,
+			       Data, sim_ring_byte(Case->Received));
+		}
+		Case->Errors++;
+	}
+	Case->Received++;
+}
+
+static void *sim_ring_consumer(void *Arg)
+{
+	Sim_Ring_Case_t *Case = (Sim_Ring_Case_t *)Arg;
+	uint8_t          Chunk[SIM_RING_CHUNK_MAX];
+	uint32_t         Seed = 7U;
+
+	while(Case->Received < SIM_RING_BYTES)
+	{
+		uint32_t Count = USART_Ring_Count(&Case->Ring);
+		uint32_t Got   = 0;
+		uint32_t i;
+
+		Case->Max_Count = (Count > Case->Max_Count) ? Count : Case->Max_Count;
+
+		if(Case->Mode == SIM_RING_BYTE)
+		{
+			uint8_t Data;
+
+			if(USART_Ring_Get(&Case->Ring, &Data) != 0U)
+			{
+				sim_ring_check(Case, Data);
+				Got = 1U;
+			}
+		}
+		else if(Case->Mode == SIM_RING_CHUNK)
+		{
+			Got = USART_Ring_Read(&Case->Ring, Chunk, sim_ring_len(&Seed));
+			for(i = 0; i < Got; i++)
+			{
+				sim_ring_check(Case, Chunk[i]);
+			}
+		}
+		else
+		{
+			const uint8_t *Span;
+			uint32_t       Len = USART_Ring_Peek(&Case->Ring, &Span);
+			uint32_t       Want = sim_ring_len(&Seed);
+
+			/* Consume part of the span only, so the next Peek starts mid-storage. */
+			Got = (Len < Want) ? Len : Want;
+			for(i = 0; i < Got; i++)
+			{
+				sim_ring_check(Case, Span[i]);
+			}
+			(void)USART_Ring_Consume(&Case->Ring, Got);
+		}
+
+		if(Got == 0U)
+		{
+			Case->Empty_Hits++;
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+/* =========================================================================================
+ *                              Multi-Producer (Reserve/Commit)
+ * =========================================================================================
+ */
+static void *sim_ring_mp_producer(void *Arg)
+{
+	Sim_Ring_Producer_t *Prod = (Sim_Ring_Producer_t *)Arg;
+	Sim_Ring_Case_t     *Case = Prod->Case;
+	uint32_t             Seq  = 0;
+
+	while(Seq < SIM_RING_RECORDS)
+	{
+		uint8_t  Rec[SIM_RING_REC_LEN] = { Prod->Id, (uint8_t)Seq, (uint8_t)(Seq >> 8), (uint8_t)(Seq >> 16) };
+		uint8_t  Rec2[SIM_RING_REC_LEN] = { Prod->Id, (uint8_t)(Seq + 1U), (uint8_t)((Seq + 1U) >> 8), (uint8_t)((Seq + 1U) >> 16) };
+		uint32_t Len = SIM_RING_REC_LEN + (Seq & 1U);
+		uint32_t Pos;
+		uint32_t Pos2;
+
+		if(USART_Ring_Reserve(&Case->Ring, Len, &Pos) == 0U)
+		{
+			/* Both producers count here; only the total matters. */
+			__sync_fetch_and_add(&Case->Full_Hits, 1U);
+			sched_yield();
+			continue;
+		}
+		USART_Ring_Fill(&Case->Ring, Pos, Rec, SIM_RING_REC_LEN);
+
+		/*
+		 * Odd records: if the next one fits right behind, reserve it too. It pins the
+		 * spare byte, and is committed first, so both go out in one deferred publish.
+		 */
+		if((Len > SIM_RING_REC_LEN) && ((Seq + 1U) < SIM_RING_RECORDS) &&
+		   USART_Ring_Reserve(&Case->Ring, SIM_RING_REC_LEN, &Pos2))
+		{
+			USART_Ring_Fill(&Case->Ring, Pos2, Rec2, SIM_RING_REC_LEN);
+			USART_Ring_Commit(&Case->Ring, Pos2, SIM_RING_REC_LEN, SIM_RING_REC_LEN);
+			Seq++;
+		}
+
+		/* The spare byte is given back if this is still the newest range, else skipped. */
+		if(USART_Ring_Shrink(&Case->Ring, Pos, Len, SIM_RING_REC_LEN))
+		{
+			Len = SIM_RING_REC_LEN;
+		}
+		else if(Len > SIM_RING_REC_LEN)
+		{
+			__sync_fetch_and_add(&Case->Skips, 1U);
+		}
+
+		/* Never waits: an early commit is published by the other producer's. */
+		USART_Ring_Commit(&Case->Ring, Pos, Len, SIM_RING_REC_LEN);
+		Seq++;
+	}
+	return NULL;
+}
+
+static void *sim_ring_mp_consumer(void *Arg)
+{
+	Sim_Ring_Case_t *Case = (Sim_Ring_Case_t *)Arg;
+	uint32_t         Next[SIM_RING_PRODUCERS] = { 0 };
+	uint32_t         Total = SIM_RING_RECORDS * SIM_RING_PRODUCERS;
+
+	while(Case->Received < Total)
+	{
+		uint32_t Count = USART_Ring_Count(&Case->Ring);
+		uint8_t  Rec[SIM_RING_REC_LEN];
+		uint32_t Got = 0;
+
+		Case->Max_Count = (Count > Case->Max_Count) ? Count : Case->Max_Count;
+
+		/* Get steps over skipped bytes; Count and Read would not. */
+		while((Got < SIM_RING_REC_LEN) && USART_Ring_Get(&Case->Ring, &Rec[Got]))
+		{
+			Got++;
+		}
+
+		/* Commits are whole records, so a partial one is never visible. */
+		if(Got < SIM_RING_REC_LEN)
+		{
+			Case->Errors += (Got != 0U) ? 1U : 0U;
+			Case->Empty_Hits++;
+			sched_yield();
+			continue;
+		}
+
+		uint32_t Seq = (uint32_t)Rec[1] | ((uint32_t)Rec[2] << 8) | ((uint32_t)Rec[3] << 16);
+
+		if((Rec[0] >= SIM_RING_PRODUCERS) || (Seq != Next[Rec[0]]))
+		{
+			if(Case->Errors == 0U)
+			{
+				printf("  record %u: producer %u seq %u\n", (unsigned)Case->Received,
+				       (unsigned)Rec[0], (unsigned)Seq);
+			}
+			Case->Errors++;
+		}
+		else
+		{
+			Next[Rec[0]]++;
+		}
+		Case->Received++;
+	}
+
+	/* A skipped byte may still follow the last record: the ring must end up empty. */
+	{
+		uint8_t Extra;
+
+		Case->Errors += USART_Ring_Get(&Case->Ring, &Extra);
+	}
+	return NULL;
+}
+
+/* =========================================================================================
+ *                                        Runner
+ * =========================================================================================
+ */
+static uint8_t sim_ring_run(Sim_Ring_Mode_t Mode, uint32_t Size)
+{
+	static const char * const Name[] = { "put/get", "write/read", "write/peek", "reserve" };
+	Sim_Ring_Case_t     Case;
+	Sim_Ring_Producer_t Prod[SIM_RING_PRODUCERS];
+	pthread_t           Prod_Th[SIM_RING_PRODUCERS];
+	pthread_t           Cons_Th;
+	uint32_t            Expect;
+	uint32_t            i;
+	uint8_t             Ok;
+
+	memset(&Case, 0, sizeof(Case));
+	memset(Sim_Storage, 0, sizeof(Sim_Storage));
+	Case.Size = Size;
+	Case.Mode = Mode;
+	(void)USART_Ring_InitMp(&Case.Ring, Sim_Storage, Size, Sim_Marks);
+
+	/* Empty ring whose counters overflow a few laps in. */
+	Case.Ring.Head    = SIM_RING_START;
+	Case.Ring.Tail    = SIM_RING_START;
+	Case.Ring.Reserve = SIM_RING_START;
+
+	if(Mode == SIM_RING_RESERVE)
+	{
+		Expect = SIM_RING_RECORDS * SIM_RING_PRODUCERS;
+		pthread_create(&Cons_Th, NULL, sim_ring_mp_consumer, &Case);
+		for(i = 0; i < SIM_RING_PRODUCERS; i++)
+		{
+			Prod[i].Case = &Case;
+			Prod[i].Id   = (uint8_t)i;
+			pthread_create(&Prod_Th[i], NULL, sim_ring_mp_producer, &Prod[i]);
+		}
+		for(i = 0; i < SIM_RING_PRODUCERS; i++)
+		{
+			pthread_join(Prod_Th[i], NULL);
+		}
+	}
+	else
+	{
+		Expect = SIM_RING_BYTES;
+		pthread_create(&Cons_Th, NULL, sim_ring_consumer, &Case);
+		pthread_create(&Prod_Th[0], NULL, sim_ring_producer, &Case);
+		pthread_join(Prod_Th[0], NULL);
+	}
+	pthread_join(Cons_Th, NULL);
+
+	Ok = (Case.Errors == 0U) && (Case.Received == Expect) && (Case.Max_Count <= Size) &&
+	     (Case.Full_Hits != 0U) && (Case.Empty_Hits != 0U) && (USART_Ring_Count(&Case.Ring) == 0U) &&
+	     ((Mode != SIM_RING_RESERVE) || (Size <= (2U * SIM_RING_REC_LEN)) || (Case.Skips != 0U));
+
+	printf("%-10s : %s, ring %3u, %u %s, max fill %u, full %u, empty %u, skips %u, errors %u\n",
+	       Name[Mode], Ok ? "ok" : "FAILED", (unsigned)Size, (unsigned)Case.Received,
+	       (Mode == SIM_RING_RESERVE) ? "records" : "bytes", (unsigned)Case.Max_Count,
+	       (unsigned)Case.Full_Hits, (unsigned)Case.Empty_Hits, (unsigned)Case.Skips,
+	       (unsigned)Case.Errors);
+	return Ok;
+}
+
+int main(void)
+{
+	static const uint32_t Sizes[] = { 1U, 8U, 256U };
+	uint8_t  Ok = 1U;
+	uint32_t Mode;
+	uint32_t i;
+
+	for(Mode = SIM_RING_BYTE; Mode <= SIM_RING_RESERVE; Mode++)
+	{
+		for(i = 0; i < (sizeof(Sizes) / sizeof(Sizes[0])); i++)
+		{
+			/* A 1-byte ring cannot hold a record. */
+			if((Mode == SIM_RING_RESERVE) && (Sizes[i] < SIM_RING_REC_LEN))
+			{
+				continue;
+			}
+			Ok &= sim_ring_run((Sim_Ring_Mode_t)Mode, Sizes[i]);
+		}
+	}
+
+	printf("ring      : %s\n", Ok ? "PASS" : "FAIL");
+	return Ok ? 0 : 1;
+}
@@ -0,0 +1,363 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Sim_Rtos.c
+ *  Author    : Ahmed
+ *  Created   : Feb 2, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Deterministic single-task kernel behind the FreeRTOS shim headers (Sim/Inc).
+ *
+ *  Blocking calls advance the simulated hardware (USART_Sim_Step) until they are
+ *  satisfied or their timeout expires, so a run is fully reproducible: the same
+ *  program always produces the same byte timings, drops and statistics.
+ *
+ *  A wait with portMAX_DELAY that nothing can satisfy would spin forever; it is
+ *  reported as a deadlock after SIM_MAX_BLOCK_TICKS of simulated time instead.
+ * =========================================================================================
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "USART_Sim.h"
+
+#define SIM_NS_PER_TICK        (1000000000ULL / configTICK_RATE_HZ)
+#define SIM_MAX_BLOCK_TICKS    60000ULL    /* 60 s of simulated time */
+
+#define SIM_NOTIFY_IDLE        0U
+#define SIM_NOTIFY_PENDING     1U
+
+static StaticTask_t Sim_Main_Task = { .Name = "main" };
+
+/* =========================================================================================
+ *                                   Internal Helpers
+ * =========================================================================================
+ */
+static TickType_t sim_ticks(void)
+{
+	return (TickType_t)(USART_Sim_TimeNs() / SIM_NS_PER_TICK);
+}
+
+/*
+ * sim_block():
+ *  - Advance simulated time until *Flag becomes non-zero or Ticks tick boundaries
+ *    have passed (FreeRTOS semantics: the wait ends on a tick interrupt).
+ */
+static void sim_block(volatile uint8_t *Flag, TickType_t Ticks)
+{
+	uint64_t Deadline;
+
+	if(Ticks == portMAX_DELAY)
+	{
+		Deadline = (sim_ticks() + SIM_MAX_BLOCK_TICKS) * SIM_NS_PER_TICK;
+	}
+	else
+	{
+		Deadline = ((uint64_t)sim_ticks() + Ticks) * SIM_NS_PER_TICK;
+	}
+
+	while((*Flag == 0U) && (USART_Sim_Step(Deadline) != 0U))
+	{
+	}
+
+	if((*Flag == 0U) && (Ticks == portMAX_DELAY))
+	{
+		fprintf(stderr, "[sim] deadlock: wait forever with nothing left to wake the task\n");
+		abort();
+	}
+}
+
+void vAssertCalled(const char *File, int Line)
+{
+	fprintf(stderr, "[sim] configASSERT failed at %s:%d\n", File, Line);
+	abort();
+}
+
+/* =========================================================================================
+ *                                       Scheduler
+ * =========================================================================================
+ */
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+	return &Sim_Main_Task;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+	return sim_ticks();
+}
+
+TickType_t xTaskGetTickCountFromISR(void)
+{
+	return sim_ticks();
+}
+
+void vTaskDelay(TickType_t xTicksToDelay)
+{
+	static volatile uint8_t Never = 0;
+
+	if(xTicksToDelay != 0U)
+	{
+		sim_block(&Never, xTicksToDelay);
+	}
+}
+
+void vTaskSuspendAll(void)
+{
+}
+
+BaseType_t xTaskResumeAll(void)
+{
+	return pdFALSE;
+}
+
+BaseType_t xTaskGetSchedulerState(void)
+{
+	return taskSCHEDULER_RUNNING;
+}
+
+/* =========================================================================================
+ *                                        Timeouts
+ * =========================================================================================
+ */
+void vTaskSetTimeOutState(TimeOut_t *pxTimeOut)
+{
+	pxTimeOut->Time_On_Entering = sim_ticks();
+}
+
+BaseType_t xTaskCheckForTimeOut(TimeOut_t *pxTimeOut, TickType_t *pxTicksToWait)
+{
+	BaseType_t Timed_Out = pdFALSE;
+	TickType_t Now       = sim_ticks();
+	TickType_t Elapsed   = Now - pxTimeOut->Time_On_Entering;
+
+	if(*pxTicksToWait == portMAX_DELAY)
+	{
+		Timed_Out = pdFALSE;
+	}
+	else if(Elapsed < *pxTicksToWait)
+	{
+		*pxTicksToWait -= Elapsed;
+		pxTimeOut->Time_On_Entering = Now;
+	}
+	else
+	{
+		*pxTicksToWait = 0;
+		Timed_Out = pdTRUE;
+	}
+	return Timed_Out;
+}
+
+/* =========================================================================================
+ *                                     Notifications
+ * =========================================================================================
+ */
+BaseType_t xTaskGenericNotify(TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue)
+{
+	BaseType_t Ret = pdPASS;
+
+	configASSERT(xTaskToNotify != NULL);
+	configASSERT(uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES);
+
+	if(pulPreviousNotificationValue != NULL)
+	{
+		*pulPreviousNotificationValue = xTaskToNotify->Notify_Value[uxIndexToNotify];
+	}
+
+	switch(eAction)
+	{
+	case eSetBits:
+		xTaskToNotify->Notify_Value[uxIndexToNotify] |= ulValue;
+		break;
+	case eIncrement:
+		xTaskToNotify->Notify_Value[uxIndexToNotify]++;
+		break;
+	case eSetValueWithOverwrite:
+		xTaskToNotify->Notify_Value[uxIndexToNotify] = ulValue;
+		break;
+	case eSetValueWithoutOverwrite:
+		if(xTaskToNotify->Notify_State[uxIndexToNotify] == SIM_NOTIFY_PENDING)
+		{
+			Ret = pdFAIL;
+		}
+		else
+		{
+			xTaskToNotify->Notify_Value[uxIndexToNotify] = ulValue;
+		}
+		break;
+	default:
+		break;
+	}
+
+	if(Ret == pdPASS)
+	{
+		xTaskToNotify->Notify_State[uxIndexToNotify] = SIM_NOTIFY_PENDING;
+	}
+	return Ret;
+}
+
+uint32_t ulTaskGenericNotifyTake(UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+	StaticTask_t *Task = &Sim_Main_Task;
+	uint32_t      Value;
+
+	configASSERT(uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES);
+
+	if((Task->Notify_Value[uxIndexToWaitOn] == 0U) && (xTicksToWait != 0U))
+	{
+		/* Any give/notify marks the index pending and ends the wait. */
+		Task->Notify_State[uxIndexToWaitOn] = SIM_NOTIFY_IDLE;
+		sim_block(&Task->Notify_State[uxIndexToWaitOn], xTicksToWait);
+	}
+
+	Value = Task->Notify_Value[uxIndexToWaitOn];
+	if(Value != 0U)
+	{
+		Task->Notify_Value[uxIndexToWaitOn] = (xClearCountOnExit != pdFALSE) ? 0U : (Value - 1U);
+	}
+	Task->Notify_State[uxIndexToWaitOn] = SIM_NOTIFY_IDLE;
+	return Value;
+}
+
+BaseType_t xTaskGenericNotifyWait(UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait)
+{
+	StaticTask_t *Task = &Sim_Main_Task;
+	BaseType_t    Ret  = pdFALSE;
+
+	configASSERT(uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES);
+
+	if(Task->Notify_State[uxIndexToWaitOn] != SIM_NOTIFY_PENDING)
+	{
+		Task->Notify_Value[uxIndexToWaitOn] &= ~ulBitsToClearOnEntry;
+		if(xTicksToWait != 0U)
+		{
+			sim_block(&Task->Notify_State[uxIndexToWaitOn], xTicksToWait);
+		}
+	}
+
+	if(pulNotificationValue != NULL)
+	{
+		*pulNotificationValue = Task->Notify_Value[uxIndexToWaitOn];
+	}
+	if(Task->Notify_State[uxIndexToWaitOn] == SIM_NOTIFY_PENDING)
+	{
+		Task->Notify_Value[uxIndexToWaitOn] &= ~ulBitsToClearOnExit;
+		Ret = pdTRUE;
+	}
+	Task->Notify_State[uxIndexToWaitOn] = SIM_NOTIFY_IDLE;
+	return Ret;
+}
+
+/* =========================================================================================
+ *                                         Queues
+ * =========================================================================================
+ */
+static void sim_queue_init(StaticQueue_t *Queue, uint8_t *Storage, UBaseType_t Length, UBaseType_t Item_Size)
+{
+	Queue->Storage   = Storage;
+	Queue->Length    = Length;
+	Queue->Item_Size = Item_Size;
+	Queue->Count     = 0;
+	Queue->Head      = 0;
+	Queue->Tail      = 0;
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t uxQueueLength, UBaseType_t uxItemSize)
+{
+	StaticQueue_t *Queue = NULL;
+	uint8_t       *Storage;
+
+	if((uxQueueLength != 0U) && (uxItemSize != 0U))
+	{
+		Queue   = malloc(sizeof(StaticQueue_t));
+		Storage = malloc(uxQueueLength * uxItemSize);
+
+		if((Queue == NULL) || (Storage == NULL))
+		{
+			free(Queue);
+			free(Storage);
+			Queue = NULL;
+		}
+		else
+		{
+			sim_queue_init(Queue, Storage, uxQueueLength, uxItemSize);
+			Queue->Dynamic = 1;
+		}
+	}
+	return Queue;
+}
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t uxQueueLength, UBaseType_t uxItemSize, uint8_t *pucQueueStorage, StaticQueue_t *pxStaticQueue)
+{
+	StaticQueue_t *Queue = NULL;
+
+	if((uxQueueLength != 0U) && (uxItemSize != 0U) && (pucQueueStorage != NULL) && (pxStaticQueue != NULL))
+	{
+		Queue = pxStaticQueue;
+		sim_queue_init(Queue, pucQueueStorage, uxQueueLength, uxItemSize);
+		Queue->Dynamic = 0;
+	}
+	return Queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait)
+{
+	BaseType_t Ret = errQUEUE_FULL;
+
+	/* Blocking queue access is never used by the driver. */
+	configASSERT(xTicksToWait == 0U);
+
+	if(xQueue->Count < xQueue->Length)
+	{
+		memcpy(&xQueue->Storage[xQueue->Head * xQueue->Item_Size], pvItemToQueue, xQueue->Item_Size);
+		xQueue->Head = (xQueue->Head + 1U) % xQueue->Length;
+		xQueue->Count++;
+		Ret = pdPASS;
+	}
+	return Ret;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait)
+{
+	BaseType_t Ret = errQUEUE_EMPTY;
+
+	configASSERT(xTicksToWait == 0U);
+
+	if(xQueue->Count != 0U)
+	{
+		memcpy(pvBuffer, &xQueue->Storage[xQueue->Tail * xQueue->Item_Size], xQueue->Item_Size);
+		xQueue->Tail = (xQueue->Tail + 1U) % xQueue->Length;
+		xQueue->Count--;
+		Ret = pdPASS;
+	}
+	return Ret;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t xQueue, const void *pvItemToQueue, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	(void)pxHigherPriorityTaskWoken;
+	return xQueueSend(xQueue, pvItemToQueue, 0);
+}
+
+BaseType_t xQueueReceiveFromISR(QueueHandle_t xQueue, void *pvBuffer, BaseType_t *pxHigherPriorityTaskWoken)
+{
+	(void)pxHigherPriorityTaskWoken;
+	return xQueueReceive(xQueue, pvBuffer, 0);
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t xQueue)
+{
+	return xQueue->Count;
+}
+
+UBaseType_t uxQueueMessagesWaitingFromISR(QueueHandle_t xQueue)
+{
+	return xQueue->Count;
+}
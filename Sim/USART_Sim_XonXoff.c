@@ -0,0 +1,200 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Sim_XonXoff.c
+ *  Author    : Ahmed
+ *  Created   : Mar 8, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Host test of XON/XOFF software flow control between two driver ports, built and
+ *  run with "make xonxoff" in Sim/ (which sets the DEFS below in its own BUILD dir).
+ *
+ *  USART1 and USART2 are cross-wired with USART_Sim_Connect(), so both ends of the
+ *  link run the real driver: the XOFF/XON one port sends are interpreted by the other.
+ *  Each case pushes SIM_XO_LEN bytes as fast as the TX buffer takes them, while the
+ *  reader drains only SIM_XO_READ_LEN bytes every SIM_XO_READ_MS ms, well below the
+ *  line rate. Without flow control the RX buffer would overflow within a few ms.
+ *
+ *    1) one way   : USART2 -> USART1 (small RX buffer, tight watermarks)
+ *    2) both ways : each port sends to the other and reads slowly, so XOFF/XON must
+ *                   also get out while the port's own TX is paused by the peer.
+ *
+ *  Checks per receiving port: every byte arrives, in order; no RX buffer-full drop,
+ *  no overrun (driver and line counters); the RX high-water mark reached the XOFF
+ *  watermark (throttling happened) but never the buffer size.
+ *  Exit code: 0 if every case passed, 1 otherwise.
+ * =========================================================================================
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "USART.h"
+#include "USART_Prv.h"
+#include "USART_Cfg.h"
+#include "USART_Sim.h"
+
+#if (USART_XON_XOFF != ENABLE)
+#error "USART_Sim_XonXoff.c needs USART_XON_XOFF == ENABLE (build it with make xonxoff)"
+#endif
+
+#define SIM_XO_LEN        4096U
+#define SIM_XO_READ_LEN   8U
+#define SIM_XO_READ_MS    2U
+#define SIM_XO_LIMIT_MS   5000U
+
+typedef struct
+{
+	USART_Num_t USART_Num;
+	uint32_t    Sent;       /* Bytes of the pattern accepted by the TX buffer */
+	uint32_t    Got;        /* Bytes of the pattern read back by the peer     */
+	uint32_t    Bad;        /* Bytes read back that do not match the pattern  */
+} Sim_Xo_Dir_t;
+
+static uint32_t Sim_Failed;
+
+static void sim_service_task(void)
+{
+	USART_RxCyclic();
+	USART_TxCyclic();
+}
+
+/* Printable pattern, never XON (0x11) or XOFF (0x13). Seed tells the ports apart. */
+static uint8_t sim_xo_byte(uint32_t Seed, uint32_t Idx)
+{
+	return (uint8_t)(0x21U + ((Idx * 7U + Seed) % 94U));
+}
+
+static void sim_xo_check(const char *Name, uint8_t Ok)
+{
+	printf("%-34s: %s\n", Name, Ok ? "ok" : "FAIL");
+	if(!Ok)
+	{
+		Sim_Failed++;
+	}
+}
+
+static void sim_xo_fill(Sim_Xo_Dir_t *Dir, uint32_t Seed)
+{
+	while((Dir->Sent < SIM_XO_LEN) &&
+	      (USART_SendByte(Dir->USART_Num, sim_xo_byte(Seed, Dir->Sent)) == USART_Tx_Ok))
+	{
+		Dir->Sent++;
+	}
+}
+
+static void sim_xo_read(USART_Num_t USART_Num, Sim_Xo_Dir_t *Dir, uint32_t Seed)
+{
+	uint8_t  Buf[SIM_XO_READ_LEN];
+	uint32_t Len = 0U;
+	uint32_t i;
+
+	if(USART_Receive(USART_Num, Buf, sizeof(Buf), USART_NO_WAIT, &Len) == USART_Rx_Ok)
+	{
+		for(i = 0U; i < Len; i++)
+		{
+			if(Buf[i] != sim_xo_byte(Seed, Dir->Got))
+			{
+				Dir->Bad++;
+			}
+			Dir->Got++;
+		}
+	}
+}
+
+/* Checks for the port that received Dir's stream. */
+static void sim_xo_report(const char *Case, USART_Num_t USART_Num, const Sim_Xo_Dir_t *Dir)
+{
+	USART_Stats_t    Stats;
+	USART_Sim_Line_t Line;
+	char             Name[48];
+
+	(void)USART_GetStats(USART_Num, &Stats);
+	USART_Sim_GetLine(USART_Num, &Line);
+
+	printf("%s: USART%u rx=%lu/%u bad=%lu drops=%lu overrun=%lu/%lu high_water=%lu/%lu (xoff at %lu)\n",
+	       Case, (unsigned)USART_Num + 1U, (unsigned long)Dir->Got, SIM_XO_LEN, (unsigned long)Dir->Bad,
+	       (unsigned long)Stats.Rx_Drops, (unsigned long)Stats.Overrun, (unsigned long)Line.Rx_Overrun,
+	       (unsigned long)Stats.Rx_High_Water, (unsigned long)USART_Config[USART_Num].Rx_Buff_Size,
+	       (unsigned long)USART_Config[USART_Num].Xoff_High_Water);
+
+	(void)snprintf(Name, sizeof(Name), "%s: USART%u no lost bytes", Case, (unsigned)USART_Num + 1U);
+	sim_xo_check(Name, (Dir->Got == SIM_XO_LEN) && (Dir->Bad == 0U));
+	(void)snprintf(Name, sizeof(Name), "%s: USART%u no RX overflow", Case, (unsigned)USART_Num + 1U);
+	sim_xo_check(Name, (Stats.Rx_Drops == 0U) && (Stats.Overrun == 0U) && (Line.Rx_Overrun == 0U) &&
+	                   (Stats.Rx_High_Water < USART_Config[USART_Num].Rx_Buff_Size));
+	(void)snprintf(Name, sizeof(Name), "%s: USART%u throttled", Case, (unsigned)USART_Num + 1U);
+	sim_xo_check(Name, Stats.Rx_High_Water >= USART_Config[USART_Num].Xoff_High_Water);
+}
+
+/*
+ * Run one case: To_1 carries USART2 -> USART1, To_2 (if not NULL) USART1 -> USART2.
+ * Both sides are serviced in 1 ms steps until every stream is read back.
+ */
+static void sim_xo_case(const char *Case, Sim_Xo_Dir_t *To_1, Sim_Xo_Dir_t *To_2)
+{
+	uint32_t Ms = 0U;
+
+	(void)USART_ResetStats(USART_NUM_1);
+	(void)USART_ResetStats(USART_NUM_2);
+	USART_Sim_ResetLine(USART_NUM_1);
+	USART_Sim_ResetLine(USART_NUM_2);
+
+	while(((To_1->Got < SIM_XO_LEN) || ((To_2 != NULL) && (To_2->Got < SIM_XO_LEN))) &&
+	      (Ms < SIM_XO_LIMIT_MS))
+	{
+		sim_xo_fill(To_1, 1U);
+		if(To_2 != NULL)
+		{
+			sim_xo_fill(To_2, 2U);
+		}
+
+		USART_Sim_Run(1000000U);
+		Ms++;
+
+		if((Ms % SIM_XO_READ_MS) == 0U)
+		{
+			sim_xo_read(USART_NUM_1, To_1, 1U);
+			if(To_2 != NULL)
+			{
+				sim_xo_read(USART_NUM_2, To_2, 2U);
+			}
+		}
+	}
+
+	printf("%s: %lu ms\n", Case, (unsigned long)Ms);
+	sim_xo_report(Case, USART_NUM_1, To_1);
+	if(To_2 != NULL)
+	{
+		sim_xo_report(Case, USART_NUM_2, To_2);
+	}
+}
+
+int main(void)
+{
+	Sim_Xo_Dir_t To_1 = { USART_NUM_2, 0U, 0U, 0U };
+	Sim_Xo_Dir_t To_2 = { USART_NUM_1, 0U, 0U, 0U };
+
+	USART_Sim_SetTickHook(sim_service_task);
+	USART_Sim_Connect(USART_NUM_1, USART_NUM_2);
+
+	if((USART_Init(USART_NUM_1) != USART_InitSuccess) || (USART_Init(USART_NUM_2) != USART_InitSuccess))
+	{
+		printf("xonxoff: init failed\n");
+		return 1;
+	}
+
+	sim_xo_case("one way", &To_1, NULL);
+
+	To_1.Sent = 0U;
+	To_1.Got  = 0U;
+	To_1.Bad  = 0U;
+	sim_xo_case("both ways", &To_1, &To_2);
+
+	printf("xonxoff   : %s\n", (Sim_Failed == 0U) ? "PASS" : "FAIL");
+	return (Sim_Failed == 0U) ? 0 : 1;
+}
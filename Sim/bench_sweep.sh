@@ -0,0 +1,60 @@
+#!/bin/sh
+# =========================================================================================
+#  File      : bench_sweep.sh
+#  Author    : Ahmed
+#  Created   : Feb 9, 2026
+#
+#  Description:
+#  ------------
+#  Runs the USART benchmark suite on the host simulation for every combination of
+#  driver mode x baud rate x buffer size, one build per combination (-D overrides of
+#  USART_Cfg.h, see Makefile DEFS). All BENCH lines go to stdout and to
+#  bench_results.txt; each run starts with its own BENCH,config record.
+#
+#  A configuration that loses data (BENCH,done,ok=0, e.g. polled RX faster than
+#  the 1 ms service period can keep up with) is a result, not an error: it is
+#  listed at the end. The script only fails if a build fails.
+#
+#    ./bench_sweep.sh
+#    MODES="it fast" BAUDS="115200" BUFFS="256" ./bench_sweep.sh
+# =========================================================================================
+
+set -e
+cd "$(dirname "$0")"
+
+MODES=${MODES:-"poll it fast queue"}
+BAUDS=${BAUDS:-"9600 115200 921600"}
+BUFFS=${BUFFS:-"64 256 1024"}
+OUT=${OUT:-bench_results.txt}
+
+mode_defs()
+{
+	case "$1" in
+	poll)  echo "-DUSART_RX_INT=DISABLE -DUSART_TX_INT=DISABLE" ;;
+	it)    echo "-DUSART_RX_INT=ENABLE -DUSART_TX_INT=ENABLE" ;;
+	fast)  echo "-DUSART_RX_INT=ENABLE -DUSART_TX_INT=ENABLE -DUSART_FAST_ISR=ENABLE" ;;
+	queue) echo "-DUSART_RX_INT=ENABLE -DUSART_TX_INT=ENABLE -DUSART_BUFF_BACKEND=USART_BUFF_QUEUE" ;;
+	*)     echo "unknown mode: $1" >&2; exit 1 ;;
+	esac
+}
+
+: > "$OUT"
+Lossy=""
+
+for Mode in $MODES; do
+	for Baud in $BAUDS; do
+		for Buff in $BUFFS; do
+			Tag="$Mode-$Baud-$Buff"
+			Defs="$(mode_defs "$Mode") -DUSART2_BAUDRATE=${Baud}U -DUSART2_TX_BUFF_SIZE=${Buff}U -DUSART2_RX_BUFF_SIZE=${Buff}U"
+
+			make -s BUILD="build/sweep/$Tag" BENCH="build/sweep/$Tag/usart_bench" DEFS="$Defs" bench
+			if ! "build/sweep/$Tag/usart_bench" > "build/sweep/$Tag/result.txt"; then
+				Lossy="$Lossy $Tag"
+			fi
+			tee -a "$OUT" < "build/sweep/$Tag/result.txt"
+		done
+	done
+done
+
+echo "sweep done, results in $OUT"
+echo "configurations that lost data:${Lossy:- none}"
@@ -8,30 +8,61 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "USART.h"
+#include "USART_Prv.h"
+#include "USART_Cfg.h"
 #include "FreeRTOS.h"
 #include "task.h"
 #include "TASKS.h"
+#include "USART_Log.h"
+#include "USART_UsbBridge.h"
+#include "usb_host.h"
 
 
+/* USART_NUM_2 carries the application data (and loops back in the loopback setup). */
+_Static_assert(USART_LOG_PORT != USART_NUM_2, "USART_LOG_PORT must not be the data port USART_NUM_2");
+
+#if (USART_STDIO == ENABLE)
+/* printf() text would corrupt the data stream and the binary log frames alike. */
+_Static_assert(USART_STDIO_PORT != USART_NUM_2, "USART_STDIO_PORT must not be the data port USART_NUM_2");
+_Static_assert(USART_STDIO_PORT != USART_LOG_PORT, "USART_STDIO_PORT must not be USART_LOG_PORT");
+#endif
+
 void TASKS_Init(void)
 {
 	USART_Init(USART_NUM_2);
+	USART_Init(USART_LOG_PORT);
+#if (USART_STDIO == ENABLE)
+	USART_Init(USART_STDIO_PORT);
+#endif
 }
 
 void TASKS_Print_Usart_Rx_Msg(void *pram)
 {
-	uint8_t Rx_data = 0;
+	uint8_t  Rx_data[16];
+	uint32_t Rx_len = 0;
+	uint32_t events = 0;
+
+	/* Event-driven: sleep until the driver reports new RX data (no periodic polling). */
+	USART_SetEventTask(USART_NUM_2, xTaskGetCurrentTaskHandle());
+
 	while(1)
 	{
-		USART_Err_St_t ret_st = USART_ReceiveByte(USART_NUM_2, &Rx_data);
+		(void)xTaskNotifyWaitIndexed(USART_EVENT_NOTIFY_INDEX, 0, 0xFFFFFFFFU, &events, portMAX_DELAY);
 
-		if(ret_st == USART_Rx_Ok)
+		if((events & USART_EVT_RX(USART_NUM_2)) != 0U)
 		{
-			printf("Rx data : %c\n" , Rx_data);
+			while(USART_Receive(USART_NUM_2, Rx_data, sizeof(Rx_data), USART_NO_WAIT, &Rx_len) == USART_Rx_Ok)
+			{
+				for(uint32_t i = 0 ; i < Rx_len ; i++)
+				{
+					/* Deferred log: a few cycles here, formatting happens on the host. */
+					USART_LOG("Rx data : %c\n" , Rx_data[i]);
+				}
+			}
 		}
-		vTaskDelay(pdMS_TO_TICKS(2));
 	}
 }
 
@@ -39,24 +70,13 @@ void TASKS_Print_Usart_Rx_Msg(void *pram)
 void TASKS_Send_Data(void *pram)
 {
 	TickType_t last_wake = xTaskGetTickCount();
-	char * Tx = "Ahmed ";
+	const char * Tx = "Ahmed ";
 
 	while(1)
 	{
-		uint8_t i = 0 ;
-		while(Tx[i] != '\0')
-		{
-			if(USART_SendByte(USART_NUM_2, (uint8_t)Tx[i]) == USART_Tx_Ok)
-			{
-				i++;
-			}
-			else
-			{
-				vTaskDelay(pdMS_TO_TICKS(1));
-			}
-//			USART_SendByte(USART_NUM_2, (uint8_t)Tx[i]);
-//			i++;
-		}
+		/* Whole message in one call: blocks on a driver notification while TX is full. */
+		(void)USART_Send(USART_NUM_2, (const uint8_t *)Tx, strlen(Tx), USART_WAIT_FOREVER);
+
 		vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(5));
 	}
 }
@@ -82,3 +102,31 @@ void TASKS_USART_Tx_Cyclic(void *pram)
 		vTaskDelayUntil(&last_wake , pdMS_TO_TICKS(1));
 	}
 }
+
+/* Consumer of the deferred log (USART_Log.h): ships buffered records every 10 ms. */
+void TASKS_Log_Flush(void *pram)
+{
+	TickType_t last_wake = xTaskGetTickCount();
+	while(1)
+	{
+		(void)USART_Log_Flush(USART_WAIT_FOREVER);
+		vTaskDelayUntil(&last_wake , pdMS_TO_TICKS(10));
+	}
+}
+
+/* USB host: USBH_Process() woken by OTG_FS / application events, plus the CDC bridge. */
+void TASKS_Usb_Host(void *pram)
+{
+#if (USART_USB_BRIDGE == ENABLE)
+	(void)USART_UsbBridge_Start(USART_USB_BRIDGE_PORT);
+#endif
+
+	while(1)
+	{
+		MX_USB_HOST_Process();
+#if (USART_USB_BRIDGE == ENABLE)
+		USART_UsbBridge_Service();
+#endif
+		MX_USB_HOST_Wait();
+	}
+}
@@ -16,4 +16,6 @@ void TASKS_1s(void *pram);
 
 void TASKS_Send_Data(void *pram);
 void TASKS_USART_Tx_Cyclic(void *pram);
+void TASKS_Log_Flush(void *pram);
+void TASKS_Usb_Host(void *pram);
 #endif /* TASKS_H_ */
@@ -0,0 +1,400 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Bench.c
+ *  Author    : Ahmed
+ *  Created   : Feb 9, 2026
+ *
+ *  Description:
+ *  ------------
+ *  USART driver benchmark suite (see USART_Bench.h for the output format).
+ *
+ *  Records, in order:
+ *   1) config     : mode, buffer backend, baud rate, buffer sizes, cycle counter clock
+ *   2) throughput : USART_BENCH_BULK_LEN bytes streamed through the loopback, verified
+ *   3) cpu        : cycles per byte spent inside non-blocking USART_Send / USART_Receive
+ *   4) isr_idle   : interrupt activity with the port silent (baseline: SysTick, ...)
+ *   5) isr_load   : interrupt activity while one TX buffer worth of data loops back
+ *   6) latency    : USART_Send -> USART_Receive round trip percentiles for one byte
+ *   7) crc        : frame checksum cost per frame size, CRC unit vs software tables
+ *   8) stats      : driver statistics accumulated over the whole run
+ *   9) prof       : per probe point cycle profile (USART_PROFILE == ENABLE only)
+ *  10) done       : overall verdict
+ *
+ *  Integer arithmetic only: newlib-nano printf on target has no float support.
+ * =========================================================================================
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "USART.h"
+#include "USART_Prv.h"
+#include "USART_Cfg.h"
+#include "USART_Crc.h"
+#include "USART_Bench.h"
+
+static uint8_t  Bench_Tx[USART_BENCH_BULK_LEN];
+static uint8_t  Bench_Rx[USART_BENCH_BULK_LEN];
+static uint32_t Bench_Lat_Us[USART_BENCH_LAT_SAMPLES];
+
+/* =========================================================================================
+ *                                   Internal Helpers
+ * =========================================================================================
+ */
+static uint32_t bench_min(uint32_t A, uint32_t B)
+{
+	return (A < B) ? A : B;
+}
+
+/* Time on the wire for Bytes frames (8N1 = 10 bits), rounded up, plus two ticks of slack. */
+static uint32_t bench_wire_ms(USART_Num_t USART_Num, uint32_t Bytes)
+{
+	uint32_t Baud = USART_Config[USART_Num].BaudRate;
+
+	return (uint32_t)((((uint64_t)Bytes * 10000U) + Baud - 1U) / Baud) + 2U;
+}
+
+/* Largest Send() span that cannot overrun the RX side between two Receive() calls. */
+static uint32_t bench_chunk(USART_Num_t USART_Num)
+{
+	uint32_t Chunk = bench_min(USART_BENCH_CHUNK_MAX,
+	                           bench_min(USART_Config[USART_Num].Tx_Buff_Size, USART_Config[USART_Num].Rx_Buff_Size) / 2U);
+
+	return (Chunk == 0U) ? 1U : Chunk;
+}
+
+static void bench_drain(USART_Num_t USART_Num, uint32_t Timeout_Ms)
+{
+	uint32_t Len = 0;
+
+	while(USART_Receive(USART_Num, Bench_Rx, sizeof(Bench_Rx), Timeout_Ms, &Len) == USART_Rx_Ok)
+	{
+	}
+}
+
+static const char *bench_mode(uint8_t Dma, uint8_t Irq)
+{
+	return (Dma == ENABLE) ? "dma" : ((Irq == ENABLE) ? "it" : "poll");
+}
+
+static void bench_print_isr(const char *Record, const USART_Bench_Isr_t *Isr, uint32_t Bytes)
+{
+	uint32_t Mean = (Isr->Count != 0U) ? (uint32_t)(Isr->Total / Isr->Count) : 0U;
+	uint32_t Per_Byte_x10 = (Bytes != 0U) ? ((Isr->Count * 10U) / Bytes) : 0U;
+
+	printf("BENCH,%s,count=%lu,min_cycles=%lu,mean_cycles=%lu,max_cycles=%lu,bytes=%lu,irq_per_byte_x10=%lu\n",
+	       Record, (unsigned long)Isr->Count, (unsigned long)((Isr->Count != 0U) ? Isr->Min : 0U),
+	       (unsigned long)Mean, (unsigned long)Isr->Max, (unsigned long)Bytes, (unsigned long)Per_Byte_x10);
+}
+
+/* =========================================================================================
+ *                                       Records
+ * =========================================================================================
+ */
+static void bench_config(USART_Num_t USART_Num)
+{
+	printf("BENCH,config,port=%u,rx=%s,tx=%s,fast_isr=%u,backend=%s,baud=%lu,tx_buff=%lu,rx_buff=%lu,clock_hz=%lu\n",
+	       (unsigned)(USART_Num + 1U),
+	       bench_mode(USART_RX_DMA, USART_RX_INT), bench_mode(USART_TX_DMA, USART_TX_INT),
+	       (unsigned)(USART_FAST_ISR == ENABLE),
+	       (USART_BUFF_BACKEND == USART_BUFF_RING) ? "ring" : "queue",
+	       (unsigned long)USART_Config[USART_Num].BaudRate,
+	       (unsigned long)USART_Config[USART_Num].Tx_Buff_Size,
+	       (unsigned long)USART_Config[USART_Num].Rx_Buff_Size,
+	       (unsigned long)USART_Bench_CyclesHz());
+}
+
+/* Stream USART_BENCH_BULK_LEN bytes and verify order and content. */
+static uint8_t bench_throughput(USART_Num_t USART_Num)
+{
+	uint32_t Chunk = bench_chunk(USART_Num);
+	uint32_t Sent  = 0;
+	uint32_t Got   = 0;
+	uint32_t Len   = 0;
+	uint64_t Start = USART_Bench_NowNs();
+	uint64_t Elapsed;
+	uint32_t Rate;
+	uint8_t  Ok;
+
+	for(uint32_t i = 0; i < USART_BENCH_BULK_LEN; i++)
+	{
+		Bench_Tx[i] = (uint8_t)((i * 7U) + (i >> 8));
+	}
+
+	while(Got < USART_BENCH_BULK_LEN)
+	{
+		if(Sent < USART_BENCH_BULK_LEN)
+		{
+			uint32_t Span = bench_min(USART_BENCH_BULK_LEN - Sent, Chunk);
+
+			if(USART_Send(USART_Num, &Bench_Tx[Sent], Span, 1000) != USART_Tx_Ok)
+			{
+				break;
+			}
+			Sent += Span;
+		}
+
+		/* Drain without waiting while sending, wait for the tail afterwards. */
+		if(USART_Receive(USART_Num, &Bench_Rx[Got], USART_BENCH_BULK_LEN - Got,
+		                 (Sent < USART_BENCH_BULK_LEN) ? USART_NO_WAIT : (bench_wire_ms(USART_Num, Chunk) + 100U),
+		                 &Len) == USART_Rx_Ok)
+		{
+			Got += Len;
+		}
+		else if(Sent >= USART_BENCH_BULK_LEN)
+		{
+			break;
+		}
+	}
+
+	Elapsed = USART_Bench_NowNs() - Start;
+	Rate    = (Elapsed != 0U) ? (uint32_t)(((uint64_t)Got * 1000000000ULL) / Elapsed) : 0U;
+	Ok      = (Got == USART_BENCH_BULK_LEN) && (memcmp(Bench_Tx, Bench_Rx, USART_BENCH_BULK_LEN) == 0);
+
+	printf("BENCH,throughput,bytes=%lu,time_us=%lu,bytes_per_s=%lu,line_pct_x10=%lu,ok=%u\n",
+	       (unsigned long)Got, (unsigned long)(Elapsed / 1000U), (unsigned long)Rate,
+	       (unsigned long)(((uint64_t)Rate * 10000U) / USART_Config[USART_Num].BaudRate), (unsigned)Ok);
+	return Ok;
+}
+
+/*
+ * CPU cost of the API calls themselves: USART_NO_WAIT calls never block, so the
+ * cycles between entry and return are pure driver work (copy, locking, TX kick).
+ */
+static void bench_cpu(USART_Num_t USART_Num)
+{
+	uint32_t Chunk = bench_chunk(USART_Num);
+	uint32_t Send_Cycles = 0, Send_Bytes = 0;
+	uint32_t Recv_Cycles = 0, Recv_Bytes = 0;
+	uint32_t Len = 0;
+	uint32_t Start;
+
+	for(uint32_t Round = 0; Round < USART_BENCH_CPU_ROUNDS; Round++)
+	{
+		Start = USART_Bench_Cycles();
+		if(USART_Send(USART_Num, Bench_Tx, Chunk, USART_NO_WAIT) == USART_Tx_Ok)
+		{
+			Send_Cycles += USART_Bench_Cycles() - Start;
+			Send_Bytes  += Chunk;
+		}
+
+		vTaskDelay(pdMS_TO_TICKS(bench_wire_ms(USART_Num, Chunk)));
+
+		Start = USART_Bench_Cycles();
+		if(USART_Receive(USART_Num, Bench_Rx, Chunk, USART_NO_WAIT, &Len) == USART_Rx_Ok)
+		{
+			Recv_Cycles += USART_Bench_Cycles() - Start;
+			Recv_Bytes  += Len;
+		}
+
+		/* Polled TX may still be trickling out: flush before the next round. */
+		bench_drain(USART_Num, bench_wire_ms(USART_Num, Chunk) + Chunk);
+	}
+
+	printf("BENCH,cpu,chunk=%lu,send_cycles_per_byte_x10=%lu,recv_cycles_per_byte_x10=%lu\n",
+	       (unsigned long)Chunk,
+	       (unsigned long)((Send_Bytes != 0U) ? (uint32_t)(((uint64_t)Send_Cycles * 10U) / Send_Bytes) : 0U),
+	       (unsigned long)((Recv_Bytes != 0U) ? (uint32_t)(((uint64_t)Recv_Cycles * 10U) / Recv_Bytes) : 0U));
+}
+
+static void bench_isr(USART_Num_t USART_Num)
+{
+	USART_Bench_Isr_t Isr;
+	uint32_t Bytes = bench_min(USART_BENCH_BULK_LEN,
+	                           bench_min(USART_Config[USART_Num].Tx_Buff_Size, USART_Config[USART_Num].Rx_Buff_Size) / 2U);
+
+	USART_Bench_IsrProbe(USART_Num, 20U, &Isr);
+	bench_print_isr("isr_idle", &Isr, 0U);
+
+	/* The whole transfer fits both buffers: nothing needs to be read during the window. */
+	(void)USART_Send(USART_Num, Bench_Tx, Bytes, USART_NO_WAIT);
+	USART_Bench_IsrProbe(USART_Num, bench_wire_ms(USART_Num, Bytes) + 5U, &Isr);
+	bench_print_isr("isr_load", &Isr, Bytes);
+
+	bench_drain(USART_Num, bench_wire_ms(USART_Num, Bytes) + Bytes);
+}
+
+static uint8_t bench_latency(USART_Num_t USART_Num)
+{
+	uint32_t Samples = 0;
+	uint32_t Len;
+	uint8_t  Tx, Rx;
+	uint64_t Start;
+
+	for(uint32_t i = 0; i < USART_BENCH_LAT_SAMPLES; i++)
+	{
+		Tx    = (uint8_t)i;
+		Rx    = (uint8_t)~Tx;
+		Len   = 0;
+		Start = USART_Bench_NowNs();
+
+		(void)USART_Send(USART_Num, &Tx, 1, 100);
+		if((USART_Receive(USART_Num, &Rx, 1, bench_wire_ms(USART_Num, 1) + 100U, &Len) == USART_Rx_Ok) &&
+		   (Len == 1U) && (Rx == Tx))
+		{
+			Bench_Lat_Us[Samples++] = (uint32_t)((USART_Bench_NowNs() - Start) / 1000U);
+		}
+
+		/* Vary the start phase against the tick so polled modes show their spread. */
+		vTaskDelay(i % 3U);
+	}
+
+	/* Insertion sort: small N, no libc qsort on the target image. */
+	for(uint32_t i = 1; i < Samples; i++)
+	{
+		uint32_t Key = Bench_Lat_Us[i];
+		uint32_t j   = i;
+
+		while((j > 0U) && (Bench_Lat_Us[j - 1U] > Key))
+		{
+			Bench_Lat_Us[j] = Bench_Lat_Us[j - 1U];
+			j--;
+		}
+		Bench_Lat_Us[j] = Key;
+	}
+
+	if(Samples != 0U)
+	{
+		printf("BENCH,latency,samples=%lu,frame_us=%lu,p50_us=%lu,p90_us=%lu,p99_us=%lu,max_us=%lu\n",
+		       (unsigned long)Samples, (unsigned long)(10000000U / USART_Config[USART_Num].BaudRate),
+		       (unsigned long)Bench_Lat_Us[((Samples - 1U) * 50U) / 100U],
+		       (unsigned long)Bench_Lat_Us[((Samples - 1U) * 90U) / 100U],
+		       (unsigned long)Bench_Lat_Us[((Samples - 1U) * 99U) / 100U],
+		       (unsigned long)Bench_Lat_Us[Samples - 1U]);
+	}
+	else
+	{
+		printf("BENCH,latency,samples=0\n");
+	}
+	return (Samples == USART_BENCH_LAT_SAMPLES);
+}
+
+/*
+ * Cycles per byte of the frame checksums. crc32 is USART_Crc32(): the CRC unit when
+ * hw=1, the same software table as sw32 otherwise (host). ok: check values match and
+ * the CRC unit agrees with the software CRC-32.
+ */
+static uint8_t bench_crc(void)
+{
+	static const uint32_t Crc_Len[] = { 16U, 64U, 256U };
+	volatile uint32_t     Sink;
+	uint32_t              Sw16, Sw32, Crc32;
+	uint32_t              Start;
+	uint32_t              Bytes;
+	uint8_t               Ok;
+	uint8_t               All_Ok = 1U;
+
+	for(uint32_t i = 0; i < (sizeof(Crc_Len) / sizeof(Crc_Len[0])); i++)
+	{
+		Bytes = Crc_Len[i] * USART_BENCH_CPU_ROUNDS;
+
+		Start = USART_Bench_Cycles();
+		for(uint32_t Round = 0; Round < USART_BENCH_CPU_ROUNDS; Round++)
+		{
+			Sink = USART_Crc16(Bench_Tx, Crc_Len[i]);
+		}
+		Sw16 = USART_Bench_Cycles() - Start;
+
+		Start = USART_Bench_Cycles();
+		for(uint32_t Round = 0; Round < USART_BENCH_CPU_ROUNDS; Round++)
+		{
+			Sink = USART_Crc32Sw(Bench_Tx, Crc_Len[i]);
+		}
+		Sw32 = USART_Bench_Cycles() - Start;
+
+		Start = USART_Bench_Cycles();
+		for(uint32_t Round = 0; Round < USART_BENCH_CPU_ROUNDS; Round++)
+		{
+			Sink = USART_Crc32(Bench_Tx, Crc_Len[i]);
+		}
+		Crc32 = USART_Bench_Cycles() - Start;
+		(void)Sink;
+
+		Ok = (USART_Crc32(Bench_Tx, Crc_Len[i]) == USART_Crc32Sw(Bench_Tx, Crc_Len[i])) &&
+		     (USART_Crc32((const uint8_t *)"123456789", 9U) == 0x0376E6E7U) &&
+		     (USART_Crc16((const uint8_t *)"123456789", 9U) == 0x29B1U);
+		All_Ok &= Ok;
+
+		printf("BENCH,crc,len=%lu,hw=%u,sw16_cycles_per_byte_x10=%lu,sw32_cycles_per_byte_x10=%lu,crc32_cycles_per_byte_x10=%lu,ok=%u\n",
+		       (unsigned long)Crc_Len[i], (unsigned)(USART_CRC_HW == ENABLE),
+		       (unsigned long)(((uint64_t)Sw16 * 10U) / Bytes),
+		       (unsigned long)(((uint64_t)Sw32 * 10U) / Bytes),
+		       (unsigned long)(((uint64_t)Crc32 * 10U) / Bytes), (unsigned)Ok);
+	}
+	return All_Ok;
+}
+
+static void bench_stats(USART_Num_t USART_Num)
+{
+	USART_Stats_t Stats;
+
+	if(USART_GetStats(USART_Num, &Stats) == USART_Ok)
+	{
+		printf("BENCH,stats,rx=%lu,tx=%lu,drops=%lu,ore=%lu,fe=%lu,ne=%lu,pe=%lu,rx_hw=%lu,tx_hw=%lu\n",
+		       (unsigned long)Stats.Rx_Bytes, (unsigned long)Stats.Tx_Bytes, (unsigned long)Stats.Rx_Drops,
+		       (unsigned long)Stats.Overrun, (unsigned long)Stats.Framing, (unsigned long)Stats.Noise,
+		       (unsigned long)Stats.Parity, (unsigned long)Stats.Rx_High_Water, (unsigned long)Stats.Tx_High_Water);
+	}
+}
+
+#if (USART_PROFILE == ENABLE)
+static void bench_prof(USART_Num_t USART_Num)
+{
+	static const char * const Point_Name[USART_PROF_POINTS] =
+	{
+		"send_byte", "receive_byte", "tx_cyclic", "rx_cyclic", "tx_cplt", "rx_cplt", "irq"
+	};
+	USART_Prof_t Prof;
+
+	for(USART_Prof_Point_t Point = 0; Point < USART_PROF_POINTS; Point++)
+	{
+		if((USART_GetProfile(USART_Num, Point, &Prof) == USART_Ok) && (Prof.Count != 0U))
+		{
+			/* Histogram bins as one ':'-separated field (bin i = [2^i, 2^(i+1)) cycles). */
+			printf("BENCH,prof,point=%s,count=%lu,min_cycles=%lu,mean_cycles=%lu,max_cycles=%lu,hist=",
+			       Point_Name[Point], (unsigned long)Prof.Count, (unsigned long)Prof.Min,
+			       (unsigned long)(Prof.Total / Prof.Count), (unsigned long)Prof.Max);
+			for(uint32_t Bin = 0; Bin < USART_PROF_BINS; Bin++)
+			{
+				printf((Bin == 0U) ? "%lu" : ":%lu", (unsigned long)Prof.Hist[Bin]);
+			}
+			printf("\n");
+		}
+	}
+}
+#endif
+
+/* =========================================================================================
+ *                                   USART_Bench_Run()
+ * =========================================================================================
+ */
+uint8_t USART_Bench_Run(USART_Num_t USART_Num)
+{
+	uint8_t Ok = 0;
+
+	if((USART_Num < USART_MAX_NUM) && (USART_Config[USART_Num].Tx_Buff_Size != 0U) &&
+	   (USART_Config[USART_Num].Rx_Buff_Size != 0U))
+	{
+		bench_drain(USART_Num, 5U);
+		(void)USART_ResetStats(USART_Num);
+		(void)USART_ResetProfile(USART_Num);
+
+		bench_config(USART_Num);
+		Ok  = bench_throughput(USART_Num);
+		bench_cpu(USART_Num);
+		bench_isr(USART_Num);
+		Ok &= bench_latency(USART_Num);
+		Ok &= bench_crc();
+		bench_stats(USART_Num);
+#if (USART_PROFILE == ENABLE)
+		bench_prof(USART_Num);
+#endif
+	}
+
+	printf("BENCH,done,ok=%u\n", (unsigned)Ok);
+	return Ok;
+}
@@ -0,0 +1,101 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Bench.h
+ *  Author    : Ahmed
+ *  Created   : Feb 9, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Throughput / CPU cost / ISR duration / RX latency benchmark for the USART driver.
+ *
+ *  The suite runs through the public driver API on one port whose TX is looped back
+ *  to its RX (jumper on target, USART_Sim_Connect() on the host), for whatever mode
+ *  the image was built with (polling, IT, fast ISR, RX DMA; see USART_Cfg.h). Baud
+ *  rates, buffer sizes and modes are swept by building one image per configuration
+ *  with -D overrides (Sim/bench_sweep.sh does this on the host).
+ *
+ *  Output (machine readable):
+ *  --------------------------
+ *  One line per result on stdout (ITM/SWO on target via printf, stdout on host):
+ *
+ *    BENCH,<record>,key=value,key=value,...
+ *
+ *  Records: config, throughput, cpu, isr_idle, isr_load, latency, crc, stats, done.
+ *  Values are integers; "_x10" keys carry one decimal digit.
+ *
+ *  Platform hooks:
+ *  ---------------
+ *  The application that runs the suite provides the four USART_Bench_* hooks below:
+ *   - Core/Src/Benchmark_UART.c : DWT->CYCCNT based (target)
+ *   - Sim/USART_Sim_Bench.c     : simulated line time + host clock (host)
+ * =========================================================================================
+ */
+
+#ifndef TASKS_USART_BENCH_H_
+#define TASKS_USART_BENCH_H_
+
+#include <stdint.h>
+
+#include "USART.h"
+
+/* =========================================================================================
+ *                                    Suite Parameters
+ * =========================================================================================
+ *
+ * USART_BENCH_BULK_LEN      : bytes streamed for the throughput record
+ * USART_BENCH_LAT_SAMPLES   : single-byte round trips for the latency percentiles
+ * USART_BENCH_CPU_ROUNDS    : non-blocking Send/Receive calls averaged for the cpu record
+ * USART_BENCH_CHUNK_MAX     : largest span handed to one USART_Send() call
+ */
+#ifndef USART_BENCH_BULK_LEN
+#define USART_BENCH_BULK_LEN       4096U
+#endif
+
+#ifndef USART_BENCH_LAT_SAMPLES
+#define USART_BENCH_LAT_SAMPLES    200U
+#endif
+
+#define USART_BENCH_CPU_ROUNDS     32U
+#define USART_BENCH_CHUNK_MAX      64U
+
+/*
+ * USART_Bench_Isr_t:
+ *  - Interrupt activity seen by USART_Bench_IsrProbe() during one window.
+ *  - Min / Max / Total are in USART_Bench_Cycles() units.
+ */
+typedef struct
+{
+	uint32_t Count;
+	uint32_t Min;
+	uint32_t Max;
+	uint64_t Total;
+} USART_Bench_Isr_t;
+
+/* =========================================================================================
+ *                                     Platform Hooks
+ * =========================================================================================
+ *
+ * USART_Bench_Cycles()   : free-running CPU cycle counter (wraps at 32 bits)
+ * USART_Bench_CyclesHz() : frequency of USART_Bench_Cycles()
+ * USART_Bench_NowNs()    : monotonic time base for throughput and latency
+ * USART_Bench_IsrProbe() : let Window_Ms pass and report the interrupts that ran
+ */
+uint32_t USART_Bench_Cycles(void);
+uint32_t USART_Bench_CyclesHz(void);
+uint64_t USART_Bench_NowNs(void);
+void     USART_Bench_IsrProbe(USART_Num_t USART_Num, uint32_t Window_Ms, USART_Bench_Isr_t *Isr);
+
+/* =========================================================================================
+ *                                      Public API
+ * =========================================================================================
+ */
+
+/**
+ * @brief  Run the whole suite on one initialized, looped-back USART.
+ * @param  USART_Num  Logical USART instance ID (USART_Init() already called)
+ * @return 1 if every byte came back complete and in order, 0 otherwise.
+ * @note   Task context only; blocks for a few seconds at 115200 baud.
+ */
+uint8_t USART_Bench_Run(USART_Num_t USART_Num);
+
+#endif /* TASKS_USART_BENCH_H_ */
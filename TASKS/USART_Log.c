@@ -0,0 +1,180 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Log.c
+ *  Author    : Ahmed
+ *  Created   : Feb 14, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Deferred-formatting binary logger (see USART_Log.h for the API and wire format).
+ *
+ *  Record buffer (multi-producer / single-consumer, lock-free):
+ *  ------------------------------------------------------------
+ *   - Log_Reserve / Log_Tail are free-running counters over Log_Buff.
+ *   - A producer claims [Pos .. Pos + Len) with a compare-and-swap on Log_Reserve
+ *     (USART_Atomic_Cas), writes the frame body, then the sync byte LAST. The sync
+ *     byte is the commit flag: producers never wait for each other, so a task that
+ *     is preempted mid-record does not hold back an ISR that logs meanwhile.
+ *   - The consumer walks from Log_Tail while the byte at the frame start is
+ *     USART_LOG_SYNC, copies the frame out and zeroes it before advancing Log_Tail,
+ *     so a stale sync byte is never mistaken for a committed frame on the next lap.
+ *
+ *  Memory ordering (Cortex-M4):
+ *  ----------------------------
+ *   - Producer: frame body -> DMB -> sync byte
+ *   - Consumer: sync byte -> DMB -> frame body, zero -> DMB -> publish Log_Tail
+ * =========================================================================================
+ */
+
+#include <stdint.h>
+
+#include "USART.h"
+#include "USART_Ring.h"
+#include "USART_Atomic.h"
+#include "USART_Log.h"
+
+#if !USART_RING_IS_POW2(USART_LOG_BUFF_SIZE)
+#error "USART_LOG_BUFF_SIZE must be a power of two"
+#endif
+
+#define USART_LOG_MASK          (USART_LOG_BUFF_SIZE - 1U)
+
+/* Largest span handed to one USART_Send() by the flush. */
+#define USART_LOG_CHUNK         64U
+
+static uint8_t           Log_Buff[USART_LOG_BUFF_SIZE];
+static volatile uint32_t Log_Reserve;
+static volatile uint32_t Log_Tail;
+
+/* Dropped: records lost to a full buffer. Reported: part of it already logged. */
+static volatile uint32_t Log_Dropped;
+static uint32_t          Log_Reported;
+
+/* Unsigned LEB128, returns the number of bytes written (1..5). */
+static inline uint32_t usart_log_varint(uint8_t *Out, uint32_t Value)
+{
+	uint32_t n = 0;
+
+	while(Value >= 0x80U)
+	{
+		Out[n++] = (uint8_t)(Value | 0x80U);
+		Value  >>= 7;
+	}
+	Out[n++] = (uint8_t)Value;
+	return n;
+}
+
+static void usart_log_count_drop(void)
+{
+	uint32_t Old;
+
+	do
+	{
+		Old = Log_Dropped;
+	} while(USART_Atomic_Cas(&Log_Dropped, Old, Old + 1U) == 0U);
+}
+
+uint8_t USART_Log_Write(uint32_t Id, const uint32_t *Args, uint32_t Nargs)
+{
+	uint8_t  Frame[USART_LOG_FRAME_MAX];
+	uint32_t Len = 2U;
+	uint32_t Pos;
+	uint8_t  ret = 0;
+
+	if(Nargs <= USART_LOG_MAX_ARGS)
+	{
+		/* Encode on the stack first: the reserved range is then filled in one go. */
+		Len += usart_log_varint(&Frame[Len], Id);
+		for(uint32_t i = 0 ; i < Nargs ; i++)
+		{
+			Len += usart_log_varint(&Frame[Len], Args[i]);
+		}
+		Frame[1] = (uint8_t)(Len - 2U);
+
+		while(1)
+		{
+			Pos = Log_Reserve;
+
+			/* Log_Tail only moves forward meanwhile, so this check can only be pessimistic. */
+			if(((Pos - Log_Tail) + Len) > USART_LOG_BUFF_SIZE)
+			{
+				break;
+			}
+			if(USART_Atomic_Cas(&Log_Reserve, Pos, Pos + Len))
+			{
+				ret = 1;
+				break;
+			}
+		}
+	}
+
+	if(ret != 0U)
+	{
+		for(uint32_t i = 1 ; i < Len ; i++)
+		{
+			Log_Buff[(Pos + i) & USART_LOG_MASK] = Frame[i];
+		}
+		USART_RING_DMB();
+		Log_Buff[Pos & USART_LOG_MASK] = USART_LOG_SYNC;
+	}
+	else
+	{
+		usart_log_count_drop();
+	}
+	return ret;
+}
+
+USART_Err_St_t USART_Log_Flush(uint32_t Timeout_Ms)
+{
+	USART_Err_St_t USART_Err_Ret = USART_Tx_Ok;
+	uint8_t        Chunk[USART_LOG_CHUNK];
+	uint32_t       Fill = 0;
+	uint32_t       Tail = Log_Tail;
+	uint32_t       Len;
+	uint32_t       Lost;
+
+	while((USART_Err_Ret == USART_Tx_Ok) && (Tail != Log_Reserve))
+	{
+		/* Frame start without sync byte: reserved but not committed yet, stop here. */
+		if(Log_Buff[Tail & USART_LOG_MASK] != USART_LOG_SYNC)
+		{
+			break;
+		}
+		USART_RING_DMB();
+
+		Len = 2U + Log_Buff[(Tail + 1U) & USART_LOG_MASK];
+		if((Fill + Len) > USART_LOG_CHUNK)
+		{
+			USART_Err_Ret = USART_Send(USART_LOG_PORT, Chunk, Fill, Timeout_Ms);
+			Fill = 0;
+		}
+
+		for(uint32_t i = 0 ; i < Len ; i++)
+		{
+			Chunk[Fill++] = Log_Buff[(Tail + i) & USART_LOG_MASK];
+			Log_Buff[(Tail + i) & USART_LOG_MASK] = 0U;
+		}
+		Tail += Len;
+
+		USART_RING_DMB();
+		Log_Tail = Tail;
+	}
+
+	if((USART_Err_Ret == USART_Tx_Ok) && (Fill != 0U))
+	{
+		USART_Err_Ret = USART_Send(USART_LOG_PORT, Chunk, Fill, Timeout_Ms);
+	}
+
+	/* Report drops through the log itself, now that there is room (sent by the next flush). */
+	Lost = Log_Dropped - Log_Reported;
+	if((Lost != 0U) && USART_Log_Write(USART_LOG_ID("usart_log: %u records dropped\n"), &Lost, 1U))
+	{
+		Log_Reported += Lost;
+	}
+	return USART_Err_Ret;
+}
+
+uint32_t USART_Log_Dropped(void)
+{
+	return Log_Dropped;
+}
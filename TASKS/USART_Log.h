@@ -0,0 +1,134 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Log.h
+ *  Author    : Ahmed
+ *  Created   : Feb 14, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Deferred-formatting binary logger over a USART.
+ *
+ *  USART_LOG("fmt", args...) does no formatting on the target: it stores the ID of the
+ *  format string plus the raw 32-bit arguments in a lock-free buffer (tens of cycles).
+ *  USART_Log_Flush(), called from a low-priority task, ships the records out of
+ *  USART_LOG_PORT in binary; Tools/usart_log_decode.py turns them back into text
+ *  using the format strings stored in the ELF.
+ *
+ *  Format strings:
+ *  ---------------
+ *   - Each USART_LOG() site places its format string in the "usart_log" section.
+ *     The linker script keeps that section in the ELF as INFO (never loaded), so the
+ *     strings cost no flash; the ID is the string's offset in the section.
+ *   - Arguments are 32-bit integers (%d %i %u %x %X %o %c, with optional width /
+ *     flags / length modifiers); log addresses as (uint32_t) with 0x%08x. %s and
+ *     floating point are not supported: the target never dereferences or converts.
+ *   - The format is checked against the arguments at compile time (printf rules).
+ *
+ *  Wire format (one frame per record):
+ *  -----------------------------------
+ *     0xA5 | Len | varint(ID) | varint(Arg0) | ... | varint(ArgN-1)
+ *
+ *   - Len: number of bytes after the Len byte.
+ *   - varint: unsigned LEB128 (7 bits per byte, LSB first, bit 7 = more bytes).
+ *     Small values take one byte; negative values take five.
+ *   - A typical "Rx data : %c\n" record is 4-5 bytes on the wire instead of 12.
+ *
+ *  Context:
+ *  --------
+ *   - USART_LOG(): any context (task or ISR), no RTOS calls, never blocks. When the
+ *     buffer is full the record is dropped and counted; the next flush emits a
+ *     "records dropped" record.
+ *   - USART_Log_Flush(): one task only (the consumer).
+ * =========================================================================================
+ */
+
+#ifndef TASKS_USART_LOG_H_
+#define TASKS_USART_LOG_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "USART.h"
+
+/* =========================================================================================
+ *                                    Logger Parameters
+ * =========================================================================================
+ *
+ * USART_LOG_PORT       : USART the records are sent on. Must not carry application data:
+ *                        binary frames mixed into a data stream corrupt it (TASKS.c checks
+ *                        this against USART_NUM_2). Needs buffers in USART_Cfg.h.
+ * USART_LOG_BUFF_SIZE  : record buffer size in bytes, power of two
+ * USART_LOG_MAX_ARGS   : most arguments one USART_LOG() call may take
+ */
+#ifndef USART_LOG_PORT
+#define USART_LOG_PORT          USART_NUM_1
+#endif
+
+#ifndef USART_LOG_BUFF_SIZE
+#define USART_LOG_BUFF_SIZE     1024U
+#endif
+
+#define USART_LOG_MAX_ARGS      6U
+
+/* Frame layout (see wire format above). */
+#define USART_LOG_SYNC          0xA5U
+#define USART_LOG_FRAME_MAX     (2U + (5U * (1U + USART_LOG_MAX_ARGS)))
+
+/* Start of the format string section, provided by the linker. */
+extern const char __start_usart_log[];
+
+/*
+ * USART_LOG_ID(Fmt):
+ *  - Places Fmt in the "usart_log" section and evaluates to its ID.
+ */
+#define USART_LOG_ID(Fmt)                                                                   \
+	({                                                                                      \
+		static const char usart_log_fmt[] __attribute__((section("usart_log"), used)) = Fmt; \
+		(uint32_t)(usart_log_fmt - __start_usart_log);                                      \
+	})
+
+/*
+ * USART_LOG(Fmt, ...):
+ *  - Record one log line. Fmt must be a string literal; up to USART_LOG_MAX_ARGS
+ *    integer arguments.
+ *  - The dead printf() only makes the compiler check Fmt against the arguments.
+ */
+#define USART_LOG(Fmt, ...)                                                                 \
+	do                                                                                      \
+	{                                                                                       \
+		const uint32_t usart_log_args[] = { __VA_ARGS__ };                                  \
+		_Static_assert(sizeof(usart_log_args) <= (USART_LOG_MAX_ARGS * sizeof(uint32_t)),    \
+		               "USART_LOG: too many arguments");                                     \
+		if(0)                                                                               \
+		{                                                                                   \
+			(void)printf(Fmt, ##__VA_ARGS__);                                               \
+		}                                                                                   \
+		(void)USART_Log_Write(USART_LOG_ID(Fmt), usart_log_args,                            \
+		                      sizeof(usart_log_args) / sizeof(uint32_t));                   \
+	} while(0)
+
+/**
+ * @brief  Encode one record into the log buffer (used by USART_LOG()).
+ * @param  Id     Format string ID (USART_LOG_ID)
+ * @param  Args   Raw argument values
+ * @param  Nargs  Number of arguments (0..USART_LOG_MAX_ARGS)
+ * @return 1 if the record was stored, 0 if it was dropped (buffer full / too many args).
+ * @note   Any context, lock-free, never blocks.
+ */
+uint8_t USART_Log_Write(uint32_t Id, const uint32_t *Args, uint32_t Nargs);
+
+/**
+ * @brief  Send every complete record in the log buffer out of USART_LOG_PORT.
+ * @param  Timeout_Ms  Max time to wait for USART TX space per chunk (USART_Send)
+ * @return USART_Tx_Ok, or the USART_Send() error that stopped the flush (the records
+ *         of that chunk are lost; the decoder resynchronizes on the next frame).
+ * @note   Task context only, one consumer task. USART_LOG_PORT must be initialized.
+ */
+USART_Err_St_t USART_Log_Flush(uint32_t Timeout_Ms);
+
+/**
+ * @brief  Number of records dropped because the log buffer was full (since boot).
+ */
+uint32_t USART_Log_Dropped(void);
+
+#endif /* TASKS_USART_LOG_H_ */
@@ -0,0 +1,657 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Modbus.c
+ *  Author    : Ahmed
+ *  Created   : Feb 22, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Modbus RTU slave (see USART_Modbus.h for the API, timing and supported functions).
+ *
+ *  Receiver ownership:
+ *  -------------------
+ *   - MODBUS_RX_IDLE / MODBUS_RX_FRAME: the RX hook and the timer interrupt own the
+ *     ADU buffer.
+ *   - MODBUS_RX_READY: the timer interrupt handed a complete request to
+ *     USART_Modbus_Poll(), which decodes it, builds the reply in the same buffer,
+ *     sends it and returns the receiver to MODBUS_RX_IDLE. Bytes that arrive
+ *     meanwhile are dropped (the master must wait for the reply).
+ * =========================================================================================
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "USART.h"
+#include "USART_Prv.h"
+#include "USART_Cfg.h"
+#include "USART_Crc.h"
+#include "USART_Modbus.h"
+
+#if (USART_MODBUS == ENABLE)
+
+#if (USART_RX_INT != ENABLE) || (USART_RX_DMA == ENABLE)
+#error "USART_Modbus.c: the slave times each byte in the RX interrupt (USART_RX_INT without USART_RX_DMA)"
+#endif
+
+/* Receiver states */
+#define MODBUS_RX_IDLE              0U
+#define MODBUS_RX_FRAME             1U
+#define MODBUS_RX_READY             2U
+
+/* Why the frame being received will be discarded (usart_modbus_t.Bad) */
+#define MODBUS_BAD_SYNC             0x01U   /* started before the slave: wait for silence */
+#define MODBUS_BAD_GAP              0x02U   /* t1.5 gap inside the frame                  */
+#define MODBUS_BAD_OVERRUN          0x04U   /* longer than USART_MODBUS_ADU_MAX           */
+
+/* Exception codes */
+#define MODBUS_EX_ILLEGAL_FUNCTION  0x01U
+#define MODBUS_EX_ILLEGAL_ADDRESS   0x02U
+#define MODBUS_EX_ILLEGAL_VALUE     0x03U
+
+/* Protocol limits (quantity per request) */
+#define MODBUS_MAX_READ_BITS        2000U
+#define MODBUS_MAX_READ_REGS        125U
+#define MODBUS_MAX_WRITE_BITS       1968U
+#define MODBUS_MAX_WRITE_REGS       123U
+
+/*
+ * usart_modbus_t:
+ *  - One slave. Channel (timer channel) is the index in Modbus_Slave[].
+ *  - T15_Us / T35_Us: inter-character / inter-frame limits at the port baud rate.
+ *  - Len / Crc: bytes received so far and their running CRC-16/MODBUS; a complete
+ *    frame including its CRC leaves Crc == 0.
+ *  - End_Us: when the request was completed (start of the turnaround).
+ */
+typedef struct
+{
+	uint8_t                      Used;
+	USART_Num_t                  USART_Num;
+	uint8_t                      Address;
+	const USART_Modbus_Region_t *Map;
+	uint32_t                     Map_Count;
+	uint32_t                     T15_Us;
+	uint32_t                     T35_Us;
+
+	volatile uint8_t             State;
+	uint8_t                      Bad;
+	uint16_t                     Crc;
+	uint32_t                     Len;
+	uint32_t                     Last_Us;
+	uint32_t                     End_Us;
+	uint8_t                      Adu[USART_MODBUS_ADU_MAX];
+
+	TaskHandle_t volatile        Waiter;
+	USART_Modbus_Stats_t         Stats;
+} usart_modbus_t;
+
+static usart_modbus_t Modbus_Slave[USART_MODBUS_MAX_SLAVES];
+
+/* =========================================================================================
+ *                                   Internal Helpers
+ * =========================================================================================
+ */
+static usart_modbus_t *usart_modbus_find(USART_Num_t USART_Num)
+{
+	usart_modbus_t *Slave = NULL;
+
+	for(uint32_t i = 0 ; i < USART_MODBUS_MAX_SLAVES ; i++)
+	{
+		if((Modbus_Slave[i].Used != 0U) && (Modbus_Slave[i].USART_Num == USART_Num))
+		{
+			Slave = &Modbus_Slave[i];
+			break;
+		}
+	}
+	return Slave;
+}
+
+/* Same conversion as the driver's blocking calls. */
+static TickType_t usart_modbus_ms_to_ticks(uint32_t Timeout_Ms)
+{
+	TickType_t Ticks = portMAX_DELAY;
+
+	if(Timeout_Ms != USART_WAIT_FOREVER)
+	{
+		Ticks = (TickType_t)(((uint64_t)Timeout_Ms * configTICK_RATE_HZ) / 1000U);
+	}
+	return Ticks;
+}
+
+static inline uint16_t usart_modbus_get16(const uint8_t *Data)
+{
+	return (uint16_t)(((uint16_t)Data[0] << 8) | Data[1]);
+}
+
+static inline void usart_modbus_put16(uint8_t *Data, uint16_t Value)
+{
+	Data[0] = (uint8_t)(Value >> 8);
+	Data[1] = (uint8_t)Value;
+}
+
+static inline uint8_t usart_modbus_get_bit(const uint8_t *Bits, uint32_t Pos)
+{
+	return (uint8_t)((Bits[Pos >> 3] >> (Pos & 7U)) & 1U);
+}
+
+static inline void usart_modbus_set_bit(uint8_t *Bits, uint32_t Pos, uint8_t Value)
+{
+	if(Value != 0U)
+	{
+		Bits[Pos >> 3] |= (uint8_t)(1U << (Pos & 7U));
+	}
+	else
+	{
+		Bits[Pos >> 3] &= (uint8_t)~(1U << (Pos & 7U));
+	}
+}
+
+/* Region of Space that holds all of [Addr .. Addr + Qty), NULL if none. */
+static const USART_Modbus_Region_t *usart_modbus_region(const usart_modbus_t *Slave, uint8_t Space, uint16_t Addr, uint32_t Qty)
+{
+	const USART_Modbus_Region_t *Region = NULL;
+
+	for(uint32_t i = 0 ; i < Slave->Map_Count ; i++)
+	{
+		if((Slave->Map[i].Space == Space) && (Addr >= Slave->Map[i].Start) &&
+		   (((uint32_t)Addr + Qty) <= ((uint32_t)Slave->Map[i].Start + Slave->Map[i].Count)))
+		{
+			Region = &Slave->Map[i];
+			break;
+		}
+	}
+	return Region;
+}
+
+/* =========================================================================================
+ *                                   Request Handling
+ * =========================================================================================
+ *
+ * usart_modbus_process():
+ *  - Decodes the request in Slave->Adu, applies it to the register map and builds
+ *    the reply (normal or exception, CRC appended) in place.
+ *  - Returns the reply length, 0 for broadcasts (no reply).
+ */
+static uint32_t usart_modbus_process(usart_modbus_t *Slave)
+{
+	uint8_t                     *Adu     = Slave->Adu;
+	uint8_t                      Func    = Adu[1];
+	uint32_t                     Pdu_Len = Slave->Len - 3U;   /* function code + data */
+	uint16_t                     Addr    = usart_modbus_get16(&Adu[2]);
+	uint16_t                     Qty     = usart_modbus_get16(&Adu[4]);
+	const USART_Modbus_Region_t *Region  = NULL;
+	uint8_t                      Ex      = 0U;
+	uint8_t                      Written = 0U;
+	uint32_t                     Len     = 0U;
+	uint32_t                     Off;
+	uint16_t                     Crc;
+
+	/* Every supported request has at least an address and a quantity / value. */
+	if(Pdu_Len < 5U)
+	{
+		Ex = ((Func >= 0x01U) && (Func <= 0x06U)) || (Func == 0x0FU) || (Func == 0x10U) ?
+		     MODBUS_EX_ILLEGAL_VALUE : MODBUS_EX_ILLEGAL_FUNCTION;
+	}
+	else
+	{
+		switch(Func)
+		{
+		case 0x01U:     /* Read Coils */
+		case 0x02U:     /* Read Discrete Inputs */
+			Region = usart_modbus_region(Slave, (Func == 0x01U) ? USART_MODBUS_COILS : USART_MODBUS_DISCRETE, Addr, Qty);
+			if((Pdu_Len != 5U) || (Qty == 0U) || (Qty > MODBUS_MAX_READ_BITS))
+			{
+				Ex = MODBUS_EX_ILLEGAL_VALUE;
+			}
+			else if(Region == NULL)
+			{
+				Ex = MODBUS_EX_ILLEGAL_ADDRESS;
+			}
+			else
+			{
+				Off    = Addr - Region->Start;
+				Adu[2] = (uint8_t)((Qty + 7U) / 8U);
+				memset(&Adu[3], 0, Adu[2]);
+
+				taskENTER_CRITICAL();
+				for(uint32_t i = 0 ; i < Qty ; i++)
+				{
+					usart_modbus_set_bit(&Adu[3], i, usart_modbus_get_bit((const uint8_t *)Region->Data, Off + i));
+				}
+				taskEXIT_CRITICAL();
+				Len = 3U + Adu[2];
+			}
+			break;
+
+		case 0x03U:     /* Read Holding Registers */
+		case 0x04U:     /* Read Input Registers */
+			Region = usart_modbus_region(Slave, (Func == 0x03U) ? USART_MODBUS_HOLDING : USART_MODBUS_INPUT, Addr, Qty);
+			if((Pdu_Len != 5U) || (Qty == 0U) || (Qty > MODBUS_MAX_READ_REGS))
+			{
+				Ex = MODBUS_EX_ILLEGAL_VALUE;
+			}
+			else if(Region == NULL)
+			{
+				Ex = MODBUS_EX_ILLEGAL_ADDRESS;
+			}
+			else
+			{
+				Off    = Addr - Region->Start;
+				Adu[2] = (uint8_t)(Qty * 2U);
+
+				taskENTER_CRITICAL();
+				for(uint32_t i = 0 ; i < Qty ; i++)
+				{
+					usart_modbus_put16(&Adu[3U + (i * 2U)], ((const uint16_t *)Region->Data)[Off + i]);
+				}
+				taskEXIT_CRITICAL();
+				Len = 3U + Adu[2];
+			}
+			break;
+
+		case 0x05U:     /* Write Single Coil (Qty field is the value) */
+			Region = usart_modbus_region(Slave, USART_MODBUS_COILS, Addr, 1U);
+			if((Pdu_Len != 5U) || ((Qty != 0xFF00U) && (Qty != 0x0000U)))
+			{
+				Ex = MODBUS_EX_ILLEGAL_VALUE;
+			}
+			else if(Region == NULL)
+			{
+				Ex = MODBUS_EX_ILLEGAL_ADDRESS;
+			}
+			else
+			{
+				taskENTER_CRITICAL();
+				usart_modbus_set_bit((uint8_t *)Region->Data, Addr - Region->Start, (uint8_t)(Qty != 0U));
+				taskEXIT_CRITICAL();
+				Qty     = 1U;
+				Written = 1U;
+				Len     = 6U;       /* echo of the request */
+			}
+			break;
+
+		case 0x06U:     /* Write Single Register (Qty field is the value) */
+			Region = usart_modbus_region(Slave, USART_MODBUS_HOLDING, Addr, 1U);
+			if(Pdu_Len != 5U)
+			{
+				Ex = MODBUS_EX_ILLEGAL_VALUE;
+			}
+			else if(Region == NULL)
+			{
+				Ex = MODBUS_EX_ILLEGAL_ADDRESS;
+			}
+			else
+			{
+				taskENTER_CRITICAL();
+				((uint16_t *)Region->Data)[Addr - Region->Start] = Qty;
+				taskEXIT_CRITICAL();
+				Qty     = 1U;
+				Written = 1U;
+				Len     = 6U;
+			}
+			break;
+
+		case 0x0FU:     /* Write Multiple Coils */
+			Region = usart_modbus_region(Slave, USART_MODBUS_COILS, Addr, Qty);
+			if((Qty == 0U) || (Qty > MODBUS_MAX_WRITE_BITS) || (Pdu_Len < 6U) ||
+			   (Adu[6] != ((Qty + 7U) / 8U)) || (Pdu_Len != (6U + Adu[6])))
+			{
+				Ex = MODBUS_EX_ILLEGAL_VALUE;
+			}
+			else if(Region == NULL)
+			{
+				Ex = MODBUS_EX_ILLEGAL_ADDRESS;
+			}
+			else
+			{
+				Off = Addr - Region->Start;
+
+				taskENTER_CRITICAL();
+				for(uint32_t i = 0 ; i < Qty ; i++)
+				{
+					usart_modbus_set_bit((uint8_t *)Region->Data, Off + i, usart_modbus_get_bit(&Adu[7], i));
+				}
+				taskEXIT_CRITICAL();
+				Written = 1U;
+				Len     = 6U;       /* address + quantity */
+			}
+			break;
+
+		case 0x10U:     /* Write Multiple Registers */
+			Region = usart_modbus_region(Slave, USART_MODBUS_HOLDING, Addr, Qty);
+			if((Qty == 0U) || (Qty > MODBUS_MAX_WRITE_REGS) || (Pdu_Len < 6U) ||
+			   (Adu[6] != (Qty * 2U)) || (Pdu_Len != (6U + Adu[6])))
+			{
+				Ex = MODBUS_EX_ILLEGAL_VALUE;
+			}
+			else if(Region == NULL)
+			{
+				Ex = MODBUS_EX_ILLEGAL_ADDRESS;
+			}
+			else
+			{
+				Off = Addr - Region->Start;
+
+				taskENTER_CRITICAL();
+				for(uint32_t i = 0 ; i < Qty ; i++)
+				{
+					((uint16_t *)Region->Data)[Off + i] = usart_modbus_get16(&Adu[7U + (i * 2U)]);
+				}
+				taskEXIT_CRITICAL();
+				Written = 1U;
+				Len     = 6U;
+			}
+			break;
+
+		default:
+			Ex = MODBUS_EX_ILLEGAL_FUNCTION;
+			break;
+		}
+	}
+
+	if((Written != 0U) && (Region->On_Write != NULL))
+	{
+		Region->On_Write(Addr, Qty);
+	}
+
+	if(Ex != 0U)
+	{
+		Adu[1] = (uint8_t)(Func | 0x80U);
+		Adu[2] = Ex;
+		Len    = 3U;
+		Slave->Stats.Exceptions++;
+	}
+
+	if(Adu[0] == 0U)
+	{
+		/* Broadcast: executed, never answered. */
+		Len = 0U;
+	}
+	else
+	{
+		Crc        = USART_Crc16Modbus(USART_CRC16_MODBUS_INIT, Adu, Len);
+		Adu[Len++] = (uint8_t)Crc;
+		Adu[Len++] = (uint8_t)(Crc >> 8);
+	}
+	return Len;
+}
+
+/* =========================================================================================
+ *                                   Receiver (ISR)
+ * =========================================================================================
+ */
+
+/* RX hook: runs in the USART RX interrupt for every byte. */
+static void usart_modbus_rx_hook(USART_Num_t USART_Num, const uint8_t *Data, uint32_t Len)
+{
+	usart_modbus_t *Slave = usart_modbus_find(USART_Num);
+	uint32_t        Now   = USART_Modbus_NowUs();
+
+	if(Slave == NULL)
+	{
+		/* Slave slot being reused: nothing to do. */
+	}
+	else if(Slave->State == MODBUS_RX_READY)
+	{
+		Slave->Stats.Overruns += Len;
+	}
+	else
+	{
+		if(Slave->State == MODBUS_RX_IDLE)
+		{
+			Slave->State = MODBUS_RX_FRAME;
+			Slave->Bad   = 0U;
+			Slave->Len   = 0U;
+			Slave->Crc   = USART_CRC16_MODBUS_INIT;
+		}
+		else if((Now - Slave->Last_Us) > Slave->T15_Us)
+		{
+			Slave->Bad |= MODBUS_BAD_GAP;
+		}
+
+		for(uint32_t i = 0 ; i < Len ; i++)
+		{
+			if(Slave->Len < USART_MODBUS_ADU_MAX)
+			{
+				Slave->Adu[Slave->Len++] = Data[i];
+			}
+			else
+			{
+				Slave->Bad |= MODBUS_BAD_OVERRUN;
+				Slave->Stats.Overruns++;
+			}
+		}
+		Slave->Crc     = USART_Crc16Modbus(Slave->Crc, Data, Len);
+		Slave->Last_Us = Now;
+
+		USART_Modbus_TimerStart((uint32_t)(Slave - Modbus_Slave), Slave->T35_Us);
+	}
+}
+
+/* t3.5 of silence: the frame is complete. */
+void USART_Modbus_TimerIsr(uint32_t Channel)
+{
+	usart_modbus_t *Slave;
+	TaskHandle_t    Task;
+	BaseType_t      Woken = pdFALSE;
+
+	if((Channel < USART_MODBUS_MAX_SLAVES) && (Modbus_Slave[Channel].State == MODBUS_RX_FRAME))
+	{
+		Slave        = &Modbus_Slave[Channel];
+		Slave->State = MODBUS_RX_IDLE;
+
+		if(Slave->Bad != 0U)
+		{
+			if((Slave->Bad & MODBUS_BAD_GAP) != 0U)
+			{
+				Slave->Stats.Gap_Errors++;
+			}
+		}
+		else if((Slave->Len < 4U) || (Slave->Crc != 0U))
+		{
+			Slave->Stats.Crc_Errors++;
+		}
+		else if((Slave->Adu[0] != Slave->Address) && (Slave->Adu[0] != 0U))
+		{
+			Slave->Stats.Ignored++;
+		}
+		else
+		{
+			Slave->End_Us = USART_Modbus_NowUs();
+			Slave->State  = MODBUS_RX_READY;
+
+			Task = Slave->Waiter;
+			if(Task != NULL)
+			{
+				Slave->Waiter = NULL;
+				vTaskNotifyGiveIndexedFromISR(Task, USART_NOTIFY_INDEX, &Woken);
+			}
+		}
+		portYIELD_FROM_ISR(Woken);
+	}
+}
+
+/* =========================================================================================
+ *                                      Public API
+ * =========================================================================================
+ */
+USART_Err_St_t USART_Modbus_Start(USART_Num_t USART_Num , uint8_t Address, const USART_Modbus_Region_t *Map, uint32_t Count)
+{
+	USART_Err_St_t  USART_Err_Ret =  USART_Ok;
+	usart_modbus_t *Slave         =  NULL;
+	uint32_t        Baud;
+
+	if((USART_Num >= USART_MAX_NUM) || (Address == 0U) || (Address > 247U) || (Map == NULL) || (Count == 0U))
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else if(USART_GetBaud(USART_Num, &Baud) != USART_Ok)
+	{
+		USART_Err_Ret =  USART_Not_Init;
+	}
+	else
+	{
+		/* Restart on the same port, else take a free slot. */
+		Slave = usart_modbus_find(USART_Num);
+		for(uint32_t i = 0 ; (Slave == NULL) && (i < USART_MODBUS_MAX_SLAVES) ; i++)
+		{
+			if(Modbus_Slave[i].Used == 0U)
+			{
+				Slave = &Modbus_Slave[i];
+			}
+		}
+
+		if(Slave == NULL)
+		{
+			USART_Err_Ret =  USART_Invalid_Arg;
+		}
+		else
+		{
+			(void)USART_SetRxHook(USART_Num, NULL);
+
+			/* 11-bit characters; fixed limits above 19200 baud (spec 2.5.1.1). */
+			if(Baud > 19200U)
+			{
+				Slave->T15_Us = 750U;
+				Slave->T35_Us = 1750U;
+			}
+			else
+			{
+				Slave->T15_Us = (16500000U + Baud - 1U) / Baud;
+				Slave->T35_Us = (38500000U + Baud - 1U) / Baud;
+			}
+
+			Slave->USART_Num = USART_Num;
+			Slave->Address   = Address;
+			Slave->Map       = Map;
+			Slave->Map_Count = Count;
+			Slave->Waiter    = NULL;
+			memset(&Slave->Stats, 0, sizeof(Slave->Stats));
+			Slave->Stats.Turn_Min_Us = UINT32_MAX;
+
+			/* The line may be mid-frame: wait for t3.5 of silence before the first request. */
+			USART_Modbus_TimerInit();
+			Slave->Bad     = MODBUS_BAD_SYNC;
+			Slave->Len     = 0U;
+			Slave->Last_Us = USART_Modbus_NowUs();
+			Slave->State   = MODBUS_RX_FRAME;
+			Slave->Used    = 1U;
+			USART_Modbus_TimerStart((uint32_t)(Slave - Modbus_Slave), Slave->T35_Us);
+
+			(void)USART_SetRxHook(USART_Num, usart_modbus_rx_hook);
+		}
+	}
+	return USART_Err_Ret;
+}
+
+USART_Err_St_t USART_Modbus_Poll(USART_Num_t USART_Num , uint32_t Timeout_Ms)
+{
+	USART_Err_St_t  USART_Err_Ret =  USART_Rx_NoData;
+	usart_modbus_t *Slave         =  usart_modbus_find(USART_Num);
+	TimeOut_t       Time_Out;
+	TickType_t      Ticks_Left    =  usart_modbus_ms_to_ticks(Timeout_Ms);
+	uint32_t        Len;
+	uint32_t        Turn;
+
+	if(USART_Num >= USART_MAX_NUM)
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else if(Slave == NULL)
+	{
+		USART_Err_Ret =  USART_Not_Init;
+	}
+	else
+	{
+		vTaskSetTimeOutState(&Time_Out);
+
+		/* Drop stale notifications -> publish waiter -> re-check -> sleep. */
+		while(Slave->State != MODBUS_RX_READY)
+		{
+			(void)ulTaskNotifyTakeIndexed(USART_NOTIFY_INDEX, pdTRUE, 0);
+			Slave->Waiter = xTaskGetCurrentTaskHandle();
+
+			if(Slave->State != MODBUS_RX_READY)
+			{
+				if(xTaskCheckForTimeOut(&Time_Out, &Ticks_Left) != pdFALSE)
+				{
+					Slave->Waiter = NULL;
+					break;
+				}
+				(void)ulTaskNotifyTakeIndexed(USART_NOTIFY_INDEX, pdTRUE, Ticks_Left);
+			}
+			Slave->Waiter = NULL;
+		}
+
+		if(Slave->State == MODBUS_RX_READY)
+		{
+			USART_Err_Ret =  USART_Rx_Ok;
+
+			if(Slave->Adu[0] == 0U)
+			{
+				Slave->Stats.Broadcasts++;
+			}
+			else
+			{
+				Slave->Stats.Requests++;
+			}
+
+			Len = usart_modbus_process(Slave);
+			if(Len != 0U)
+			{
+				if(USART_Send(USART_Num, Slave->Adu, Len, USART_MODBUS_TX_TIMEOUT_MS) != USART_Tx_Ok)
+				{
+					USART_Err_Ret =  USART_Tx_Busy;
+				}
+				else
+				{
+					Turn = USART_Modbus_NowUs() - Slave->End_Us;
+
+					Slave->Stats.Turn_Last_Us = Turn;
+					if(Turn < Slave->Stats.Turn_Min_Us)
+					{
+						Slave->Stats.Turn_Min_Us = Turn;
+					}
+					if(Turn > Slave->Stats.Turn_Max_Us)
+					{
+						Slave->Stats.Turn_Max_Us = Turn;
+					}
+				}
+			}
+			Slave->State = MODBUS_RX_IDLE;
+		}
+	}
+	return USART_Err_Ret;
+}
+
+USART_Err_St_t USART_Modbus_GetStats(USART_Num_t USART_Num , USART_Modbus_Stats_t *Stats)
+{
+	USART_Err_St_t  USART_Err_Ret =  USART_Ok;
+	usart_modbus_t *Slave         =  usart_modbus_find(USART_Num);
+
+	if((USART_Num >= USART_MAX_NUM) || (Stats == NULL))
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else if(Slave == NULL)
+	{
+		USART_Err_Ret =  USART_Not_Init;
+	}
+	else
+	{
+		taskENTER_CRITICAL();
+		*Stats = Slave->Stats;
+		taskEXIT_CRITICAL();
+
+		if(Stats->Turn_Min_Us == UINT32_MAX)
+		{
+			Stats->Turn_Min_Us = 0U;
+		}
+	}
+	return USART_Err_Ret;
+}
+
+#endif /* USART_MODBUS */
@@ -0,0 +1,182 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Modbus.h
+ *  Author    : Ahmed
+ *  Created   : Feb 22, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Modbus RTU slave on a USART port.
+ *
+ *  Frame delimiting (Modbus over serial line V1.02, 2.5.1.1):
+ *  ----------------------------------------------------------
+ *   - USART_Modbus_Start() installs the slave as the port's RX hook (USART_SetRxHook),
+ *     so each byte is handled in the RX interrupt: it is stored, the CRC-16 is
+ *     updated (USART_Crc16Modbus), and a one-shot timer is restarted for t3.5.
+ *   - A gap longer than t1.5 inside a frame marks the frame bad (it is discarded).
+ *   - Timer expiry (t3.5 of silence) ends the frame: CRC residue, slave address and
+ *     length are checked in the timer interrupt and a valid request wakes the task
+ *     blocked in USART_Modbus_Poll().
+ *   - t1.5 / t3.5 are 16.5 / 38.5 bit times, fixed at 750 / 1750 us above 19200 baud.
+ *   - Needs RX interrupts (USART_RX_INT == ENABLE, without RX DMA): with polled or
+ *     DMA reception bytes arrive in batches and their gaps cannot be timed.
+ *
+ *  Requests (USART_Modbus_Poll(), task context):
+ *  ---------------------------------------------
+ *   - Function codes 01/02/03/04 (read), 05/06 (write single), 15/16 (write
+ *     multiple). Others answer exception 01; addresses outside the register map
+ *     answer exception 02, bad quantities / values exception 03.
+ *   - Broadcast (address 0) write requests are executed without a reply.
+ *   - The register map is a table of USART_Modbus_Region_t. A request must fall
+ *     inside one region. Region data is read and written inside a critical
+ *     section, so other tasks see each request's writes all at once.
+ *
+ *  Turnaround:
+ *  -----------
+ *   - Measured per request from the end of the frame (t3.5 expiry) to the reply
+ *     handed to the driver; min / max / last in USART_Modbus_Stats_t.
+ *   - Bounded by the Poll() task's wake-up latency (its priority; the scheduler is
+ *     cooperative) plus the request processing, which is linear in the request
+ *     size with no blocking other than TX buffer space (USART_MODBUS_TX_TIMEOUT_MS).
+ *
+ *  Platform hooks:
+ *  ---------------
+ *  The slave needs a microsecond clock and one one-shot timer channel per port:
+ *   - TASKS/USART_Modbus_Tim.c : TIM2 (32-bit, 1 MHz) and its compare channels (target)
+ *   - Sim/USART_Sim_Modbus.c   : simulated time and USART_Sim_SetAlarm() (host)
+ * =========================================================================================
+ */
+
+#ifndef TASKS_USART_MODBUS_H_
+#define TASKS_USART_MODBUS_H_
+
+#include <stdint.h>
+
+#include "USART.h"
+
+/* =========================================================================================
+ *                                    Slave Parameters
+ * =========================================================================================
+ *
+ * USART_MODBUS_MAX_SLAVES     : ports that can run a slave at the same time (timer channels)
+ * USART_MODBUS_TX_TIMEOUT_MS  : longest wait for TX buffer space when replying
+ */
+#ifndef USART_MODBUS_MAX_SLAVES
+#define USART_MODBUS_MAX_SLAVES       1U
+#endif
+
+#ifndef USART_MODBUS_TX_TIMEOUT_MS
+#define USART_MODBUS_TX_TIMEOUT_MS    10U
+#endif
+
+/* RTU ADU: address + PDU (253) + CRC (2). */
+#define USART_MODBUS_ADU_MAX          256U
+
+/* Register spaces (USART_Modbus_Region_t.Space). */
+#define USART_MODBUS_COILS            0U    /* bits, read / write      */
+#define USART_MODBUS_DISCRETE         1U    /* bits, read only         */
+#define USART_MODBUS_HOLDING          2U    /* registers, read / write */
+#define USART_MODBUS_INPUT            3U    /* registers, read only    */
+
+/*
+ * USART_Modbus_Region_t:
+ *  - Count registers / bits of one space, starting at protocol address Start.
+ *  - Data: uint16_t[Count] for registers; for bits uint8_t[(Count + 7) / 8], bit i at
+ *    Data[i / 8] bit (i % 8).
+ *  - On_Write: optional, called from USART_Modbus_Poll() after the master wrote
+ *    [Addr .. Addr + Count) of this region (outside the critical section).
+ */
+typedef struct
+{
+	uint8_t   Space;
+	uint16_t  Start;
+	uint16_t  Count;
+	void     *Data;
+	void    (*On_Write)(uint16_t Addr, uint16_t Count);
+} USART_Modbus_Region_t;
+
+/*
+ * USART_Modbus_Stats_t (USART_Modbus_GetStats):
+ *
+ * Requests / Broadcasts:
+ *  - Valid requests for this slave / for address 0
+ * Exceptions:
+ *  - Requests answered with an exception response
+ * Crc_Errors:
+ *  - Frames with a bad CRC or shorter than 4 bytes
+ * Gap_Errors:
+ *  - Frames discarded because of a t1.5 gap between two bytes
+ * Overruns:
+ *  - Bytes dropped: frame longer than USART_MODBUS_ADU_MAX, or received while the
+ *    previous request was still being processed
+ * Ignored:
+ *  - Valid frames addressed to another slave
+ * Turn_Min_Us / Turn_Max_Us / Turn_Last_Us:
+ *  - Turnaround of the replies sent (see above)
+ */
+typedef struct
+{
+	uint32_t Requests;
+	uint32_t Broadcasts;
+	uint32_t Exceptions;
+	uint32_t Crc_Errors;
+	uint32_t Gap_Errors;
+	uint32_t Overruns;
+	uint32_t Ignored;
+	uint32_t Turn_Min_Us;
+	uint32_t Turn_Max_Us;
+	uint32_t Turn_Last_Us;
+} USART_Modbus_Stats_t;
+
+/* =========================================================================================
+ *                                     Platform Hooks
+ * =========================================================================================
+ *
+ * USART_Modbus_TimerInit()     : start the microsecond clock (called by USART_Modbus_Start)
+ * USART_Modbus_NowUs()         : free-running microsecond clock (wraps at 32 bits), ISR safe
+ * USART_Modbus_TimerStart()    : (re)arm timer channel Channel to call
+ *                                USART_Modbus_TimerIsr(Channel) Us microseconds from now;
+ *                                called from the RX interrupt
+ * USART_Modbus_TimerIsr()      : provided by the slave, called from the timer interrupt,
+ *                                which must be at USART_NVIC_GROUP_PRIORITY (FromISR calls)
+ */
+void     USART_Modbus_TimerInit(void);
+uint32_t USART_Modbus_NowUs(void);
+void     USART_Modbus_TimerStart(uint32_t Channel, uint32_t Us);
+void     USART_Modbus_TimerIsr(uint32_t Channel);
+
+/* =========================================================================================
+ *                                      Public API
+ * =========================================================================================
+ */
+
+/**
+ * @brief  Start a Modbus RTU slave on an initialized port.
+ * @param  USART_Num     Logical USART instance ID (USART_Init() already called)
+ * @param  Address       Slave address 1..247
+ * @param  Map / Count   Register map (kept by reference, must stay valid)
+ * @return USART_Ok, USART_Invalid_Arg (bad address / map, no free slave slot) or
+ *         USART_Not_Init.
+ * @note   Task context, before USART_Modbus_Poll(). The port's received bytes go to
+ *         the slave from now on (not to USART_Receive / the frame layer). t1.5 / t3.5
+ *         follow the current rate: call it again after USART_SetBaud().
+ */
+USART_Err_St_t USART_Modbus_Start(USART_Num_t USART_Num , uint8_t Address, const USART_Modbus_Region_t *Map, uint32_t Count);
+
+/**
+ * @brief  Wait for one request and answer it.
+ * @param  USART_Num   Logical USART instance ID (slave started)
+ * @param  Timeout_Ms  Max time to wait for a request (USART_NO_WAIT / USART_WAIT_FOREVER)
+ * @return USART_Rx_Ok when a request was handled, USART_Rx_NoData on timeout,
+ *         USART_Tx_Busy if the reply did not fit the TX buffer in time, or
+ *         USART_Invalid_Arg / USART_Not_Init.
+ * @note   Task context only, one task per slave; call it in that task's loop.
+ */
+USART_Err_St_t USART_Modbus_Poll(USART_Num_t USART_Num , uint32_t Timeout_Ms);
+
+/**
+ * @brief  Copy the counters of one slave.
+ */
+USART_Err_St_t USART_Modbus_GetStats(USART_Num_t USART_Num , USART_Modbus_Stats_t *Stats);
+
+#endif /* TASKS_USART_MODBUS_H_ */
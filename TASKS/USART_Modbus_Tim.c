@@ -0,0 +1,115 @@
+/*
+ * =========================================================================================
+ *  File      : USART_Modbus_Tim.c
+ *  Author    : Ahmed
+ *  Created   : Feb 22, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Target platform hooks of the Modbus RTU slave (see USART_Modbus.h) on TIM2.
+ *
+ *   - TIM2 is a free-running 32-bit counter at 1 MHz: USART_Modbus_NowUs() is CNT.
+ *   - Compare channel N (CC1..CC4) is slave N's t3.5 timer: arming writes
+ *     CCRN = CNT + Us and enables CCNIE; the match interrupt disables it again and
+ *     calls USART_Modbus_TimerIsr(N). Up to four slaves.
+ *   - TIM2_IRQn runs at the USART IRQ priority, so it never preempts the RX hook
+ *     that re-arms it (and may call FreeRTOS FromISR APIs).
+ *
+ *  TIM2 is not used elsewhere in this project (TIM6 is the HAL time base); this
+ *  file owns TIM2_IRQHandler.
+ * =========================================================================================
+ */
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "stm32f4xx_hal.h"
+
+#include "USART.h"
+#include "USART_Prv.h"
+#include "USART_Cfg.h"
+#include "USART_Modbus.h"
+
+#if (USART_MODBUS == ENABLE)
+
+#define MODBUS_TIM_CHANNELS     4U
+
+#if (USART_MODBUS_MAX_SLAVES > MODBUS_TIM_CHANNELS)
+#error "USART_Modbus_Tim.c: TIM2 has 4 compare channels (USART_MODBUS_MAX_SLAVES <= 4)"
+#endif
+
+static volatile uint32_t * const Modbus_Tim_Ccr[MODBUS_TIM_CHANNELS] =
+{
+	&TIM2->CCR1, &TIM2->CCR2, &TIM2->CCR3, &TIM2->CCR4
+};
+
+static uint8_t Modbus_Tim_Started;
+
+void USART_Modbus_TimerInit(void)
+{
+	uint32_t Clock;
+
+	if(Modbus_Tim_Started == 0U)
+	{
+		__HAL_RCC_TIM2_CLK_ENABLE();
+
+		/* APB1 timers run at 2 x PCLK1 unless APB1 is undivided. */
+		Clock = HAL_RCC_GetPCLK1Freq();
+		if((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+		{
+			Clock *= 2U;
+		}
+
+		TIM2->CR1  = 0U;
+		TIM2->DIER = 0U;
+		TIM2->PSC  = (Clock / 1000000U) - 1U;
+		TIM2->ARR  = 0xFFFFFFFFU;
+		TIM2->EGR  = TIM_EGR_UG;        /* load PSC now */
+		TIM2->SR   = 0U;
+		TIM2->CR1  = TIM_CR1_CEN;
+
+		HAL_NVIC_SetPriority(TIM2_IRQn, USART_NVIC_GROUP_PRIORITY, USART_NVIC_SUB_PRIORITY);
+		HAL_NVIC_EnableIRQ(TIM2_IRQn);
+
+		Modbus_Tim_Started = 1U;
+	}
+}
+
+uint32_t USART_Modbus_NowUs(void)
+{
+	return TIM2->CNT;
+}
+
+void USART_Modbus_TimerStart(uint32_t Channel, uint32_t Us)
+{
+	UBaseType_t Mask;
+
+	configASSERT(Channel < MODBUS_TIM_CHANNELS);
+
+	/* DIER is shared by all channels: read-modify-write with interrupts masked. */
+	Mask = taskENTER_CRITICAL_FROM_ISR();
+	*Modbus_Tim_Ccr[Channel] = TIM2->CNT + Us;
+	TIM2->SR    = ~(TIM_SR_CC1IF << Channel);      /* rc_w0: clears only this flag */
+	TIM2->DIER |= (TIM_DIER_CC1IE << Channel);
+	taskEXIT_CRITICAL_FROM_ISR(Mask);
+}
+
+void TIM2_IRQHandler(void)
+{
+	uint32_t Pending = TIM2->SR & TIM2->DIER;
+
+	for(uint32_t Channel = 0 ; Channel < MODBUS_TIM_CHANNELS ; Channel++)
+	{
+		if((Pending & (TIM_SR_CC1IF << Channel)) != 0U)
+		{
+			/* One-shot: disarm before the callback, which may re-arm. */
+			TIM2->DIER &= ~(TIM_DIER_CC1IE << Channel);
+			TIM2->SR    = ~(TIM_SR_CC1IF << Channel);
+			USART_Modbus_TimerIsr(Channel);
+		}
+	}
+}
+
+#endif /* USART_MODBUS */
@@ -0,0 +1,373 @@
+/*
+ * =========================================================================================
+ *  File      : USART_UsbBridge.c
+ *  Author    : Ahmed
+ *  Created   : Mar 2, 2026
+ *
+ *  Description:
+ *  ------------
+ *  USB CDC host <-> USART bridge (see USART_UsbBridge.h for buffers and threading).
+ *
+ *  Buffer ownership:
+ *  -----------------
+ *   - Down (USB -> USART), per buffer:
+ *       BRIDGE_FREE -> BRIDGE_RECEIVING (USBH_CDC_Receive, USB host owns it)
+ *                   -> BRIDGE_FULL      (USBH_CDC_ReceiveCallback)
+ *                   -> BRIDGE_SENDING   (USART_SendBuffer, the TX DMA owns it)
+ *                   -> BRIDGE_FREE      (completion callback, or TX ring copy done)
+ *     Down_Rx / Down_Tx alternate between the two buffers, so data leaves in the
+ *     order it arrived.
+ *   - Up (USART -> USB): the RX hook owns Up[Up_Fill] and appends to it; the poll
+ *     swaps Up_Fill inside a critical section and the other buffer belongs to the
+ *     CDC OUT transfer until USBH_CDC_TransmitCallback() empties it.
+ * =========================================================================================
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "usb_host.h"
+#include "usbh_core.h"
+#include "usbh_cdc.h"
+
+#include "USART.h"
+#include "USART_Prv.h"
+#include "USART_Cfg.h"
+#include "USART_UsbBridge.h"
+
+#if (USART_USB_BRIDGE == ENABLE)
+
+#if (USART_TX_DMA != ENABLE) && (USART_BUFF_BACKEND != USART_BUFF_RING)
+#error "USART_UsbBridge.c: needs USART_TX_DMA or the ring TX buffer (USART_TxReserve)"
+#endif
+
+/* Down buffer states */
+#define BRIDGE_FREE                 0U
+#define BRIDGE_RECEIVING            1U
+#define BRIDGE_FULL                 2U
+#define BRIDGE_SENDING              3U
+
+/* USB host core handle and class state (USB_HOST/App/usb_host.c). */
+extern USBH_HandleTypeDef  hUsbHostFS;
+extern ApplicationTypeDef  Appli_state;
+
+/*
+ * usart_bridge_t:
+ *  - Down / Down_State / Down_Len / Down_Off: USB -> USART buffers; Down_Off is the
+ *    part already copied into the TX ring (no USART_TX_DMA), Down_Dma the buffer
+ *    in flight on the TX DMA.
+ *  - Up / Up_Len / Up_Fill: USART -> USB buffers; Up_Len[Up_Fill] is written by the
+ *    RX hook only.
+ *  - Up_Tx_Len: bytes of Up[Up_Fill ^ 1] owned by the CDC OUT transfer (0 = none),
+ *    Up_Tx_Busy: USBH_CDC_Transmit() accepted it.
+ *  - Attached: a CDC device is ready; read by the RX hook.
+ */
+typedef struct
+{
+	uint8_t                  Down[2][USBH_MAX_DATA_BUFFER];
+	volatile uint8_t         Down_State[2];
+	uint32_t                 Down_Len[2];
+	uint32_t                 Down_Off[2];
+	uint8_t                  Down_Rx;
+	uint8_t                  Down_Tx;
+	uint8_t                  Down_Dma;
+
+	uint8_t                  Up[2][USBH_MAX_DATA_BUFFER];
+	volatile uint32_t        Up_Len[2];
+	volatile uint8_t         Up_Fill;
+	uint32_t                 Up_Tx_Len;
+	uint8_t                  Up_Tx_Busy;
+
+	volatile uint8_t         Attached;
+	uint8_t                  Started;
+	USART_Num_t              USART_Num;
+	USART_UsbBridge_Stats_t  Stats;
+} usart_bridge_t;
+
+static usart_bridge_t Bridge;
+
+/* =========================================================================================
+ *                                 USART side (interrupts)
+ * =========================================================================================
+ */
+static void usart_bridge_rx_hook(USART_Num_t USART_Num, const uint8_t *Data, uint32_t Len)
+{
+	uint8_t  Fill = Bridge.Up_Fill;
+	uint32_t Used = Bridge.Up_Len[Fill];
+	uint32_t Take = 0U;
+
+	(void)USART_Num;
+
+	if(Bridge.Attached != 0U)
+	{
+		Take = USBH_MAX_DATA_BUFFER - Used;
+		if(Take > Len)
+		{
+			Take = Len;
+		}
+		memcpy(&Bridge.Up[Fill][Used], Data, Take);
+		Bridge.Up_Len[Fill] = Used + Take;
+	}
+	Bridge.Stats.Up_Dropped += Len - Take;
+
+	if(Take != 0U)
+	{
+		MX_USB_HOST_WakeFromISR();
+	}
+}
+
+#if (USART_TX_DMA == ENABLE)
+static void usart_bridge_tx_done(USART_Num_t USART_Num)
+{
+	(void)USART_Num;
+
+	Bridge.Down_State[Bridge.Down_Dma] = BRIDGE_FREE;
+	MX_USB_HOST_WakeFromISR();
+}
+#endif
+
+/* =========================================================================================
+ *                               USB side (USB host task)
+ * =========================================================================================
+ */
+void USBH_CDC_ReceiveCallback(USBH_HandleTypeDef *phost)
+{
+	CDC_HandleTypeDef *CDC_Handle = (CDC_HandleTypeDef *)phost->pActiveClass->pData;
+	uint8_t            Rx         = Bridge.Down_Rx;
+	uint32_t           Len;
+
+	/* pRxData advanced over every full packet; the last one is not included. */
+	Len = (uint32_t)(CDC_Handle->pRxData - Bridge.Down[Rx]) + USBH_CDC_GetLastReceivedDataSize(phost);
+
+	if((Bridge.Down_State[Rx] == BRIDGE_RECEIVING) && (Len != 0U))
+	{
+		Bridge.Down_Len[Rx]   = Len;
+		Bridge.Down_Off[Rx]   = 0U;
+		Bridge.Down_State[Rx] = BRIDGE_FULL;
+		Bridge.Down_Rx        = Rx ^ 1U;
+	}
+	else
+	{
+		/* Zero-length packet: receive into the same buffer again. */
+		Bridge.Down_State[Rx] = BRIDGE_FREE;
+	}
+}
+
+void USBH_CDC_TransmitCallback(USBH_HandleTypeDef *phost)
+{
+	(void)phost;
+
+	Bridge.Stats.Up_Bytes     += Bridge.Up_Tx_Len;
+	Bridge.Stats.Up_Transfers += 1U;
+
+	/* The buffer is not Up_Fill: the RX hook does not touch it. */
+	Bridge.Up_Len[Bridge.Up_Fill ^ 1U] = 0U;
+	Bridge.Up_Tx_Len  = 0U;
+	Bridge.Up_Tx_Busy = 0U;
+}
+
+/* CDC device ready / gone: USB transfers in progress are lost with the pipes. */
+static void usart_bridge_attach(uint8_t Attached)
+{
+	for(uint32_t i = 0 ; i < 2U ; i++)
+	{
+		if(Bridge.Down_State[i] == BRIDGE_RECEIVING)
+		{
+			Bridge.Down_State[i] = BRIDGE_FREE;
+		}
+	}
+
+	taskENTER_CRITICAL();
+	Bridge.Up_Len[0]  = 0U;
+	Bridge.Up_Len[1]  = 0U;
+	Bridge.Up_Tx_Len  = 0U;
+	Bridge.Up_Tx_Busy = 0U;
+	Bridge.Attached   = Attached;
+	taskEXIT_CRITICAL();
+
+	if(Attached != 0U)
+	{
+		Bridge.Stats.Attaches += 1U;
+	}
+}
+
+/* Hand full down buffers to the USART, oldest first, without blocking. */
+static void usart_bridge_down_forward(void)
+{
+	uint8_t  Tx;
+	uint8_t  Done;
+
+	do
+	{
+		Done = 0U;
+		Tx   = Bridge.Down_Tx;
+
+		if(Bridge.Down_State[Tx] == BRIDGE_FULL)
+		{
+#if (USART_TX_DMA == ENABLE)
+			/* One buffer in flight at a time: the completion frees Down_Dma. */
+			if(Bridge.Down_State[Tx ^ 1U] != BRIDGE_SENDING)
+			{
+				Bridge.Down_Dma       = Tx;
+				Bridge.Down_State[Tx] = BRIDGE_SENDING;
+
+				if(USART_SendBuffer(Bridge.USART_Num, Bridge.Down[Tx], (uint16_t)Bridge.Down_Len[Tx], usart_bridge_tx_done) == USART_Tx_Ok)
+				{
+					Bridge.Stats.Down_Bytes     += Bridge.Down_Len[Tx];
+					Bridge.Stats.Down_Transfers += 1U;
+					Bridge.Down_Tx = Tx ^ 1U;
+				}
+				else
+				{
+					/* Transmitter busy with other TX: retry on the next poll. */
+					Bridge.Down_State[Tx] = BRIDGE_FULL;
+				}
+			}
+#else
+			USART_TxResv_t Resv;
+			uint32_t       Chunk;
+
+			while(Bridge.Down_Off[Tx] < Bridge.Down_Len[Tx])
+			{
+				Chunk = Bridge.Down_Len[Tx] - Bridge.Down_Off[Tx];
+				if(Chunk > USART_USB_BRIDGE_TX_CHUNK)
+				{
+					Chunk = USART_USB_BRIDGE_TX_CHUNK;
+				}
+
+				if(USART_TxReserve(Bridge.USART_Num, Chunk, USART_NO_WAIT, &Resv) != USART_Tx_Ok)
+				{
+					break;
+				}
+				(void)USART_TxWrite(&Resv, &Bridge.Down[Tx][Bridge.Down_Off[Tx]], Chunk);
+				(void)USART_TxCommit(&Resv);
+				Bridge.Down_Off[Tx] += Chunk;
+			}
+
+			if(Bridge.Down_Off[Tx] == Bridge.Down_Len[Tx])
+			{
+				Bridge.Stats.Down_Bytes     += Bridge.Down_Len[Tx];
+				Bridge.Stats.Down_Transfers += 1U;
+				Bridge.Down_State[Tx] = BRIDGE_FREE;
+				Bridge.Down_Tx        = Tx ^ 1U;
+				Done = 1U;
+			}
+#endif
+		}
+	} while(Done != 0U);
+}
+
+static void usart_bridge_service(void)
+{
+	uint8_t  Attached = ((Appli_state == APPLICATION_READY) && (hUsbHostFS.gState == HOST_CLASS)) ? 1U : 0U;
+	uint8_t  Fill;
+	uint8_t  Rx;
+
+	if(Attached != Bridge.Attached)
+	{
+		usart_bridge_attach(Attached);
+	}
+
+	/* USB -> USART: data already received is delivered even after a detach. */
+	usart_bridge_down_forward();
+
+	if(Attached != 0U)
+	{
+		/* Keep one IN transfer pending whenever a buffer is free. */
+		Rx = Bridge.Down_Rx;
+		if((Bridge.Down_State[Rx] == BRIDGE_FREE) && (Bridge.Down_State[Rx ^ 1U] != BRIDGE_RECEIVING))
+		{
+			if(USBH_CDC_Receive(&hUsbHostFS, Bridge.Down[Rx], USBH_MAX_DATA_BUFFER) == USBH_OK)
+			{
+				Bridge.Down_State[Rx] = BRIDGE_RECEIVING;
+			}
+		}
+
+		/* USART -> USB: swap buffers once the OUT pipe is free and data is waiting. */
+		if((Bridge.Up_Tx_Len == 0U) && (Bridge.Up_Len[Bridge.Up_Fill] != 0U))
+		{
+			taskENTER_CRITICAL();
+			Fill             = Bridge.Up_Fill;
+			Bridge.Up_Tx_Len = Bridge.Up_Len[Fill];
+			Bridge.Up_Fill   = Fill ^ 1U;
+			taskEXIT_CRITICAL();
+		}
+
+		if((Bridge.Up_Tx_Len != 0U) && (Bridge.Up_Tx_Busy == 0U))
+		{
+			if(USBH_CDC_Transmit(&hUsbHostFS, Bridge.Up[Bridge.Up_Fill ^ 1U], Bridge.Up_Tx_Len) == USBH_OK)
+			{
+				Bridge.Up_Tx_Busy = 1U;
+			}
+		}
+	}
+}
+
+/* =========================================================================================
+ *                                      Public API
+ * =========================================================================================
+ */
+USART_Err_St_t USART_UsbBridge_Start(USART_Num_t USART_Num)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Ok;
+	uint32_t       Baud;
+
+	if(USART_Num >= USART_MAX_NUM)
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else if(USART_GetBaud(USART_Num, &Baud) != USART_Ok)
+	{
+		USART_Err_Ret =  USART_Not_Init;
+	}
+	else if(Bridge.Started != 0U)
+	{
+		/* Buffers may be in flight on the first port. */
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else
+	{
+		(void)USART_SetRxHook(USART_Num, NULL);
+
+		memset(&Bridge.Stats, 0, sizeof(Bridge.Stats));
+		Bridge.USART_Num = USART_Num;
+		Bridge.Started   = 1U;
+
+		(void)USART_SetRxHook(USART_Num, usart_bridge_rx_hook);
+	}
+	return USART_Err_Ret;
+}
+
+void USART_UsbBridge_Service(void)
+{
+	if(Bridge.Started != 0U)
+	{
+		usart_bridge_service();
+	}
+}
+
+USART_Err_St_t USART_UsbBridge_GetStats(USART_UsbBridge_Stats_t *Stats)
+{
+	USART_Err_St_t USART_Err_Ret =  USART_Ok;
+
+	if(Stats == NULL)
+	{
+		USART_Err_Ret =  USART_Invalid_Arg;
+	}
+	else if(Bridge.Started == 0U)
+	{
+		USART_Err_Ret =  USART_Not_Init;
+	}
+	else
+	{
+		taskENTER_CRITICAL();
+		*Stats = Bridge.Stats;
+		taskEXIT_CRITICAL();
+	}
+	return USART_Err_Ret;
+}
+
+#endif /* USART_USB_BRIDGE */
@@ -0,0 +1,115 @@
+/*
+ * =========================================================================================
+ *  File      : USART_UsbBridge.h
+ *  Author    : Ahmed
+ *  Created   : Mar 2, 2026
+ *
+ *  Description:
+ *  ------------
+ *  Transparent bridge between a CDC device on the USB host port (USBH_CDC_CLASS,
+ *  e.g. a USB modem) and one USART port, in both directions.
+ *
+ *  Buffers (ping-pong, USBH_MAX_DATA_BUFFER bytes each, no queues):
+ *  ----------------------------------------------------------------
+ *   - USB -> USART: USBH_CDC_Receive() fills one buffer while the other is being
+ *     sent. With USART_TX_DMA the filled buffer is handed to USART_SendBuffer() as
+ *     is (no copy); otherwise it goes into the TX ring in USART_TxReserve() chunks
+ *     of USART_USB_BRIDGE_TX_CHUNK bytes (one block copy, never a blocking wait).
+ *   - USART -> USB: the bridge is the port's RX hook (USART_SetRxHook), which
+ *     appends each received chunk to the filling buffer in the RX interrupt. When
+ *     the CDC OUT pipe is idle the buffers swap and the full one goes to
+ *     USBH_CDC_Transmit() as is. Bytes that find both buffers full are dropped
+ *     (counted in Up_Dropped).
+ *   - A buffer is refilled only after its transfer completed, so every transfer
+ *     reads and writes its buffer in place.
+ *
+ *  Threading:
+ *  ----------
+ *   - All USBH_CDC_* calls, the CDC callbacks (USBH_CDC_ReceiveCallback /
+ *     USBH_CDC_TransmitCallback, defined here) and USART_UsbBridge_Service() run in
+ *     the USB host task (TASKS_Usb_Host); the USB host library is not reentrant.
+ *   - The RX hook and the USART_SendBuffer() completion wake that task with
+ *     MX_USB_HOST_WakeFromISR(); USB events wake it from the OTG_FS interrupt.
+ *   - Line coding of the CDC device is left as enumerated: the device's own
+ *     serial side (if any) is the modem's business, not the bridge's.
+ * =========================================================================================
+ */
+
+#ifndef TASKS_USART_USBBRIDGE_H_
+#define TASKS_USART_USBBRIDGE_H_
+
+#include <stdint.h>
+
+#include "USART.h"
+
+/* =========================================================================================
+ *                                   Bridge Parameters
+ * =========================================================================================
+ *
+ * USART_USB_BRIDGE           : ENABLE runs the bridge in the USB host task (TASKS_Usb_Host)
+ * USART_USB_BRIDGE_PORT      : USART bridged to the CDC device
+ * USART_USB_BRIDGE_TX_CHUNK  : largest TX ring reservation per USART_TxReserve() call
+ *                              (no USART_TX_DMA); one full-speed bulk packet by default
+ */
+#ifndef USART_USB_BRIDGE
+#define USART_USB_BRIDGE             DISABLE
+#endif
+
+#ifndef USART_USB_BRIDGE_PORT
+#define USART_USB_BRIDGE_PORT        USART_NUM_2
+#endif
+
+#ifndef USART_USB_BRIDGE_TX_CHUNK
+#define USART_USB_BRIDGE_TX_CHUNK    64U
+#endif
+
+/*
+ * USART_UsbBridge_Stats_t (USART_UsbBridge_GetStats):
+ *
+ * Down_Bytes / Up_Bytes:
+ *  - Bytes forwarded USB -> USART / USART -> USB
+ * Down_Transfers / Up_Transfers:
+ *  - Buffers forwarded in each direction
+ * Up_Dropped:
+ *  - USART bytes lost because both USB-bound buffers were full
+ * Attaches:
+ *  - CDC devices that became ready (each one restarts the bridge)
+ */
+typedef struct
+{
+	uint32_t Down_Bytes;
+	uint32_t Up_Bytes;
+	uint32_t Down_Transfers;
+	uint32_t Up_Transfers;
+	uint32_t Up_Dropped;
+	uint32_t Attaches;
+} USART_UsbBridge_Stats_t;
+
+/* =========================================================================================
+ *                                      Public API
+ * =========================================================================================
+ */
+
+/**
+ * @brief  Bind the bridge to an initialized port.
+ * @param  USART_Num  Logical USART instance ID (USART_Init() already called)
+ * @return USART_Ok, USART_Invalid_Arg or USART_Not_Init.
+ * @note   Task context, before the first USART_UsbBridge_Service(). The port's
+ *         received bytes go to the bridge from now on (not to USART_Receive).
+ */
+USART_Err_St_t USART_UsbBridge_Start(USART_Num_t USART_Num);
+
+/**
+ * @brief  Move the bridge forward: start CDC transfers, hand received USB data to
+ *         the USART. Never blocks.
+ * @note   Call it right after each USBH_Process(), in the same task. A full TX
+ *         buffer is retried on the next call.
+ */
+void USART_UsbBridge_Service(void);
+
+/**
+ * @brief  Copy the bridge counters.
+ */
+USART_Err_St_t USART_UsbBridge_GetStats(USART_UsbBridge_Stats_t *Stats);
+
+#endif /* TASKS_USART_USBBRIDGE_H_ */
@@ -68,6 +68,10 @@
 #define configGENERATE_RUN_TIME_STATS	0
 #define configEnable_FPU 0
 
+/* Index 0 stays free for the application, index 1 is used by the USART driver
+   (USART_NOTIFY_INDEX in USART_Prv.h) to wake tasks blocked in USART_Send/Receive. */
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES	2
+
 /* Software timer definitions. */
 #define configUSE_TIMERS				1
 #define configTIMER_TASK_PRIORITY		( 2 )
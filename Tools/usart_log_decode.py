@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+# =========================================================================================
+#  File      : usart_log_decode.py
+#  Author    : Ahmed
+#  Created   : Feb 14, 2026
+#
+#  Description:
+#  ------------
+#  Host decoder for the deferred binary logger (TASKS/USART_Log.h).
+#
+#  Reads the format strings from the "usart_log" section of the firmware ELF, then
+#  turns the binary record stream (file, pipe or serial device) back into text:
+#
+#    stty -F /dev/ttyUSB0 115200 raw
+#    python3 Tools/usart_log_decode.py Debug/UART_Asynchronous_Driver.elf /dev/ttyUSB0
+#
+#  Frames: 0xA5 | Len | varint(ID) | varint(Arg)...  (Len = bytes after Len)
+#  Bytes that do not form a valid frame (line noise, a lost chunk) are skipped
+#  until the next frame decodes. No third-party modules needed.
+# =========================================================================================
+
+import re
+import struct
+import sys
+
+SYNC = 0xA5
+SECTION = "usart_log"
+
+# %[flags][width][.precision][length]conversion, as far as USART_LOG() supports it.
+SPEC = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(?:hh|h|ll|l|j|z|t)?([diouxXcp%])")
+
+
+def elf_section(path, name):
+    """Return the raw bytes of section 'name' (ELF32/ELF64, little endian)."""
+    with open(path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF" or elf[5] != 1:
+        sys.exit("%s: not a little-endian ELF file" % path)
+    if elf[4] == 1:
+        shoff, = struct.unpack_from("<I", elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x2E)
+        fmt = "<IIIIII"
+    else:
+        shoff, = struct.unpack_from("<Q", elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x3A)
+        fmt = "<IIQQQQ"
+
+    headers = [struct.unpack_from(fmt, elf, shoff + i * shentsize) for i in range(shnum)]
+    strtab = headers[shstrndx]
+    for sh_name, _, _, _, offset, size in headers:
+        start = strtab[4] + sh_name
+        if elf[start:elf.index(b"\0", start)].decode() == name:
+            return elf[offset:offset + size]
+    sys.exit("%s: no '%s' section (no USART_LOG() calls, or stripped ELF)" % (path, name))
+
+
+def fmt_arg(match, value):
+    flags, width, precision, conv = match.groups()
+    if conv == "%":
+        return "%"
+    if conv in "di":
+        value = value - (1 << 32) if value & 0x80000000 else value
+        conv = "d"
+    elif conv == "u":
+        conv = "d"
+    elif conv == "c":
+        return chr(value & 0xFF)
+    elif conv == "p":
+        return "0x%08x" % value
+    spec = "%" + flags + width + ("." + precision if precision else "") + conv
+    return spec % value
+
+
+def render(fmt, args):
+    out = []
+    pos = 0
+    args = iter(args)
+    for match in SPEC.finditer(fmt):
+        out.append(fmt[pos:match.start()])
+        out.append("%" if match.group(4) == "%" else fmt_arg(match, next(args, 0)))
+        pos = match.end()
+    out.append(fmt[pos:])
+    return "".join(out)
+
+
+def varints(body):
+    """Decode a frame body into its LEB128 values, None if it is malformed."""
+    values, value, shift = [], 0, 0
+    for byte in body:
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if byte & 0x80 == 0:
+            values.append(value & 0xFFFFFFFF)
+            value, shift = 0, 0
+        elif shift > 28:
+            return None
+    return values if shift == 0 and values else None
+
+
+def decode(strings, stream):
+    buf = bytearray()
+    while True:
+        data = stream.read1(4096) if hasattr(stream, "read1") else stream.read(4096)
+        if not data:
+            break
+        buf += data
+        while len(buf) >= 2:
+            if buf[0] != SYNC:
+                del buf[0]
+                continue
+            end = 2 + buf[1]
+            if len(buf) < end:
+                break
+            values = varints(buf[2:end])
+            fmt = None
+            if values is not None and values[0] < len(strings):
+                nul = strings.find(b"\0", values[0])
+                fmt = strings[values[0]:nul].decode(errors="replace")
+            if fmt is None:
+                del buf[0]      # not a frame after all: resynchronize
+                continue
+            sys.stdout.write(render(fmt, values[1:]))
+            sys.stdout.flush()
+            del buf[:end]
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        sys.exit("usage: %s <firmware.elf> [stream (default: stdin)]" % sys.argv[0])
+    strings = elf_section(sys.argv[1], SECTION)
+    if len(sys.argv) == 3:
+        with open(sys.argv[2], "rb", buffering=0) as stream:
+            decode(strings, stream)
+    else:
+        decode(strings, sys.stdin.buffer)
+
+
+if __name__ == "__main__":
+    main()
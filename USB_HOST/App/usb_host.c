@@ -25,7 +25,8 @@
 #include "usbh_cdc.h"
 
 /* USER CODE BEGIN Includes */
-
+#include "FreeRTOS.h"
+#include "task.h"
 /* USER CODE END Includes */
 
 /* USER CODE BEGIN PV */
@@ -46,7 +47,20 @@ ApplicationTypeDef Appli_state = APPLICATION_IDLE;
  * -- Insert your variables declaration here --
  */
 /* USER CODE BEGIN 0 */
-
+/*
+ * RTOS integration (task notifications, USBH_USE_OS stays 0):
+ *  - ST's USBH_USE_OS mode is built on CMSIS-RTOS (cmsis_os.h), which this project
+ *    does not use. Instead one task runs USBH_Process() and sleeps in
+ *    MX_USB_HOST_Wait() on a notification (index 0) between events.
+ *  - Events: the OTG_FS interrupt callbacks in usbh_conf.c (connect / disconnect /
+ *    port / URB done) and application code that queued class work (the USB bridge
+ *    RX hook) call MX_USB_HOST_WakeFromISR() / MX_USB_HOST_Wake().
+ *  - The core only advances one state per USBH_Process() call and, without the OS
+ *    mode, posts no event for its own transitions: while it is enumerating or
+ *    between transfers it is run again at once or polled every tick (see
+ *    MX_USB_HOST_Wait()); when it is idle or waiting for the bus the task sleeps.
+ */
+static TaskHandle_t volatile USB_Host_Task = NULL;
 /* USER CODE END 0 */
 
 /*
@@ -94,9 +108,86 @@ void MX_USB_HOST_Init(void)
  */
 void MX_USB_HOST_Process(void)
 {
+  /* USER CODE BEGIN USB_HOST_Process */
+  /* The task that runs the host is the one woken by its events. */
+  if (USB_Host_Task == NULL)
+  {
+    USB_Host_Task = xTaskGetCurrentTaskHandle();
+  }
+  /* USER CODE END USB_HOST_Process */
+
   /* USB Host Background task */
   USBH_Process(&hUsbHostFS);
 }
+
+/* USER CODE BEGIN 2 */
+/*
+ * Sleep the host task until USBH_Process() has work:
+ *  - CDC data queued but not yet on the bus (SEND_DATA / RECEIVE_DATA): no sleep
+ *  - enumeration, class requests, state changes: one tick
+ *  - idle, or a transfer waiting for the bus: until an event (URB done, connect,
+ *    disconnect, application wake-up)
+ */
+void MX_USB_HOST_Wait(void)
+{
+  static HOST_StateTypeDef Last_State = HOST_IDLE;
+  CDC_HandleTypeDef *CDC_Handle = NULL;
+  TickType_t Ticks = portMAX_DELAY;
+
+  if (hUsbHostFS.gState == HOST_CLASS)
+  {
+    if (hUsbHostFS.pActiveClass != NULL)
+    {
+      CDC_Handle = (CDC_HandleTypeDef *)hUsbHostFS.pActiveClass->pData;
+    }
+
+    if ((CDC_Handle != NULL) &&
+        ((CDC_Handle->data_tx_state == CDC_SEND_DATA) || (CDC_Handle->data_rx_state == CDC_RECEIVE_DATA)))
+    {
+      Ticks = 0U;
+    }
+    else if ((CDC_Handle != NULL) &&
+             (CDC_Handle->state != CDC_IDLE_STATE) && (CDC_Handle->state != CDC_TRANSFER_DATA))
+    {
+      Ticks = 1U;
+    }
+  }
+  else if ((hUsbHostFS.gState != HOST_IDLE) || (hUsbHostFS.device.is_connected != 0U))
+  {
+    Ticks = 1U;
+  }
+
+  if (hUsbHostFS.gState != Last_State)
+  {
+    Ticks = 0U;
+  }
+  Last_State = hUsbHostFS.gState;
+
+  (void)ulTaskNotifyTake(pdTRUE, Ticks);
+}
+
+void MX_USB_HOST_Wake(void)
+{
+  TaskHandle_t Task = USB_Host_Task;
+
+  if (Task != NULL)
+  {
+    (void)xTaskNotifyGive(Task);
+  }
+}
+
+void MX_USB_HOST_WakeFromISR(void)
+{
+  TaskHandle_t Task = USB_Host_Task;
+  BaseType_t Woken = pdFALSE;
+
+  if (Task != NULL)
+  {
+    vTaskNotifyGiveFromISR(Task, &Woken);
+    portYIELD_FROM_ISR(Woken);
+  }
+}
+/* USER CODE END 2 */
 /*
  * user callback definition
  */
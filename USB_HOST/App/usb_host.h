@@ -72,6 +72,15 @@ void MX_USB_HOST_Init(void);
 
 void MX_USB_HOST_Process(void);
 
+/* USER CODE BEGIN FunctionsPrototype */
+/** @brief Sleep the task calling MX_USB_HOST_Process() until the host has work. */
+void MX_USB_HOST_Wait(void);
+
+/** @brief Wake the host task (task / interrupt context). */
+void MX_USB_HOST_Wake(void);
+void MX_USB_HOST_WakeFromISR(void);
+/* USER CODE END FunctionsPrototype */
+
 /**
   * @}
   */
@@ -23,7 +23,9 @@
 #include "usbh_platform.h"
 
 /* USER CODE BEGIN Includes */
-
+#include "FreeRTOS.h"
+#include "task.h"
+#include "usb_host.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -94,7 +96,9 @@ void HAL_HCD_MspInit(HCD_HandleTypeDef* hcdHandle)
     HAL_NVIC_SetPriority(OTG_FS_IRQn, 0, 0);
     HAL_NVIC_EnableIRQ(OTG_FS_IRQn);
   /* USER CODE BEGIN USB_OTG_FS_MspInit 1 */
-
+    /* The interrupt wakes the host task (FromISR API): it must be at or below
+       configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, and below the USARTs. */
+    HAL_NVIC_SetPriority(OTG_FS_IRQn, 5, 0);
   /* USER CODE END USB_OTG_FS_MspInit 1 */
   }
 }
@@ -144,6 +148,7 @@ void HAL_HCD_SOF_Callback(HCD_HandleTypeDef *hhcd)
 void HAL_HCD_Connect_Callback(HCD_HandleTypeDef *hhcd)
 {
   USBH_LL_Connect(hhcd->pData);
+  MX_USB_HOST_WakeFromISR();
 }
 
 /**
@@ -154,6 +159,7 @@ void HAL_HCD_Connect_Callback(HCD_HandleTypeDef *hhcd)
 void HAL_HCD_Disconnect_Callback(HCD_HandleTypeDef *hhcd)
 {
   USBH_LL_Disconnect(hhcd->pData);
+  MX_USB_HOST_WakeFromISR();
 }
 
 /**
@@ -169,6 +175,13 @@ void HAL_HCD_HC_NotifyURBChange_Callback(HCD_HandleTypeDef *hhcd, uint8_t chnum,
 #if (USBH_USE_OS == 1)
   USBH_LL_NotifyURBChange(hhcd->pData);
 #endif
+  /* USER CODE BEGIN NotifyURBChange */
+  /* A NAKed IN transfer is retried by the HCD driver itself: nothing to process. */
+  if ((urb_state != URB_NOTREADY) || (hhcd->hc[chnum].ep_is_in == 0U))
+  {
+    MX_USB_HOST_WakeFromISR();
+  }
+  /* USER CODE END NotifyURBChange */
 }
 /**
 * @brief  Port Port Enabled callback.
@@ -178,6 +191,7 @@ void HAL_HCD_HC_NotifyURBChange_Callback(HCD_HandleTypeDef *hhcd, uint8_t chnum,
 void HAL_HCD_PortEnabled_Callback(HCD_HandleTypeDef *hhcd)
 {
   USBH_LL_PortEnabled(hhcd->pData);
+  MX_USB_HOST_WakeFromISR();
 }
 
 /**
@@ -188,6 +202,7 @@ void HAL_HCD_PortEnabled_Callback(HCD_HandleTypeDef *hhcd)
 void HAL_HCD_PortDisabled_Callback(HCD_HandleTypeDef *hhcd)
 {
   USBH_LL_PortDisabled(hhcd->pData);
+  MX_USB_HOST_WakeFromISR();
 }
 
 /*******************************************************************************
@@ -531,7 +546,18 @@ uint8_t USBH_LL_GetToggle(USBH_HandleTypeDef *phost, uint8_t pipe)
   */
 void USBH_Delay(uint32_t Delay)
 {
-  HAL_Delay(Delay);
+  /* USER CODE BEGIN USBH_Delay */
+  /* Attach / reset delays (up to 200 ms): sleep instead of spinning once the
+     host runs in its task. */
+  if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)
+  {
+    vTaskDelay(pdMS_TO_TICKS(Delay) + 1U);
+  }
+  else
+  {
+    HAL_Delay(Delay);
+  }
+  /* USER CODE END USBH_Delay */
 }
 
 /**